@@ -27,6 +27,13 @@
 /// Asserts that a given mobj is a client mobj.
 #define CL_ASSERT_CLMOBJ(mo)    DE_ASSERT(Cl_IsClientMobj(mo));
 
+/// Maximum number of received states remembered for each client mobj.
+#define CLMOBJ_HISTORY_MAX      16
+
+/// Number of received states used for interpolating client mobj origins
+/// (cvar "client-mobj-history"). Zero disables interpolation.
+extern int clMobjHistoryDepth;
+
 /**
  * Make the real player mobj identical with the client mobj.
  * The client mobj is always unlinked. Only the *real* mobj is visible.
@@ -75,6 +82,36 @@ void ClMobj_ReadDelta();
  */
 void ClMobj_ReadNullDelta();
 
+/**
+ * Clears the history of received client mobj states and (re)allocates the shared
+ * history pool. Called when the map changes.
+ */
+void ClMobj_ResetHistory();
+
+/**
+ * Notes that a frame with the given server game time has been received. The interval
+ * between frames determines how far in the past client mobjs are rendered.
+ */
+void ClMobj_HistoryFrameReceived(float gameTime);
+
+/**
+ * Forgets the received states of the client mobj @a id, releasing its history slot.
+ */
+void ClMobj_ForgetHistory(thid_t id);
+
+/**
+ * Determines the render origin of a client mobj by interpolating between the states
+ * received from the server (or extrapolating from the latest one using the mobj's
+ * momentum, if the next state is late).
+ *
+ * @param mob     Client mobj. Players are ignored (they have their own Smoother).
+ * @param origin  The interpolated origin is written here. Not modified if @c false
+ *                is returned.
+ *
+ * @return  @c true, if an interpolated origin was available.
+ */
+dd_bool ClMobj_HistoryOrigin(const mobj_t *mob, coord_t origin[3]);
+
 /**
  * Determines whether a mobj is a client mobj.
  *
@@ -42,6 +42,10 @@ namespace de
 
 struct texturecontent_s;
 
+/// Maximum amount of deferred texture content uploaded per frame, in KiB (cvar
+/// "rend-tex-upload-budget"). Zero means only the time limit applies.
+extern int glDeferredUploadBudget;
+
 /**
  * Initializes the deferred tasks module.
  */
@@ -66,7 +70,9 @@ int GL_DeferredTaskCount();
  * Processes deferred GL tasks. This must be called from the main thread.
  *
  * @param timeOutMilliSeconds  Processing will continue until this timeout expires.
- *                             Use zero for no timeout.
+ *                             Use zero for no timeout. When a timeout is given,
+ *                             texture uploads are also limited by
+ *                             @ref glDeferredUploadBudget.
  */
 void GL_ProcessDeferredTasks(uint timeOutMilliSeconds);
 
@@ -298,7 +298,8 @@ uint8_t *GL_ConvertBuffer(const uint8_t *src, int width, int height,
     int informat, colorpaletteid_t paletteId, int outformat);
 
 /**
- * @param method  Unique identifier of the smart filtering method to apply.
+ * @param method  Unique identifier of the smart filtering method to apply:
+ *                0=linear, 1=nearest neighbor, 2=hq2x, 3=hq4x (hq2x applied twice).
  * @param src  Source image to be filtered.
  * @param width  Width of the source image in pixels.
  * @param height  Height of the source image in pixels.
@@ -323,10 +324,42 @@ void GL_CalcLuminance(const uint8_t *buffer, int width, int height, int comps,
 
 // DGL internal API ---------------------------------------------------------------------
 
+/**
+ * Drawing statistics since the latest call to DGL_BeginFrame().
+ */
+struct DGLFrameStats
+{
+    unsigned int drawCalls;
+    unsigned int batches;           ///< Batches drawn (Begin/End sections, unless merged).
+    unsigned int vertices;          ///< Vertices submitted (after converting primitives).
+    unsigned int primitiveSwitches; ///< Flushes caused by incompatible primitives.
+    unsigned int stateChanges;      ///< Draw calls with a different GL state than the previous one.
+    unsigned int mergedSections;    ///< Begin/End sections drawn as part of the previous batch.
+};
+
 void      DGL_Shutdown();
 unsigned int    DGL_BatchMaxSize();
 void      DGL_BeginFrame();
 void            DGL_Flush();
+DGLFrameStats   DGL_FrameStats();
+
+/**
+ * Enables or disables the null drawing backend. When enabled, DGL primitives are
+ * batched and counted as usual, but nothing is submitted to OpenGL: there are no
+ * uniform or vertex uploads, state changes, texture unit or texture binding changes,
+ * or draw calls. Used for measuring the CPU cost of rendering. Textures are still
+ * prepared (and uploaded, if not yet done) normally.
+ */
+void            DGL_SetNullBackend(bool enable);
+bool            DGL_IsNullBackend();
+
+/**
+ * Binds a 2D texture to the active DGL texture unit. With the null backend, the
+ * binding is only remembered for batching and nothing is changed in OpenGL.
+ *
+ * @return @c true if the texture was bound in OpenGL, so its parameters may be set.
+ */
+bool            DGL_BindTexture2D(GLuint glName);
 void      DGL_AssertNotInPrimitive(void);
 de::Mat4f DGL_Matrix(DGLenum matrixMode);
 void      DGL_CurrentColor(DGLubyte *rgba);
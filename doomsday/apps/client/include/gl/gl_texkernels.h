@@ -0,0 +1,182 @@
+/** @file gl_texkernels.h  Inner loops of the image manipulation algorithms.
+ *
+ * @ingroup gl
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_GL_TEXKERNELS_H
+#define DE_GL_TEXKERNELS_H
+
+#include <cstdint>
+
+/**
+ * Table of the inner loops used by the image manipulation algorithms (see gl_tex.h).
+ *
+ * Each kernel has a portable scalar implementation and, on x86, SSE2 and AVX2
+ * implementations. The best implementation supported by the CPU is chosen at runtime.
+ * All implementations produce identical results.
+ *
+ * The kernels have no dependencies to the rest of the engine so that they can be
+ * verified and benchmarked in isolation (see tests/test_texkernels).
+ */
+struct ImageKernels
+{
+    enum Level { Scalar, SSE2, AVX2, LevelCount };
+
+    Level level;
+    const char *name;
+
+    /**
+     * Sums each channel of @a count RGBA pixels, and counts the pixels whose alpha
+     * is less than 255.
+     */
+    void (*sumRGBA)(const uint8_t *pixels, long count, uint64_t sums[4], long *translucentCount);
+
+    /**
+     * Finds the smallest and largest of @a count bytes, their sum, and the number of
+     * bytes equal to 255.
+     */
+    void (*byteStats)(const uint8_t *bytes, long count, uint8_t *min, uint8_t *max,
+                      uint64_t *sum, long *maxedCount);
+
+    /**
+     * Finds the largest of the @a count bytes whose corresponding @a mask byte is
+     * nonzero. Returns zero if there are no such bytes.
+     */
+    uint8_t (*maskedMax)(const uint8_t *bytes, const uint8_t *mask, long count);
+
+    /**
+     * Replaces the color of each of the @a count RGBA pixels with a gray level midway
+     * between its smallest and largest component. Alpha is not changed.
+     */
+    void (*desaturateRGBA)(uint8_t *pixels, long count);
+
+    /**
+     * Linear interpolation between two rows of @a count bytes:
+     * <pre>out[i] = (a[i] * (0x10000 - weight) + b[i] * weight) >> 16</pre>
+     *
+     * @param weight  Fixed-point (16.16) weight of @a b, in the range [0, 0x10000).
+     */
+    void (*lerpBytes)(const uint8_t *a, const uint8_t *b, uint8_t *out, long count, int weight);
+
+    /**
+     * Box-filters two rows of 2 x @a outWidth RGBA pixels into one row of @a outWidth
+     * pixels. @a out may point to @a row0 (but not anywhere else in the input rows).
+     */
+    void (*halveRGBA)(const uint8_t *row0, const uint8_t *row1, uint8_t *out, long outWidth);
+
+    /**
+     * Box-filters two rows of 2 x @a outWidth bytes into one row of @a outWidth bytes.
+     * @a out may point to @a row0 (but not anywhere else in the input rows).
+     */
+    void (*halveBytes)(const uint8_t *row0, const uint8_t *row1, uint8_t *out, long outWidth);
+
+    /**
+     * Finds the first and last of @a count RGBA pixels whose alpha is 255.
+     *
+     * @return @c false, if there are no such pixels.
+     */
+    bool (*opaqueSpanRGBA)(const uint8_t *pixels, long count, long *first, long *last);
+
+    /**
+     * Finds the first and last of @a count alpha values that are 255.
+     *
+     * @return @c false, if there are no such values.
+     */
+    bool (*opaqueSpanAlpha)(const uint8_t *alpha, long count, long *first, long *last);
+
+    /**
+     * Classifies the neighborhoods of @a count pixels for the hq2x upscaler. The
+     * pixels are represented by color keys: YUV888 in the low 24 bits, and 0xff in
+     * the high byte if the pixel is not fully transparent.
+     *
+     * A neighbor differs from the center pixel if their transparency differs, or
+     * their Y, U, or V components differ by more than 48, 7, or 6, respectively.
+     * The pattern of pixel @c x has one bit per differing neighbor, in order:
+     * above[x-1], above[x], above[x+1], row[x-1], row[x+1], below[x-1], below[x],
+     * below[x+1]. The rows must therefore be readable from index -1 to @a count.
+     */
+    void (*hqPatterns)(const uint32_t *above, const uint32_t *row, const uint32_t *below,
+                       long count, uint8_t *patterns);
+
+    /**
+     * Converts @a count color indices to RGBA pixels by looking them up in @a table,
+     * which has 256 RGBA colors (in memory order R, G, B, A).
+     *
+     * @param alpha  If not @c nullptr, the alpha of each pixel is taken from here
+     *               instead of the table.
+     */
+    void (*indexedToRGBA)(const uint8_t *indices, const uint8_t *alpha, const uint32_t *table,
+                          long count, uint8_t *out);
+};
+
+/**
+ * Returns the fastest kernels supported by the CPU.
+ */
+const ImageKernels &GL_ImageKernels();
+
+/**
+ * Returns the kernels of a specific implementation level, or @c nullptr if the level
+ * is not available in this build or not supported by the CPU.
+ */
+const ImageKernels *GL_ImageKernelsAtLevel(ImageKernels::Level level);
+
+/*
+ * Whole-image operations built on the kernels. Like the kernels, these have no
+ * dependencies to the rest of the engine; gl_tex.cpp calls them with GL_ImageKernels().
+ */
+
+/**
+ * Scales an image to a new size using linear interpolation when magnifying and
+ * averaging when minifying. Each row is first scaled horizontally, then the rows are
+ * scaled vertically.
+ *
+ * @param out  Output image of @a outWidth x @a outHeight pixels.
+ */
+void GL_ScaleImage(const ImageKernels &kernels, const uint8_t *in, int width, int height,
+                   int comps, uint8_t *out, int outWidth, int outHeight);
+
+/**
+ * Box-filters an image in place to half its size, using 2x2 pixel blocks. Both
+ * dimensions must be at least 2.
+ */
+void GL_HalveImage(const ImageKernels &kernels, uint8_t *pixels, int width, int height,
+                   int comps);
+
+/**
+ * Finds the smallest region of an image that contains all of its fully opaque pixels.
+ *
+ * @param pixelSize  Size of each pixel. For 1, the alpha values follow the image. For
+ *                   sizes other than 1 and 4, all pixels are opaque.
+ * @param region     Left, right, top, and bottom edges of the region (inclusive). If
+ *                   there are no opaque pixels, set to @a width, 0, @a height, 0.
+ */
+void GL_FindOpaqueRegion(const ImageKernels &kernels, const uint8_t *pixels, int width,
+                         int height, int pixelSize, int region[4]);
+
+/**
+ * Converts @a count color indices to RGB or RGBA pixels by looking them up in @a table
+ * (see ImageKernels::indexedToRGBA).
+ *
+ * @param outComps  3 or 4.
+ */
+void GL_IndexedToTrueColor(const ImageKernels &kernels, const uint8_t *indices,
+                           const uint8_t *alpha, const uint32_t *table, long count,
+                           uint8_t *out, int outComps);
+
+#endif // DE_GL_TEXKERNELS_H
@@ -87,6 +87,22 @@ void GL_PrepareTextureContent(texturecontent_t &c,
                               const TextureVariantSpec &spec,
                               const res::TextureManifest &textureManifest);
 
+/**
+ * Applies the smart filter (and the processing preceding it) to @a content ahead of
+ * uploading, so that the work can be done in a worker thread. The content is changed
+ * to use the filtered pixels, which will not be processed again when uploaded.
+ *
+ * @return Filtered pixels, or @c nullptr if the content was not changed. The caller
+ * must free the buffer with M_Free() once the content has been uploaded.
+ */
+uint8_t *GL_SmartFilterTextureContent(texturecontent_t &content);
+
+/**
+ * Estimates the amount of texture memory used by @a content once uploaded,
+ * including upscaling and mipmaps.
+ */
+de::dsize GL_TextureContentSize(const texturecontent_t &content);
+
 /**
  * @param method  GL upload method. By default the upload is deferred.
  *
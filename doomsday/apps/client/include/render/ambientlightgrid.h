@@ -0,0 +1,138 @@
+/** @file ambientlightgrid.h  Baked grid of ambient light for lighting objects.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_CLIENT_RENDER_AMBIENTLIGHTGRID_H
+#define DE_CLIENT_RENDER_AMBIENTLIGHTGRID_H
+
+#include <memory>
+#include <vector>
+
+/**
+ * Three-dimensional grid of ambient light covering a map, used for lighting sprites,
+ * models and particles with a single lookup.
+ *
+ * The light of each cell has two parts:
+ * - The ambient light of the region (e.g., subsector) the cell's column is in. The
+ *   regions' light is kept in a table that can be updated at any time, so changes to
+ *   sector lighting take effect immediately without baking again.
+ * - Light from static sources (e.g., light decorations). A source only lights cells
+ *   in its own region so that light does not leak through walls. When sources are
+ *   added, removed or changed, only the cells they reach are updated.
+ *
+ * Sampling interpolates between the neighboring cells, ignoring cells outside the map.
+ * The grid does not depend on the rest of the renderer (see tests/test_ambientlightgrid).
+ *
+ * @ingroup render
+ */
+class AmbientLightGrid
+{
+public:
+    /// Provides information about the map for baking.
+    class MapInfo
+    {
+    public:
+        virtual ~MapInfo() = default;
+
+        /**
+         * Returns the light region at a point on the XY plane, or -1 if the point is
+         * outside the map. Called from several threads at once while baking.
+         */
+        virtual int regionAt(double x, double y) const = 0;
+    };
+
+    /// Static light source.
+    struct Light
+    {
+        double origin[3];
+        double radius;
+        float color[3];
+    };
+
+    struct Bounds
+    {
+        double min[3];
+        double max[3];
+    };
+
+public:
+    AmbientLightGrid();
+    ~AmbientLightGrid();
+
+    /**
+     * Bakes the grid. Region lights are reset to black.
+     *
+     * @param bounds       Map space volume to cover.
+     * @param cellSize     Size of a cell in map units. Increased if the grid would
+     *                     otherwise be too large.
+     * @param regionCount  Number of light regions.
+     * @param map          Map information.
+     * @param lights       Static light sources.
+     * @param threadCount  Number of parallel tasks to bake with. Zero means one per core.
+     */
+    void bake(const Bounds &bounds, double cellSize, int regionCount, const MapInfo &map,
+              const std::vector<Light> &lights, int threadCount = 0);
+
+    /**
+     * Changes the static light sources without baking the whole grid again. A changed
+     * source is first removed and then added back. The result equals baking with the
+     * new set of sources, apart from rounding errors.
+     *
+     * @param map      Map information (the same as when baking).
+     * @param removed  Sources to remove. These must have been baked or added earlier.
+     * @param added    Sources to add.
+     */
+    void updateLights(const MapInfo &map, const std::vector<Light> &removed,
+                      const std::vector<Light> &added);
+
+    void clear();
+
+    bool isBaked() const;
+
+    /**
+     * Returns the size of a cell in map units.
+     */
+    double cellSize() const;
+
+    /**
+     * Returns the number of cells in the grid.
+     */
+    size_t cellCount() const;
+
+    /**
+     * Changes the ambient light of a region.
+     *
+     * @param region  Region index.
+     * @param rgb     Light color, with intensity applied.
+     */
+    void setRegionLight(int region, const float rgb[3]);
+
+    /**
+     * Determines the ambient light at a point.
+     *
+     * @param point  Map space point.
+     * @param rgb    The light color is written here. Black if the grid is not baked.
+     */
+    void evaluate(const double point[3], float rgb[3]) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> d;
+};
+
+#endif // DE_CLIENT_RENDER_AMBIENTLIGHTGRID_H
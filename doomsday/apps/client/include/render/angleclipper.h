@@ -24,35 +24,7 @@
 #include <de/legacy/binangle.h>
 #include <de/vector.h>
 #include <doomsday/mesh/face.h>
-
-/**
- * Inclusive > inclusive binary angle range.
- *
- * @ingroup data
- */
-struct AngleRange
-{
-    binangle_t from;
-    binangle_t to;
-
-    explicit AngleRange(binangle_t a = 0, binangle_t b = 0) : from(a), to(b) {}
-
-    /**
-     * @return @c  0= "this" completely includes @a other.
-     *         @c  1= "this" contains the beginning of @a other.
-     *         @c  2= "this" contains the end of @a other.
-     *         @c  3= @other completely contains "this".
-     *         @c -1= No meaningful relationship.
-     */
-    int relationship(const AngleRange &other)
-    {
-        if(from >= other.from && to   <= other.to) return 0;
-        if(from >= other.from && from <  other.to) return 1;
-        if(to    > other.from && to   <= other.to) return 2;
-        if(from <= other.from && to   >= other.to) return 3;
-        return -1;
-    }
-};
+#include "render/anglerangelist.h"
 
 /**
  * 360 degree, polar angle(-range) clipper.
@@ -64,6 +36,9 @@ struct AngleRange
  * Oranges (occlusion ranges) clip a half-space on an angle range. These are produced
  * by horizontal edges that have empty space behind.
  *
+ * The ranges are kept in flat, sorted arrays (see ClipRangeList and OcclusionRangeList)
+ * that are reused from frame to frame.
+ *
  * @ingroup render
  */
 class AngleClipper
@@ -138,7 +113,7 @@ public:  // --------------------------------------------------------------------
 
 #ifdef DE_DEBUG
     /**
-     * A debugging aid: checks if clipnode links are valid.
+     * A debugging aid: checks that the ranges are in order.
      */
     void validate();
 #endif
@@ -0,0 +1,144 @@
+/** @file anglerangelist.h  Sorted lists of angle ranges for the angle clipper.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_CLIENT_RENDER_ANGLERANGELIST_H
+#define DE_CLIENT_RENDER_ANGLERANGELIST_H
+
+#include <de/legacy/binangle.h>
+#include <vector>
+
+/**
+ * Inclusive > inclusive binary angle range.
+ *
+ * @ingroup data
+ */
+struct AngleRange
+{
+    binangle_t from;
+    binangle_t to;
+
+    explicit AngleRange(binangle_t a = 0, binangle_t b = 0) : from(a), to(b) {}
+
+    /**
+     * @return @c  0= "this" completely includes @a other.
+     *         @c  1= "this" contains the beginning of @a other.
+     *         @c  2= "this" contains the end of @a other.
+     *         @c  3= @other completely contains "this".
+     *         @c -1= No meaningful relationship.
+     */
+    int relationship(const AngleRange &other) const
+    {
+        if(from >= other.from && to   <= other.to) return 0;
+        if(from >= other.from && from <  other.to) return 1;
+        if(to    > other.from && to   <= other.to) return 2;
+        if(from <= other.from && to   >= other.to) return 3;
+        return -1;
+    }
+};
+
+/**
+ * Clipped (solid) angle ranges. The ranges are kept in a flat array, sorted by start
+ * angle. Overlapping and touching ranges are merged, so the ranges never overlap and
+ * lookups can use a binary search.
+ *
+ * None of the ranges wrap around; the caller splits such ranges in two.
+ *
+ * @ingroup render
+ */
+class ClipRangeList
+{
+public:
+    void clear();
+
+    /**
+     * Adds a range, merging it with existing ranges it overlaps.
+     *
+     * @pre @a from <= @a to
+     */
+    void add(binangle_t from, binangle_t to);
+
+    /**
+     * Returns @c true if a single range includes all of [@a from, @a to].
+     */
+    bool contains(binangle_t from, binangle_t to) const;
+
+    /**
+     * Returns @c true if @a angle is inside a range, excluding the ends of the range.
+     */
+    bool containsAngle(binangle_t angle) const;
+
+    /**
+     * Returns @c true if the ranges cover all angles.
+     */
+    bool isFull() const;
+
+    const std::vector<AngleRange> &ranges() const { return _ranges; }
+
+private:
+    std::vector<AngleRange> _ranges;
+};
+
+/**
+ * Occlusion ranges. Each range clips a half-space, so unlike clipped ranges they can
+ * overlap each other. The ranges are kept in a flat array, sorted by start angle.
+ *
+ * @ingroup render
+ */
+class OcclusionRangeList
+{
+public:
+    struct Occluder : public AngleRange
+    {
+        bool  topHalf;    ///< @c true= top, rather than bottom, half.
+        float normal[3];  ///< Of the occlusion plane.
+    };
+
+    /**
+     * Decides which of two occluders with the same range is redundant.
+     *
+     * @return @c 0= Neither can be removed.
+     *         @c 1= The first one can be removed.
+     *         @c 2= The second one can be removed.
+     */
+    typedef int (*MergeFunc)(const Occluder &, const Occluder &);
+
+public:
+    void clear();
+
+    /**
+     * Adds a range. Ranges that wrap around are ignored.
+     */
+    void add(const Occluder &occluder);
+
+    /**
+     * Removes [@a from, @a to] from all the ranges, cutting ranges in two if needed.
+     * Afterwards, ranges that are made redundant by the cuts are merged using
+     * @a merge.
+     */
+    void cut(binangle_t from, binangle_t to, MergeFunc merge);
+
+    const std::vector<Occluder> &occluders() const { return _occluders; }
+
+private:
+    void mergeEqualRanges(MergeFunc merge);
+
+    std::vector<Occluder> _occluders;
+};
+
+#endif // DE_CLIENT_RENDER_ANGLERANGELIST_H
@@ -0,0 +1,59 @@
+/** @file depthsort.h  Linear-time back-to-front ordering of depth-sorted items.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_CLIENT_RENDER_DEPTHSORT_H
+#define DE_CLIENT_RENDER_DEPTHSORT_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Orders items by depth, farthest first, using a radix sort on the exact depth
+ * values. Items at equal depth are ordered by descending index, i.e., the item
+ * added last is drawn first (this matches the original selection sort of the
+ * vissprites).
+ *
+ * The sorter keeps its working buffers between calls so that sorting on every
+ * frame does not allocate memory. It has no dependencies on the rest of the
+ * renderer (see tests/test_depthsort).
+ *
+ * @ingroup render
+ */
+class DepthSorter
+{
+public:
+    /**
+     * Sorts items by depth.
+     *
+     * @param depths  Depth of each item (e.g., distance from the viewer).
+     * @param count   Number of items.
+     *
+     * @return Indices of the items, farthest first. Valid until the next call.
+     */
+    const std::vector<uint32_t> &sort(const double *depths, uint32_t count);
+
+private:
+    std::vector<uint64_t> _keys;
+    std::vector<uint64_t> _tempKeys;
+    std::vector<uint32_t> _order;
+    std::vector<uint32_t> _tempOrder;
+    std::vector<uint32_t> _histograms;
+};
+
+#endif // DE_CLIENT_RENDER_DEPTHSORT_H
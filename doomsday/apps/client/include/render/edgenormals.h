@@ -0,0 +1,125 @@
+/** @file edgenormals.h  Cached smoothed wall edge normals of a line side.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_CLIENT_RENDER_EDGENORMALS_H
+#define DE_CLIENT_RENDER_EDGENORMALS_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+
+/**
+ * Smoothed wall edge normals of the sections of a line side, cached between frames.
+ *
+ * The normal at each edge of a wall section is blended with the normal of a
+ * neighboring wall, which is found by walking the lines around the edge's vertex.
+ * That is expensive, so the result is kept until the geometry around the line
+ * changes: a plane of a sector the line borders moves, or a wall surface of the line
+ * changes its normal, material or opacity. As the neighbor is found around the
+ * vertices, the lines sharing a vertex with the changed line are invalidated, too.
+ *
+ * The map is described through the Topology interface, so the cache does not depend
+ * on the rest of the renderer (see tests/test_edgenormals). WallEdge uses it with the
+ * map's lines.
+ *
+ * @ingroup render
+ */
+class EdgeNormals
+{
+public:
+    typedef std::array<float, 3> Normal;
+
+    /// Describes the lines of a map, for invalidating the normals around a change.
+    class Topology
+    {
+    public:
+        typedef void *Line;
+        typedef void *Sector;
+
+        virtual ~Topology() = default;
+
+        /// Returns the cached normals of a side of @a line (0: front, 1: back).
+        virtual EdgeNormals &normals(Line line, int side) const = 0;
+
+        /**
+         * Calls @a func for each line that has the vertex @a to of @a line as one of
+         * its vertices, including @a line itself.
+         */
+        virtual void forAllLinesAtVertex(Line line, int to,
+                                         const std::function<void (Line)> &func) const = 0;
+
+        /// Calls @a func for each line with a side in @a sector.
+        virtual void forAllSectorLines(Sector sector,
+                                       const std::function<void (Line)> &func) const = 0;
+    };
+
+public:
+    /**
+     * Returns the normal of an edge. If no valid normal is cached, @a compute is called
+     * to determine it.
+     *
+     * @param section  Wall section (middle, bottom, top).
+     * @param edge     Edge of the section (0: left, 1: right).
+     * @param compute  Returns the smoothed normal (see smooth()).
+     */
+    template <typename ComputeFunc>
+    const Normal &normal(int section, int edge, ComputeFunc compute)
+    {
+        const int index = section * 2 + edge;
+        if (!_valid[index])
+        {
+            _normals[index] = compute();
+            _valid[index]   = true;
+        }
+        return _normals[index];
+    }
+
+    bool isValid(int section, int edge) const { return _valid[section * 2 + edge]; }
+
+    inline void invalidate() { _valid.fill(false); }
+
+    /**
+     * Blends the normal of a wall with the normal of its neighbor, if the angle between
+     * the walls is less than 45 degrees.
+     *
+     * @param normal       Normal of the wall.
+     * @param blendNormal  Normal of the neighbor. @c nullptr if there is no neighbor.
+     * @param angleDiff    Angle between the walls, as a 16-bit binary angle.
+     */
+    static Normal smooth(const Normal &normal, const Normal *blendNormal, uint16_t angleDiff);
+
+    /**
+     * Invalidates the normals of @a line and of the lines sharing a vertex with it.
+     * To be called when a wall surface of the line changes its normal, material or
+     * opacity.
+     */
+    static void invalidateAroundLine(const Topology &map, Topology::Line line);
+
+    /**
+     * Invalidates the normals of the lines of @a sector and of the lines sharing a
+     * vertex with them. To be called when a plane of the sector moves.
+     */
+    static void invalidateAroundSector(const Topology &map, Topology::Sector sector);
+
+private:
+    std::array<Normal, 6> _normals;  ///< { section * 2 + edge }
+    std::array<bool, 6> _valid {};
+};
+
+#endif // DE_CLIENT_RENDER_EDGENORMALS_H
@@ -24,10 +24,13 @@
 #include <de/legacy/aabox.h>
 
 #include <de/vector.h>
+#include <memory>
 
 #include "world/mapobject.h"
 #include "resource/clienttexture.h"
 
+struct ContactSpreadCache;
+
 /**
  * Luminous object. @ingroup render
  *
@@ -52,7 +55,8 @@ public:
     class Source
     {
     public:
-        virtual ~Source() {}
+        Source();
+        virtual ~Source();
 
         /**
          * Calculate an occlusion factor for the light. The implementation should
@@ -64,6 +68,15 @@ public:
          * @param eye  Position of the eye in map space.
          */
         virtual float occlusion(const de::Vec3d &eye) const;
+
+        /**
+         * Returns the subspaces reached by the contact of the light when it was last
+         * spread. The cache is discarded along with the source.
+         */
+        ContactSpreadCache &contactSpreadCache() const;
+
+    private:
+        mutable std::unique_ptr<ContactSpreadCache> _contactSpreadCache;
     };
 
 public:
@@ -103,6 +116,11 @@ public:
      */
     void setSource(const Source *newSource);
 
+    /**
+     * Returns the attributed source of the lumobj, if any.
+     */
+    const Source *source() const;
+
     /**
      * Sets the mobj that is responsible for casting this light.
      *
@@ -99,6 +99,22 @@ struct FogParams
 
 extern FogParams fogParams;
 
+/**
+ * Counts of shadows considered in the current frame, and how many of them were culled
+ * because they are outside the view frustum.
+ */
+struct ShadowCullStats
+{
+    int mobjShadows;
+    int mobjShadowsCulled;
+    int radioWalls;
+    int radioWallsCulled;
+    int radioFlatEdges;
+    int radioFlatEdgesCulled;
+};
+
+extern ShadowCullStats shadowCullStats;
+
 DE_EXTERN_C byte smoothTexAnim, devMobjVLights;
 
 DE_EXTERN_C int renderTextures; /// @c 0= no textures, @c 1= normal mode, @c 2= lighting debug
@@ -128,6 +144,7 @@ DE_EXTERN_C int devRendSkyMode;
 DE_EXTERN_C int gameDrawHUD;
 
 //DE_EXTERN_C int useBias;
+DE_EXTERN_C byte useLightGrid;
 
 DE_EXTERN_C int useDynLights;
 DE_EXTERN_C float dynlightFactor, dynlightFogBright;
@@ -163,6 +180,7 @@ DE_EXTERN_C byte loadExtAlways;
 DE_EXTERN_C int devNoCulling;
 DE_EXTERN_C byte devRendSkyAlways;
 DE_EXTERN_C byte rendInfoLums;
+DE_EXTERN_C byte rendInfoShadows;
 DE_EXTERN_C byte devDrawLums;
 
 DE_EXTERN_C byte freezeRLs;
@@ -203,6 +221,16 @@ de::Mat4f Rend_GetModelViewMatrix(int consoleNum, bool inWorldSpace = true, bool
 
 de::Vec3d Rend_EyeOrigin();
 
+/**
+ * Determines whether a box may be visible in the view frustum of the current frame.
+ * Used for skipping work whose results could not be seen. Always @c true when culling
+ * is disabled (rend-dev-cull-leafs).
+ *
+ * @param min  Minimum corner of the box in map space.
+ * @param max  Maximum corner of the box in map space.
+ */
+bool Rend_IsBoxInViewFrustum(const de::Vec3d &min, const de::Vec3d &max);
+
 /**
  * Returns the projection matrix that is used for rendering the current frame's
  * 3D portions.
@@ -0,0 +1,95 @@
+/** @file renderbench.h  Renderer CPU benchmark.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_CLIENT_RENDER_RENDERBENCH_H
+#define DE_CLIENT_RENDER_RENDERBENCH_H
+
+#include <de/time.h>
+
+struct viewer_t;
+
+/**
+ * Phases of rendering a player's view that are timed separately.
+ */
+enum RenderBenchPhase
+{
+    RBP_VIEW,        ///< The rest of the view: the game's HUD, setup, etc. The timer wraps
+                     ///< the whole view; the phases below are subtracted from it.
+    RBP_VISIBILITY,  ///< Traversing the BSP: occlusion, clipping, and projecting sprites.
+    RBP_GEOMETRY,    ///< Writing the geometry of the visible subspaces, after the traversal.
+    RBP_DRAW,        ///< Drawing the lists, masked objects and particles.
+    RBP_COUNT
+};
+
+/**
+ * The renderer benchmark replays a camera path, one point per frame, and reports the
+ * CPU time spent in each phase of rendering along with the DGL drawing statistics.
+ *
+ * Camera paths are recorded from the console player's view during normal play and can
+ * be saved to a file, so that the same path can be replayed later (for example, with
+ * "-cmd" on the command line). The DGL null backend is used while the benchmark runs,
+ * so GPU time does not affect the results.
+ *
+ * The console command "renderbench" controls the benchmark.
+ */
+void RenderBench_Register();
+
+bool RenderBench_IsRunning();
+
+/**
+ * Records or replaces the view of a player, depending on what the benchmark is doing.
+ * Called when the viewer is updated for a frame.
+ *
+ * @param consoleNum  Console number of the player.
+ * @param view        Current (smoothed) view of the player.
+ */
+void RenderBench_UpdateViewer(int consoleNum, viewer_t &view);
+
+/**
+ * Finishes the frame of a player's view.
+ *
+ * @param consoleNum  Console number of the player.
+ */
+void RenderBench_EndFrame(int consoleNum);
+
+/**
+ * Measures the time spent in a rendering phase while the benchmark is running. The
+ * time is measured from construction to destruction, or until switching to another
+ * phase.
+ */
+class RenderBenchTimer
+{
+public:
+    RenderBenchTimer(RenderBenchPhase phase);
+    ~RenderBenchTimer();
+
+    /**
+     * Stops timing the current phase and starts timing @a phase.
+     */
+    void switchTo(RenderBenchPhase phase);
+
+private:
+    void stop();
+
+    RenderBenchPhase _phase;
+    bool _timing;
+    de::Time _startedAt;
+};
+
+#endif // DE_CLIENT_RENDER_RENDERBENCH_H
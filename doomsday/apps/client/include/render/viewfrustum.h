@@ -0,0 +1,69 @@
+/** @file viewfrustum.h  View frustum for culling.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_CLIENT_RENDER_VIEWFRUSTUM_H
+#define DE_CLIENT_RENDER_VIEWFRUSTUM_H
+
+/**
+ * The six planes of the view volume, in map space. Used for rejecting geometry that
+ * cannot appear in the view before any work is done to generate it.
+ *
+ * The planes are extracted from the combined projection and model-view matrix, so the
+ * frustum matches what is actually drawn (including fixed and stereo views).
+ *
+ * @ingroup render
+ */
+class ViewFrustum
+{
+public:
+    /**
+     * Constructs a frustum that includes everything.
+     */
+    ViewFrustum();
+
+    /**
+     * Extracts the planes from a view matrix.
+     *
+     * @param mvp  Projection matrix multiplied by the model-view matrix, as 16 values in
+     *             column-major order (like de::Mat4f). The matrix transforms points in
+     *             GL space, where the map's Y and Z axes are swapped.
+     */
+    void setMatrix(const float mvp[16]);
+
+    /**
+     * Includes everything; boxes are never rejected.
+     */
+    void setUnbounded();
+
+    /**
+     * Determines whether an axis-aligned box in map space may be visible. The test is
+     * conservative: a box is rejected only if it is entirely outside one of the planes.
+     *
+     * @param min  Minimum corner of the box (map X, Y, Z).
+     * @param max  Maximum corner of the box (map X, Y, Z).
+     */
+    bool isBoxVisible(const double min[3], const double max[3]) const;
+
+private:
+    struct Plane { double normal[3]; double dist; };
+    Plane _planes[6];
+    bool _unbounded;
+};
+
+#endif // DE_CLIENT_RENDER_VIEWFRUSTUM_H
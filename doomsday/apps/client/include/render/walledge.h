@@ -83,6 +83,10 @@ public:
 
     de::Vec2f materialOrigin() const;
 
+    /**
+     * Returns the (possibly smoothed) normal of the edge. Smoothed normals are cached
+     * in the LineSide until invalidateNormals() is called for the line.
+     */
     de::Vec3f normal() const;
 
     const WallSpec &spec() const;
@@ -117,6 +121,20 @@ public:
 
     const Event &at(EventIndex index) const;
 
+    /**
+     * Marks the cached edge normals of @a line out of date, along with those of the
+     * lines that share a vertex with it (smoothing blends with these neighbors). To be
+     * called when the line changes in a way that may affect normal smoothing (e.g., a
+     * neighboring plane moves or a wall material changes).
+     */
+    static void invalidateNormals(world::Line &line);
+
+    /**
+     * Marks the cached edge normals of the lines of @a sector out of date, along with
+     * those of their neighbors. To be called when a plane of the sector moves.
+     */
+    static void invalidateNormals(world::Sector &sector);
+
 private:
     struct Impl;
     Impl *d;
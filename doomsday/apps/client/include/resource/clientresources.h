@@ -48,6 +48,7 @@
 #include "framemodeldef.h"
 #include "materialvariantspec.h"
 #include "rawtexture.h"
+#include "texturecontentcache.h"
 
 class ClientMaterial;
 
@@ -422,6 +423,11 @@ public:
      */
     void purgeCacheQueue();
 
+    /**
+     * Returns the persistent cache of processed texture content.
+     */
+    TextureContentCache &textureContentCache();
+
 public:  /// @todo Should be private:
     void initModels();
     void clearAllRawTextures();
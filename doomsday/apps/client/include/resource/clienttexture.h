@@ -23,9 +23,16 @@
 
 #include "image.h" // res::Source
 #include "texturevariantspec.h"
+#include "textureresidency.h"
 
 #include <doomsday/res/texture.h>
 
+struct texturecontent_s;
+
+/// Budget for the GL textures of texture variants, in MiB (cvar "rend-tex-memory").
+/// Zero means unlimited.
+extern int texMemoryBudget;
+
 /**
  * Logical texture resource.
  *
@@ -69,6 +76,13 @@ public:
         /// Returns @c true if the variant is flagged as "masked".
         inline bool isMasked() const { return isFlagged(Masked); }
 
+        /**
+         * Returns @c true if the variant has a GL-name but its content is still being
+         * processed by a TexturePreparer. Until the content is ready, the texture is
+         * drawn using "uninitialized" texels.
+         */
+        bool isPending() const;
+
         /**
          * Prepare the texture variant for render.
          *
@@ -83,6 +97,16 @@ public:
          */
         uint prepare();
 
+        /**
+         * Completes the preparation of the variant using processed texture content:
+         * the content is submitted for uploading (deferred, if possible) and the
+         * GL-texture coordinates are updated. Used by TexturePreparer.
+         *
+         * @param content  Processed content. The pixel data is not taken over.
+         * @param image    Processed image data from which @a content was prepared.
+         */
+        void finishPrepare(const struct texturecontent_s &content, const image_t &image);
+
         /**
          * Release any uploaded GL-texture and clear the associated GL-name
          * for the variant.
@@ -126,6 +150,14 @@ public:
          */
         uint glName() const;
 
+        /**
+         * Prevents the GL texture from being released by releaseIdle(). Call this
+         * when the GL-name is kept beyond the current frame, as the holder has no
+         * way of noticing that the texture was released. The variant is unpinned
+         * when it is released for other reasons.
+         */
+        void pin() const;
+
         /**
          * Returns the prepared GL-texture coordinates for the variant.
          *
@@ -134,6 +166,21 @@ public:
          */
         void glCoords(float *s, float *t) const;
 
+        /**
+         * Returns the residency manager that accounts for the GL textures of all
+         * prepared variants.
+         */
+        static TextureResidency &residency();
+
+        /**
+         * Releases the GL textures of variants that haven't been used recently, if
+         * the total size of the textures exceeds the budget ("rend-tex-memory").
+         * Released variants are prepared again when they are next used.
+         *
+         * @param frame  Current frame number.
+         */
+        static void releaseIdle(int frame);
+
     private:
         DE_PRIVATE(d)
     };
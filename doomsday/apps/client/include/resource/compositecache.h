@@ -0,0 +1,96 @@
+/** @file compositecache.h  Cache for building composite textures.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_RESOURCE_COMPOSITECACHE_H
+#define DE_RESOURCE_COMPOSITECACHE_H
+
+#include "dd_types.h"
+
+#include <doomsday/res/patch.h>
+#include <doomsday/res/texture.h>
+#include <de/block.h>
+
+/**
+ * Cache of intermediate images used when building id Tech 1 composite textures
+ * (see res::Composite) from their patches.
+ *
+ * Many composite textures are built from the same patches, and a texture may have
+ * several variants that are all built from the same composite image. When many
+ * textures are prepared at once (e.g., when precaching a map), the decoded patches
+ * and the composited images are kept around so that each is produced only once.
+ *
+ * While a CompositeCache exists, composite textures loaded in the thread that created
+ * it use the cache. The cache is not meant to be shared between threads. When the
+ * size limit is reached, all cached images are discarded.
+ *
+ * @ingroup resource
+ */
+class CompositeCache
+{
+public:
+    /// Patch image decoded with res::Patch::load().
+    struct DecodedPatch
+    {
+        de::Block pixels; ///< Empty if the lump is not a valid patch.
+        res::PatchMetadata info;
+    };
+
+public:
+    /**
+     * @param maxBytes  Maximum total size of the cached images.
+     */
+    CompositeCache(de::dsize maxBytes = 64 * 1024 * 1024);
+
+    ~CompositeCache();
+
+    /**
+     * Looks up a previously decoded patch.
+     *
+     * @param lumpNum    Lump containing the patch.
+     * @param loadFlags  res::Patch::Flags used when decoding.
+     *
+     * @return Decoded patch, or @c nullptr if not cached.
+     */
+    const DecodedPatch *patch(lumpnum_t lumpNum, int loadFlags) const;
+
+    const DecodedPatch &insertPatch(lumpnum_t lumpNum, int loadFlags, DecodedPatch decoded);
+
+    /**
+     * Looks up the previously composited image of a texture.
+     *
+     * @param texture     Composite texture.
+     * @param buildFlags  Identifies how the image was built (caller-defined).
+     *
+     * @return Paletted image data (indices followed by alpha), or @c nullptr if
+     * not cached.
+     */
+    const de::Block *composite(const res::Texture &texture, int buildFlags) const;
+
+    void insertComposite(const res::Texture &texture, int buildFlags, const de::Block &pixels);
+
+    /**
+     * Returns the cache active in the calling thread, if any.
+     */
+    static CompositeCache *active();
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif // DE_RESOURCE_COMPOSITECACHE_H
@@ -24,6 +24,7 @@
 #ifdef __CLIENT__
 #  include "resource/clienttexture.h"
 #endif
+#include <de/block.h>
 #include <de/error.h>
 #include <de/string.h>
 #include <de/bitarray.h>
@@ -161,6 +162,21 @@ public:
      */
     static FrameModel *loadFromFile(res::FileHandle &file, float aspectScale = 1);
 
+    /**
+     * Attempt to load a new model resource from data that has already been read
+     * from a file. Does not access the file system, so this can be called in any
+     * thread.
+     *
+     * @param data         Contents of the model file.
+     * @param filePath     Path of the model file. The extension is used for
+     *                     guessing the format.
+     * @param aspectScale  Optionally apply y-aspect scaling.
+     *
+     * @return  The new FrameModel (if any). Ownership is given to the caller.
+     */
+    static FrameModel *loadFromData(const de::Block &data, const de::String &filePath,
+                                    float aspectScale = 1);
+
     /**
      * Returns the unique identifier associated with the model.
      */
@@ -21,6 +21,8 @@
 #ifndef DE_RESOURCE_HQ2X_H
 #define DE_RESOURCE_HQ2X_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -44,12 +46,19 @@ void GL_InitSmartFilterHQ2x(void);
  * Alpha is taken into account in the processing to preserve edges.
  * (Not quite as efficient as the original version.)
  *
+ * May be called from any thread. When called in the main thread, large images are
+ * processed in parallel bands of rows.
+ *
+ * The upscaler has no dependencies on the rest of the engine (see tests/test_hq2x).
+ *
  * @param src  R8G8B8A8 source image to be scaled.
  * @param width  Width of the source image in pixels.
  * @param height  Height of the source image in pixels.
- * @param flags  @ref imageConversionFlags
+ * @param wrapH  Non-zero to wrap around horizontally when sampling at the edges.
+ *               Otherwise the edge pixels are repeated.
+ * @param wrapV  Non-zero to wrap around vertically when sampling at the edges.
  */
-uint8_t *GL_SmartFilterHQ2x(const uint8_t *src, int width, int height, int flags);
+uint8_t *GL_SmartFilterHQ2x(const uint8_t *src, int width, int height, int wrapH, int wrapV);
 
 ///@}
 
@@ -0,0 +1,111 @@
+/** @file texturecontentcache.h  Persistent cache of processed texture content.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_RESOURCE_TEXTURECONTENTCACHE_H
+#define DE_RESOURCE_TEXTURECONTENTCACHE_H
+
+#include "resource/image.h"
+#include "resource/texturevariantspec.h"
+
+#include <de/block.h>
+
+/// Use the texture content cache (cvar "rend-tex-cache").
+extern byte texContentCacheEnabled;
+
+/// Maximum size of the texture content cache on disk, in MiB (cvar "rend-tex-cache-size").
+extern int texContentCacheSize;
+
+/**
+ * Persistent cache of texture images that have been processed for uploading (see
+ * GL_PrepareTextureContent()). Images upscaled with hq2x or hq4x, either when prepared
+ * or by the smart filter of uploading, are kept on disk and reused in later sessions.
+ * Other processing is cheaper than looking up the cache.
+ *
+ * Entries are identified by a hash of the source image content and the parts of the
+ * variant specification (and configuration) that affect processing. The cache is
+ * limited in size; when full, the least recently used entries are removed.
+ *
+ * Lookups and stores are thread-safe.
+ *
+ * @ingroup resource
+ */
+class TextureContentCache
+{
+public:
+    /// Results of processing an image, in addition to the processed pixel data.
+    struct Processed
+    {
+        dint format = 0; ///< dgltexformat_t
+        dfloat baMul = 1; ///< Detail texture luminance equalization.
+        dfloat hiMul = 1;
+        dfloat loMul = 1;
+    };
+
+public:
+    TextureContentCache();
+
+    /**
+     * Prepares the cache for use: locates the cache folder and removes entries
+     * exceeding the size limit. Must be called in the main thread.
+     */
+    void initialize();
+
+    bool isEnabled() const;
+
+    /**
+     * Composes the identifier of the processed content for a source image.
+     *
+     * @param source  Source image (not yet processed).
+     * @param spec    Variant specification used for processing.
+     *
+     * @return Cache key.
+     */
+    de::Block key(const image_t &source, const TextureVariantSpec &spec) const;
+
+    /**
+     * Looks up processed content from the cache.
+     *
+     * @param key        Cache key.
+     * @param image      Source image. If found, the image is replaced with the
+     *                   processed image data.
+     * @param processed  Processing results are written here.
+     *
+     * @return @c true, if the content was found in the cache.
+     */
+    bool load(const de::Block &key, image_t &image, Processed &processed);
+
+    /**
+     * Stores processed content in the cache.
+     *
+     * @param key        Cache key (from the source image).
+     * @param image      Processed image.
+     * @param processed  Processing results.
+     */
+    void store(const de::Block &key, const image_t &image, const Processed &processed);
+
+    /**
+     * Deletes all cached content.
+     */
+    void clear();
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif // DE_RESOURCE_TEXTURECONTENTCACHE_H
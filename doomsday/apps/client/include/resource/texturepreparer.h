@@ -0,0 +1,95 @@
+/** @file texturepreparer.h  Asynchronous texture variant preparation.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_RESOURCE_TEXTUREPREPARER_H
+#define DE_RESOURCE_TEXTUREPREPARER_H
+
+#include "resource/clienttexture.h"
+
+/**
+ * Pipeline for preparing many texture variants at once (e.g., when precaching a map).
+ *
+ * While a TexturePreparer exists, texture variants prepared in the thread that created
+ * it are prepared in stages:
+ * - the source image is loaded and analyzed in the calling thread (these access
+ *   shared resources),
+ * - the image processing (upscaling, filtering, format conversion) is done in a
+ *   TaskPool worker, which also finds the average color of the image if it is not
+ *   yet known for the texture,
+ * - the processed content is submitted for uploading in the calling thread when
+ *   poll() is called, or when the preparer is destroyed. The upload itself is
+ *   deferred to the GL thread when possible (see GL_ChooseUploadMethod()).
+ *
+ * Until the content has been submitted, the variant is @em pending: it already has
+ * a GL name, but the texture has no content yet.
+ *
+ * The number of variants in the worker stage is limited; when the limit is reached,
+ * the calling thread waits for a variant to finish before continuing.
+ *
+ * @ingroup resource
+ */
+class TexturePreparer
+{
+public:
+    /**
+     * @param maxPending  Maximum number of variants processed concurrently.
+     *                    Zero means a limit is chosen based on the number of CPU cores.
+     */
+    TexturePreparer(int maxPending = 0);
+
+    /**
+     * Waits until all pending variants have been processed and submits them for
+     * uploading.
+     */
+    ~TexturePreparer();
+
+    /**
+     * Submits the variants that have finished processing for uploading. Must be
+     * called in the thread that created the preparer.
+     */
+    void poll();
+
+    /**
+     * Waits until all pending variants have been processed and submits them for
+     * uploading. Must be called in the thread that created the preparer.
+     */
+    void waitForAll();
+
+    /**
+     * Hands over the source @a image of @a variant for processing. Ownership of the
+     * image pixel data is transferred to the preparer.
+     */
+    void process(ClientTexture::Variant &variant, image_t &image);
+
+    /**
+     * Returns the preparer active in the calling thread, if any.
+     */
+    static TexturePreparer *active();
+
+    /**
+     * Stops processing of @a variant, if it is pending in any preparer. The processed
+     * content will be discarded. Called when the variant is released or deleted.
+     */
+    static void forget(const ClientTexture::Variant &variant);
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif // DE_RESOURCE_TEXTUREPREPARER_H
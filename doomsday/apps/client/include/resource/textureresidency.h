@@ -0,0 +1,136 @@
+/** @file textureresidency.h  Texture memory budget and eviction of unused textures.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_RESOURCE_TEXTURERESIDENCY_H
+#define DE_RESOURCE_TEXTURERESIDENCY_H
+
+#include <cstdint>
+#include <memory>
+
+/**
+ * Keeps account of the memory used by resident (uploaded) textures, and evicts the
+ * least recently used ones when the total exceeds a budget.
+ *
+ * Textures are identified by opaque pointers. The residency manager does not know
+ * about GL: evicting a texture is done by a Backend, which makes it possible to test
+ * the logic in isolation (see tests/test_texresidency). An evicted texture is
+ * expected to be made resident again on demand when it is next used.
+ *
+ * Only textures that have not been used in a number of frames are evicted, so that
+ * the textures in view are never thrown out even if they exceed the budget. When
+ * evicting, textures are removed until the total drops somewhat below the budget to
+ * avoid evicting on every frame.
+ *
+ * A texture can be pinned when a reference to its resident data is kept elsewhere
+ * (for instance, a GL name stored beyond the current frame). Pinned textures are
+ * never evicted.
+ *
+ * All methods are thread-safe. The backend is called without internal locks held,
+ * so it may call remove().
+ *
+ * @ingroup resource
+ */
+class TextureResidency
+{
+public:
+    typedef const void *Item;
+
+    /// Performs the actual eviction of textures.
+    class Backend
+    {
+    public:
+        virtual ~Backend() = default;
+
+        /// Releases the resident data of @a item.
+        virtual void evict(Item item) = 0;
+    };
+
+    struct Counters
+    {
+        uint64_t residentCount = 0;
+        uint64_t residentBytes = 0;
+        uint64_t peakBytes     = 0; ///< Largest total since creation.
+        uint64_t evictionCount = 0;
+        uint64_t evictedBytes  = 0;
+        uint64_t reloadCount   = 0; ///< Evicted textures that were made resident again.
+    };
+
+public:
+    TextureResidency(Backend &backend);
+    ~TextureResidency();
+
+    /**
+     * Sets the maximum total size of resident textures.
+     *
+     * @param bytes  Budget in bytes. Zero means unlimited.
+     */
+    void setBudget(uint64_t bytes);
+
+    uint64_t budget() const;
+
+    /**
+     * Sets the number of frames a texture must be unused before it can be evicted.
+     */
+    void setMinIdleFrames(int frames);
+
+    /**
+     * Adds a texture that has become resident.
+     *
+     * @param item   Texture.
+     * @param bytes  Size of the texture's resident data.
+     * @param frame  Current frame number. The texture is considered used.
+     */
+    void add(Item item, uint64_t bytes, int frame);
+
+    /**
+     * Marks a resident texture as used on @a frame. Unknown textures are ignored.
+     */
+    void touch(Item item, int frame);
+
+    /**
+     * Prevents @a item from being evicted until it is removed. The texture does not
+     * need to be resident yet.
+     */
+    void pin(Item item);
+
+    bool isPinned(Item item) const;
+
+    /**
+     * Removes a texture that is no longer resident (or no longer exists). This also
+     * unpins the texture.
+     */
+    void remove(Item item);
+
+    /**
+     * Evicts textures if the total size exceeds the budget.
+     *
+     * @param frame  Current frame number.
+     *
+     * @return Number of textures evicted.
+     */
+    int evictIdle(int frame);
+
+    Counters counters() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> d;
+};
+
+#endif // DE_RESOURCE_TEXTURERESIDENCY_H
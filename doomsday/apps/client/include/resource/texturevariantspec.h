@@ -129,6 +129,12 @@ struct variantspecification_t
     inline bool operator != (const variantspecification_t &other) const {
         return !(*this == other);
     }
+
+    /**
+     * Returns a hash of the properties that are considered in equality comparison.
+     * Equal specifications have equal hashes.
+     */
+    de::duint32 hash() const;
 };
 
 /**
@@ -150,6 +156,8 @@ struct detailvariantspecification_t
     inline bool operator != (const detailvariantspecification_t &other) const {
         return !(*this == other);
     }
+
+    de::duint32 hash() const;
 };
 
 enum texturevariantspecificationtype_t
@@ -175,6 +183,11 @@ public:
         return !(*this == other);
     }
 
+    /**
+     * Returns a hash of the specification, for looking up equal specifications.
+     */
+    de::duint32 hash() const;
+
     /**
      * Returns a textual, human-readable representation of the specification.
      */
@@ -0,0 +1,76 @@
+/** @file simd.h  Compiler support and CPU detection for the SIMD kernels.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_CLIENT_SIMD_H
+#define DE_CLIENT_SIMD_H
+
+/*
+ * DE_SIMD_SSE2 is defined when the SSE2 intrinsics can be used unconditionally.
+ *
+ * DE_SIMD_AVX2 is defined when the compiler can build AVX2 functions without
+ * AVX2 being enabled for the whole translation unit. Such functions must be
+ * declared with DE_TARGET_AVX2 and only called after SIMD_CPUSupportsAVX2()
+ * has returned @c true.
+ */
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define DE_SIMD_SSE2
+#  include <emmintrin.h>
+#  if defined(__GNUC__) || defined(__clang__)
+#    define DE_SIMD_AVX2
+#    define DE_TARGET_AVX2 __attribute__((target("avx2")))
+#    include <immintrin.h>
+#  elif defined(_MSC_VER) && _MSC_VER >= 1900
+#    define DE_SIMD_AVX2
+#    define DE_TARGET_AVX2
+#    include <immintrin.h>
+#    include <intrin.h>
+#  endif
+#endif
+
+#ifdef DE_SIMD_AVX2
+
+/**
+ * Determines whether the CPU, and the operating system, support AVX2.
+ */
+inline bool SIMD_CPUSupportsAVX2()
+{
+    static const bool supported = [] () {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();
+        return bool(__builtin_cpu_supports("avx2"));
+#else
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        // The OS must save the AVX registers, too.
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx     = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#endif
+    }();
+    return supported;
+}
+
+#endif // DE_SIMD_AVX2
+
+#endif // DE_CLIENT_SIMD_H
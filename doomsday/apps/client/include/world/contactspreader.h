@@ -25,11 +25,36 @@
 #include <doomsday/world/blockmap.h>
 #include <de/legacy/aabox.h>
 #include <de/bitarray.h>
+#include <de/list.h>
+#include <de/vector.h>
+
+class ConvexSubspace;
+
+/**
+ * Subspaces reached by the contact of a static light source (light decoration), owned
+ * by the source. The result of spreading depends only on the origin and radius of the
+ * source and on the geometry of the subsectors it reached, so it can be reused until
+ * one of them changes.
+ */
+struct ContactSpreadCache
+{
+    de::Vec3d origin;
+    double radius = 0;
+    de::duint geometryStamp = 0;  ///< Map geometry stamp when spread (0 if never).
+    de::List<ConvexSubspace *> subspaces;
+};
 
 /**
  * Performs contact spreading for the specified @a blockmap.
+ *
+ * @param geometryStamp  Current geometry stamp of the map (see Map::markGeometryChanged()).
+ *                       If non-zero, the spreading of static light sources is cached.
+ *
+ * @return Number of contacts spread through the map (excluding the ones found in
+ * the cache).
  */
-void spreadContacts(const world::Blockmap &blockmap, const AABoxd &region, de::BitArray *spreadBlocks = 0);
+int spreadContacts(const world::Blockmap &blockmap, const AABoxd &region,
+                   de::BitArray *spreadBlocks = 0, de::duint geometryStamp = 0);
 
 #endif  // DE_CLIENT_WORLD_CONTACTSPREADER_H
 #endif  // __CLIENT__
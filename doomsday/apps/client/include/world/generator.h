@@ -20,9 +20,11 @@
 
 #pragma once
 
+#include <de/list.h>
 #include <de/vector.h>
 #include <doomsday/defs/dedtypes.h>
 #include "map.h"
+#include "particlekernels.h"
 
 class Line;
 class Plane;
@@ -44,6 +46,11 @@ struct ParticleInfo
 
 /**
  * Particle generator.
+ *
+ * The particles are stored as a structure of arrays (see ParticleArrays). A tick has
+ * two parts: beginTick() spawns particles and advances their stages, and finishTicks()
+ * applies the forces and moves the particles. The latter does not change anything
+ * outside the generator, so the particles of several generators are moved in parallel.
  */
 struct Generator
 {
@@ -102,6 +109,19 @@ struct Generator
     /// Unique identifier associated with each generator (1-based).
     typedef int16_t Id;
 
+    /**
+     * The part of the generator's state that changes when it is ticked.
+     * @see tickState()
+     */
+    struct TickState
+    {
+        struct mobj_s *        source;
+        int                    age;
+        float                  spawnCount;
+        int                    spawnCP;
+        de::List<ParticleInfo> particles;
+    };
+
 public:                                   //! @todo make private:
     thinker_t           thinker;          //  Func = P_PtcGenThinker
     Plane *             plane;            //  Flat-triggered.
@@ -146,11 +166,37 @@ public:
      */
     void runTick();
 
+    /**
+     * Generates new particles and advances the stages of the particles. This is the
+     * first part of runTick(); finishTicks() completes the tick.
+     *
+     * @return  @c false, if the generator reached its maximum age and was deleted.
+     */
+    bool beginTick();
+
+    /**
+     * Applies forces to and moves the particles of @a gens, whose ticks have been begun
+     * with beginTick(). The generators are processed in parallel. Afterwards the sounds
+     * of the particles hitting something are played, in the order of @a gens.
+     */
+    static void finishTicks(const de::List<Generator *> &gens);
+
     /**
      * Run the generator's thinker for the given number of @a tics.
      */
     void presimulate(int tics);
 
+    /**
+     * Returns a copy of the state that runTick() changes, so that the generator can be
+     * ticked without lasting effects (see the "ptcbench" command).
+     */
+    TickState tickState() const;
+
+    /**
+     * Returns the generator to a state previously saved with tickState().
+     */
+    void restoreTickState(const TickState &state);
+
     /**
      * Returns the age of the generator (time since spawn), in tics.
      */
@@ -193,9 +239,14 @@ public:
     int activeParticleCount() const;
 
     /**
-     * Provides readonly access to the generator particle info data.
+     * Provides readonly access to the particles of the generator.
      */
-    const ParticleInfo *particleInfo() const;
+    const ParticleArrays &particles() const;
+
+    /**
+     * Returns the current state of the particle at @a index.
+     */
+    ParticleInfo particleInfo(int index) const;
 
 public: /// @todo make private:
     /**
@@ -210,15 +261,27 @@ public: /// @todo make private:
      */
     int newParticle();
 
+    /// State of moving the particles of one generator (see finishTicks()).
+    struct MotionContext;
+
+    /**
+     * Applies the forces of the particles' current stages to their momentum, and
+     * rotates the particles according to the spin speed.
+     */
+    void accelerateParticles();
+
+    /**
+     * Applies the forces to all particles and moves them.
+     */
+    void moveParticles(MotionContext &motion);
+
     /**
      * The movement is done in two steps:
      * Z movement is done first. Skyflat kills the particle.
      * XY movement checks for hits with solid walls (no backsector).
      * This is supposed to be fast and simple (but not too simple).
      */
-    void moveParticle(int index);
-
-    void spinParticle(ParticleInfo &pt);
+    void moveParticle(int index, MotionContext &motion);
 
     float particleZ(const ParticleInfo &pt) const;
 
@@ -232,13 +295,16 @@ public:
     static void consoleRegister();
 
 private:
-    Id            _id; // Unique in the map.
-    de::Flags     _flags;
-    int           _age; // Time since spawn, in tics.
-    float         _spawnCount;
-    bool          _untriggered; // @c true= consider this as not yet triggered.
-    int           _spawnCP;     // Particle spawn cursor.
-    ParticleInfo *_pinfo;       // Info about each generated particle.
+    void setParticleInfo(int index, const ParticleInfo &pinfo);
+
+    Id                    _id; // Unique in the map.
+    de::Flags             _flags;
+    int                   _age; // Time since spawn, in tics.
+    float                 _spawnCount;
+    bool                  _untriggered; // @c true= consider this as not yet triggered.
+    int                   _spawnCP;     // Particle spawn cursor.
+    ParticleArrays        _particles;   // The generated particles.
+    ParticleStageForces * _stageForces; // Forces of each stage, updated each tick.
 };
 
 typedef Generator::ParticleStage GeneratorParticleStage;
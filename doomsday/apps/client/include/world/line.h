@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include "render/edgenormals.h"
 #include "render/rend_main.h" // edgespan_t, shadowcorner_t
 #include <doomsday/world/line.h>
 
@@ -93,8 +94,23 @@ public:
      */
     void setRadioEdgeSpan(bool top, bool right, double length);
 
+    /**
+     * Smoothed wall edge normals of the side's sections, cached by WallEdge.
+     */
+    inline EdgeNormals &edgeNormals() { return _edgeNormals; }
+
+    /**
+     * Returns the map space bounds of the FakeRadio shadows that the side casts on the
+     * planes of its sector. Determined by Map::initRadio().
+     */
+    inline const AABoxd &shadowBounds() const { return _shadowBounds; }
+
+    inline void setShadowBounds(const AABoxd &bounds) { _shadowBounds = bounds; }
+
 private:
     RadioData radioData;
+    EdgeNormals _edgeNormals;
+    AABoxd _shadowBounds;
 };
 
 class LineSideSegment : public world::LineSideSegment
@@ -205,6 +205,19 @@ public:  //- Particle generators -----------------------------------------------
 
     void unlinkGenerator(Generator &generator);
 
+    /**
+     * Schedules the particles of @a generator to be moved in moveGeneratorParticles().
+     * Called by the generator's thinker after beginning its tick.
+     */
+    void scheduleParticleMotion(Generator &generator);
+
+    /**
+     * Moves the particles of all the generators whose thinkers have run since the
+     * previous call, in parallel (see Generator::finishTicks()). Called after running
+     * the thinkers.
+     */
+    void moveGeneratorParticles();
+
 //- Skies -------------------------------------------------------------------------------
 
     SkyDrawable::Animator &skyAnimator() const;
@@ -249,9 +262,43 @@ public:  //- Particle generators -----------------------------------------------
 
     /**
      * Perform spreading of all contacts in the specified map space @a region.
+     *
+     * The subspaces reached by the contacts of static light sources (light decorations)
+     * are remembered, and such contacts are spread again only when the source or the
+     * map geometry changes.
      */
     void spreadAllContacts(const AABoxd &region);
 
+    /**
+     * Returns @c true if the ambient light grid has been baked. The grid is baked when
+     * it is first needed (see the "rend-light-grid" cvar).
+     */
+    bool hasLightGrid() const;
+
+    /**
+     * Determines the ambient light at a point using the light grid. The light from
+     * static sources (light decorations) is included.
+     *
+     * @param point  Map space point.
+     *
+     * @return Light color, with intensity applied.
+     */
+    de::Vec3f evaluateLightGrid(const de::Vec3d &point) const;
+
+    /**
+     * Marks render data derived from the geometry of @a sector out of date. To be
+     * called when one of the sector's planes moves. The subsectors of the sector and
+     * its neighbors are stamped (see Subsector::geometryStamp()).
+     */
+    void markGeometryChanged(world::Sector &sector);
+
+    /**
+     * Marks render data derived from the geometry of @a line out of date. To be
+     * called when a wall surface of the line changes. The subsectors on both sides
+     * of the line are stamped (see Subsector::geometryStamp()).
+     */
+    void markGeometryChanged(world::Line &line);
+
     /**
      * Fixing the sky means that for adjacent sky sectors the lower sky ceiling is lifted
      * to match the upper sky. The raising only affects rendering, it has no bearing on gameplay.
@@ -104,8 +104,18 @@ void Mobj_SpawnParticleGen(mobj_t *source, const ded_ptcgen_t *def);
 /**
  * Calculate the visible @a origin of @a mob in world space, including
  * any short range offset.
+ *
+ * @param withSRVO        Include the short range visual offset. It is never included
+ *                        when the origin is interpolated from the states received from
+ *                        the server, as that would smooth the movement twice.
+ * @param withViewOrigin  Use the current view origin of the console player for its
+ *                        own mobj. The view origin is the camera position, so this must
+ *                        be @c false when the body itself is drawn (e.g., in chasecam).
+ *
+ * @return @c true, if the origin was interpolated from the received states.
  */
-void Mobj_OriginSmoothed(const mobj_t *mob, coord_t origin[3]);
+bool Mobj_OriginSmoothed(const mobj_t *mob, coord_t origin[3], bool withSRVO = true,
+                         bool withViewOrigin = true);
 
 angle_t Mobj_AngleSmoothed(const mobj_t *mob);
 
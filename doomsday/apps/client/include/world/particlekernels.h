@@ -0,0 +1,126 @@
+/** @file particlekernels.h  Particle storage and the inner loops of particle ticking.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DE_CLIENT_WORLD_PARTICLEKERNELS_H
+#define DE_CLIENT_WORLD_PARTICLEKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+class Line;
+namespace world { class BspLeaf; }
+
+/**
+ * The particles of a generator as a structure of arrays, so that each pass over the
+ * particles only loads the properties it needs. All the arrays are in one memory block
+ * (see blockSize() and setBlock()).
+ *
+ * Positions and momenta are 16.16 fixed-point. Angles are 16-bit binary angles.
+ */
+struct ParticleArrays
+{
+    int                count;     ///< Number of particles in each array.
+    int32_t *          stage;     ///< Negative if the particle doesn't exist.
+    int16_t *          tics;      ///< Remaining in the current stage.
+    int32_t *          origin[3];
+    int32_t *          mov[3];    ///< Momentum.
+    uint16_t *         yaw;
+    uint16_t *         pitch;
+    world::BspLeaf **  bspLeaf;   ///< Updated when needed.
+    Line **            contact;   ///< Updated when lines are hit/avoided.
+
+    /**
+     * Returns the size of the memory block needed for @a count particles.
+     */
+    static size_t blockSize(int count);
+
+    /**
+     * Points the arrays to @a block, which must be at least blockSize() bytes and
+     * suitably aligned for pointers. The contents of the block are not changed.
+     */
+    void setBlock(void *block, int count);
+
+    /**
+     * Returns the memory block of the arrays.
+     */
+    void *block() const;
+};
+
+/**
+ * Forces of a particle stage, for ParticleKernels::applyForces().
+ */
+struct ParticleStageForces
+{
+    int32_t accel[3];      ///< Added to the momentum (16.16 fixed-point).
+    int32_t resistance;    ///< The momentum is then multiplied with this (16.16 fixed-point).
+    float   spin[2];       ///< Added to the yaw and pitch (by particles with a positive spin).
+    float   spinFactor[2]; ///< The yaw and pitch are then multiplied with these.
+};
+
+/**
+ * Table of the inner loops of particle ticking.
+ *
+ * Each kernel has a portable scalar implementation and, on x86, SSE2 and AVX2
+ * implementations. The best implementation supported by the CPU is chosen at runtime.
+ * All implementations produce identical results.
+ *
+ * The kernels have no dependencies to the rest of the engine so that they can be
+ * verified and benchmarked in isolation (see tests/test_particlekernels).
+ */
+struct ParticleKernels
+{
+    enum Level { Scalar, SSE2, AVX2, LevelCount };
+
+    Level level;
+    const char *name;
+
+    /**
+     * Applies the forces of each existing particle's stage. For a particle with index
+     * @c i and stage @c s:
+     * <pre>
+     * k     = (i + spinPhase) % 4
+     * yaw   = uint16(int32(yaw   + (k & 2? -forces[s].spin[0] : forces[s].spin[0])))
+     * pitch = uint16(int32(pitch + (k & 1? -forces[s].spin[1] : forces[s].spin[1])))
+     * yaw   = uint16(int32(yaw   * forces[s].spinFactor[0]))
+     * pitch = uint16(int32(pitch * forces[s].spinFactor[1]))
+     * mov   = (mov + forces[s].accel) * forces[s].resistance
+     * </pre>
+     * The angles are calculated in single precision, truncating toward zero. The
+     * fixed-point product is truncated toward zero, like FixedMul(), and all integer
+     * arithmetic wraps around.
+     *
+     * @param forces  Forces of each stage. Must have an element for every stage used
+     *                by the particles.
+     */
+    void (*applyForces)(const ParticleArrays &particles, const ParticleStageForces *forces,
+                        int spinPhase);
+};
+
+/**
+ * Returns the fastest kernels supported by the CPU.
+ */
+const ParticleKernels &Particle_Kernels();
+
+/**
+ * Returns the kernels of a specific implementation level, or @c nullptr if the level
+ * is not available in this build or not supported by the CPU.
+ */
+const ParticleKernels *Particle_KernelsAtLevel(ParticleKernels::Level level);
+
+#endif // DE_CLIENT_WORLD_PARTICLEKERNELS_H
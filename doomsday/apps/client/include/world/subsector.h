@@ -66,6 +66,14 @@ public:
      */
     bool hasWorldVolume(bool useSmoothedHeights = true) const;
 
+    /**
+     * Returns the geometry stamp of the latest change that may affect the spreading of
+     * contacts through the subsector (see Map::markGeometryChanged()).
+     */
+    de::duint geometryStamp() const;
+
+    void setGeometryStamp(de::duint stamp);
+
 //- Edge loops --------------------------------------------------------------------------
 
     // Edge loop identifiers:
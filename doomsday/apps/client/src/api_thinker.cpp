@@ -18,6 +18,9 @@
 
 #include "api_thinker.h"
 #include "world/p_object.h"
+#if defined(__CLIENT__)
+#  include "world/map.h"
+#endif
 
 #include <doomsday/world/map.h>
 #include <doomsday/world/world.h>
@@ -86,6 +89,11 @@ void Thinker_Run()
         }
         return LoopContinue;
     });
+
+#if defined(__CLIENT__)
+    // The generator thinkers leave moving the particles for later.
+    World::get().map().as<Map>().moveGeneratorParticles();
+#endif
 }
 
 #undef Thinker_Add
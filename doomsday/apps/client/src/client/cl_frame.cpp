@@ -95,6 +95,8 @@ void Cl_ResetFrame()
 {
     netState.gotFrame = false;
 
+    ClMobj_ResetHistory();
+
     // All frames received before the PSV_FIRST_FRAME2 are ignored.
     // They must be from the wrong map.
     gotFirstFrame = false;
@@ -123,6 +125,8 @@ void Cl_Frame2Received(int packetType)
         return;
     }
 
+    ClMobj_HistoryFrameReceived(frameGameTime);
+
     // Read and process the message.
     while (!Reader_AtEnd(msgReader))
     {
@@ -24,6 +24,7 @@
 #include "de_base.h"
 #include "api_client.h"
 #include "api_sound.h"
+#include "client/cl_frame.h"
 #include "client/cl_mobj.h"
 #include "client/cl_player.h"
 #include "client/cl_world.h"
@@ -49,6 +50,186 @@ using world::DmuArgs;
 #define UNFIXED8_8(x)   (((x) << 16) / 256)
 #define UNFIXED10_6(x)  (((x) << 16) / 64)
 
+/// Received states further apart than this are not interpolated (e.g., teleport).
+#define CLMOBJ_HISTORY_SNAP_DIST    128
+
+int clMobjHistoryDepth = 4;
+
+/**
+ * Origins of client mobjs as received from the server. All mobjs of the map share one
+ * pool whose arrays are laid out as structure-of-arrays: each mobj owns a slot, i.e.,
+ * a ring of CLMOBJ_HISTORY_MAX consecutive samples. The pool is allocated when the map
+ * begins and only grows if the map has more client mobjs than anticipated.
+ */
+static struct ClMobjHistory
+{
+    static const int INITIAL_SLOTS = 1024;
+
+    List<float> time; ///< Server game time of each sample.
+    List<coord_t> x, y, z;
+    List<duint8> head;  ///< Index of the latest sample of each slot.
+    List<duint8> count; ///< Number of valid samples in each slot.
+    List<int> freeSlots;
+    Hash<thid_t, int> slots;
+
+    // Timing of received frames.
+    float latestFrameTime = 0;
+    duint latestFrameRealTime = 0;
+    float frameInterval = 2 * SECONDSPERTIC; ///< Smoothed.
+
+    int slotCount() const { return head.sizei(); }
+
+    void resize(int newSlotCount)
+    {
+        const int oldSlotCount = slotCount();
+        time.resize(newSlotCount * CLMOBJ_HISTORY_MAX);
+        x   .resize(newSlotCount * CLMOBJ_HISTORY_MAX);
+        y   .resize(newSlotCount * CLMOBJ_HISTORY_MAX);
+        z   .resize(newSlotCount * CLMOBJ_HISTORY_MAX);
+        head .resize(newSlotCount);
+        count.resize(newSlotCount);
+        for (int i = newSlotCount - 1; i >= oldSlotCount; --i)
+        {
+            freeSlots << i;
+        }
+    }
+
+    void reset()
+    {
+        slots.clear();
+        freeSlots.clear();
+        head.clear();
+        count.clear();
+        resize(INITIAL_SLOTS);
+        latestFrameTime     = 0;
+        latestFrameRealTime = 0;
+        frameInterval       = 2 * SECONDSPERTIC;
+    }
+
+    int slotFor(thid_t id, bool canAllocate)
+    {
+        auto found = slots.find(id);
+        if (found != slots.end()) return found->second;
+        if (!canAllocate) return -1;
+
+        if (freeSlots.isEmpty())
+        {
+            resize(de::max(INITIAL_SLOTS, 2 * slotCount()));
+        }
+        const int slot = freeSlots.takeLast();
+        head[slot]  = 0;
+        count[slot] = 0;
+        slots.insert(id, slot);
+        return slot;
+    }
+
+    void release(thid_t id)
+    {
+        auto found = slots.find(id);
+        if (found == slots.end()) return;
+        freeSlots << found->second;
+        slots.erase(found);
+    }
+
+    void record(int slot, float gameTime, const coord_t origin[3])
+    {
+        const int base = slot * CLMOBJ_HISTORY_MAX;
+        if (count[slot] > 0)
+        {
+            // Several deltas for the same frame replace the latest sample.
+            if (gameTime > time[base + head[slot]])
+            {
+                head[slot] = (head[slot] + 1) % CLMOBJ_HISTORY_MAX;
+                count[slot] = de::min(count[slot] + 1, CLMOBJ_HISTORY_MAX);
+            }
+        }
+        else
+        {
+            count[slot] = 1;
+        }
+        const int idx = base + head[slot];
+        time[idx] = gameTime;
+        x[idx]    = origin[VX];
+        y[idx]    = origin[VY];
+        z[idx]    = origin[VZ];
+    }
+} clHistory;
+
+void ClMobj_ResetHistory()
+{
+    clHistory.reset();
+}
+
+void ClMobj_HistoryFrameReceived(float gameTime)
+{
+    if (clHistory.latestFrameRealTime && gameTime > clHistory.latestFrameTime)
+    {
+        const float interval = gameTime - clHistory.latestFrameTime;
+        clHistory.frameInterval += (interval - clHistory.frameInterval) / 8;
+    }
+    clHistory.latestFrameTime     = gameTime;
+    clHistory.latestFrameRealTime = Timer_RealMilliseconds();
+}
+
+void ClMobj_ForgetHistory(thid_t id)
+{
+    clHistory.release(id);
+}
+
+dd_bool ClMobj_HistoryOrigin(const mobj_t *mob, coord_t origin[3])
+{
+    DE_ASSERT(mob && origin);
+
+    if (clMobjHistoryDepth < 2 || mob->dPlayer) return false;
+
+    const int slot = clHistory.slotFor(mob->thinker.id, false);
+    if (slot < 0) return false;
+
+    const int available = de::min<int>(clHistory.count[slot], clMobjHistoryDepth);
+    if (available < 2) return false;
+
+    // Render one frame interval in the past, so that there is usually a later
+    // state to interpolate towards.
+    const float now = clHistory.latestFrameTime
+                    + (Timer_RealMilliseconds() - clHistory.latestFrameRealTime) / 1000.f
+                    - clHistory.frameInterval;
+
+    const int base  = slot * CLMOBJ_HISTORY_MAX;
+    int newer = base + clHistory.head[slot];
+
+    if (now >= clHistory.time[newer])
+    {
+        // The next state is late; extrapolate using the known momentum, but only
+        // up to one frame interval.
+        const float ahead = de::min(now - clHistory.time[newer], clHistory.frameInterval);
+        origin[VX] = clHistory.x[newer] + mob->mom[MX] * ahead * TICSPERSEC;
+        origin[VY] = clHistory.y[newer] + mob->mom[MY] * ahead * TICSPERSEC;
+        origin[VZ] = clHistory.z[newer] + mob->mom[MZ] * ahead * TICSPERSEC;
+        return true;
+    }
+
+    for (int i = 1; i < available; ++i)
+    {
+        const int older = base + (clHistory.head[slot] + CLMOBJ_HISTORY_MAX - i) % CLMOBJ_HISTORY_MAX;
+        if (now >= clHistory.time[older] || i == available - 1)
+        {
+            const Vec3d a(clHistory.x[older], clHistory.y[older], clHistory.z[older]);
+            const Vec3d b(clHistory.x[newer], clHistory.y[newer], clHistory.z[newer]);
+            if ((b - a).length() > CLMOBJ_HISTORY_SNAP_DIST)
+            {
+                b.decompose(origin);
+                return true;
+            }
+            const float span = clHistory.time[newer] - clHistory.time[older];
+            const float pos  = de::clamp(0.f, span > 0 ? (now - clHistory.time[older]) / span : 1.f, 1.f);
+            (a + (b - a) * pos).decompose(origin);
+            return true;
+        }
+        newer = older;
+    }
+    return false;
+}
+
 #if 0
 ClMobjInfo::ClMobjInfo()
     : startMagic(CLM_MAGIC1)
@@ -576,6 +757,12 @@ void ClMobj_ReadDelta()
             Cl_UpdateRealPlayerMobj(d->dPlayer->mo, d, df, onFloor);
         }
     }
+
+    // Remember the received origin so movement can be interpolated.
+    if ((df & (MDF_ORIGIN_X | MDF_ORIGIN_Y | MDF_ORIGIN_Z)) && !d->dPlayer)
+    {
+        clHistory.record(clHistory.slotFor(id, true), Cl_FrameGameTime(), d->origin);
+    }
 }
 
 void ClMobj_ReadNullDelta()
@@ -616,6 +803,8 @@ void ClMobj_ReadNullDelta()
     // The mobj will soon time out and be permanently removed.
     info->time = Timer_RealMilliseconds();
     info->flags |= CLMF_UNPREDICTABLE | CLMF_NULLED;
+
+    ClMobj_ForgetHistory(id);
 }
 
 #undef ClMobj_Find
@@ -661,7 +661,10 @@ dd_bool DGL_SetInteger(int name, int value)
         DE_ASSERT(value >= 0);
         DE_ASSERT(value < MAX_TEX_UNITS);
         dgl().activeTexture = value;
-        glActiveTexture(GL_TEXTURE0 + duint(value));
+        if (!DGL_IsNullBackend())
+        {
+            glActiveTexture(GL_TEXTURE0 + duint(value));
+        }
         break;
 
     case DGL_MODULATE_TEXTURE:
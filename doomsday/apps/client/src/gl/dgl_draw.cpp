@@ -24,6 +24,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <de/legacy/concurrency.h>
 #include <de/glinfo.h>
 #include <de/glbuffer.h>
@@ -45,6 +46,11 @@ static unsigned s_primSwitchCount = 0;
 static unsigned s_minBatchLength = 0;
 static unsigned s_maxBatchLength = 0;
 static unsigned s_totalBatchCount = 0;
+static unsigned s_vertexCount = 0;
+static unsigned s_stateChangeCount = 0;
+static unsigned s_mergedCount = 0;
+static bool     s_nullBackend = false;
+static GLuint   s_nullBoundTexture[MAX_TEX_UNITS]; ///< Bindings with the null backend.
 
 struct DGLDrawState
 {
@@ -87,6 +93,8 @@ struct DGLDrawState
         GLProgram shader;
 
         GLState  batchState;
+        GLState  drawnState;      ///< State of the previous draw call.
+        bool     hasDrawnState = false;
         Mat4f    batchMvpMatrix[MAX_BATCH];
         Mat4f    batchTexMatrix0[MAX_BATCH];
         Mat4f    batchTexMatrix1[MAX_BATCH];
@@ -349,6 +357,12 @@ struct DGLDrawState
 
     void getBoundTextures(int &id0, int &id1)
     {
+        if (s_nullBackend)
+        {
+            id0 = int(s_nullBoundTexture[0]);
+            id1 = int(s_nullBoundTexture[1]);
+            return;
+        }
         glActiveTexture(GL_TEXTURE0);
         glGetIntegerv(GL_TEXTURE_BINDING_2D, &id0);
         glActiveTexture(GL_TEXTURE1);
@@ -413,6 +427,34 @@ struct DGLDrawState
         // However, all DGL textures must be bound via DGL_Bind and not directly via OpenGL.
 
         getBoundTextures(gl->batchTexture0[idx], gl->batchTexture1[idx]);
+
+        if (idx > 0 && isSameBatchAsPrevious(idx))
+        {
+            // Continue in the previous batch; the vertices will use its index and the
+            // entry being written is reused by the next Begin/End section.
+            currentBatchIndex = idx - 1;
+            ++s_mergedCount;
+        }
+    }
+
+    /**
+     * Determines if the batch entry @a idx has the same uniform values as the one
+     * before it, meaning the two can be drawn as one batch. This happens when
+     * consecutive Begin/End sections use the same textures and matrices, for example
+     * when drawing the primitives of a draw list.
+     */
+    bool isSameBatchAsPrevious(duint idx) const
+    {
+        const duint prev = idx - 1;
+        return gl->batchTexture0[idx]   == gl->batchTexture0[prev]   &&
+               gl->batchTexture1[idx]   == gl->batchTexture1[prev]   &&
+               gl->batchTexEnabled[idx] == gl->batchTexEnabled[prev] &&
+               gl->batchTexMode[idx]    == gl->batchTexMode[prev]    &&
+               fequal(gl->batchAlphaLimit[idx], gl->batchAlphaLimit[prev]) &&
+               gl->batchTexModeColor[idx] == gl->batchTexModeColor[prev] &&
+               !std::memcmp(&gl->batchMvpMatrix[idx],  &gl->batchMvpMatrix[prev],  sizeof(Mat4f)) &&
+               !std::memcmp(&gl->batchTexMatrix0[idx], &gl->batchTexMatrix0[prev], sizeof(Mat4f)) &&
+               !std::memcmp(&gl->batchTexMatrix1[idx], &gl->batchTexMatrix1[prev], sizeof(Mat4f));
     }
 
     void endBatch()
@@ -445,10 +487,13 @@ struct DGLDrawState
 
         if (!gl)
         {
-            batchMaxSize = DGL_BatchMaxSize();
+            batchMaxSize = (s_nullBackend? duint(MAX_BATCH) : DGL_BatchMaxSize());
 
             gl.reset(new GLData(batchMaxSize));
 
+            // Nothing is drawn with the null backend.
+            if (s_nullBackend) return;
+
             // Set up the shader.
             ClientApp::shaders().build(gl->shader, "dgl.draw")
                     << gl->uFragmentSize
@@ -609,6 +654,21 @@ struct DGLDrawState
         s_minBatchLength = de::min(s_minBatchLength, batchLength);
         s_maxBatchLength = de::max(s_maxBatchLength, batchLength);
         s_totalBatchCount += batchLength;
+        s_vertexCount += duint(numVertices());
+
+        if (!gl->hasDrawnState || !(gl->drawnState == gl->batchState))
+        {
+            ++s_stateChangeCount;
+            gl->drawnState    = gl->batchState;
+            gl->hasDrawnState = true;
+        }
+
+        if (s_nullBackend)
+        {
+            // The batch is complete; only the submission is skipped.
+            ++s_drawCallCount;
+            return;
+        }
 
         // Batched uniforms.
         gl->uMvpMatrix.set(gl->batchMvpMatrix, batchLength);
@@ -680,17 +740,70 @@ void DGL_BeginFrame()
 //             << "batch min/max/avg:" << s_minBatchLength << s_maxBatchLength
 //             << (s_drawCallCount ? float(s_totalBatchCount) / float(s_drawCallCount) : 0.f);
 
-    s_drawCallCount   = 0;
-    s_totalBatchCount = 0;
-    s_primSwitchCount = 0;
-    s_maxBatchLength  = 0;
-    s_minBatchLength  = std::numeric_limits<decltype(s_minBatchLength)>::max();
+    s_drawCallCount    = 0;
+    s_totalBatchCount  = 0;
+    s_primSwitchCount  = 0;
+    s_maxBatchLength   = 0;
+    s_minBatchLength   = std::numeric_limits<decltype(s_minBatchLength)>::max();
+    s_vertexCount      = 0;
+    s_stateChangeCount = 0;
+    s_mergedCount      = 0;
 
     if (dglDraw.gl)
     {
         // Reuse buffers every frame.
         dglDraw.gl->bufferPos = 0;
+        dglDraw.gl->hasDrawnState = false;
+    }
+}
+
+DGLFrameStats DGL_FrameStats()
+{
+    DGLFrameStats stats;
+    stats.drawCalls         = s_drawCallCount;
+    stats.batches           = s_totalBatchCount;
+    stats.vertices          = s_vertexCount;
+    stats.primitiveSwitches = s_primSwitchCount;
+    stats.stateChanges      = s_stateChangeCount;
+    stats.mergedSections    = s_mergedCount;
+    return stats;
+}
+
+void DGL_SetNullBackend(bool enable)
+{
+    if (s_nullBackend == enable) return;
+
+    // Batches collected so far belong to the previous backend.
+    dglDraw.flushBatches();
+
+    // The GL resources are set up differently for each backend.
+    dglDraw.glDeinit();
+
+    s_nullBackend = enable;
+    zap(s_nullBoundTexture);
+
+    if (!enable)
+    {
+        // The active unit was not changed in GL while the null backend was in use.
+        glActiveTexture(GL_TEXTURE0 + duint(DGL_GetInteger(DGL_ACTIVE_TEXTURE)));
+    }
+}
+
+bool DGL_IsNullBackend()
+{
+    return s_nullBackend;
+}
+
+bool DGL_BindTexture2D(GLuint glName)
+{
+    if (s_nullBackend)
+    {
+        s_nullBoundTexture[DGL_GetInteger(DGL_ACTIVE_TEXTURE)] = glName;
+        return false;
     }
+    glBindTexture(GL_TEXTURE_2D, glName);
+    LIBGUI_ASSERT_GL_OK();
+    return true;
 }
 
 void DGL_Flush()
@@ -96,6 +96,8 @@ typedef struct apifunc_s {
     } param;
 } apifunc_t;
 
+int glDeferredUploadBudget = 0;
+
 static dd_bool deferredInited = false;
 static mutex_t deferredMutex;
 static DGLuint reservedTextureNames[NUM_RESERVED_TEXTURENAMES];
@@ -426,6 +428,8 @@ void GL_ProcessDeferredTasks(uint timeOutMilliSeconds)
 {
     deferredtask_t* d;
     uint startTime;
+    size_t uploadedBytes = 0;
+    const size_t uploadBudget = (timeOutMilliSeconds? size_t(glDeferredUploadBudget) * 1024 : 0);
 
     if(novideo || !deferredInited) return;
 
@@ -440,8 +444,15 @@ void GL_ProcessDeferredTasks(uint timeOutMilliSeconds)
 
     while((!timeOutMilliSeconds ||
            Timer_RealMilliseconds() - startTime < timeOutMilliSeconds) &&
+          (!uploadBudget || uploadedBytes < uploadBudget) &&
           (d = GL_NextDeferredTask()) != NULL)
     {
+        if(d->type == DTT_UPLOAD_TEXTURECONTENT)
+        {
+            // Approximate; the content is usually uploaded as RGBA.
+            const texturecontent_t *content = (const texturecontent_t *) d->data;
+            uploadedBytes += size_t(content->width) * content->height * 4;
+        }
         processTask(d);
         destroyTask(d);
         GL_ReserveNames();
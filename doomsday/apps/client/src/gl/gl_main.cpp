@@ -65,6 +65,7 @@
 #include <doomsday/r_util.h>
 #include <doomsday/res/colorpalettes.h>
 #include <de/legacy/concurrency.h>
+#include <de/legacy/memory.h>
 #include <de/app.h>
 #include <de/config.h>
 #include <de/glinfo.h>
@@ -839,8 +840,7 @@ void GL_BindTexture(TextureVariant *vtexture)
     DE_ASSERT_IN_RENDER_THREAD();
     DE_ASSERT_GL_CONTEXT_ACTIVE();
 
-    glBindTexture(GL_TEXTURE_2D, glTexName);
-    LIBGUI_ASSERT_GL_OK();
+    if (!DGL_BindTexture2D(glTexName)) return;
 
     // Apply dynamic adjustments to the GL texture state according to our spec.
     const TextureVariantSpec &spec = vtexture->spec();
@@ -877,8 +877,7 @@ void GL_BindTextureUnmanaged(GLuint glName, gfx::Wrapping wrapS, gfx::Wrapping w
     DE_ASSERT_IN_RENDER_THREAD();
     DE_ASSERT_GL_CONTEXT_ACTIVE();
 
-    glBindTexture(GL_TEXTURE_2D, glName);
-    LIBGUI_ASSERT_GL_OK();
+    if (!DGL_BindTexture2D(glName)) return;
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_Wrap(wrapS));
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_Wrap(wrapT));
@@ -933,7 +932,7 @@ void GL_SetNoTexture()
 
     /// @todo Don't actually change the current binding. Instead we should disable
     ///       all currently enabled texture types.
-    glBindTexture(GL_TEXTURE_2D, 0);
+    DGL_BindTexture2D(0);
 }
 
 dint GL_ChooseSmartFilter(dint width, dint height, dint /*flags*/)
@@ -966,7 +965,22 @@ duint8 *GL_SmartFilter(dint method, const duint8 *src, dint width, dint height,
     case 2:  // hq2x
         newWidth  = width  * 2;
         newHeight = height * 2;
-        out = GL_SmartFilterHQ2x(src, width, height, flags);
+        out = GL_SmartFilterHQ2x(src, width, height, (flags & ICF_UPSCALE_SAMPLE_WRAPH) != 0,
+                                 (flags & ICF_UPSCALE_SAMPLE_WRAPV) != 0);
+        break;
+
+    case 3:  // hq4x (hq2x applied twice).
+        newWidth  = width  * 4;
+        newHeight = height * 4;
+        if(duint8 *doubled = GL_SmartFilterHQ2x(src, width, height,
+                                                (flags & ICF_UPSCALE_SAMPLE_WRAPH) != 0,
+                                                (flags & ICF_UPSCALE_SAMPLE_WRAPV) != 0))
+        {
+            out = GL_SmartFilterHQ2x(doubled, width * 2, height * 2,
+                                     (flags & ICF_UPSCALE_SAMPLE_WRAPH) != 0,
+                                     (flags & ICF_UPSCALE_SAMPLE_WRAPV) != 0);
+            M_Free(doubled);
+        }
         break;
     };
 
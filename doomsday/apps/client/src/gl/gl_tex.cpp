@@ -19,6 +19,7 @@
 
 #include "de_platform.h"
 #include "gl/gl_tex.h"
+#include "gl/gl_texkernels.h"
 #include "dd_main.h"
 #include "render/r_main.h"
 #include "resource/clientresources.h"
@@ -31,150 +32,22 @@
 #include <de/legacy/vector1.h>
 #include <de/legacy/texgamma.h>
 #include <cstdlib>
+#include <cstring>
 #include <cmath>
 #include <cctype>
 
-static uint8_t *scratchBuffer;
-static size_t scratchBufferSize;
-
-/**
- * Provides a persistent scratch buffer for use by texture manipulation
- * routines e.g. scaleLine().
- */
-static uint8_t *GetScratchBuffer(size_t size)
-{
-    // Need to enlarge?
-    if(size > scratchBufferSize)
-    {
-        scratchBuffer = (uint8_t *) Z_Realloc(scratchBuffer, size, PU_APPSTATIC);
-        scratchBufferSize = size;
-    }
-    return scratchBuffer;
-}
-
-/**
- * Len is measured in out units. Comps is the number of components per
- * pixel, or rather the number of bytes per pixel (3 or 4). The strides must
- * be byte-aligned anyway, though; not in pixels.
- *
- * @todo Probably could be optimized.
- */
-static void scaleLine(const uint8_t* in, int inStride, uint8_t* out, int outStride,
-    int outLen, int inLen, int comps)
-{
-    float inToOutScale = outLen / (float) inLen;
-    int i, c;
-
-    if(inToOutScale > 1)
-    {
-        // Magnification is done using linear interpolation.
-        fixed_t inPosDelta = (FRACUNIT * (inLen - 1)) / (outLen - 1);
-        fixed_t inPos = inPosDelta;
-        const uint8_t* col1, *col2;
-        int weight, invWeight;
-
-        // The first pixel.
-        memcpy(out, in, comps);
-        out += outStride;
-
-        // Step at each out pixel between the first and last ones.
-        for(i = 1; i < outLen - 1; ++i, out += outStride, inPos += inPosDelta)
-        {
-            col1 = in + (inPos >> FRACBITS) * inStride;
-            col2 = col1 + inStride;
-            weight = inPos & 0xffff;
-            invWeight = 0x10000 - weight;
-
-            for(c = 0; c < comps; ++c)
-                out[c] = (uint8_t)((col1[c] * invWeight + col2[c] * weight) >> 16);
-        }
-
-        // The last pixel.
-        memcpy(out, in + (inLen - 1) * inStride, comps);
-        return;
-    }
-
-    if(inToOutScale < 1)
-    {
-        // Minification needs to calculate the average of each of
-        // the pixels contained by the out pixel.
-        uint cumul[4] = { 0, 0, 0, 0 }, count = 0;
-        int outpos = 0;
-
-        for(i = 0; i < inLen; ++i, in += inStride)
-        {
-            if((int) (i * inToOutScale) != outpos)
-            {
-                outpos = (int) (i * inToOutScale);
-
-                for(c = 0; c < comps; ++c)
-                {
-                    out[c] = (count? uint8_t(cumul[c] / count) : 0);
-                    cumul[c] = 0;
-                }
-                count = 0;
-                out += outStride;
-            }
-            for(c = 0; c < comps; ++c)
-                cumul[c] += in[c];
-            count++;
-        }
-        // Fill in the last pixel, too.
-        if(count)
-            for(c = 0; c < comps; ++c)
-                out[c] = (uint8_t)(cumul[c] / count);
-        return;
-    }
-
-    // No need for scaling.
-    for(i = outLen; i > 0; i--, out += outStride, in += inStride)
-    {
-        for(c = 0; c < comps; ++c)
-            out[c] = in[c];
-    }
-}
-
-/// \todo Avoid use of a secondary buffer by scaling directly to output.
 uint8_t* GL_ScaleBuffer(const uint8_t* in, int width, int height, int comps,
     int outWidth, int outHeight)
 {
     assert(in);
     {
-    uint inOffsetSize, outOffsetSize;
-    uint8_t* outOff, *buffer;
-    const uint8_t* inOff;
     uint8_t* out;
-    int stride;
 
     if(width <= 0 || height <= 0)
         return (uint8_t*)in;
 
-    buffer = GetScratchBuffer(comps * outWidth * height);
-
     out = (uint8_t *) M_Malloc(comps * outWidth * outHeight);
-
-    // First scale horizontally, to outWidth, into the temporary buffer.
-    inOff = in;
-    outOff = buffer;
-    inOffsetSize = width * comps;
-    outOffsetSize = outWidth * comps;
-    { int i;
-    for(i = 0; i < height; ++i, inOff += inOffsetSize, outOff += outOffsetSize)
-    {
-        scaleLine(inOff, comps, outOff, comps, outWidth, width, comps);
-    }}
-
-    // Then scale vertically, to outHeight, into the out buffer.
-    inOff = buffer;
-    outOff = out;
-    stride = outWidth * comps;
-    inOffsetSize = comps;
-    outOffsetSize = comps;
-    { int i;
-    for(i = 0; i < outWidth; ++i, inOff += inOffsetSize, outOff += outOffsetSize)
-    {
-        scaleLine(inOff, stride, outOff, stride, outHeight, height, comps);
-    }}
+    GL_ScaleImage(GL_ImageKernels(), in, width, height, comps, out, outWidth, outHeight);
     return out;
     }
 }
@@ -639,6 +512,7 @@ uint8_t* GL_ScaleBufferNearest(const uint8_t* in, int width, int height, int com
     {
     int ratioX, ratioY, shearY;
     uint8_t* out, *outP;
+    int *columns;
 
     if(width <= 0 || height <= 0)
         return (uint8_t*)in;
@@ -648,21 +522,29 @@ uint8_t* GL_ScaleBufferNearest(const uint8_t* in, int width, int height, int com
 
     out = (uint8_t *) M_Malloc(comps * outWidth * outHeight);
 
+    // The source columns are the same on every row.
+    columns = (int *) M_Malloc(sizeof(int) * outWidth);
+    { int j, shearX = 0;
+    for(j = 0; j < outWidth; ++j, shearX += ratioX)
+        columns[j] = (shearX >> 16) * comps;
+    }
+
     outP = out;
     shearY = 0;
     { int i;
     for(i = 0; i < outHeight; ++i, shearY += ratioY)
     {
-        int shearX = 0;
-        int shearY2 = (shearY >> 16) * width;
+        const uint8_t *row = in + (shearY >> 16) * width * comps;
         { int j;
-        for(j = 0; j < outWidth; ++j, outP += comps, shearX += ratioX)
+        for(j = 0; j < outWidth; ++j, outP += comps)
         {
-            int c, n = (shearY2 + (shearX >> 16)) * comps;
-            for(c = 0; c < comps; ++c, n++)
-                outP[c] = in[n];
+            const uint8_t *src = row + columns[j];
+            int c;
+            for(c = 0; c < comps; ++c)
+                outP[c] = src[c];
         }}
     }}
+    M_Free(columns);
     return out;
     }
 }
@@ -671,7 +553,7 @@ void GL_DownMipmap32(uint8_t* in, int width, int height, int comps)
 {
     assert(in);
     {
-    int x, y, c, outW = width >> 1, outH = height >> 1;
+    int x, c, outW = width >> 1, outH = height >> 1;
     uint8_t* out;
 
     if(width <= 0 || height <= 0 || comps <= 0)
@@ -696,18 +578,13 @@ void GL_DownMipmap32(uint8_t* in, int width, int height, int comps)
     }
 
     // Unconstrained, 2x2 -> 1x1 reduction?
-    out = in;
-    for(y = 0; y < outH; ++y, in += width * comps)
-        for(x = 0; x < outW; ++x, in += comps * 2)
-            for(c = 0; c < comps; ++c, out++)
-                *out = (uint8_t)((in[c] + in[comps + c] + in[comps * width + c] +
-                              in[comps * (width + 1) + c]) >> 2);
+    GL_HalveImage(GL_ImageKernels(), in, width, height, comps);
     }
 }
 
 void GL_DownMipmap8(uint8_t* in, uint8_t* fadedOut, int width, int height, float fade)
 {
-    int x, y, outW = width / 2, outH = height / 2;
+    int x, outW = width / 2, outH = height / 2;
     float invFade;
     byte* out = in;
 
@@ -734,13 +611,16 @@ void GL_DownMipmap8(uint8_t* in, uint8_t* fadedOut, int width, int height, float
     }
     else
     {   // Unconstrained, 2x2 -> 1x1 reduction?
-        for(y = 0; y < outH; y++, in += width)
-            for(x = 0; x < outW; x++, in += 2)
-            {
-                *out = (in[0] + in[1] + in[width] + in[width + 1]) / 4;
-                *fadedOut++ = (byte) (*out * invFade + 0x80 * fade);
-                out++;
-            }
+        const long numOut = long(outW) * outH;
+        byte fadeTable[256];
+        long i;
+
+        for(i = 0; i < 256; ++i)
+            fadeTable[i] = (byte) (i * invFade + 0x80 * fade);
+
+        GL_HalveImage(GL_ImageKernels(), in, width, height, 1);
+        for(i = 0; i < numOut; ++i)
+            *fadedOut++ = fadeTable[out[i]];
     }
 }
 
@@ -755,35 +635,25 @@ dd_bool GL_PalettizeImage(uint8_t *out, int outformat, const res::ColorPalette *
     if(informat <= 2 && outformat >= 3)
     {
         const long numPels = width * height;
-        const int inSize   = (informat == 2 ? 1 : informat);
-        const int outSize  = (outformat == 2 ? 1 : outformat);
 
-        for(long i = 0; i < numPels; ++i)
+        // Look up each palette color (with gamma applied) only once.
+        const int lastColor = de::max(0, palette->colorCount() - 1);
+        uint32_t table[256];
+        for(int i = 0; i < 256; ++i)
         {
-            de::Vec3ub palColor = palette->color(*in);
-
-            out[0] = palColor.x;
-            out[1] = palColor.y;
-            out[2] = palColor.z;
-
+            de::Vec3ub palColor = palette->color(de::min(i, lastColor));
             if(applyTexGamma)
             {
-                out[0] = R_TexGammaLut(out[0]);
-                out[1] = R_TexGammaLut(out[1]);
-                out[2] = R_TexGammaLut(out[2]);
+                palColor = de::Vec3ub(R_TexGammaLut(palColor.x),
+                                      R_TexGammaLut(palColor.y),
+                                      R_TexGammaLut(palColor.z));
             }
-
-            if(outformat == 4)
-            {
-                if(informat == 2)
-                    out[3] = in[numPels * inSize];
-                else
-                    out[3] = 0;
-            }
-
-            in  += inSize;
-            out += outSize;
+            const uint8_t rgba[4] = { palColor.x, palColor.y, palColor.z, 0 };
+            std::memcpy(&table[i], rgba, 4);
         }
+
+        GL_IndexedToTrueColor(GL_ImageKernels(), in, informat == 2 ? in + numPels : nullptr,
+                              table, numPels, out, outformat);
         return true;
     }
     return false;
@@ -796,22 +666,22 @@ dd_bool GL_QuantizeImageToPalette(uint8_t *out, int outformat, const res::ColorP
 
     if(informat >= 3 && outformat <= 2 && width > 0 && height > 0)
     {
-        int inSize = (informat == 2 ? 1 : informat);
-        int outSize = (outformat == 2 ? 1 : outformat);
-        int i, numPixels = width * height;
+        const int numPixels = width * height;
 
-        for(i = 0; i < numPixels; ++i, in += inSize, out += outSize)
-        {
-            // Convert the color value.
-            *out = palette->nearestIndex(de::Vec3ub(in));
+        // Convert the color values.
+        palette->nearestIndices(in, informat, numPixels, out);
 
-            // Alpha channel?
-            if(outformat == 2)
+        // Alpha channel?
+        if(outformat == 2)
+        {
+            uint8_t *alpha = out + numPixels;
+            if(informat == 4)
             {
-                if(informat == 4)
-                    out[numPixels * outSize] = in[3];
-                else
-                    out[numPixels * outSize] = 0;
+                for(int i = 0; i < numPixels; ++i) alpha[i] = in[4 * i + 3];
+            }
+            else
+            {
+                std::memset(alpha, 0, numPixels);
             }
         }
         return true;
@@ -828,37 +698,44 @@ void GL_DeSaturatePalettedImage(uint8_t *pixels, const res::ColorPalette &palett
 
     const long numPels = width * height;
 
-    // What is the maximum color value?
-    int max = 0;
+    // The result only depends on the color index, so work out the gray level of
+    // each color once and then remap the pixels.
+    bool used[256] = {};
     for(long i = 0; i < numPels; ++i)
     {
-        de::Vec3ub palColor = palette[pixels[i]];
-        if(palColor.x == palColor.y && palColor.x == palColor.z)
-        {
-            if(palColor.x > max)
-            {
-                max = palColor.x;
-            }
-            continue;
-        }
+        used[pixels[i]] = true;
+    }
+
+    int gray[256];
+    bool isGray[256];
+    int max = 0; // What is the maximum color value?
+    for(int i = 0; i < 256; ++i)
+    {
+        if(!used[i]) continue;
 
-        int temp = (2 * int( palColor.x ) + 4 * int( palColor.y ) + 3 * int( palColor.z )) / 9;
-        if(temp > max) max = temp;
+        de::Vec3ub palColor = palette[i];
+        isGray[i] = (palColor.x == palColor.y && palColor.x == palColor.z);
+        gray[i]   = isGray[i] ? palColor.x
+                              : (2 * int( palColor.x ) + 4 * int( palColor.y ) + 3 * int( palColor.z )) / 9;
+        if(gray[i] > max) max = gray[i];
     }
 
-    for(long i = 0; i < numPels; ++i)
+    uint8_t mapping[256];
+    for(int i = 0; i < 256; ++i)
     {
-        de::Vec3ub palColor = palette[pixels[i]];
-        if(palColor.x == palColor.y && palColor.x == palColor.z)
-        {
-            continue;
-        }
+        mapping[i] = uint8_t(i);
+        if(!used[i] || isGray[i]) continue;
 
         // Calculate a weighted average.
-        int temp = (2 * int( palColor.x ) + 4 * int( palColor.y ) + 3 * int( palColor.z )) / 9;
+        int temp = gray[i];
         if(max) temp *= 255.f / max;
 
-        pixels[i] = palette.nearestIndex(de::Vec3ub(temp, temp, temp));
+        mapping[i] = uint8_t(palette.nearestIndex(de::Vec3ub(temp, temp, temp)));
+    }
+
+    for(long i = 0; i < numPels; ++i)
+    {
+        pixels[i] = mapping[pixels[i]];
     }
 }
 
@@ -967,12 +844,24 @@ void FindAverageColor(const uint8_t* pixels, int width, int height,
     }
 
     numpels = width * height;
-    src = pixels;
-    for(i = 0; i < numpels; ++i, src += pixelSize)
+    if(pixelSize == 4)
     {
-        avg[0] += src[0];
-        avg[1] += src[1];
-        avg[2] += src[2];
+        uint64_t sums[4];
+        long translucent;
+        GL_ImageKernels().sumRGBA(pixels, numpels, sums, &translucent);
+        avg[0] = long(sums[0]);
+        avg[1] = long(sums[1]);
+        avg[2] = long(sums[2]);
+    }
+    else
+    {
+        src = pixels;
+        for(i = 0; i < numpels; ++i, src += pixelSize)
+        {
+            avg[0] += src[0];
+            avg[1] += src[1];
+            avg[2] += src[2];
+        }
     }
 
     V3f_Set(color->rgb, avg[0] / numpels * reciprocal255,
@@ -1020,8 +909,7 @@ void FindAverageColorIdx(const uint8_t *data, int w, int h, const res::ColorPale
 void FindAverageAlpha(const uint8_t* pixels, int width, int height,
                       int pixelSize, float* alpha, float* coverage)
 {
-    long i, numPels, avg = 0, alphaCount = 0;
-    const uint8_t* src;
+    long numPels, avg = 0, alphaCount = 0;
 
     if(!pixels || !alpha) return;
 
@@ -1053,12 +941,10 @@ void FindAverageAlpha(const uint8_t* pixels, int width, int height,
     }
 
     numPels = width * height;
-    src = pixels;
-    for(i = 0; i < numPels; ++i, src += 4)
     {
-        const uint8_t val = src[3];
-        avg += val;
-        if(val < 255) alphaCount++;
+        uint64_t sums[4];
+        GL_ImageKernels().sumRGBA(pixels, numPels, sums, &alphaCount);
+        avg = long(sums[3]);
     }
 
     *alpha = avg / numPels * reciprocal255;
@@ -1070,7 +956,7 @@ void FindAverageAlpha(const uint8_t* pixels, int width, int height,
 void FindAverageAlphaIdx(const uint8_t *pixels, int w, int h, float *alpha,
     float *coverage)
 {
-    long i, numPels, avg = 0, alphaCount = 0;
+    long numPels, avg = 0, alphaCount = 0;
     const uint8_t *alphaStart;
 
     if(!pixels || !alpha) return;
@@ -1085,14 +971,13 @@ void FindAverageAlphaIdx(const uint8_t *pixels, int w, int h, float *alpha,
 
     numPels = w * h;
     alphaStart = pixels + numPels;
-    for(i = 0; i < numPels; ++i)
     {
-        const uint8_t val = alphaStart[i];
-        avg += val;
-        if(val < 255)
-        {
-            alphaCount++;
-        }
+        uint8_t min, max;
+        uint64_t sum;
+        long opaqueCount;
+        GL_ImageKernels().byteStats(alphaStart, numPels, &min, &max, &sum, &opaqueCount);
+        avg = long(sum);
+        alphaCount = numPels - opaqueCount;
     }
 
     *alpha = avg / numPels * reciprocal255;
@@ -1106,9 +991,6 @@ void FindClipRegionNonAlpha(const uint8_t* buffer, int width, int height,
 {
     assert(buffer && retRegion);
     {
-    const uint8_t* src, *alphasrc;
-    int region[4];
-
     if(width <= 0 || height <= 0)
     {
         DE_ASSERT_FAIL("FindClipRegionNonAlpha: Attempt to find region on zero-sized image.");
@@ -1117,52 +999,7 @@ void FindClipRegionNonAlpha(const uint8_t* buffer, int width, int height,
         return;
     }
 
-    region[0] = width;
-    region[1] = 0;
-    region[2] = height;
-    region[3] = 0;
-
-    src = buffer;
-    // For paletted images the alpha channel follows the actual image.
-    if(pixelsize == 1)
-        alphasrc = buffer + width * height;
-    else
-        alphasrc = NULL;
-
-    // \todo This is not very efficent. Better to use an algorithm which works
-    // on full rows and full columns.
-    { int k, i;
-    for(k = 0; k < height; ++k)
-        for(i = 0; i < width; ++i, src += pixelsize, alphasrc++)
-        {
-            // Alpha pixels don't count.
-            if(pixelsize == 1)
-            {
-                if(*alphasrc < 255)
-                    continue;
-            }
-            else if(pixelsize == 4)
-            {
-                if(src[3] < 255)
-                    continue;
-            }
-
-            if(i < region[0])
-                region[0] = i;
-            if(i > region[1])
-                region[1] = i;
-
-            if(k < region[2])
-                region[2] = k;
-            if(k > region[3])
-                region[3] = k;
-        }
-    }
-
-    retRegion[0] = region[0];
-    retRegion[1] = region[1];
-    retRegion[2] = region[2];
-    retRegion[3] = region[3];
+    GL_FindOpaqueRegion(GL_ImageKernels(), buffer, width, height, pixelsize, retRegion);
     }
 }
 
@@ -1333,13 +1170,11 @@ void EqualizeLuma(uint8_t* pixels, int width, int height, float* rBaMul,
     max = 0;
     wideAvg = 0;
 
-    { long i;
-    for(i = 0, pix = pixels; i < numpels; ++i, pix += 1)
-    {
-        if(*pix < min) min = *pix;
-        if(*pix > max) max = *pix;
-        wideAvg += *pix;
-    }}
+    { uint64_t sum;
+    long maxedCount;
+    GL_ImageKernels().byteStats(pixels, numpels, &min, &max, &sum, &maxedCount);
+    wideAvg = long(sum);
+    }
 
     if(max <= min || max == 0 || min == 255)
     {
@@ -1366,16 +1201,23 @@ void EqualizeLuma(uint8_t* pixels, int width, int height, float* rBaMul,
 
     if(!(baMul == 1 && hiMul == 1 && loMul == 1))
     {
+        // Equal values are adjusted equally.
+        uint8_t table[256];
         long i;
-        for(i = 0, pix = pixels; i < numpels; ++i, pix += 1)
+        int v;
+        for(v = 0; v < 256; ++v)
         {
             // First balance.
-            float val = baMul * (*pix);
+            float val = baMul * v;
             // Now amplify.
             if(val > 127) val *= hiMul;
             else          val *= loMul;
 
-            *pix = (uint8_t) MINMAX_OF(0, val, 255);
+            table[v] = (uint8_t) MINMAX_OF(0, val, 255);
+        }
+        for(i = 0, pix = pixels; i < numpels; ++i, pix += 1)
+        {
+            *pix = table[*pix];
         }
     }
 
@@ -1396,6 +1238,11 @@ void Desaturate(uint8_t* pixels, int width, int height, int comps)
         return;
 
     numpels = width * height;
+    if(comps == 4)
+    {
+        GL_ImageKernels().desaturateRGBA(pixels, numpels);
+        return;
+    }
     for(i = 0, pix = pixels; i < numpels; ++i, pix += comps)
     {
         int min = MIN_OF(pix[0], MIN_OF(pix[1], pix[2]));
@@ -1418,38 +1265,31 @@ void AmplifyLuma(uint8_t* pixels, int width, int height, dd_bool hasAlpha)
     numPels = width * height;
     if(hasAlpha)
     {
-        uint8_t* pix = pixels;
-        uint8_t* apix = pixels + numPels;
-        long i;
-        for(i = 0; i < numPels; ++i, pix++, apix++)
-        {
-            // Only non-masked pixels count.
-            if(!(*apix > 0))
-                continue;
-
-            if(*pix > max)
-                max = *pix;
-        }
+        // Only non-masked pixels count.
+        max = GL_ImageKernels().maskedMax(pixels, pixels + numPels, numPels);
     }
     else
     {
-        uint8_t* pix = pixels;
-        long i;
-        for(i = 0; i < numPels; ++i, pix++)
-        {
-            if(*pix > max)
-                max = *pix;
-        }
+        uint8_t min;
+        uint64_t sum;
+        long maxedCount;
+        GL_ImageKernels().byteStats(pixels, numPels, &min, &max, &sum, &maxedCount);
     }
 
     if(0 == max || 255 == max)
         return;
 
-    { uint8_t* pix = pixels;
+    { uint8_t table[256];
+    uint8_t* pix = pixels;
     long i;
+    int v;
+    for(v = 0; v < 256; ++v)
+    {
+        table[v] = (uint8_t) MINMAX_OF(0, (float)v / max * 255, 255);
+    }
     for(i = 0; i < numPels; ++i, pix++)
     {
-        *pix = (uint8_t) MINMAX_OF(0, (float)*pix / max * 255, 255);
+        *pix = table[*pix];
     }}
     }
 }
@@ -1474,21 +1314,24 @@ void EnhanceContrast(uint8_t* pixels, int width, int height, int comps)
     pix = pixels;
     numpels = width * height;
 
-    for(i = 0; i < numpels; ++i, pix += comps)
+    { uint8_t table[256];
+    int v;
+    for(v = 0; v < 256; ++v)
     {
-        int c;
-        for(c = 0; c < 3; ++c)
-        {
-            uint8_t out;
-            if(pix[c] < 60) // Darken dark parts.
-                out = (uint8_t) MINMAX_OF(0, ((float)pix[c] - 70) * 1.0125f + 70, 255);
-            else if(pix[c] > 185) // Lighten light parts.
-                out = (uint8_t) MINMAX_OF(0, ((float)pix[c] - 185) * 1.0125f + 185, 255);
-            else
-                out = pix[c];
-            pix[c] = out;
-        }
+        if(v < 60) // Darken dark parts.
+            table[v] = (uint8_t) MINMAX_OF(0, ((float)v - 70) * 1.0125f + 70, 255);
+        else if(v > 185) // Lighten light parts.
+            table[v] = (uint8_t) MINMAX_OF(0, ((float)v - 185) * 1.0125f + 185, 255);
+        else
+            table[v] = (uint8_t) v;
     }
+
+    for(i = 0; i < numpels; ++i, pix += comps)
+    {
+        pix[0] = table[pix[0]];
+        pix[1] = table[pix[1]];
+        pix[2] = table[pix[2]];
+    }}
     }
 }
 
@@ -0,0 +1,1195 @@
+/** @file gl_texkernels.cpp  Inner loops of the image manipulation algorithms.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "gl/gl_texkernels.h"
+#include "simd.h"
+
+#include <cstring>
+#include <vector>
+
+/*
+ * Portable implementations. These also process the leftovers of the vectorized loops.
+ */
+namespace scalar {
+
+static void sumRGBA(const uint8_t *pixels, long count, uint64_t sums[4], long *translucentCount)
+{
+    uint64_t red = 0, green = 0, blue = 0, alpha = 0;
+    long translucent = 0;
+    for (long i = 0; i < count; ++i, pixels += 4)
+    {
+        red   += pixels[0];
+        green += pixels[1];
+        blue  += pixels[2];
+        alpha += pixels[3];
+        if (pixels[3] < 255) translucent++;
+    }
+    sums[0] = red;
+    sums[1] = green;
+    sums[2] = blue;
+    sums[3] = alpha;
+    *translucentCount = translucent;
+}
+
+static void byteStats(const uint8_t *bytes, long count, uint8_t *min, uint8_t *max,
+                      uint64_t *sum, long *maxedCount)
+{
+    uint8_t lo = 255, hi = 0;
+    uint64_t total = 0;
+    long maxed = 0;
+    for (long i = 0; i < count; ++i)
+    {
+        const uint8_t b = bytes[i];
+        if (b < lo) lo = b;
+        if (b > hi) hi = b;
+        total += b;
+        if (b == 255) maxed++;
+    }
+    *min = lo;
+    *max = hi;
+    *sum = total;
+    *maxedCount = maxed;
+}
+
+static uint8_t maskedMax(const uint8_t *bytes, const uint8_t *mask, long count)
+{
+    uint8_t hi = 0;
+    for (long i = 0; i < count; ++i)
+    {
+        if (mask[i] && bytes[i] > hi) hi = bytes[i];
+    }
+    return hi;
+}
+
+static void desaturateRGBA(uint8_t *pixels, long count)
+{
+    for (long i = 0; i < count; ++i, pixels += 4)
+    {
+        int lo = pixels[0], hi = pixels[0];
+        if (pixels[1] < lo) lo = pixels[1];
+        if (pixels[2] < lo) lo = pixels[2];
+        if (pixels[1] > hi) hi = pixels[1];
+        if (pixels[2] > hi) hi = pixels[2];
+        pixels[0] = pixels[1] = pixels[2] = uint8_t((lo + hi) / 2);
+    }
+}
+
+static void lerpBytes(const uint8_t *a, const uint8_t *b, uint8_t *out, long count, int weight)
+{
+    const int invWeight = 0x10000 - weight;
+    for (long i = 0; i < count; ++i)
+    {
+        out[i] = uint8_t((a[i] * invWeight + b[i] * weight) >> 16);
+    }
+}
+
+static void halveRGBA(const uint8_t *row0, const uint8_t *row1, uint8_t *out, long outWidth)
+{
+    for (long x = 0; x < outWidth; ++x, row0 += 8, row1 += 8)
+    {
+        for (int c = 0; c < 4; ++c, out++)
+        {
+            *out = uint8_t((row0[c] + row0[4 + c] + row1[c] + row1[4 + c]) >> 2);
+        }
+    }
+}
+
+static void halveBytes(const uint8_t *row0, const uint8_t *row1, uint8_t *out, long outWidth)
+{
+    for (long x = 0; x < outWidth; ++x, row0 += 2, row1 += 2)
+    {
+        out[x] = uint8_t((row0[0] + row0[1] + row1[0] + row1[1]) >> 2);
+    }
+}
+
+static bool opaqueSpanRGBA(const uint8_t *pixels, long count, long *first, long *last)
+{
+    long lo = -1, hi = -1;
+    for (long i = 0; i < count; ++i)
+    {
+        if (pixels[4 * i + 3] == 255)
+        {
+            if (lo < 0) lo = i;
+            hi = i;
+        }
+    }
+    *first = lo;
+    *last  = hi;
+    return lo >= 0;
+}
+
+static bool opaqueSpanAlpha(const uint8_t *alpha, long count, long *first, long *last)
+{
+    long lo = -1, hi = -1;
+    for (long i = 0; i < count; ++i)
+    {
+        if (alpha[i] == 255)
+        {
+            if (lo < 0) lo = i;
+            hi = i;
+        }
+    }
+    *first = lo;
+    *last  = hi;
+    return lo >= 0;
+}
+
+static inline bool hqKeysDiffer(uint32_t a, uint32_t b)
+{
+    static const int thresholds[4] = { 6, 7, 48, 0 }; // V, U, Y, transparency
+    for (int i = 0; i < 4; ++i)
+    {
+        const int ca = int(a >> (8 * i)) & 0xff;
+        const int cb = int(b >> (8 * i)) & 0xff;
+        if (ca - cb > thresholds[i] || cb - ca > thresholds[i]) return true;
+    }
+    return false;
+}
+
+static void hqPatterns(const uint32_t *above, const uint32_t *row, const uint32_t *below,
+                       long count, uint8_t *patterns)
+{
+    for (long x = 0; x < count; ++x)
+    {
+        const uint32_t c = row[x];
+        patterns[x] = uint8_t((hqKeysDiffer(c, above[x - 1])?   1 : 0) |
+                              (hqKeysDiffer(c, above[x])?       2 : 0) |
+                              (hqKeysDiffer(c, above[x + 1])?   4 : 0) |
+                              (hqKeysDiffer(c, row[x - 1])?     8 : 0) |
+                              (hqKeysDiffer(c, row[x + 1])?    16 : 0) |
+                              (hqKeysDiffer(c, below[x - 1])?  32 : 0) |
+                              (hqKeysDiffer(c, below[x])?      64 : 0) |
+                              (hqKeysDiffer(c, below[x + 1])? 128 : 0));
+    }
+}
+
+static void indexedToRGBA(const uint8_t *indices, const uint8_t *alpha, const uint32_t *table,
+                          long count, uint8_t *out)
+{
+    for (long i = 0; i < count; ++i, out += 4)
+    {
+        std::memcpy(out, &table[indices[i]], 4);
+        if (alpha) out[3] = alpha[i];
+    }
+}
+
+} // namespace scalar
+
+/**
+ * Combines the span found in a vectorized loop with the span of the leftovers.
+ */
+static bool mergeSpans(long lo, long hi, bool tailFound, long tailLo, long tailHi,
+                       long tailStart, long *first, long *last)
+{
+    if (tailFound)
+    {
+        if (lo < 0) lo = tailStart + tailLo;
+        hi = tailStart + tailHi;
+    }
+    *first = lo;
+    *last  = hi;
+    return lo >= 0;
+}
+
+static int lowestBit(unsigned bits)
+{
+    int i = 0;
+    while (!(bits & 1)) { bits >>= 1; ++i; }
+    return i;
+}
+
+static int highestBit(unsigned bits)
+{
+    int i = -1;
+    while (bits) { bits >>= 1; ++i; }
+    return i;
+}
+
+#ifdef DE_SIMD_SSE2
+
+namespace sse2 {
+
+static void sumRGBA(const uint8_t *pixels, long count, uint64_t sums[4], long *translucentCount)
+{
+    const __m128i zero   = _mm_setzero_si128();
+    const __m128i low8   = _mm_set1_epi32(0xff);
+    __m128i red = zero, green = zero, blue = zero, alpha = zero, opaque = zero;
+
+    long i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + 4 * i));
+        const __m128i a = _mm_srli_epi32(v, 24);
+        red    = _mm_add_epi64(red,   _mm_sad_epu8(_mm_and_si128(v, low8), zero));
+        green  = _mm_add_epi64(green, _mm_sad_epu8(_mm_and_si128(_mm_srli_epi32(v, 8), low8), zero));
+        blue   = _mm_add_epi64(blue,  _mm_sad_epu8(_mm_and_si128(_mm_srli_epi32(v, 16), low8), zero));
+        alpha  = _mm_add_epi64(alpha, _mm_sad_epu8(a, zero));
+        opaque = _mm_sub_epi32(opaque, _mm_cmpeq_epi32(a, low8));
+    }
+
+    uint64_t lanes[4][2];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes[0]), red);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes[1]), green);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes[2]), blue);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes[3]), alpha);
+    int32_t opaqueLanes[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(opaqueLanes), opaque);
+
+    long translucent;
+    scalar::sumRGBA(pixels + 4 * i, count - i, sums, &translucent);
+    for (int c = 0; c < 4; ++c)
+    {
+        sums[c] += lanes[c][0] + lanes[c][1];
+    }
+    *translucentCount = translucent + i
+            - (long(opaqueLanes[0]) + opaqueLanes[1] + opaqueLanes[2] + opaqueLanes[3]);
+}
+
+static void byteStats(const uint8_t *bytes, long count, uint8_t *min, uint8_t *max,
+                      uint64_t *sum, long *maxedCount)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi8(1);
+    const __m128i full = _mm_set1_epi8(char(0xff));
+    __m128i lo = full, hi = zero, total = zero, maxed = zero;
+
+    long i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i));
+        lo    = _mm_min_epu8(lo, v);
+        hi    = _mm_max_epu8(hi, v);
+        total = _mm_add_epi64(total, _mm_sad_epu8(v, zero));
+        maxed = _mm_add_epi64(maxed, _mm_sad_epu8(_mm_and_si128(_mm_cmpeq_epi8(v, full), ones), zero));
+    }
+
+    uint8_t los[16], his[16];
+    uint64_t totals[2], maxeds[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(los), lo);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(his), hi);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(totals), total);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(maxeds), maxed);
+
+    scalar::byteStats(bytes + i, count - i, min, max, sum, maxedCount);
+    for (int k = 0; k < 16; ++k)
+    {
+        if (los[k] < *min) *min = los[k];
+        if (his[k] > *max) *max = his[k];
+    }
+    *sum        += totals[0] + totals[1];
+    *maxedCount += long(maxeds[0] + maxeds[1]);
+}
+
+static uint8_t maskedMax(const uint8_t *bytes, const uint8_t *mask, long count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i hi = zero;
+
+    long i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i));
+        const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i *>(mask + i));
+        // Masked out bytes are treated as zero.
+        hi = _mm_max_epu8(hi, _mm_andnot_si128(_mm_cmpeq_epi8(m, zero), v));
+    }
+
+    uint8_t his[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(his), hi);
+    uint8_t result = scalar::maskedMax(bytes + i, mask + i, count - i);
+    for (int k = 0; k < 16; ++k)
+    {
+        if (his[k] > result) result = his[k];
+    }
+    return result;
+}
+
+static void desaturateRGBA(uint8_t *pixels, long count)
+{
+    const __m128i low8  = _mm_set1_epi32(0xff);
+    const __m128i alpha = _mm_set1_epi32(int(0xff000000));
+
+    long i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i *p = reinterpret_cast<__m128i *>(pixels + 4 * i);
+        const __m128i v = _mm_loadu_si128(p);
+        const __m128i g = _mm_srli_epi32(v, 8);
+        const __m128i b = _mm_srli_epi32(v, 16);
+        // Only the lowest byte of each pixel is meaningful.
+        const __m128i lo = _mm_and_si128(_mm_min_epu8(v, _mm_min_epu8(g, b)), low8);
+        const __m128i hi = _mm_and_si128(_mm_max_epu8(v, _mm_max_epu8(g, b)), low8);
+        const __m128i l  = _mm_srli_epi32(_mm_add_epi32(lo, hi), 1);
+        _mm_storeu_si128(p, _mm_or_si128(_mm_or_si128(l, _mm_slli_epi32(l, 8)),
+                                         _mm_or_si128(_mm_slli_epi32(l, 16),
+                                                      _mm_and_si128(v, alpha))));
+    }
+    scalar::desaturateRGBA(pixels + 4 * i, count - i);
+}
+
+/*
+ * The products and their sum are at most 255 * 0x10000 < 2^24, so they are exactly
+ * representable as floats and the result is identical to the integer arithmetic.
+ */
+static inline __m128i lerpLanes(__m128i a, __m128i b, __m128 wa, __m128 wb, __m128 scale)
+{
+    return _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(a), wa),
+                                                  _mm_mul_ps(_mm_cvtepi32_ps(b), wb)),
+                                       scale));
+}
+
+static void lerpBytes(const uint8_t *a, const uint8_t *b, uint8_t *out, long count, int weight)
+{
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128  wa    = _mm_set1_ps(float(0x10000 - weight));
+    const __m128  wb    = _mm_set1_ps(float(weight));
+    const __m128  scale = _mm_set1_ps(1.f / 0x10000);
+
+    long i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i va  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        const __m128i vb  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        const __m128i aLo = _mm_unpacklo_epi8(va, zero), aHi = _mm_unpackhi_epi8(va, zero);
+        const __m128i bLo = _mm_unpacklo_epi8(vb, zero), bHi = _mm_unpackhi_epi8(vb, zero);
+
+        const __m128i r0 = lerpLanes(_mm_unpacklo_epi16(aLo, zero), _mm_unpacklo_epi16(bLo, zero), wa, wb, scale);
+        const __m128i r1 = lerpLanes(_mm_unpackhi_epi16(aLo, zero), _mm_unpackhi_epi16(bLo, zero), wa, wb, scale);
+        const __m128i r2 = lerpLanes(_mm_unpacklo_epi16(aHi, zero), _mm_unpacklo_epi16(bHi, zero), wa, wb, scale);
+        const __m128i r3 = lerpLanes(_mm_unpackhi_epi16(aHi, zero), _mm_unpackhi_epi16(bHi, zero), wa, wb, scale);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                         _mm_packus_epi16(_mm_packs_epi32(r0, r1), _mm_packs_epi32(r2, r3)));
+    }
+    scalar::lerpBytes(a + i, b + i, out + i, count - i, weight);
+}
+
+/// Sums horizontally adjacent pixels of four RGBA pixels from both rows and divides by four.
+static inline __m128i halve4RGBA(__m128i r0, __m128i r1)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(r0, zero), _mm_unpacklo_epi8(r1, zero));
+    const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(r0, zero), _mm_unpackhi_epi8(r1, zero));
+    return _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi)), 2);
+}
+
+static void halveRGBA(const uint8_t *row0, const uint8_t *row1, uint8_t *out, long outWidth)
+{
+    long x = 0;
+    for (; x + 4 <= outWidth; x += 4)
+    {
+        // All input is loaded before storing, so the output may overlap the first row.
+        const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + 8 * x));
+        const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + 8 * x + 16));
+        const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + 8 * x));
+        const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + 8 * x + 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4 * x),
+                         _mm_packus_epi16(halve4RGBA(a0, a1), halve4RGBA(b0, b1)));
+    }
+    scalar::halveRGBA(row0 + 8 * x, row1 + 8 * x, out + 4 * x, outWidth - x);
+}
+
+static inline __m128i halve16Bytes(__m128i r0, __m128i r1)
+{
+    const __m128i low8 = _mm_set1_epi16(0xff);
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(_mm_and_si128(r0, low8), _mm_srli_epi16(r0, 8)),
+                                        _mm_add_epi16(_mm_and_si128(r1, low8), _mm_srli_epi16(r1, 8))),
+                          2);
+}
+
+static void halveBytes(const uint8_t *row0, const uint8_t *row1, uint8_t *out, long outWidth)
+{
+    long x = 0;
+    for (; x + 16 <= outWidth; x += 16)
+    {
+        const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + 2 * x));
+        const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + 2 * x + 16));
+        const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + 2 * x));
+        const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + 2 * x + 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x),
+                         _mm_packus_epi16(halve16Bytes(a0, a1), halve16Bytes(b0, b1)));
+    }
+    scalar::halveBytes(row0 + 2 * x, row1 + 2 * x, out + x, outWidth - x);
+}
+
+static bool opaqueSpanRGBA(const uint8_t *pixels, long count, long *first, long *last)
+{
+    const __m128i full = _mm_set1_epi32(0xff);
+    long lo = -1, hi = -1, hiStart = 0;
+    unsigned hiBits = 0;
+
+    long i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + 4 * i));
+        const unsigned bits = unsigned(_mm_movemask_ps(
+                _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_srli_epi32(v, 24), full))));
+        if (bits)
+        {
+            if (lo < 0) lo = i + lowestBit(bits);
+            hiStart = i;
+            hiBits  = bits;
+        }
+    }
+    if (hiBits) hi = hiStart + highestBit(hiBits);
+    long tailLo, tailHi;
+    const bool tail = scalar::opaqueSpanRGBA(pixels + 4 * i, count - i, &tailLo, &tailHi);
+    return mergeSpans(lo, hi, tail, tailLo, tailHi, i, first, last);
+}
+
+static bool opaqueSpanAlpha(const uint8_t *alpha, long count, long *first, long *last)
+{
+    const __m128i full = _mm_set1_epi8(char(0xff));
+    long lo = -1, hi = -1, hiStart = 0;
+    unsigned hiBits = 0;
+
+    long i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(alpha + i));
+        const unsigned bits = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(v, full)));
+        if (bits)
+        {
+            if (lo < 0) lo = i + lowestBit(bits);
+            hiStart = i;
+            hiBits  = bits;
+        }
+    }
+    if (hiBits) hi = hiStart + highestBit(hiBits);
+    long tailLo, tailHi;
+    const bool tail = scalar::opaqueSpanAlpha(alpha + i, count - i, &tailLo, &tailHi);
+    return mergeSpans(lo, hi, tail, tailLo, tailHi, i, first, last);
+}
+
+/// Returns @a flag in the lanes where the neighbor key differs from the center key.
+static inline __m128i hqDiffer(__m128i center, const uint32_t *neighbor, __m128i thresholds,
+                               __m128i flag)
+{
+    const __m128i n    = _mm_loadu_si128(reinterpret_cast<const __m128i *>(neighbor));
+    const __m128i diff = _mm_or_si128(_mm_subs_epu8(center, n), _mm_subs_epu8(n, center));
+    const __m128i same = _mm_cmpeq_epi32(_mm_subs_epu8(diff, thresholds), _mm_setzero_si128());
+    return _mm_andnot_si128(same, flag);
+}
+
+static void hqPatterns(const uint32_t *above, const uint32_t *row, const uint32_t *below,
+                       long count, uint8_t *patterns)
+{
+    const __m128i thresholds = _mm_set1_epi32(0x00300706);
+    long x = 0;
+    for (; x + 4 <= count; x += 4)
+    {
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x));
+        __m128i pat =       hqDiffer(c, above + x - 1, thresholds, _mm_set1_epi32(1));
+        pat = _mm_or_si128(pat, hqDiffer(c, above + x,     thresholds, _mm_set1_epi32(2)));
+        pat = _mm_or_si128(pat, hqDiffer(c, above + x + 1, thresholds, _mm_set1_epi32(4)));
+        pat = _mm_or_si128(pat, hqDiffer(c, row + x - 1,   thresholds, _mm_set1_epi32(8)));
+        pat = _mm_or_si128(pat, hqDiffer(c, row + x + 1,   thresholds, _mm_set1_epi32(16)));
+        pat = _mm_or_si128(pat, hqDiffer(c, below + x - 1, thresholds, _mm_set1_epi32(32)));
+        pat = _mm_or_si128(pat, hqDiffer(c, below + x,     thresholds, _mm_set1_epi32(64)));
+        pat = _mm_or_si128(pat, hqDiffer(c, below + x + 1, thresholds, _mm_set1_epi32(128)));
+        pat = _mm_packs_epi32(pat, pat);
+        pat = _mm_packus_epi16(pat, pat);
+        const int packed = _mm_cvtsi128_si32(pat);
+        std::memcpy(patterns + x, &packed, 4);
+    }
+    scalar::hqPatterns(above + x, row + x, below + x, count - x, patterns + x);
+}
+
+/// Replaces the alpha bytes of four RGBA pixels with four bytes from @a alpha.
+static inline __m128i replaceAlpha4(__m128i pixels, const uint8_t *alpha)
+{
+    int32_t packed;
+    std::memcpy(&packed, alpha, 4);
+    __m128i a = _mm_cvtsi32_si128(packed);
+    a = _mm_unpacklo_epi8(_mm_setzero_si128(), a);  // a << 8 in 16-bit lanes
+    a = _mm_unpacklo_epi16(_mm_setzero_si128(), a); // a << 24 in 32-bit lanes
+    return _mm_or_si128(_mm_and_si128(pixels, _mm_set1_epi32(0x00ffffff)), a);
+}
+
+static void indexedToRGBA(const uint8_t *indices, const uint8_t *alpha, const uint32_t *table,
+                          long count, uint8_t *out)
+{
+    // There is no gather in SSE2, but the lookups are done four at a time and the
+    // alpha is merged in with vector operations.
+    long i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const uint32_t px[4] = { table[indices[i]],     table[indices[i + 1]],
+                                 table[indices[i + 2]], table[indices[i + 3]] };
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(px));
+        if (alpha) v = replaceAlpha4(v, alpha + i);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4 * i), v);
+    }
+    scalar::indexedToRGBA(indices + i, alpha? alpha + i : nullptr, table, count - i, out + 4 * i);
+}
+
+} // namespace sse2
+
+#endif // DE_SIMD_SSE2
+
+#ifdef DE_SIMD_AVX2
+
+namespace avx2 {
+
+DE_TARGET_AVX2 static void sumRGBA(const uint8_t *pixels, long count, uint64_t sums[4],
+                                   long *translucentCount)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i low8 = _mm256_set1_epi32(0xff);
+    __m256i red = zero, green = zero, blue = zero, alpha = zero, opaque = zero;
+
+    long i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + 4 * i));
+        const __m256i a = _mm256_srli_epi32(v, 24);
+        red    = _mm256_add_epi64(red,   _mm256_sad_epu8(_mm256_and_si256(v, low8), zero));
+        green  = _mm256_add_epi64(green, _mm256_sad_epu8(_mm256_and_si256(_mm256_srli_epi32(v, 8), low8), zero));
+        blue   = _mm256_add_epi64(blue,  _mm256_sad_epu8(_mm256_and_si256(_mm256_srli_epi32(v, 16), low8), zero));
+        alpha  = _mm256_add_epi64(alpha, _mm256_sad_epu8(a, zero));
+        opaque = _mm256_sub_epi32(opaque, _mm256_cmpeq_epi32(a, low8));
+    }
+
+    uint64_t lanes[4][4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes[0]), red);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes[1]), green);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes[2]), blue);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes[3]), alpha);
+    int32_t opaqueLanes[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(opaqueLanes), opaque);
+
+    long translucent;
+    sse2::sumRGBA(pixels + 4 * i, count - i, sums, &translucent);
+    for (int c = 0; c < 4; ++c)
+    {
+        sums[c] += lanes[c][0] + lanes[c][1] + lanes[c][2] + lanes[c][3];
+    }
+    long opaqueCount = 0;
+    for (int k = 0; k < 8; ++k) opaqueCount += opaqueLanes[k];
+    *translucentCount = translucent + i - opaqueCount;
+}
+
+DE_TARGET_AVX2 static void byteStats(const uint8_t *bytes, long count, uint8_t *min,
+                                     uint8_t *max, uint64_t *sum, long *maxedCount)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi8(1);
+    const __m256i full = _mm256_set1_epi8(char(0xff));
+    __m256i lo = full, hi = zero, total = zero, maxed = zero;
+
+    long i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bytes + i));
+        lo    = _mm256_min_epu8(lo, v);
+        hi    = _mm256_max_epu8(hi, v);
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(v, zero));
+        maxed = _mm256_add_epi64(maxed, _mm256_sad_epu8(
+                    _mm256_and_si256(_mm256_cmpeq_epi8(v, full), ones), zero));
+    }
+
+    uint8_t los[32], his[32];
+    uint64_t totals[4], maxeds[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(los), lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(his), hi);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(totals), total);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(maxeds), maxed);
+
+    sse2::byteStats(bytes + i, count - i, min, max, sum, maxedCount);
+    for (int k = 0; k < 32; ++k)
+    {
+        if (los[k] < *min) *min = los[k];
+        if (his[k] > *max) *max = his[k];
+    }
+    *sum        += totals[0] + totals[1] + totals[2] + totals[3];
+    *maxedCount += long(maxeds[0] + maxeds[1] + maxeds[2] + maxeds[3]);
+}
+
+DE_TARGET_AVX2 static uint8_t maskedMax(const uint8_t *bytes, const uint8_t *mask, long count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i hi = zero;
+
+    long i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bytes + i));
+        const __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mask + i));
+        hi = _mm256_max_epu8(hi, _mm256_andnot_si256(_mm256_cmpeq_epi8(m, zero), v));
+    }
+
+    uint8_t his[32];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(his), hi);
+    uint8_t result = sse2::maskedMax(bytes + i, mask + i, count - i);
+    for (int k = 0; k < 32; ++k)
+    {
+        if (his[k] > result) result = his[k];
+    }
+    return result;
+}
+
+DE_TARGET_AVX2 static void desaturateRGBA(uint8_t *pixels, long count)
+{
+    const __m256i low8  = _mm256_set1_epi32(0xff);
+    const __m256i alpha = _mm256_set1_epi32(int(0xff000000));
+
+    long i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i *p = reinterpret_cast<__m256i *>(pixels + 4 * i);
+        const __m256i v  = _mm256_loadu_si256(p);
+        const __m256i g  = _mm256_srli_epi32(v, 8);
+        const __m256i b  = _mm256_srli_epi32(v, 16);
+        const __m256i lo = _mm256_and_si256(_mm256_min_epu8(v, _mm256_min_epu8(g, b)), low8);
+        const __m256i hi = _mm256_and_si256(_mm256_max_epu8(v, _mm256_max_epu8(g, b)), low8);
+        const __m256i l  = _mm256_srli_epi32(_mm256_add_epi32(lo, hi), 1);
+        _mm256_storeu_si256(p, _mm256_or_si256(_mm256_or_si256(l, _mm256_slli_epi32(l, 8)),
+                                               _mm256_or_si256(_mm256_slli_epi32(l, 16),
+                                                               _mm256_and_si256(v, alpha))));
+    }
+    sse2::desaturateRGBA(pixels + 4 * i, count - i);
+}
+
+DE_TARGET_AVX2 static inline __m256i lerpLanes(__m256i a, __m256i b, __m256 wa, __m256 wb,
+                                               __m256 scale)
+{
+    return _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(a), wa),
+                                                           _mm256_mul_ps(_mm256_cvtepi32_ps(b), wb)),
+                                             scale));
+}
+
+DE_TARGET_AVX2 static void lerpBytes(const uint8_t *a, const uint8_t *b, uint8_t *out,
+                                     long count, int weight)
+{
+    const __m256i zero  = _mm256_setzero_si256();
+    const __m256  wa    = _mm256_set1_ps(float(0x10000 - weight));
+    const __m256  wb    = _mm256_set1_ps(float(weight));
+    const __m256  scale = _mm256_set1_ps(1.f / 0x10000);
+
+    long i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        // Unpacking and packing both work within 128-bit lanes, so the order is preserved.
+        const __m256i va  = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        const __m256i vb  = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+        const __m256i aLo = _mm256_unpacklo_epi8(va, zero), aHi = _mm256_unpackhi_epi8(va, zero);
+        const __m256i bLo = _mm256_unpacklo_epi8(vb, zero), bHi = _mm256_unpackhi_epi8(vb, zero);
+
+        const __m256i r0 = lerpLanes(_mm256_unpacklo_epi16(aLo, zero), _mm256_unpacklo_epi16(bLo, zero), wa, wb, scale);
+        const __m256i r1 = lerpLanes(_mm256_unpackhi_epi16(aLo, zero), _mm256_unpackhi_epi16(bLo, zero), wa, wb, scale);
+        const __m256i r2 = lerpLanes(_mm256_unpacklo_epi16(aHi, zero), _mm256_unpacklo_epi16(bHi, zero), wa, wb, scale);
+        const __m256i r3 = lerpLanes(_mm256_unpackhi_epi16(aHi, zero), _mm256_unpackhi_epi16(bHi, zero), wa, wb, scale);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                            _mm256_packus_epi16(_mm256_packs_epi32(r0, r1),
+                                                _mm256_packs_epi32(r2, r3)));
+    }
+    sse2::lerpBytes(a + i, b + i, out + i, count - i, weight);
+}
+
+DE_TARGET_AVX2 static inline __m256i halve8RGBA(__m256i r0, __m256i r1)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(r0, zero), _mm256_unpacklo_epi8(r1, zero));
+    const __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(r0, zero), _mm256_unpackhi_epi8(r1, zero));
+    return _mm256_srli_epi16(_mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi),
+                                              _mm256_unpackhi_epi64(lo, hi)), 2);
+}
+
+DE_TARGET_AVX2 static void halveRGBA(const uint8_t *row0, const uint8_t *row1, uint8_t *out,
+                                     long outWidth)
+{
+    long x = 0;
+    for (; x + 8 <= outWidth; x += 8)
+    {
+        const __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row0 + 8 * x));
+        const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row0 + 8 * x + 32));
+        const __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row1 + 8 * x));
+        const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row1 + 8 * x + 32));
+        // Packing interleaves the 64-bit halves of the lanes; restore the order.
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 4 * x),
+                            _mm256_permute4x64_epi64(_mm256_packus_epi16(halve8RGBA(a0, a1),
+                                                                         halve8RGBA(b0, b1)),
+                                                     0xd8));
+    }
+    sse2::halveRGBA(row0 + 8 * x, row1 + 8 * x, out + 4 * x, outWidth - x);
+}
+
+DE_TARGET_AVX2 static inline __m256i halve32Bytes(__m256i r0, __m256i r1)
+{
+    const __m256i low8 = _mm256_set1_epi16(0xff);
+    return _mm256_srli_epi16(
+            _mm256_add_epi16(_mm256_add_epi16(_mm256_and_si256(r0, low8), _mm256_srli_epi16(r0, 8)),
+                             _mm256_add_epi16(_mm256_and_si256(r1, low8), _mm256_srli_epi16(r1, 8))),
+            2);
+}
+
+DE_TARGET_AVX2 static void halveBytes(const uint8_t *row0, const uint8_t *row1, uint8_t *out,
+                                      long outWidth)
+{
+    long x = 0;
+    for (; x + 32 <= outWidth; x += 32)
+    {
+        const __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row0 + 2 * x));
+        const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row0 + 2 * x + 32));
+        const __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row1 + 2 * x));
+        const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row1 + 2 * x + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + x),
+                            _mm256_permute4x64_epi64(_mm256_packus_epi16(halve32Bytes(a0, a1),
+                                                                         halve32Bytes(b0, b1)),
+                                                     0xd8));
+    }
+    sse2::halveBytes(row0 + 2 * x, row1 + 2 * x, out + x, outWidth - x);
+}
+
+DE_TARGET_AVX2 static bool opaqueSpanRGBA(const uint8_t *pixels, long count, long *first,
+                                          long *last)
+{
+    const __m256i full = _mm256_set1_epi32(0xff);
+    long lo = -1, hi = -1, hiStart = 0;
+    unsigned hiBits = 0;
+
+    long i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + 4 * i));
+        const unsigned bits = unsigned(_mm256_movemask_ps(
+                _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_srli_epi32(v, 24), full))));
+        if (bits)
+        {
+            if (lo < 0) lo = i + lowestBit(bits);
+            hiStart = i;
+            hiBits  = bits;
+        }
+    }
+    if (hiBits) hi = hiStart + highestBit(hiBits);
+    long tailLo, tailHi;
+    const bool tail = sse2::opaqueSpanRGBA(pixels + 4 * i, count - i, &tailLo, &tailHi);
+    return mergeSpans(lo, hi, tail, tailLo, tailHi, i, first, last);
+}
+
+DE_TARGET_AVX2 static bool opaqueSpanAlpha(const uint8_t *alpha, long count, long *first,
+                                           long *last)
+{
+    const __m256i full = _mm256_set1_epi8(char(0xff));
+    long lo = -1, hi = -1, hiStart = 0;
+    unsigned hiBits = 0;
+
+    long i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(alpha + i));
+        const unsigned bits = unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, full)));
+        if (bits)
+        {
+            if (lo < 0) lo = i + lowestBit(bits);
+            hiStart = i;
+            hiBits  = bits;
+        }
+    }
+    if (hiBits) hi = hiStart + highestBit(hiBits);
+    long tailLo, tailHi;
+    const bool tail = sse2::opaqueSpanAlpha(alpha + i, count - i, &tailLo, &tailHi);
+    return mergeSpans(lo, hi, tail, tailLo, tailHi, i, first, last);
+}
+
+DE_TARGET_AVX2 static inline __m256i hqDiffer(__m256i center, const uint32_t *neighbor,
+                                              __m256i thresholds, int flag)
+{
+    const __m256i n    = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(neighbor));
+    const __m256i diff = _mm256_or_si256(_mm256_subs_epu8(center, n), _mm256_subs_epu8(n, center));
+    const __m256i same = _mm256_cmpeq_epi32(_mm256_subs_epu8(diff, thresholds),
+                                            _mm256_setzero_si256());
+    return _mm256_andnot_si256(same, _mm256_set1_epi32(flag));
+}
+
+DE_TARGET_AVX2 static void hqPatterns(const uint32_t *above, const uint32_t *row,
+                                      const uint32_t *below, long count, uint8_t *patterns)
+{
+    const __m256i thresholds = _mm256_set1_epi32(0x00300706);
+    long x = 0;
+    for (; x + 8 <= count; x += 8)
+    {
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + x));
+        __m256i pat =          hqDiffer(c, above + x - 1, thresholds, 1);
+        pat = _mm256_or_si256(pat, hqDiffer(c, above + x,     thresholds, 2));
+        pat = _mm256_or_si256(pat, hqDiffer(c, above + x + 1, thresholds, 4));
+        pat = _mm256_or_si256(pat, hqDiffer(c, row + x - 1,   thresholds, 8));
+        pat = _mm256_or_si256(pat, hqDiffer(c, row + x + 1,   thresholds, 16));
+        pat = _mm256_or_si256(pat, hqDiffer(c, below + x - 1, thresholds, 32));
+        pat = _mm256_or_si256(pat, hqDiffer(c, below + x,     thresholds, 64));
+        pat = _mm256_or_si256(pat, hqDiffer(c, below + x + 1, thresholds, 128));
+        // Packing works within each 128-bit lane.
+        pat = _mm256_packs_epi32(pat, pat);
+        pat = _mm256_packus_epi16(pat, pat);
+        const int lo = _mm_cvtsi128_si32(_mm256_castsi256_si128(pat));
+        const int hi = _mm_cvtsi128_si32(_mm256_extracti128_si256(pat, 1));
+        std::memcpy(patterns + x,     &lo, 4);
+        std::memcpy(patterns + x + 4, &hi, 4);
+    }
+    sse2::hqPatterns(above + x, row + x, below + x, count - x, patterns + x);
+}
+
+DE_TARGET_AVX2 static void indexedToRGBA(const uint8_t *indices, const uint8_t *alpha,
+                                         const uint32_t *table, long count, uint8_t *out)
+{
+    const __m256i colorMask = _mm256_set1_epi32(0x00ffffff);
+    long i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i idx = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(indices + i)));
+        __m256i px = _mm256_i32gather_epi32(reinterpret_cast<const int *>(table), idx, 4);
+        if (alpha)
+        {
+            const __m256i a = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i *>(alpha + i)));
+            px = _mm256_or_si256(_mm256_and_si256(px, colorMask), _mm256_slli_epi32(a, 24));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 4 * i), px);
+    }
+    sse2::indexedToRGBA(indices + i, alpha? alpha + i : nullptr, table, count - i, out + 4 * i);
+}
+
+} // namespace avx2
+
+#endif // DE_SIMD_AVX2
+
+static const ImageKernels scalarKernels = {
+    ImageKernels::Scalar, "scalar",
+    scalar::sumRGBA, scalar::byteStats, scalar::maskedMax, scalar::desaturateRGBA,
+    scalar::lerpBytes, scalar::halveRGBA, scalar::halveBytes,
+    scalar::opaqueSpanRGBA, scalar::opaqueSpanAlpha,
+    scalar::hqPatterns, scalar::indexedToRGBA
+};
+
+#ifdef DE_SIMD_SSE2
+static const ImageKernels sse2Kernels = {
+    ImageKernels::SSE2, "SSE2",
+    sse2::sumRGBA, sse2::byteStats, sse2::maskedMax, sse2::desaturateRGBA,
+    sse2::lerpBytes, sse2::halveRGBA, sse2::halveBytes,
+    sse2::opaqueSpanRGBA, sse2::opaqueSpanAlpha,
+    sse2::hqPatterns, sse2::indexedToRGBA
+};
+#endif
+
+#ifdef DE_SIMD_AVX2
+static const ImageKernels avx2Kernels = {
+    ImageKernels::AVX2, "AVX2",
+    avx2::sumRGBA, avx2::byteStats, avx2::maskedMax, avx2::desaturateRGBA,
+    avx2::lerpBytes, avx2::halveRGBA, avx2::halveBytes,
+    avx2::opaqueSpanRGBA, avx2::opaqueSpanAlpha,
+    avx2::hqPatterns, avx2::indexedToRGBA
+};
+#endif
+
+const ImageKernels *GL_ImageKernelsAtLevel(ImageKernels::Level level)
+{
+    switch (level)
+    {
+    case ImageKernels::Scalar:
+        return &scalarKernels;
+
+#ifdef DE_SIMD_SSE2
+    case ImageKernels::SSE2:
+        return &sse2Kernels;
+#endif
+
+#ifdef DE_SIMD_AVX2
+    case ImageKernels::AVX2: {
+        return SIMD_CPUSupportsAVX2()? &avx2Kernels : nullptr; }
+#endif
+
+    default:
+        return nullptr;
+    }
+}
+
+const ImageKernels &GL_ImageKernels()
+{
+    static const ImageKernels *best = [] () {
+        for (int level = ImageKernels::LevelCount - 1; level > ImageKernels::Scalar; --level)
+        {
+            if (const ImageKernels *kernels = GL_ImageKernelsAtLevel(ImageKernels::Level(level)))
+            {
+                return kernels;
+            }
+        }
+        return &scalarKernels;
+    }();
+    return *best;
+}
+
+/**
+ * Scales a line of pixels. @a outLen is measured in output pixels; the strides are in
+ * bytes.
+ */
+static void scaleLine(const uint8_t *in, int inStride, uint8_t *out, int outStride,
+                      int outLen, int inLen, int comps)
+{
+    const float inToOutScale = outLen / float(inLen);
+
+    if (inToOutScale > 1)
+    {
+        // Magnification is done using linear interpolation (16.16 fixed point).
+        const int inPosDelta = (0x10000 * (inLen - 1)) / (outLen - 1);
+        int inPos = inPosDelta;
+
+        // The first pixel.
+        std::memcpy(out, in, comps);
+        out += outStride;
+
+        // Step at each out pixel between the first and last ones.
+        for (int i = 1; i < outLen - 1; ++i, out += outStride, inPos += inPosDelta)
+        {
+            const uint8_t *col1 = in + (inPos >> 16) * inStride;
+            const int weight    = inPos & 0xffff;
+            const int invWeight = 0x10000 - weight;
+
+            if (!weight)
+            {
+                // Don't read past the end of a line of one pixel.
+                std::memcpy(out, col1, comps);
+                continue;
+            }
+            const uint8_t *col2 = col1 + inStride;
+            for (int c = 0; c < comps; ++c)
+                out[c] = uint8_t((col1[c] * invWeight + col2[c] * weight) >> 16);
+        }
+
+        // The last pixel.
+        std::memcpy(out, in + (inLen - 1) * inStride, comps);
+        return;
+    }
+
+    if (inToOutScale < 1)
+    {
+        // Minification needs to calculate the average of each of
+        // the pixels contained by the out pixel.
+        unsigned cumul[4] = { 0, 0, 0, 0 }, count = 0;
+        int outPos = 0;
+
+        for (int i = 0; i < inLen; ++i, in += inStride)
+        {
+            if (int(i * inToOutScale) != outPos)
+            {
+                outPos = int(i * inToOutScale);
+
+                for (int c = 0; c < comps; ++c)
+                {
+                    out[c] = (count? uint8_t(cumul[c] / count) : 0);
+                    cumul[c] = 0;
+                }
+                count = 0;
+                out += outStride;
+            }
+            for (int c = 0; c < comps; ++c)
+                cumul[c] += in[c];
+            count++;
+        }
+        // Fill in the last pixel, too.
+        if (count)
+            for (int c = 0; c < comps; ++c)
+                out[c] = uint8_t(cumul[c] / count);
+        return;
+    }
+
+    // No need for scaling.
+    for (int i = outLen; i > 0; i--, out += outStride, in += inStride)
+    {
+        for (int c = 0; c < comps; ++c)
+            out[c] = in[c];
+    }
+}
+
+/**
+ * Scales an image vertically. Whole rows are processed at a time, but the result is
+ * identical to scaling each column separately with scaleLine().
+ *
+ * @param rowSize  Size of a row in bytes.
+ */
+static void scaleRows(const ImageKernels &kernels, const uint8_t *in, uint8_t *out,
+                      int rowSize, int outLen, int inLen)
+{
+    const float inToOutScale = outLen / float(inLen);
+
+    if (inToOutScale > 1)
+    {
+        // Magnification is done using linear interpolation (16.16 fixed point).
+        const int inPosDelta = (0x10000 * (inLen - 1)) / (outLen - 1);
+        int inPos = inPosDelta;
+
+        // The first row.
+        std::memcpy(out, in, rowSize);
+        out += rowSize;
+
+        // Step at each out row between the first and last ones.
+        for (int i = 1; i < outLen - 1; ++i, out += rowSize, inPos += inPosDelta)
+        {
+            const uint8_t *row1 = in + (inPos >> 16) * rowSize;
+            const int weight    = inPos & 0xffff;
+
+            if (weight)
+                kernels.lerpBytes(row1, row1 + rowSize, out, rowSize, weight);
+            else
+                std::memcpy(out, row1, rowSize);
+        }
+
+        // The last row.
+        std::memcpy(out, in + (inLen - 1) * rowSize, rowSize);
+        return;
+    }
+
+    if (inToOutScale < 1)
+    {
+        // Minification needs to calculate the average of each of
+        // the rows contained by the out row.
+        std::vector<unsigned> cumul(rowSize);
+        unsigned count = 0;
+        int outPos = 0;
+
+        for (int i = 0; i < inLen; ++i, in += rowSize)
+        {
+            if (int(i * inToOutScale) != outPos)
+            {
+                outPos = int(i * inToOutScale);
+
+                for (int c = 0; c < rowSize; ++c)
+                {
+                    out[c] = (count? uint8_t(cumul[c] / count) : 0);
+                    cumul[c] = 0;
+                }
+                count = 0;
+                out += rowSize;
+            }
+            for (int c = 0; c < rowSize; ++c)
+                cumul[c] += in[c];
+            count++;
+        }
+        // Fill in the last row, too.
+        if (count)
+            for (int c = 0; c < rowSize; ++c)
+                out[c] = uint8_t(cumul[c] / count);
+        return;
+    }
+
+    // No need for scaling.
+    std::memcpy(out, in, rowSize * outLen);
+}
+
+void GL_ScaleImage(const ImageKernels &kernels, const uint8_t *in, int width, int height,
+                   int comps, uint8_t *out, int outWidth, int outHeight)
+{
+    // First scale horizontally, to outWidth, into a temporary buffer.
+    std::vector<uint8_t> buffer(comps * outWidth * height);
+    for (int i = 0; i < height; ++i)
+    {
+        scaleLine(in + i * width * comps, comps, buffer.data() + i * outWidth * comps, comps,
+                  outWidth, width, comps);
+    }
+
+    // Then scale vertically, to outHeight, into the out buffer.
+    scaleRows(kernels, buffer.data(), out, outWidth * comps, outHeight, height);
+}
+
+void GL_HalveImage(const ImageKernels &kernels, uint8_t *pixels, int width, int height,
+                   int comps)
+{
+    const int outW = width / 2, outH = height / 2;
+
+    if (comps == 4 || comps == 1)
+    {
+        const int inRowStep = (width + 2 * outW) * comps;
+
+        // An output row never overlaps the input rows still to be read.
+        for (int y = 0; y < outH; ++y)
+        {
+            const uint8_t *row = pixels + y * inRowStep;
+            uint8_t *out = pixels + y * outW * comps;
+            if (comps == 4)
+                kernels.halveRGBA(row, row + width * comps, out, outW);
+            else
+                kernels.halveBytes(row, row + width, out, outW);
+        }
+        return;
+    }
+
+    const uint8_t *in = pixels;
+    uint8_t *out = pixels;
+    for (int y = 0; y < outH; ++y, in += width * comps)
+        for (int x = 0; x < outW; ++x, in += comps * 2)
+            for (int c = 0; c < comps; ++c, out++)
+                *out = uint8_t((in[c] + in[comps + c] + in[comps * width + c] +
+                                in[comps * (width + 1) + c]) >> 2);
+}
+
+void GL_FindOpaqueRegion(const ImageKernels &kernels, const uint8_t *pixels, int width,
+                         int height, int pixelSize, int region[4])
+{
+    region[0] = width;
+    region[1] = 0;
+    region[2] = height;
+    region[3] = 0;
+
+    // For paletted images the alpha channel follows the actual image.
+    const uint8_t *alpha = (pixelSize == 1? pixels + width * height : nullptr);
+
+    // Find the opaque span of each row.
+    for (int k = 0; k < height; ++k)
+    {
+        long first, last;
+
+        // Alpha pixels don't count.
+        if (pixelSize == 1)
+        {
+            if (!kernels.opaqueSpanAlpha(alpha + k * width, width, &first, &last))
+                continue;
+        }
+        else if (pixelSize == 4)
+        {
+            if (!kernels.opaqueSpanRGBA(pixels + k * width * 4, width, &first, &last))
+                continue;
+        }
+        else
+        {
+            first = 0;
+            last  = width - 1;
+        }
+
+        if (first < region[0]) region[0] = int(first);
+        if (last  > region[1]) region[1] = int(last);
+        if (k < region[2]) region[2] = k;
+        if (k > region[3]) region[3] = k;
+    }
+}
+
+void GL_IndexedToTrueColor(const ImageKernels &kernels, const uint8_t *indices,
+                           const uint8_t *alpha, const uint32_t *table, long count,
+                           uint8_t *out, int outComps)
+{
+    if (outComps == 4)
+    {
+        kernels.indexedToRGBA(indices, alpha, table, count, out);
+        return;
+    }
+    for (long i = 0; i < count; ++i, out += 3)
+    {
+        std::memcpy(out, &table[indices[i]], 3);
+    }
+}
@@ -91,6 +91,8 @@ void GL_InitTextureManager()
 
     GL_InitSmartFilterHQ2x();
 
+    App_Resources().textureContentCache().initialize();
+
     // Initialization done.
     initedOk = true;
 }
@@ -285,6 +287,8 @@ GLuint GL_PrepareFlaremap(const res::Uri &resourceUri)
     {
         if (const TextureVariant *variant = static_cast<ClientTexture *>(tex)->prepareVariant(Rend_HaloTextureSpec()))
         {
+            // The GL-name is kept for drawing halos.
+            variant->pin();
             return variant->glName();
         }
         // Dang...
@@ -26,6 +26,7 @@
 #include "gl/gl_tex.h"
 #include "gl/texturecontent.h"
 #include "render/rend_main.h"  // misc global vars awaiting new home
+#include "resource/clientresources.h"
 
 #include <doomsday/res/colorpalettes.h>
 #include <de/legacy/concurrency.h>
@@ -36,6 +37,23 @@
 
 using namespace de;
 
+/// Largest textures that are upscaled 4x when smart filtering ("rend-tex-filter-smart" 2).
+static const int HQ4X_MAX_SIZE = 128;
+
+/**
+ * Chooses the smart filter applied to true-color content when uploading.
+ */
+static int chooseUploadSmartFilter(int width, int height)
+{
+    int method = GL_ChooseSmartFilter(width, height, 0);
+    if (method == 2 && useSmartFilter == 2 &&
+        width <= HQ4X_MAX_SIZE && height <= HQ4X_MAX_SIZE)
+    {
+        method = 3; // Small textures benefit from more upscaling.
+    }
+    return method;
+}
+
 static int BytesPerPixelFmt(dgltexformat_t format)
 {
     switch (format)
@@ -316,6 +334,62 @@ static dgltexformat_t prepareImageAsDetailTexture(image_t &image,
     return DGL_LUMINANCE;
 }
 
+/**
+ * Determines whether the smart filter will upscale @a image with hq2x or hq4x when it
+ * is uploaded, after it has been prepared with prepareImageAsTexture().
+ */
+static bool isSmartFilteredWhenUploaded(const image_t &image, const variantspecification_t &spec)
+{
+    if (!useSmartFilter || (spec.flags & (TSF_UPSCALE_AND_SHARPEN | TSF_MONOCHROME)) ||
+        spec.toAlpha)
+    {
+        return false;
+    }
+    // Only color content is filtered.
+    if (!image.paletteId && image.pixelSize < 3) return false;
+    return chooseUploadSmartFilter(image.size.x, image.size.y) >= 2;
+}
+
+/**
+ * Determines whether @a spec upscales @a image with hq2x while preparing it.
+ */
+static bool isUpscaledWhenPrepared(const image_t &image, const TextureVariantSpec &spec)
+{
+    return spec.type == TST_GENERAL && !spec.variant.toAlpha && image.paletteId &&
+           (spec.variant.flags & TSF_UPSCALE_AND_SHARPEN) &&
+           GL_ChooseSmartFilter(image.size.x, image.size.y, 0) >= 2;
+}
+
+/**
+ * Applies the smart filter of uploading (and the gamma correction preceding it) to an
+ * image prepared with prepareImageAsTexture(), so that the upscaled image can be cached.
+ *
+ * @return @c true, if the image was replaced with the filtered image.
+ */
+static bool smartFilterPreparedImage(image_t &image, TextureContentCache::Processed &processed,
+                                     bool gammaCorrection)
+{
+    texturecontent_t c;
+    GL_InitTextureContent(&c);
+    c.format    = dgltexformat_t(processed.format);
+    c.pixels    = image.pixels;
+    c.paletteId = image.paletteId;
+    c.width     = image.size.x;
+    c.height    = image.size.y;
+    if (gammaCorrection) c.flags |= TXCF_APPLY_GAMMACORRECTION;
+
+    uint8_t *filtered = GL_SmartFilterTextureContent(c);
+    if (!filtered) return false;
+
+    M_Free(image.pixels);
+    image.pixels    = filtered;
+    image.size      = image_t::Size(c.width, c.height);
+    image.pixelSize = BytesPerPixelFmt(c.format);
+    image.paletteId = 0;
+    processed.format = c.format;
+    return true;
+}
+
 void GL_PrepareTextureContent(texturecontent_t &c,
                               GLuint glTexName,
                               image_t &image,
@@ -329,6 +403,25 @@ void GL_PrepareTextureContent(texturecontent_t &c,
     GL_InitTextureContent(&c);
     c.name = glTexName;
 
+    // Processing results may be available from an earlier session. Only upscaled content
+    // is cached; other processing takes less time than hashing the source image and
+    // reading the result. When caching, the smart filter of uploading is applied here so
+    // the upscaled result can be cached, too.
+    TextureContentCache &contentCache = App_Resources().textureContentCache();
+    TextureContentCache::Processed processed;
+    Block cacheKey;
+    bool cached = false;
+    bool filterNow = false;
+    if (contentCache.isEnabled())
+    {
+        filterNow = (spec.type == TST_GENERAL && isSmartFilteredWhenUploaded(image, spec.variant));
+        if (filterNow || isUpscaledWhenPrepared(image, spec))
+        {
+            cacheKey = contentCache.key(image, spec);
+            cached   = contentCache.load(cacheKey, image, processed);
+        }
+    }
+
     switch (spec.type)
     {
     case TST_GENERAL: {
@@ -339,7 +432,20 @@ void GL_PrepareTextureContent(texturecontent_t &c,
         const bool noSmartFilter = (vspec.flags & TSF_UPSCALE_AND_SHARPEN) != 0;
 
         // Prepare the image for upload.
-        dgltexformat_t dglFormat = prepareImageAsTexture(image, vspec);
+        bool filtered = cached && filterNow;
+        if (!cached)
+        {
+            processed.format = prepareImageAsTexture(image, vspec);
+            if (filterNow)
+            {
+                filtered = smartFilterPreparedImage(image, processed, vspec.gammaCorrection);
+            }
+            if (!cacheKey.isEmpty() && filtered == filterNow)
+            {
+                contentCache.store(cacheKey, image, processed);
+            }
+        }
+        const dgltexformat_t dglFormat = dgltexformat_t(processed.format);
 
         // Configure the texture content.
         c.format      = dglFormat;
@@ -350,10 +456,11 @@ void GL_PrepareTextureContent(texturecontent_t &c,
 
         if (noCompression || (image.size.x < 128 || image.size.y < 128))
             c.flags |= TXCF_NO_COMPRESSION;
-        if (vspec.gammaCorrection) c.flags |= TXCF_APPLY_GAMMACORRECTION;
+        // Gamma correction precedes the smart filter.
+        if (vspec.gammaCorrection && !filtered) c.flags |= TXCF_APPLY_GAMMACORRECTION;
         if (vspec.noStretch)       c.flags |= TXCF_UPLOAD_ARG_NOSTRETCH;
         if (vspec.mipmapped)       c.flags |= TXCF_MIPMAP;
-        if (noSmartFilter)         c.flags |= TXCF_UPLOAD_ARG_NOSMARTFILTER;
+        if (noSmartFilter || filtered) c.flags |= TXCF_UPLOAD_ARG_NOSMARTFILTER;
 
         c.magFilter   = vspec.glMagFilter();
         c.minFilter   = vspec.glMinFilter();
@@ -366,8 +473,16 @@ void GL_PrepareTextureContent(texturecontent_t &c,
         const detailvariantspecification_t &dspec = spec.detailVariant;
 
         // Prepare the image for upload.
-        float baMul, hiMul, loMul;
-        dgltexformat_t dglFormat = prepareImageAsDetailTexture(image, dspec, &baMul, &hiMul, &loMul);
+        if (!cached)
+        {
+            processed.format = prepareImageAsDetailTexture(image, dspec, &processed.baMul,
+                                                           &processed.hiMul, &processed.loMul);
+            if (!cacheKey.isEmpty()) contentCache.store(cacheKey, image, processed);
+        }
+        const dgltexformat_t dglFormat = dgltexformat_t(processed.format);
+        const float baMul = processed.baMul;
+        const float hiMul = processed.hiMul;
+        const float loMul = processed.loMul;
 
         // Determine the gray mipmap factor.
         int grayMipmapFactor = dspec.contrast;
@@ -742,28 +857,58 @@ static dd_bool uploadTextureGrayMipmap(GLenum         glFormat,
     return true;
 }
 
-/// @note Texture parameters will NOT be set here!
-void GL_UploadTextureContent(const texturecontent_t &content, gfx::UploadMethod method)
+dsize GL_TextureContentSize(const texturecontent_t &content)
 {
-    if (method == gfx::Deferred)
+    dsize bytes = dsize(content.width) * dsize(content.height);
+    switch (content.format)
     {
-        GL_DeferTextureUpload(&content);
-        return;
-    }
+    case DGL_LUMINANCE:
+        if (!(content.flags & TXCF_CONVERT_8BIT_TO_ALPHA)) break;
+        bytes *= 4;
+        break;
 
-    if (novideo) return;
+    case DGL_LUMINANCE_PLUS_A8:
+        bytes *= 2;
+        break;
 
-    // Do this right away. No need to take a copy.
-    bool generateMipmaps = (content.flags & (TXCF_MIPMAP|TXCF_GRAY_MIPMAP)) != 0;
-    bool applyTexGamma   = (content.flags & TXCF_APPLY_GAMMACORRECTION)     != 0;
-    bool noCompression   = (content.flags & TXCF_NO_COMPRESSION)            != 0;
-    bool noSmartFilter   = (content.flags & TXCF_UPLOAD_ARG_NOSMARTFILTER)  != 0;
-    bool noStretch       = (content.flags & TXCF_UPLOAD_ARG_NOSTRETCH)      != 0;
+    default:
+        bytes *= 4;
+        if (useSmartFilter && !(content.flags & TXCF_UPLOAD_ARG_NOSMARTFILTER))
+        {
+            // Upscaled while uploading.
+            bytes *= (chooseUploadSmartFilter(content.width, content.height) == 3? 16 : 4);
+        }
+        break;
+    }
+    if (content.flags & (TXCF_MIPMAP | TXCF_GRAY_MIPMAP))
+    {
+        bytes += bytes / 3;
+    }
+    return bytes;
+}
 
-    int loadWidth             = content.width;
-    int loadHeight            = content.height;
+/**
+ * Converts paletted content to true color, and applies gamma correction and the
+ * smart filter to true-color content, as specified by the content flags.
+ *
+ * @param content  Texture content.
+ * @param width    Width of the resulting pixels (updated).
+ * @param height   Height of the resulting pixels (updated).
+ * @param format   Format of the resulting pixels (updated).
+ *
+ * @return Resulting pixels. If not the same as @a content.pixels, the caller gets
+ * ownership of the buffer.
+ */
+static const uint8_t *prepareTrueColorPixels(const texturecontent_t &content, int &width,
+                                             int &height, dgltexformat_t &format)
+{
+    const bool applyTexGamma = (content.flags & TXCF_APPLY_GAMMACORRECTION)    != 0;
+    const bool noSmartFilter = (content.flags & TXCF_UPLOAD_ARG_NOSMARTFILTER) != 0;
+
+    int loadWidth             = width;
+    int loadHeight            = height;
     const uint8_t *loadPixels = content.pixels;
-    dgltexformat_t dglFormat  = content.format;
+    dgltexformat_t dglFormat  = format;
 
     // Convert a paletted source image to truecolor.
     if (dglFormat == DGL_COLOR_INDEX_8 || dglFormat == DGL_COLOR_INDEX_8_PLUS_A8)
@@ -837,7 +982,7 @@ void GL_UploadTextureContent(const texturecontent_t &content, gfx::UploadMethod
                 dglFormat = DGL_RGBA;
             }
 
-            uint8_t *filtered = GL_SmartFilter(GL_ChooseSmartFilter(loadWidth, loadHeight, 0),
+            uint8_t *filtered = GL_SmartFilter(chooseUploadSmartFilter(loadWidth, loadHeight),
                                                loadPixels, loadWidth, loadHeight,
                                                ICF_UPSCALE_SAMPLE_WRAP,
                                                &loadWidth, &loadHeight);
@@ -852,6 +997,67 @@ void GL_UploadTextureContent(const texturecontent_t &content, gfx::UploadMethod
         }
     }
 
+    width  = loadWidth;
+    height = loadHeight;
+    format = dglFormat;
+    return loadPixels;
+}
+
+uint8_t *GL_SmartFilterTextureContent(texturecontent_t &content)
+{
+    if (!useSmartFilter || (content.flags & TXCF_UPLOAD_ARG_NOSMARTFILTER))
+        return nullptr;
+
+    switch (content.format)
+    {
+    case DGL_COLOR_INDEX_8:
+    case DGL_COLOR_INDEX_8_PLUS_A8:
+    case DGL_RGB:
+    case DGL_RGBA:
+        break;
+
+    default:
+        return nullptr;
+    }
+
+    int width = content.width, height = content.height;
+    dgltexformat_t format = content.format;
+    const uint8_t *pixels = prepareTrueColorPixels(content, width, height, format);
+    if (pixels == content.pixels)
+        return nullptr;
+
+    // Nothing more is left to do for these when uploading.
+    content.pixels    = pixels;
+    content.width     = width;
+    content.height    = height;
+    content.format    = format;
+    content.paletteId = 0;
+    content.flags     = (content.flags & ~TXCF_APPLY_GAMMACORRECTION) | TXCF_UPLOAD_ARG_NOSMARTFILTER;
+    return const_cast<uint8_t *>(pixels);
+}
+
+/// @note Texture parameters will NOT be set here!
+void GL_UploadTextureContent(const texturecontent_t &content, gfx::UploadMethod method)
+{
+    if (method == gfx::Deferred)
+    {
+        GL_DeferTextureUpload(&content);
+        return;
+    }
+
+    if (novideo) return;
+
+    // Do this right away. No need to take a copy.
+    bool generateMipmaps = (content.flags & (TXCF_MIPMAP|TXCF_GRAY_MIPMAP)) != 0;
+    bool noCompression   = (content.flags & TXCF_NO_COMPRESSION)            != 0;
+    bool noStretch       = (content.flags & TXCF_UPLOAD_ARG_NOSTRETCH)      != 0;
+
+    int loadWidth             = content.width;
+    int loadHeight            = content.height;
+    dgltexformat_t dglFormat  = content.format;
+
+    const uint8_t *loadPixels = prepareTrueColorPixels(content, loadWidth, loadHeight, dglFormat);
+
     if (dglFormat == DGL_LUMINANCE && (content.flags & TXCF_CONVERT_8BIT_TO_ALPHA))
     {
         // Needs converting. This adds some overhead.
@@ -358,6 +358,13 @@ void Demo_StopPlayback()
 #endif
 }
 
+/**
+ * @todo Demo playback is disabled until the demo file I/O is ported to FS2 (LZSS
+ * files are no longer available). When it is revived, the container should carry a
+ * tic => file offset index and periodic world state keyframes (e.g., serialized via
+ * the savegame map state writer) so that playback can seek and fast-forward without
+ * replaying the whole packet stream.
+ */
 dd_bool Demo_ReadPacket()
 {
     return false;
@@ -26,6 +26,7 @@
 #include "api_console.h"
 #include "api_fontrender.h"
 #include "client/cl_def.h"
+#include "client/cl_mobj.h"
 #include "clientapp.h"
 #include "dd_loop.h"
 #include "gl/gl_main.h"
@@ -142,6 +143,7 @@ D_CMD(Connect)
 void N_Register(void)
 {
     C_VAR_CHARPTR("net-name", &playerName, 0, 0, 0);
+    C_VAR_INT    ("client-mobj-history", &clMobjHistoryDepth, 0, 0, CLMOBJ_HISTORY_MAX);
 
     C_CMD_FLAGS ("connect", nullptr,    Connect, CMDF_NO_NULLGAME | CMDF_NO_DEDICATED);
     C_CMD       ("setname", "s",        SetName);
@@ -0,0 +1,291 @@
+/** @file ambientlightgrid.cpp  Baked grid of ambient light for lighting objects.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "render/ambientlightgrid.h"
+
+#include <de/taskpool.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+static const size_t AMBIENTGRID_MAX_CELLS = 4 * 1024 * 1024;
+
+struct AmbientLightGrid::Impl
+{
+    double origin[3] {0, 0, 0};
+    double cellSize = 0;
+    int dims[3] {0, 0, 0};
+    std::vector<int> columnRegions;  ///< Region of each column of cells (-1 if outside).
+    std::vector<float> staticLight;  ///< RGB from static sources in each cell.
+    std::vector<float> regionLight;  ///< RGB of each region.
+    int regionCount = 0;
+
+    inline size_t columnIndex(int x, int y) const
+    {
+        return size_t(y) * size_t(dims[0]) + size_t(x);
+    }
+
+    inline size_t cellIndex(int x, int y, int z) const
+    {
+        return (size_t(z) * size_t(dims[1]) + size_t(y)) * size_t(dims[0]) + size_t(x);
+    }
+
+    inline double cellCenter(int axis, int index) const
+    {
+        return origin[axis] + (index + .5) * cellSize;
+    }
+
+    /**
+     * Calls @a func with consecutive ranges of [0, count) in parallel tasks. The first
+     * range is processed in the calling thread.
+     */
+    template <typename Func>
+    static void parallelFor(int count, int taskCount, const Func &func)
+    {
+        taskCount = std::max(1, std::min(taskCount, count));
+        if (taskCount == 1)
+        {
+            func(0, count);
+            return;
+        }
+        de::TaskPool tasks;
+        for (int i = 1; i < taskCount; ++i)
+        {
+            const int begin = int(long(count) * i / taskCount);
+            const int end   = int(long(count) * (i + 1) / taskCount);
+            tasks.start([&func, begin, end] () { func(begin, end); });
+        }
+        func(0, int(long(count) / taskCount));
+        tasks.waitForDone();
+    }
+
+    /**
+     * Adds the light of a static source to the cells of its region.
+     *
+     * @param factor  Multiplier for the light's color; -1 removes a previously added light.
+     */
+    void addLight(const Light &light, int region, int zBegin, int zEnd, float factor = 1)
+    {
+        int lo[3], hi[3];
+        for (int a = 0; a < 3; ++a)
+        {
+            lo[a] = std::max(0, int(std::floor((light.origin[a] - light.radius - origin[a]) / cellSize)));
+            hi[a] = std::min(dims[a] - 1, int(std::floor((light.origin[a] + light.radius - origin[a]) / cellSize)));
+        }
+        lo[2] = std::max(lo[2], zBegin);
+        hi[2] = std::min(hi[2], zEnd - 1);
+
+        for (int z = lo[2]; z <= hi[2]; ++z)
+        for (int y = lo[1]; y <= hi[1]; ++y)
+        for (int x = lo[0]; x <= hi[0]; ++x)
+        {
+            if (columnRegions[columnIndex(x, y)] != region) continue;
+
+            const double dx = cellCenter(0, x) - light.origin[0];
+            const double dy = cellCenter(1, y) - light.origin[1];
+            const double dz = cellCenter(2, z) - light.origin[2];
+            const double dist = std::sqrt(dx*dx + dy*dy + dz*dz);
+
+            // Same falloff as the vector lights of luminous objects.
+            const float intensity = std::min(1.f, std::max(0.f, float(1 - dist / light.radius) * 2));
+            if (intensity < .05f) continue;
+
+            float *cell = &staticLight[cellIndex(x, y, z) * 3];
+            for (int c = 0; c < 3; ++c)
+            {
+                cell[c] += light.color[c] * intensity * factor;
+            }
+        }
+    }
+};
+
+AmbientLightGrid::AmbientLightGrid()
+    : d(new Impl)
+{}
+
+AmbientLightGrid::~AmbientLightGrid()
+{}
+
+void AmbientLightGrid::bake(const Bounds &bounds, double cellSize, int regionCount,
+                            const MapInfo &map, const std::vector<Light> &lights, int threadCount)
+{
+    clear();
+
+    // Choose the dimensions.
+    double size = std::max(1.0, cellSize);
+    for (;;)
+    {
+        size_t total = 1;
+        for (int a = 0; a < 3; ++a)
+        {
+            const double extent = std::max(0.0, bounds.max[a] - bounds.min[a]);
+            d->dims[a] = std::max(1, int(std::ceil(extent / size)));
+            total *= size_t(d->dims[a]);
+        }
+        if (total <= AMBIENTGRID_MAX_CELLS) break;
+        size *= 1.25;
+    }
+    d->cellSize = size;
+    for (int a = 0; a < 3; ++a)
+    {
+        d->origin[a] = bounds.min[a];
+    }
+
+    if (threadCount <= 0)
+    {
+        threadCount = std::max(1, int(std::thread::hardware_concurrency()));
+    }
+
+    // Find out which region each column is in.
+    d->columnRegions.resize(size_t(d->dims[0]) * size_t(d->dims[1]));
+    Impl::parallelFor(d->dims[1], threadCount, [this, &map, regionCount] (int begin, int end)
+    {
+        for (int y = begin; y < end; ++y)
+        for (int x = 0; x < d->dims[0]; ++x)
+        {
+            int region = map.regionAt(d->cellCenter(0, x), d->cellCenter(1, y));
+            if (region >= regionCount) region = -1;
+            d->columnRegions[d->columnIndex(x, y)] = region;
+        }
+    });
+
+    d->regionLight.assign(size_t(std::max(0, regionCount)) * 3, 0.f);
+
+    // Bake the static lights. Each thread processes its own layers of cells.
+    std::vector<int> lightRegions;
+    for (const Light &light : lights)
+    {
+        const int region = map.regionAt(light.origin[0], light.origin[1]);
+        lightRegions.push_back(light.radius > 0 && region < regionCount? region : -1);
+    }
+    d->staticLight.assign(cellCount() * 3, 0.f);
+    Impl::parallelFor(d->dims[2], threadCount, [this, &lights, &lightRegions] (int begin, int end)
+    {
+        for (size_t i = 0; i < lights.size(); ++i)
+        {
+            if (lightRegions[i] < 0) continue;
+            d->addLight(lights[i], lightRegions[i], begin, end);
+        }
+    });
+    d->regionCount = regionCount;
+}
+
+void AmbientLightGrid::updateLights(const MapInfo &map, const std::vector<Light> &removed,
+                                    const std::vector<Light> &added)
+{
+    if (!isBaked()) return;
+
+    auto apply = [this, &map] (const std::vector<Light> &lights, float factor)
+    {
+        for (const Light &light : lights)
+        {
+            const int region = map.regionAt(light.origin[0], light.origin[1]);
+            if (light.radius <= 0 || region < 0 || region >= d->regionCount) continue;
+            d->addLight(light, region, 0, d->dims[2], factor);
+        }
+    };
+    apply(removed, -1);
+    apply(added, 1);
+}
+
+void AmbientLightGrid::clear()
+{
+    d.reset(new Impl);
+}
+
+bool AmbientLightGrid::isBaked() const
+{
+    return !d->columnRegions.empty();
+}
+
+double AmbientLightGrid::cellSize() const
+{
+    return d->cellSize;
+}
+
+size_t AmbientLightGrid::cellCount() const
+{
+    return size_t(d->dims[0]) * size_t(d->dims[1]) * size_t(d->dims[2]);
+}
+
+void AmbientLightGrid::setRegionLight(int region, const float rgb[3])
+{
+    if (region < 0 || size_t(region) * 3 >= d->regionLight.size()) return;
+
+    float *light = &d->regionLight[size_t(region) * 3];
+    light[0] = rgb[0];
+    light[1] = rgb[1];
+    light[2] = rgb[2];
+}
+
+void AmbientLightGrid::evaluate(const double point[3], float rgb[3]) const
+{
+    rgb[0] = rgb[1] = rgb[2] = 0;
+    if (!isBaked()) return;
+
+    // Cells on both sides of the point on each axis, and the weight of the second one.
+    int lo[3], hi[3];
+    float t[3];
+    for (int a = 0; a < 3; ++a)
+    {
+        double pos = (point[a] - d->origin[a]) / d->cellSize - .5;
+        pos   = std::min(std::max(pos, 0.0), double(d->dims[a] - 1));
+        lo[a] = int(pos);
+        hi[a] = std::min(lo[a] + 1, d->dims[a] - 1);
+        t[a]  = float(pos - lo[a]);
+    }
+
+    float sum[3] = {0, 0, 0};
+    float weightSum = 0;
+    auto accumulate = [&] (bool ignoreWeights)
+    {
+        for (int j = 0; j < 2; ++j)
+        for (int i = 0; i < 2; ++i)
+        {
+            const int x = i? hi[0] : lo[0];
+            const int y = j? hi[1] : lo[1];
+            const int region = d->columnRegions[d->columnIndex(x, y)];
+            const float weight = ignoreWeights? 1.f : (i? t[0] : 1 - t[0]) * (j? t[1] : 1 - t[1]);
+            if (region < 0 || weight <= 0) continue;
+
+            const float *regionLight = &d->regionLight[size_t(region) * 3];
+            const float *lower = &d->staticLight[d->cellIndex(x, y, lo[2]) * 3];
+            const float *upper = &d->staticLight[d->cellIndex(x, y, hi[2]) * 3];
+            for (int c = 0; c < 3; ++c)
+            {
+                sum[c] += weight * (regionLight[c] + lower[c] * (1 - t[2]) + upper[c] * t[2]);
+            }
+            weightSum += weight;
+        }
+    };
+    accumulate(false);
+    if (weightSum <= 0)
+    {
+        // The nearest cells are outside the map; use whichever are inside.
+        accumulate(true);
+    }
+
+    if (weightSum > 0)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            rgb[c] = sum[c] / weightSum;
+        }
+    }
+}
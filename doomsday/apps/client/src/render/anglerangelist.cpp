@@ -0,0 +1,185 @@
+/** @file anglerangelist.cpp  Sorted lists of angle ranges for the angle clipper.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "render/anglerangelist.h"
+
+#include <algorithm>
+
+void ClipRangeList::clear()
+{
+    _ranges.clear();
+}
+
+void ClipRangeList::add(binangle_t from, binangle_t to)
+{
+    // The ranges don't overlap, so the ends are sorted as well. Find the ranges that
+    // overlap or touch the new one.
+    auto first = std::lower_bound(_ranges.begin(), _ranges.end(), from,
+                                  [] (const AngleRange &range, binangle_t angle) {
+        return range.to < angle;
+    });
+    auto last = std::upper_bound(first, _ranges.end(), to,
+                                 [] (binangle_t angle, const AngleRange &range) {
+        return angle < range.from;
+    });
+
+    if (first == last)
+    {
+        // Disconnected from the others.
+        _ranges.insert(first, AngleRange(from, to));
+        return;
+    }
+
+    // Merge everything into the first overlapped range.
+    first->from = std::min(first->from, from);
+    first->to   = std::max((last - 1)->to, to);
+    _ranges.erase(first + 1, last);
+}
+
+bool ClipRangeList::contains(binangle_t from, binangle_t to) const
+{
+    // Only the last range that starts before the given range can contain it.
+    auto found = std::upper_bound(_ranges.begin(), _ranges.end(), from,
+                                  [] (binangle_t angle, const AngleRange &range) {
+        return angle < range.from;
+    });
+    if (found == _ranges.begin()) return false;
+    return to <= (found - 1)->to;
+}
+
+bool ClipRangeList::containsAngle(binangle_t angle) const
+{
+    auto found = std::lower_bound(_ranges.begin(), _ranges.end(), angle,
+                                  [] (const AngleRange &range, binangle_t a) {
+        return range.from < a;
+    });
+    if (found == _ranges.begin()) return false;
+    return angle < (found - 1)->to;
+}
+
+bool ClipRangeList::isFull() const
+{
+    return !_ranges.empty() && _ranges.front().from == 0 && _ranges.front().to == BANG_MAX;
+}
+
+//---------------------------------------------------------------------------------------
+
+void OcclusionRangeList::clear()
+{
+    _occluders.clear();
+}
+
+void OcclusionRangeList::add(const Occluder &occluder)
+{
+    // Is the range valid?
+    if (occluder.from > occluder.to) return;
+
+    // Add after the ranges that start at the same angle.
+    auto pos = std::upper_bound(_occluders.begin(), _occluders.end(), occluder.from,
+                                [] (binangle_t angle, const Occluder &other) {
+        return angle < other.from;
+    });
+    _occluders.insert(pos, occluder);
+}
+
+void OcclusionRangeList::cut(binangle_t from, binangle_t to, MergeFunc merge)
+{
+    // Ranges cut in two are split at the end of the cut range, so the latter parts are
+    // inserted after the last range that starts before that. This keeps the ranges
+    // sorted by start angle.
+    size_t insertPos = size_t(std::lower_bound(_occluders.begin(), _occluders.end(), to,
+                                               [] (const Occluder &orange, binangle_t angle) {
+        return orange.from < angle;
+    }) - _occluders.begin());
+
+    for (size_t i = 0; i < _occluders.size(); )
+    {
+        Occluder &orange = _occluders[i];
+
+        // Does the cut range include this orange?
+        if (from <= orange.to)
+        {
+            // No more cuts possible?
+            if (orange.from >= to) break;
+
+            switch (orange.relationship(AngleRange(from, to)))
+            {
+            case 0:  // The cut range completely includes this orange.
+                _occluders.erase(_occluders.begin() + long(i));
+                if (i < insertPos) insertPos--;
+                continue;
+
+            case 1:  // The cut range contains the beginning of the orange.
+                orange.from = to;
+                break;
+
+            case 2:  // The cut range contains the end of the orange.
+                orange.to = from;
+                break;
+
+            case 3: {  // The orange contains the whole cut range.
+                Occluder part = orange;
+                part.from = to;
+                orange.to = from;
+                _occluders.insert(_occluders.begin() + long(insertPos), part);
+                break; }
+
+            default:  // No meaningful relationship (in this context).
+                break;
+            }
+        }
+        ++i;
+    }
+
+    mergeEqualRanges(merge);
+}
+
+void OcclusionRangeList::mergeEqualRanges(MergeFunc merge)
+{
+    // Quite a number of ranges with matching ends may be produced as a result of cuts.
+    for (size_t i = 0; i + 1 < _occluders.size(); )
+    {
+        size_t next = i + 1;
+        for (size_t k = i + 1; k < _occluders.size() && _occluders[k].from == _occluders[i].from; ++k)
+        {
+            const Occluder &orange = _occluders[i];
+            const Occluder &other  = _occluders[k];
+            if (other.topHalf != orange.topHalf) continue;
+            if (other.to != orange.to) continue;
+
+            // It is a candidate for merging.
+            switch (merge(orange, other))
+            {
+            case 1:
+                _occluders.erase(_occluders.begin() + long(i));
+                next = i;
+                break;
+
+            case 2:
+                _occluders.erase(_occluders.begin() + long(k));
+                break;
+
+            default:
+                break;
+            }
+            break;
+        }
+        i = next;
+    }
+}
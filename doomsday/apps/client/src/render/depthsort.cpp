@@ -0,0 +1,126 @@
+/** @file depthsort.cpp  Linear-time back-to-front ordering of depth-sorted items.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "render/depthsort.h"
+
+#include <algorithm>
+#include <cstring>
+
+static const int DEPTHSORT_DIGIT_BITS  = 11;
+static const int DEPTHSORT_BUCKETS     = 1 << DEPTHSORT_DIGIT_BITS;
+static const int DEPTHSORT_PASSES      = (64 + DEPTHSORT_DIGIT_BITS - 1) / DEPTHSORT_DIGIT_BITS;
+static const uint32_t DEPTHSORT_SMALL  = 64; ///< Insertion sort is faster below this.
+
+/**
+ * Converts a depth value to an unsigned integer with the same ordering, farthest
+ * first. The exact value is used so that the ordering is the same as when comparing
+ * the depths directly.
+ */
+static inline uint64_t depthSortKey(double depth)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    // Flip negative values so that they compare correctly as integers.
+    bits = (bits & 0x8000000000000000ull)? ~bits : (bits | 0x8000000000000000ull);
+    // Farthest first.
+    return ~bits;
+}
+
+const std::vector<uint32_t> &DepthSorter::sort(const double *depths, uint32_t count)
+{
+    _keys.resize(count);
+    _order.resize(count);
+
+    // The keys are sorted in ascending order; equal keys must end up in descending
+    // index order, so the items are processed starting from the last one.
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const uint32_t index = count - 1 - i;
+        _keys[i]  = depthSortKey(depths[index]);
+        _order[i] = index;
+    }
+
+    if (count < DEPTHSORT_SMALL)
+    {
+        // Stable insertion sort.
+        for (uint32_t i = 1; i < count; ++i)
+        {
+            const uint64_t key   = _keys[i];
+            const uint32_t index = _order[i];
+            uint32_t j = i;
+            for (; j > 0 && _keys[j - 1] > key; --j)
+            {
+                _keys[j]  = _keys[j - 1];
+                _order[j] = _order[j - 1];
+            }
+            _keys[j]  = key;
+            _order[j] = index;
+        }
+        return _order;
+    }
+
+    // Least significant digit first radix sort. Histograms for all digits are
+    // counted in a single pass over the keys.
+    _histograms.assign(DEPTHSORT_PASSES * DEPTHSORT_BUCKETS, 0);
+    for (uint64_t key : _keys)
+    {
+        for (int pass = 0; pass < DEPTHSORT_PASSES; ++pass)
+        {
+            const uint32_t digit = uint32_t(key >> (pass * DEPTHSORT_DIGIT_BITS)) &
+                                   (DEPTHSORT_BUCKETS - 1);
+            _histograms[pass * DEPTHSORT_BUCKETS + digit]++;
+        }
+    }
+
+    _tempKeys.resize(count);
+    _tempOrder.resize(count);
+
+    for (int pass = 0; pass < DEPTHSORT_PASSES; ++pass)
+    {
+        uint32_t *counts = &_histograms[pass * DEPTHSORT_BUCKETS];
+        const int shift  = pass * DEPTHSORT_DIGIT_BITS;
+
+        // Passes where all the keys have the same digit can be skipped. Depths tend
+        // to be in a narrow range, so the most significant digits are often equal.
+        if (counts[uint32_t(_keys[0] >> shift) & (DEPTHSORT_BUCKETS - 1)] == count)
+        {
+            continue;
+        }
+
+        // Starting offsets of the buckets.
+        uint32_t offset = 0;
+        for (int i = 0; i < DEPTHSORT_BUCKETS; ++i)
+        {
+            const uint32_t n = counts[i];
+            counts[i] = offset;
+            offset += n;
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const uint64_t key = _keys[i];
+            const uint32_t pos = counts[uint32_t(key >> shift) & (DEPTHSORT_BUCKETS - 1)]++;
+            _tempKeys[pos]  = key;
+            _tempOrder[pos] = _order[i];
+        }
+        _keys.swap(_tempKeys);
+        _order.swap(_tempOrder);
+    }
+    return _order;
+}
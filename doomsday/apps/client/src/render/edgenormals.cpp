@@ -0,0 +1,61 @@
+/** @file edgenormals.cpp  Cached smoothed wall edge normals of a line side.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "render/edgenormals.h"
+
+static const int EDGENORMALS_BANG_45  = 0x2000;
+static const int EDGENORMALS_BANG_180 = 0x8000;
+
+EdgeNormals::Normal EdgeNormals::smooth(const Normal &normal, const Normal *blendNormal,
+                                        uint16_t angleDiff)
+{
+    /// @todo Should be user customizable with a Material property. -ds
+    if (!blendNormal || angleDiff < EDGENORMALS_BANG_180 - EDGENORMALS_BANG_45 ||
+        angleDiff > EDGENORMALS_BANG_180 + EDGENORMALS_BANG_45)
+    {
+        return normal;
+    }
+    // Average normals.
+    return Normal {{ (normal[0] + (*blendNormal)[0]) / 2,
+                     (normal[1] + (*blendNormal)[1]) / 2,
+                     (normal[2] + (*blendNormal)[2]) / 2 }};
+}
+
+void EdgeNormals::invalidateAroundLine(const Topology &map, Topology::Line line)
+{
+    auto invalidateLine = [&map] (Topology::Line other)
+    {
+        map.normals(other, 0).invalidate();
+        map.normals(other, 1).invalidate();
+    };
+
+    invalidateLine(line);
+    for (int to = 0; to < 2; ++to)
+    {
+        map.forAllLinesAtVertex(line, to, invalidateLine);
+    }
+}
+
+void EdgeNormals::invalidateAroundSector(const Topology &map, Topology::Sector sector)
+{
+    map.forAllSectorLines(sector, [&map] (Topology::Line line)
+    {
+        invalidateAroundLine(map, line);
+    });
+}
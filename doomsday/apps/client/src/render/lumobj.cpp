@@ -27,6 +27,7 @@
 #include "render/rend_halo.h"
 #include "render/vissprite.h"
 
+#include "world/contactspreader.h"
 #include "world/map.h"
 
 using namespace de;
@@ -34,6 +35,21 @@ using namespace de;
 static dint radiusMax     = 320;    ///< Absolute maximum lumobj radius (cvar).
 static dfloat radiusScale = 5.2f;  ///< Radius scale factor (cvar).
 
+Lumobj::Source::Source()
+{}
+
+Lumobj::Source::~Source()
+{}
+
+ContactSpreadCache &Lumobj::Source::contactSpreadCache() const
+{
+    if (!_contactSpreadCache)
+    {
+        _contactSpreadCache.reset(new ContactSpreadCache);
+    }
+    return *_contactSpreadCache;
+}
+
 dfloat Lumobj::Source::occlusion(const Vec3d & /*eye*/) const
 {
     return 1;  // Fully visible.
@@ -88,6 +104,11 @@ void Lumobj::setSource(const Source *newSource)
     d->source = newSource;
 }
 
+const Lumobj::Source *Lumobj::source() const
+{
+    return d->source;
+}
+
 void Lumobj::setSourceMobj(const mobj_t *mo)
 {
     d->sourceMobj = mo;
@@ -113,12 +113,11 @@ static void setupPSpriteParams(rendpspriteparams_t &parm, const vispsprite_t &vs
     else
     {
         DE_ASSERT(vs.bspLeaf);
-#if 0
-        const world::Map &map = ClientApp::world().map();
-        if (useBias && map.hasLightGrid())
+        const Map &map = vs.bspLeaf->map().as<Map>();
+        if (useLightGrid && map.hasLightGrid())
         {
             // Evaluate the position in the light grid.
-            Vec4f color = map.lightGrid().evaluate(vs.origin);
+            Vec3f color = map.evaluateLightGrid(vs.origin);
 
             // Apply light range compression.
             for (int i = 0; i < 3; ++i)
@@ -129,7 +128,6 @@ static void setupPSpriteParams(rendpspriteparams_t &parm, const vispsprite_t &vs
             V3f_Set(parm.ambientColor, color.x, color.y, color.z);
         }
         else
-#endif
         {
             const auto &subsec   = vs.bspLeaf->subspace().subsector().as<Subsector>();
             const Vec4f color = subsec.lightSourceColorfIntensity();
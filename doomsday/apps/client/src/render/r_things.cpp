@@ -66,12 +66,11 @@ static void evaluateLighting(const Vec3d &origin, ConvexSubspace &subspaceAtOrig
     {
         auto &subsec = subspaceAtOrigin.subsector().as<Subsector>();
 
-#if 0
-        Map &map = subsec.sector().map();
-        if(useBias && map.hasLightGrid())
+        const Map &map = subsec.sector().map().as<Map>();
+        if(useLightGrid && map.hasLightGrid())
         {
             // Evaluate the position in the light grid.
-            Vec4f color = map.lightGrid().evaluate(origin);
+            Vec3f color = map.evaluateLightGrid(origin);
             // Apply light range compression.
             for(dint i = 0; i < 3; ++i)
             {
@@ -80,7 +79,6 @@ static void evaluateLighting(const Vec3d &origin, ConvexSubspace &subspaceAtOrig
             ambientColor = color;
         }
         else
-#endif
         {
             const Vec4f color = subsec.lightSourceColorfIntensity();
 
@@ -108,20 +106,6 @@ static void evaluateLighting(const Vec3d &origin, ConvexSubspace &subspaceAtOrig
     }
 }
 
-/// @todo use Mobj_OriginSmoothed
-static Vec3d mobjOriginSmoothed(mobj_t *mob)
-{
-    DE_ASSERT(mob);
-    coord_t origin[] = { mob->origin[0], mob->origin[1], mob->origin[2] };
-
-    // The client may have a Smoother for this object.
-    if(netState.isClient && mob->dPlayer && P_GetDDPlayerIdx(mob->dPlayer) != consolePlayer)
-    {
-        Smoother_Evaluate(DD_Player(P_GetDDPlayerIdx(mob->dPlayer))->smoother(), origin);
-    }
-
-    return Vec3d(origin);
-}
 
 /**
  * Determine the correct Z coordinate for the mobj. The visible Z coordinate
@@ -173,7 +157,12 @@ void R_ProjectSprite(mobj_t &mob)
     const ClientMobjThinkerData *mobjData = THINKER_DATA_MAYBE(mob.thinker, ClientMobjThinkerData);
 
     // Determine distance to object.
-    const Vec3d moPos = mobjOriginSmoothed(&mob);
+    // The short range visual offset is applied below, unless the origin is already
+    // interpolated from the states received from the server. The console player's
+    // own body is drawn at its origin rather than at the camera (e.g., in chasecam).
+    coord_t smoothedOrigin[3];
+    const bool interpolated = Mobj_OriginSmoothed(&mob, smoothedOrigin, false, false);
+    const Vec3d moPos(smoothedOrigin);
     const coord_t distFromEye = Rend_PointDist2D(moPos);
 
     // Should we use a 3D model?
@@ -354,7 +343,7 @@ void R_ProjectSprite(mobj_t &mob)
 
     // Determine possible short-range visual offset.
     Vec3d visOff;
-    if((hasModel && useSRVO > 0) || (!hasModel && useSRVO > 1))
+    if(!interpolated && ((hasModel && useSRVO > 0) || (!hasModel && useSRVO > 1)))
     {
         if(mob.tics >= 0)
         {
@@ -886,9 +886,6 @@ void Rend_DrawWallRadio(const WallEdge &leftEdge, const WallEdge &rightEdge, flo
     if(shadowSize < MIN_SHADOW_SIZE)
         return;
 
-    // Ensure we have up-to-date information for generating shadow geometry.
-    leftEdge.lineSide().updateRadioForFrame(R_FrameCount());
-
     Vec3f const posCoords[] = {
         leftEdge .bottom().origin(),
         leftEdge .top   ().origin(),
@@ -896,6 +893,25 @@ void Rend_DrawWallRadio(const WallEdge &leftEdge, const WallEdge &rightEdge, flo
         rightEdge.top   ().origin()
     };
 
+    // The shadows cover the wall section; skip it entirely if it is outside the view.
+    ::shadowCullStats.radioWalls++;
+    {
+        Vec3f min = posCoords[0], max = posCoords[0];
+        for (const Vec3f &pos : posCoords)
+        {
+            min = min.min(pos);
+            max = max.max(pos);
+        }
+        if (!Rend_IsBoxInViewFrustum(min, max))
+        {
+            ::shadowCullStats.radioWallsCulled++;
+            return;
+        }
+    }
+
+    // Ensure we have up-to-date information for generating shadow geometry.
+    leftEdge.lineSide().updateRadioForFrame(R_FrameCount());
+
     ProjectedShadowData projected;
 
     if(projectWallShadow(leftEdge, rightEdge, TopShadow, shadowSize, projected))
@@ -1062,6 +1078,17 @@ void Rend_DrawFlatRadio(const ConvexSubspace &subspace)
                 if (Vec3f(eyeToSubspace, Rend_EyeOrigin().y - plane.heightSmoothed())
                          .dot(plane.surface().normal()) >= 0)
                 {
+                    // Skip shadows outside the view.
+                    ::shadowCullStats.radioFlatEdges++;
+                    const AABoxd &bounds = side.shadowBounds();
+                    const double height  = plane.heightSmoothed();
+                    if (!Rend_IsBoxInViewFrustum(Vec3d(bounds.minX, bounds.minY, height),
+                                                 Vec3d(bounds.maxX, bounds.maxY, height)))
+                    {
+                        ::shadowCullStats.radioFlatEdgesCulled++;
+                        continue;
+                    }
+
                     const mesh::HEdge *hEdges[2/*left, right*/] = { side.leftHEdge(), side.leftHEdge() };
 
                     if (prepareFlatShadowEdges(shadowEdges, hEdges, pln, shadowDark))
@@ -24,6 +24,7 @@
 
 #include "resource/materialvariantspec.h"
 #include "resource/clienttexture.h"
+#include "resource/texturecontentcache.h"
 
 #include "world/map.h"
 #include "world/p_object.h"
@@ -41,6 +42,7 @@
 #include "render/trianglestripbuilder.h"
 #include "render/walledge.h"
 
+#include "gl/gl_defer.h"  // glDeferredUploadBudget
 #include "gl/gl_main.h"
 #include "gl/gl_tex.h"  // pointlight_analysis_t
 #include "gl/gl_texmanager.h"
@@ -57,6 +59,7 @@
 #include "render/modelrenderer.h"
 #include "render/r_main.h"
 #include "render/r_things.h"
+#include "render/renderbench.h"
 #include "render/rendersystem.h"
 #include "render/rend_fakeradio.h"
 #include "render/rend_halo.h"
@@ -64,6 +67,7 @@
 #include "render/rendpoly.h"
 #include "render/skydrawable.h"
 #include "render/store.h"
+#include "render/viewfrustum.h"
 #include "render/viewports.h"
 #include "render/vissprite.h"
 #include "render/vr.h"
@@ -98,6 +102,7 @@
 #include <de/legacy/vector1.h>
 #include <de/glinfo.h>
 #include <de/glstate.h>
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -156,6 +161,7 @@ D_CMD(TexReset);
 D_CMD(CubeShot);
 
 FogParams fogParams;
+ShadowCullStats shadowCullStats;
 float fieldOfView = 95.0f;
 dbyte smoothTexAnim = true;
 
@@ -185,6 +191,7 @@ int shadowMaxRadius = 80;
 int shadowMaxDistance = 1000;
 
 dbyte useLightDecorations = true;  ///< cvar
+dbyte useLightGrid;                ///< cvar: Light objects with the baked ambient light grid.
 
 float detailFactor = .5f;
 float detailScale = 4;
@@ -195,7 +202,7 @@ int texQuality = TEXQ_BEST;
 
 int ratioLimit;      ///< Zero if none.
 dd_bool fillOutlines = true;
-int useSmartFilter;  ///< Smart filter mode (cvar: 1=hq2x)
+int useSmartFilter;  ///< Smart filter mode (cvar: 1=hq2x, 2=hq4x for small textures)
 int filterSprites = true;
 int texMagMode = 1;  ///< Linear.
 int texAniso = -1;   ///< Use best.
@@ -231,6 +238,8 @@ struct FixedView
 };
 static std::unique_ptr<FixedView> fixedView;
 
+static ViewFrustum viewFrustum;  ///< Of the view being drawn.
+
 dbyte freezeRLs;
 int devNoCulling;  ///< @c 1= disabled (cvar).
 int devRendSkyMode;
@@ -295,7 +304,10 @@ dbyte devNoTexFix;               ///< @c 1= Draw "missing" rather than fix mater
 dbyte devSectorIndices;          ///< @c 1= Draw sector indicies.
 dbyte devThinkerIds;             ///< @c 1= Draw (mobj) thinker indicies.
 
+dbyte devSortLists = true;       ///< @c 1= Group draw lists by texture before drawing.
+
 dbyte rendInfoLums;              ///< @c 1= Print lumobj debug info to the console.
+dbyte rendInfoShadows;           ///< @c 1= Print shadow culling counts to the console.
 dbyte devDrawLums;               ///< @c 1= Draw lumobjs origins.
 
 #if 0
@@ -321,6 +333,17 @@ static Vec3f curSectorLightColor;
 static float curSectorLightLevel;
 static bool firstSubspace;            ///< No range checking for the first one.
 
+/**
+ * A subspace found visible while traversing the BSP, with the state its geometry
+ * depends on at that point of the traversal.
+ */
+struct VisibleSubspace
+{
+    ConvexSubspace *subspace;
+    double skyCeilingHeight;          ///< May be raised when projecting sprites.
+};
+static List<VisibleSubspace> visibleSubspaces; ///< In front-to-back order.
+
 using MaterialAnimatorLookup = Hash<const Record *, MaterialAnimator *>;
 
 // State lookup (for speed):
@@ -431,6 +454,13 @@ Vec3d Rend_EyeOrigin()
     return vEyeOrigin;
 }
 
+bool Rend_IsBoxInViewFrustum(const Vec3d &min, const Vec3d &max)
+{
+    const double minCorner[3] = { min.x, min.y, min.z };
+    const double maxCorner[3] = { max.x, max.y, max.z };
+    return viewFrustum.isBoxVisible(minCorner, maxCorner);
+}
+
 void Rend_SetFixedView(int consoleNum, float yaw, float pitch, float fov, Vec2f viewportSize)
 {
     const viewdata_t *viewData = &DD_Player(consoleNum)->viewport();
@@ -1383,6 +1413,19 @@ struct rendworldpoly_params_t
     } wall;
 };
 
+/**
+ * Determines whether a world poly is drawn as opaque geometry rather than as a masked
+ * vissprite. The occlusion of the visibility pass depends on this, so it must agree
+ * with renderWorldPoly().
+ *
+ * @pre The material animator has been prepared.
+ */
+static bool worldPolyIsOpaque(bool forceOpaque, bool skyMasked, float alpha,
+    blendmode_t blendMode, const MaterialAnimator &matAnimator)
+{
+    return forceOpaque || skyMasked || !(!matAnimator.isOpaque() || alpha < 1 || blendMode > 0);
+}
+
 static bool renderWorldPoly(const Vec3f *rvertices, uint32_t numVertices,
     const rendworldpoly_params_t &p, MaterialAnimator &matAnimator)
 {
@@ -1399,7 +1442,7 @@ static bool renderWorldPoly(const Vec3f *rvertices, uint32_t numVertices,
     const bool skyMaskedMaterial        = (p.skyMasked || (matAnimator.material().isSkyMasked()));
 
     // Masked polys (walls) get a special treatment (=> vissprite).
-    const bool drawAsVisSprite          = (!p.forceOpaque && !p.skyMasked && (!matAnimator.isOpaque() || p.alpha < 1 || p.blendMode > 0));
+    const bool drawAsVisSprite          = !worldPolyIsOpaque(p.forceOpaque, p.skyMasked, p.alpha, p.blendMode, matAnimator);
 
     // Map RTU configuration.
     const GLTextureUnit *layer0RTU      = (!p.skyMasked)? &matAnimator.texUnit(MaterialAnimator::TU_LAYER0) : nullptr;
@@ -2174,6 +2217,8 @@ static DGLuint prepareLightmap(ClientTexture *tex = nullptr)
     {
         if (TextureVariant *variant = tex->prepareVariant(Rend_MapSurfaceLightmapTextureSpec()))
         {
+            // The GL-name is kept by the lumobj.
+            variant->pin();
             return variant->glName();
         }
         // Dang...
@@ -2316,6 +2361,20 @@ static bool projectShadow(const Vec3d &topLeft, const Vec3d &bottomRight,
     coord_t mobHeight = mob.height;
     if (!mobHeight) mobHeight = 1;
 
+    // Is the part of the surface that may receive the shadow outside the view?
+    shadowCullStats.mobjShadows++;
+    {
+        const Vec3d reach(shadowRadius, shadowRadius, mobHeight);
+        const Vec3d min = (Vec3d(mobOrigin) - reach).max(topLeft.min(bottomRight));
+        const Vec3d max = (Vec3d(mobOrigin) + reach).min(topLeft.max(bottomRight));
+        if (min.x <= max.x && min.y <= max.y && min.z <= max.z &&
+            !Rend_IsBoxInViewFrustum(min, max))
+        {
+            shadowCullStats.mobjShadowsCulled++;
+            return false;
+        }
+    }
+
     // If this were a light this is where we would check whether the origin is on
     // the right side of the surface. However this is a shadow and light is moving
     // in the opposite direction (inward toward the mobj's origin), therefore this
@@ -2568,8 +2627,12 @@ uint32_t Rend_CollectAffectingLights(const Vec3d &point, const Vec3f &ambientCol
     {
         // Interpret lighting from luminous-objects near the origin and which
         // are in contact the specified subspace and add them to the identified list.
-        R_ForAllSubspaceLumContacts(subspace->as<ConvexSubspace>(), [&point, &lightListIdx] (Lumobj &lum)
+        const bool useGrid = ::useLightGrid && subspace->map().as<Map>().hasLightGrid();
+        R_ForAllSubspaceLumContacts(subspace->as<ConvexSubspace>(), [&point, &lightListIdx, useGrid] (Lumobj &lum)
         {
+            // Light from static sources is already included in the light grid.
+            if (useGrid && lum.source()) return LoopContinue;
+
             VectorLightData vlight;
             if (lightWithLumobj(point, lum, vlight))
             {
@@ -2688,39 +2751,76 @@ static void wallLuminosityDeltas(const WallEdge &leftEdge, const WallEdge &right
     }
 }
 
-static void writeWall(const WallEdge &leftEdge, const WallEdge &rightEdge,
-    bool *retWroteOpaque = nullptr, coord_t *retBottomZ = nullptr, coord_t *retTopZ = nullptr)
-{
-    DE_ASSERT(leftEdge.lineSideSegment().isFrontFacing() && leftEdge.lineSide().hasSections());
-
-    if (retWroteOpaque) *retWroteOpaque = false;
-    if (retBottomZ)     *retBottomZ     = 0;
-    if (retTopZ)        *retTopZ        = 0;
+/**
+ * How a wall section is drawn. Chosen by chooseWallSection().
+ */
+struct WallSection
+{
+    Surface *surface;
+    ClientMaterial *material;
+    float opacity;
+    bool didNearFade;
+    bool skyMasked;
+    bool twoSidedMiddle;
+    blendmode_t blendMode;
+};
 
-    auto &subsec = curSubspace->subsector().as<Subsector>();
-    Surface &surface = leftEdge.lineSide().surface(leftEdge.spec().section).as<Surface>();
+/**
+ * Chooses how the wall section between @a leftEdge and @a rightEdge is drawn. Both
+ * writeWall() and the occlusion of the visibility pass use this.
+ *
+ * @return  @c false if nothing is drawn.
+ */
+static bool chooseWallSection(const WallEdge &leftEdge, const WallEdge &rightEdge,
+    WallSection &ws)
+{
+    ws.surface = &leftEdge.lineSide().surface(leftEdge.spec().section).as<Surface>();
 
     // Skip nearly transparent surfaces.
-    float opacity = surface.opacity();
-    if (opacity < .001f)
-        return;
+    ws.opacity = ws.surface->opacity();
+    if (ws.opacity < .001f)
+        return false;
 
     // Determine which Material to use (a drawable material is required).
-    ClientMaterial *material = Rend_ChooseMapSurfaceMaterial(surface);
-    if (!material || !material->isDrawable())
-        return;
+    ws.material = Rend_ChooseMapSurfaceMaterial(*ws.surface);
+    if (!ws.material || !ws.material->isDrawable())
+        return false;
 
     // Do the edge geometries describe a valid polygon?
     if (!leftEdge.isValid() || !rightEdge.isValid()
         || de::fequal(leftEdge.bottom().z(), rightEdge.top().z()))
+        return false;
+
+    ws.didNearFade    = applyNearFadeOpacity(leftEdge, rightEdge, ws.opacity);
+    ws.skyMasked      = ws.material->isSkyMasked() && !::devRendSkyMode;
+    ws.twoSidedMiddle = (leftEdge.spec().section == LineSide::Middle && !leftEdge.lineSide().considerOneSided());
+
+    ws.blendMode = BM_NORMAL;
+    if (!ws.skyMasked && ws.twoSidedMiddle)
+    {
+        ws.blendMode = ws.surface->blendMode();
+        if (ws.blendMode == BM_NORMAL && noSpriteTrans)
+            ws.blendMode = BM_ZEROALPHA;  // "no translucency" mode
+    }
+    return true;
+}
+
+static void writeWall(const WallEdge &leftEdge, const WallEdge &rightEdge)
+{
+    DE_ASSERT(leftEdge.lineSideSegment().isFrontFacing() && leftEdge.lineSide().hasSections());
+
+    auto &subsec = curSubspace->subsector().as<Subsector>();
+
+    WallSection ws;
+    if (!chooseWallSection(leftEdge, rightEdge, ws))
         return;
 
+    Surface &surface              = *ws.surface;
     const WallSpec &wallSpec      = leftEdge.spec();
-    const bool didNearFade        = applyNearFadeOpacity(leftEdge, rightEdge, opacity);
-    const bool skyMasked          = material->isSkyMasked() && !::devRendSkyMode;
-    const bool twoSidedMiddle     = (wallSpec.section == LineSide::Middle && !leftEdge.lineSide().considerOneSided());
+    const bool skyMasked          = ws.skyMasked;
+    const bool twoSidedMiddle     = ws.twoSidedMiddle;
 
-    MaterialAnimator &matAnimator = material->getAnimator(Rend_MapSurfaceMaterialSpec());
+    MaterialAnimator &matAnimator = ws.material->getAnimator(Rend_MapSurfaceMaterialSpec());
     const Vec2f materialScale  = surface.materialScale();
     const Vec3f materialOrigin = leftEdge.materialOrigin();
     const Vec3d topLeft        = leftEdge .top   ().origin();
@@ -2733,7 +2833,7 @@ static void writeWall(const WallEdge &leftEdge, const WallEdge &rightEdge,
     parm.topLeft              = &topLeft;
     parm.bottomRight          = &bottomRight;
     parm.forceOpaque          = wallSpec.flags.testFlag(WallSpec::ForceOpaque);
-    parm.alpha                = parm.forceOpaque? 1 : opacity;
+    parm.alpha                = parm.forceOpaque? 1 : ws.opacity;
     parm.surfaceTangentMatrix = &surface.tangentMatrix();
     parm.blendMode            = BM_NORMAL;
     parm.materialOrigin       = &materialOrigin;
@@ -2773,12 +2873,7 @@ static void writeWall(const WallEdge &leftEdge, const WallEdge &rightEdge,
                         wallSpec.flags.testFlag(WallSpec::SortDynLights),
                         parm.lightListIdx, parm.shadowListIdx);
 
-        if (twoSidedMiddle)
-        {
-            parm.blendMode = surface.blendMode();
-            if (parm.blendMode == BM_NORMAL && noSpriteTrans)
-                parm.blendMode = BM_ZEROALPHA;  // "no translucency" mode
-        }
+        parm.blendMode = ws.blendMode;
 
         side.chooseSurfaceColors(wallSpec.section, &parm.surfaceColor, &parm.wall.surfaceColor2);
     }
@@ -2817,10 +2912,24 @@ static void writeWall(const WallEdge &leftEdge, const WallEdge &rightEdge,
         curSectorLightColor = color.toVec3f();
         curSectorLightLevel = color.w;
     }
+}
 
-    if (retWroteOpaque) *retWroteOpaque = wroteOpaque && !didNearFade;
-    if (retBottomZ)     *retBottomZ     = leftEdge .bottom().z();
-    if (retTopZ)        *retTopZ        = rightEdge.top   ().z();
+/**
+ * Determines whether writeWall() draws the wall section as opaque geometry that may
+ * occlude what is behind it. Walls faded out near the viewer never occlude.
+ */
+static bool wallSectionOccludes(const WallEdge &leftEdge, const WallEdge &rightEdge)
+{
+    WallSection ws;
+    if (!chooseWallSection(leftEdge, rightEdge, ws) || ws.didNearFade)
+        return false;
+
+    MaterialAnimator &matAnimator = ws.material->getAnimator(Rend_MapSurfaceMaterialSpec());
+    matAnimator.prepare();
+
+    const bool forceOpaque = leftEdge.spec().flags.testFlag(WallSpec::ForceOpaque);
+    return worldPolyIsOpaque(forceOpaque, ws.skyMasked, forceOpaque? 1 : ws.opacity,
+                             ws.blendMode, matAnimator);
 }
 
 /**
@@ -3419,22 +3528,42 @@ static void writeAllWalls(mesh::HEdge &hedge)
     // Done here because of the logic of doom.exe wrt the automap.
     reportWallDrawn(seg.line());
 
-    bool wroteOpaqueMiddle = false;
-    coord_t middleBottomZ  = 0;
-    coord_t middleTopZ     = 0;
-
     writeWall(WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Bottom), hedge, Line::From),
               WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Bottom), hedge, Line::To  ));
     writeWall(WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Top),    hedge, Line::From),
               WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Top),    hedge, Line::To  ));
     writeWall(WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Middle), hedge, Line::From),
-              WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Middle), hedge, Line::To  ),
-              &wroteOpaqueMiddle, &middleBottomZ, &middleTopZ);
+              WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Middle), hedge, Line::To  ));
+}
+
+/**
+ * Occludes the angle range of a wall segment in the angle clipper, if its middle
+ * section covers the open range.
+ */
+static void occludeWithWall(mesh::HEdge &hedge)
+{
+    // Edges without a map line segment implicitly have no surfaces.
+    if (!hedge.hasMapElement())
+        return;
+
+    // We are only interested in front facing segments with sections.
+    auto &seg = hedge.mapElementAs<LineSideSegment>();
+    if (!seg.isFrontFacing() || !seg.lineSide().hasSections())
+        return;
+
+    // Nothing is occluded when the viewer is in the void.
+    if (P_IsInVoid(viewPlayer))
+        return;
+
+    const WallEdge leftEdge (WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Middle), hedge, Line::From);
+    const WallEdge rightEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Middle), hedge, Line::To  );
+
+    const bool opaqueMiddle = wallSectionOccludes(leftEdge, rightEdge);
 
     // We can occlude the angle range defined by the X|Y origins of the
-    // line segment if the open range has been covered (when the viewer
-    // is not in the void).
-    if (!P_IsInVoid(viewPlayer) && coveredOpenRange(hedge, middleBottomZ, middleTopZ, wroteOpaqueMiddle))
+    // line segment if the open range has been covered.
+    if (coveredOpenRange(hedge, opaqueMiddle? leftEdge .bottom().z() : 0,
+                                opaqueMiddle? rightEdge.top   ().z() : 0, opaqueMiddle))
     {
         if (hedge.hasMapElement())
         {
@@ -3484,6 +3613,36 @@ static void writeSubspaceWalls()
     });
 }
 
+static void occludeWithSubspaceWalls()
+{
+    DE_ASSERT(::curSubspace);
+    auto *base  = ::curSubspace->poly().hedge();
+    DE_ASSERT(base);
+    auto *hedge = base;
+    do
+    {
+        occludeWithWall(*hedge);
+    } while ((hedge = &hedge->next()) != base);
+
+    ::curSubspace->forAllExtraMeshes([] (mesh::Mesh &mesh)
+    {
+        for (auto *hedge : mesh.hedges())
+        {
+            occludeWithWall(*hedge);
+        }
+        return LoopContinue;
+    });
+
+    ::curSubspace->forAllPolyobjs([] (Polyobj &pob)
+    {
+        for (auto *hedge : pob.mesh().hedges())
+        {
+            occludeWithWall(*hedge);
+        }
+        return LoopContinue;
+    });
+}
+
 static void writeSubspaceFlats()
 {
     DE_ASSERT(::curSubspace);
@@ -3745,9 +3904,14 @@ static void projectSubspaceSprites()
 }
 
 /**
+ * Performs the visibility work for the current subspace: the subspace is marked
+ * visible, its sprites are projected, and its walls are added to the angle clipper.
+ * The subspace is then added to the visible subspaces, whose geometry is written
+ * after the traversal (see drawVisibleSubspaces()).
+ *
  * @pre Assumes the subspace is at least partially visible.
  */
-static void drawCurrentSubspace()
+static void occludeCurrentSubspace()
 {
     DE_ASSERT(curSubspace);
 
@@ -3761,8 +3925,6 @@ static void drawCurrentSubspace()
     // Perform contact spreading for this map region.
     sector.map().as<Map>().spreadAllContacts(::curSubspace->poly().bounds());
 
-    Rend_DrawFlatRadio(*::curSubspace);
-
     // Before clip testing lumobjs (for halos), range-occlude the back facing edges.
     // After testing, range-occlude the front facing edges. Done before drawing wall
     // sections so that opening occlusions cut out unnecessary oranges.
@@ -3794,9 +3956,11 @@ static void drawCurrentSubspace()
     // of halos.
     projectSubspaceSprites();
 
-    writeSubspaceSkyMask();
-    writeSubspaceWalls();
-    writeSubspaceFlats();
+    occludeWithSubspaceWalls();
+
+    // Projecting sprites may have raised the sky ceiling; the geometry of this
+    // subspace is written with the sky as it is now.
+    ::visibleSubspaces << VisibleSubspace{ ::curSubspace, sector.map().as<Map>().skyCeiling().height() };
 }
 
 /**
@@ -3820,7 +3984,7 @@ static void makeCurrent(ConvexSubspace &subspace)
     }
 }
 
-static void traverseBspTreeAndDrawSubspaces(const world::BspTree *bspTree)
+static void traverseBspTreeAndFindVisibleSubspaces(const world::BspTree *bspTree)
 {
     DE_ASSERT(bspTree);
     const AngleClipper &clipper = ClientApp::render().angleClipper();
@@ -3833,7 +3997,7 @@ static void traverseBspTreeAndDrawSubspaces(const world::BspTree *bspTree)
         const int eyeSide  = bspNode.pointOnSide(eyeOrigin) < 0;
 
         // Recursively divide front space.
-        traverseBspTreeAndDrawSubspaces(bspTree->childPtr(world::BspTree::ChildId(eyeSide)));
+        traverseBspTreeAndFindVisibleSubspaces(bspTree->childPtr(world::BspTree::ChildId(eyeSide)));
 
         // If the clipper is full we're pretty much done. This means no geometry
         // will be visible in the distance because every direction has already
@@ -3861,15 +4025,40 @@ static void traverseBspTreeAndDrawSubspaces(const world::BspTree *bspTree)
             return;
 
         // This is now the current subspace.
-        makeCurrent(subspace->as<ConvexSubspace>());
+        ::curSubspace = &subspace->as<ConvexSubspace>();
 
-        drawCurrentSubspace();
+        occludeCurrentSubspace();
 
         // This is no longer the first subspace.
         ::firstSubspace = false;
     }
 }
 
+/**
+ * Writes the geometry of the visible subspaces, in the order they were found visible.
+ * The angle clipper is not used here.
+ */
+static void drawVisibleSubspaces(Map &map)
+{
+    ClSkyPlane &skyCeiling = map.skyCeiling();
+
+    ::curSubspace = nullptr;
+    for (const VisibleSubspace &visible : ::visibleSubspaces)
+    {
+        makeCurrent(*visible.subspace);
+
+        // Walls and sky masks reaching the sky use its height, as it was when the
+        // subspace was found visible.
+        skyCeiling.setHeight(visible.skyCeilingHeight);
+
+        Rend_DrawFlatRadio(*::curSubspace);
+        writeSubspaceSkyMask();
+        writeSubspaceWalls();
+        writeSubspaceFlats();
+    }
+    ::visibleSubspaces.clear();
+}
+
 /**
  * Project all the non-clipped decorations. They become regular vissprites.
  */
@@ -4388,12 +4577,58 @@ static void popGLStateForPass(DrawMode mode)
     }
 }
 
-static void drawLists(const DrawLists::FoundLists &lists, DrawMode mode)
+/**
+ * Identifies the texture of a texture unit, for grouping lists that use the same
+ * textures. Lists with no texture in the unit are grouped together.
+ */
+static dintptr textureKey(const GLTextureUnit &unit)
+{
+    return unit.texture? dintptr(unit.texture) : dintptr(unit.unmanaged.glName);
+}
+
+/**
+ * Orders the lists so that lists which bind the same textures in @a mode are drawn
+ * one after the other. DGL can then merge their primitives into the same batches,
+ * because consecutive Begin/End sections with equal textures and matrices share a
+ * batch entry.
+ *
+ * The order of the lists within a pass is otherwise arbitrary (it comes from the
+ * list hashes), so this does not affect what ends up in the frame.
+ */
+static void sortListsByTexture(DrawLists::FoundLists &lists, DrawMode mode)
+{
+    // Detail passes bind the detail textures; all other modes begin with the
+    // primary and interpolation textures.
+    const bool details = (mode == DM_ALL_DETAILS || mode == DM_BLENDED_DETAILS);
+    const texunitid_t order[NUM_TEXTURE_UNITS] = {
+        details? TU_PRIMARY_DETAIL : TU_PRIMARY,
+        details? TU_INTER_DETAIL   : TU_INTER,
+        details? TU_PRIMARY        : TU_PRIMARY_DETAIL,
+        details? TU_INTER          : TU_INTER_DETAIL
+    };
+
+    std::sort(lists.begin(), lists.end(), [&order] (const DrawList *a, const DrawList *b) {
+        for (texunitid_t unit : order)
+        {
+            const dintptr ka = textureKey(a->spec().unit(unit));
+            const dintptr kb = textureKey(b->spec().unit(unit));
+            if (ka != kb) return ka < kb;
+        }
+        return false;
+    });
+}
+
+static void drawLists(DrawLists::FoundLists &lists, DrawMode mode)
 {
     if (lists.isEmpty()) return;
     // If the first list is empty -- do nothing.
     if (lists.at(0)->isEmpty()) return;
 
+    if (devSortLists)
+    {
+        sortListsByTexture(lists, mode);
+    }
+
     // Setup GL state that's common to all the lists in this mode.
     TexUnitMap texUnitMap;
     pushGLStateForPass(mode, texUnitMap);
@@ -4780,8 +5015,21 @@ void Rend_RenderMap(Map &map)
     // Setup the modelview matrix.
     Rend_ModelViewMatrix();
 
+    RenderBenchTimer benchTimer(RBP_VISIBILITY);
+
     if (!freezeRLs)
     {
+        // Shadows and other generated geometry is culled using the view frustum.
+        if (devNoCulling)
+        {
+            viewFrustum.setUnbounded();
+        }
+        else
+        {
+            viewFrustum.setMatrix((DGL_Matrix(DGL_PROJECTION) * DGL_Matrix(DGL_MODELVIEW)).values());
+        }
+        de::zap(shadowCullStats);
+
         // Prepare for rendering.
         ClientApp::render().beginFrame();
 
@@ -4815,9 +5063,22 @@ void Rend_RenderMap(Map &map)
         // No current subspace as of yet.
         curSubspace = nullptr;
 
-        // Draw the world!
-        traverseBspTreeAndDrawSubspaces(&map.bspTree());
+        // Find the visible subspaces, then draw them.
+        traverseBspTreeAndFindVisibleSubspaces(&map.bspTree());
+        benchTimer.switchTo(RBP_GEOMETRY);
+        drawVisibleSubspaces(map);
+
+        if (rendInfoShadows)
+        {
+            const ShadowCullStats &stats = shadowCullStats;
+            LOGDEV_GL_MSG("Shadows culled: mobj %i/%i, radio walls %i/%i, radio flat edges %i/%i")
+                    << stats.mobjShadowsCulled << stats.mobjShadows
+                    << stats.radioWallsCulled << stats.radioWalls
+                    << stats.radioFlatEdgesCulled << stats.radioFlatEdges;
+        }
     }
+
+    benchTimer.switchTo(RBP_DRAW);
     drawAllLists(map);
 
     // Draw various debugging displays:
@@ -6301,6 +6562,7 @@ void Rend_Register()
     C_VAR_INT("rend-glow-wall", &useGlowOnWalls, 0, 0, 1);
 
     C_VAR_BYTE("rend-info-lums", &rendInfoLums, 0, 0, 1);
+    C_VAR_BYTE("rend-info-shadows", &rendInfoShadows, CVF_NO_ARCHIVE, 0, 1);
 
     C_VAR_INT2("rend-light", &useDynLights, 0, 0, 1, useDynlightsChanged);
     C_VAR_INT2("rend-light-ambient", &ambientLight, 0, 0, 255, Rend_UpdateLightModMatrix);
@@ -6310,6 +6572,7 @@ void Rend_Register()
     C_VAR_FLOAT2("rend-light-compression", &lightRangeCompression, 0, -1, 1, Rend_UpdateLightModMatrix);
     C_VAR_BYTE("rend-light-decor", &useLightDecorations, 0, 0, 1);
     C_VAR_FLOAT("rend-light-fog-bright", &dynlightFogBright, 0, 0, 1);
+    C_VAR_BYTE("rend-light-grid", &useLightGrid, 0, 0, 1);
     //C_VAR_INT("rend-light-multitex", &useMultiTexLights, 0, 0, 1);
     C_VAR_INT("rend-light-num", &rendMaxLumobjs, CVF_NO_MAX, 0, 0);
     C_VAR_FLOAT("rend-light-sky", &rendSkyLight, 0, 0, 1/*, useSkylightChanged*/);
@@ -6333,13 +6596,17 @@ void Rend_Register()
     C_VAR_BYTE2("rend-tex-external-always", &loadExtAlways, 0, 0, 1, loadExtAlwaysChanged);
     C_VAR_INT("rend-tex-filter-anisotropic", &texAniso, 0, -1, 4);
     C_VAR_INT("rend-tex-filter-mag", &texMagMode, 0, 0, 1);
-    C_VAR_INT2("rend-tex-filter-smart", &useSmartFilter, 0, 0, 1, useSmartFilterChanged);
+    C_VAR_INT2("rend-tex-filter-smart", &useSmartFilter, 0, 0, 2, useSmartFilterChanged);
     C_VAR_INT("rend-tex-filter-sprite", &filterSprites, 0, 0, 1);
     C_VAR_INT("rend-tex-filter-ui", &filterUI, 0, 0, 1);
     C_VAR_FLOAT2("rend-tex-gamma", &texGamma, 0, 0, 1, texGammaChanged);
     C_VAR_INT2("rend-tex-mipmap", &mipmapping, CVF_PROTECTED, 0, 5, mipmappingChanged);
     C_VAR_INT2("rend-tex-quality", &texQuality, 0, 0, 8, texQualityChanged);
     C_VAR_INT("rend-tex-shiny", &useShinySurfaces, 0, 0, 1);
+    C_VAR_INT("rend-tex-upload-budget", &glDeferredUploadBudget, CVF_NO_MAX, 0, 0);
+    C_VAR_BYTE("rend-tex-cache", &texContentCacheEnabled, 0, 0, 1);
+    C_VAR_INT("rend-tex-cache-size", &texContentCacheSize, CVF_NO_MAX, 0, 0);
+    C_VAR_INT("rend-tex-memory", &texMemoryBudget, CVF_NO_MAX, 0, 0);
 
     //C_VAR_BYTE("rend-bias-grid-debug", &devLightGrid, CVF_NO_ARCHIVE, 0, 1);
     //C_VAR_FLOAT("rend-bias-grid-debug-size", &devLightGridSize, 0, .1f, 100);
@@ -6356,6 +6623,7 @@ void Rend_Register()
     C_VAR_BYTE("rend-dev-sector-show-indices", &devSectorIndices, CVF_NO_ARCHIVE, 0, 1);
     C_VAR_INT("rend-dev-sky", &devRendSkyMode, CVF_NO_ARCHIVE, 0, 1);
     C_VAR_BYTE("rend-dev-sky-always", &devRendSkyAlways, CVF_NO_ARCHIVE, 0, 1);
+    C_VAR_BYTE("rend-dev-sort-lists", &devSortLists, CVF_NO_ARCHIVE, 0, 1);
     C_VAR_BYTE("rend-dev-soundorigins", &devSoundEmitters, CVF_NO_ARCHIVE, 0, 7);
     C_VAR_BYTE("rend-dev-surface-show-vectors", &devSurfaceVectors, CVF_NO_ARCHIVE, 0, 7);
     C_VAR_BYTE("rend-dev-thinker-ids", &devThinkerIds, CVF_NO_ARCHIVE, 0, 1);
@@ -34,6 +34,7 @@
 
 #include "resource/image.h"
 
+#include "render/depthsort.h"
 #include "render/r_main.h"
 #include "render/viewports.h"
 #include "render/rend_main.h"
@@ -52,6 +53,7 @@
 #include <de/folder.h>
 #include <de/glinfo.h>
 #include <de/imagefile.h>
+#include <algorithm>
 #include <cstdlib>
 
 using namespace de;
@@ -73,6 +75,9 @@ struct OrderedParticle
 };
 static OrderedParticle *order;
 static size_t orderSize;
+static DepthSorter particleSorter;
+static std::vector<double> particleDistances;
+static std::vector<OrderedParticle> sortedParticles;
 
 static size_t numParts;
 
@@ -248,16 +253,22 @@ void Rend_ParticleReleaseExtraTextures()
 }
 
 /**
- * Sorts in descending order.
+ * Sorts the order buffer back to front.
  */
-static int comparePOrder(const void *a, const void *b)
+static void sortParticleOrder()
 {
-    const auto &ptA = *(const OrderedParticle *) a;
-    const auto &ptB = *(const OrderedParticle *) b;
+    particleDistances.resize(::numParts);
+    for (size_t i = 0; i < ::numParts; ++i)
+    {
+        particleDistances[i] = ::order[i].distance;
+    }
 
-    if(ptA.distance > ptB.distance) return -1;
-    if(ptA.distance < ptB.distance) return 1;
-    return 0;  // Highly unlikely (but possible).
+    sortedParticles.clear();
+    for (duint32 index : particleSorter.sort(particleDistances.data(), duint32(::numParts)))
+    {
+        sortedParticles.push_back(::order[index]);
+    }
+    std::copy(sortedParticles.begin(), sortedParticles.end(), ::order);
 }
 
 /**
@@ -286,19 +297,20 @@ static void expandOrderBuffer(size_t max)
 }
 
 /**
- * Determines whether the given particle is potentially visible for the current viewer.
+ * Determines whether the particle at @a index is potentially visible for the current viewer.
  */
-static bool particlePVisible(const ParticleInfo &pinfo)
+static bool particlePVisible(const ParticleArrays &particles, int index)
 {
     // Never if it has already expired.
-    if(pinfo.stage < 0) return false;
+    if(particles.stage[index] < 0) return false;
 
     // Never if the origin lies outside the map.
-    if(!pinfo.bspLeaf || !pinfo.bspLeaf->hasSubspace())
+    const world::BspLeaf *bspLeaf = particles.bspLeaf[index];
+    if(!bspLeaf || !bspLeaf->hasSubspace())
         return false;
 
     // Potentially, if the subspace at the origin is visible.
-    return R_ViewerSubspaceIsVisible(pinfo.bspLeaf->subspace().as<ConvexSubspace>());
+    return R_ViewerSubspaceIsVisible(bspLeaf->subspace().as<ConvexSubspace>());
  }
 
 /**
@@ -332,14 +344,15 @@ static int listVisibleParticles(Map &map)
     {
         if(!R_ViewerGeneratorIsVisible(gen)) return LoopContinue;  // Skip.
 
-        for(int i = 0; i < gen.count; ++i)
+        const ParticleArrays &particles = gen.particles();
+        for(int i = 0; i < particles.count; ++i)
         {
-            const ParticleInfo &pinfo = gen.particleInfo()[i];
-
-            if(!particlePVisible(pinfo)) continue;  // Skip.
+            if(!particlePVisible(particles, i)) continue;  // Skip.
 
             // Skip particles too far from, or near to, the viewer.
-            const float dist = de::max(pointDist(pinfo.origin), 1.f);
+            const fixed_t origin[3] = { particles.origin[0][i], particles.origin[1][i],
+                                        particles.origin[2][i] };
+            const float dist = de::max(pointDist(origin), 1.f);
             if(gen.def->maxDist != 0 && dist > gen.def->maxDist) continue;
             if(dist < float( ::particleNearLimit )) continue;
 
@@ -351,7 +364,7 @@ static int listVisibleParticles(Map &map)
 
             // Determine what type of particle this is, as this will affect how
             // we go order our render passes and manipulate the render state.
-            const int psType = gen.stages[pinfo.stage].type;
+            const int psType = gen.stages[particles.stage[i]].type;
             if(psType == PTC_POINT)
             {
                 ::hasPoints = true;
@@ -394,8 +407,8 @@ static int listVisibleParticles(Map &map)
     // This is the real number of possibly visible particles.
     ::numParts = numVisibleParts;
 
-    // Sort the order list back->front. A quicksort is fast enough.
-    qsort(::order, ::numParts, sizeof(OrderedParticle), comparePOrder);
+    // Sort the order list back->front.
+    sortParticleOrder();
 
     return true;
 }
@@ -454,12 +467,10 @@ static void setupModelParamsForParticle(vissprite_t &spr, const ParticleInfo *pi
     }
     else
     {
-        world::Map &map = pinfo->bspLeaf->subspace().sector().map();
-
-#if 0
-        if(useBias && map.hasLightGrid())
+        const Map &map = pinfo->bspLeaf->map().as<Map>();
+        if(useLightGrid && map.hasLightGrid())
         {
-            Vec4f color = map.lightGrid().evaluate(spr.pose.origin);
+            Vec3f color = map.evaluateLightGrid(spr.pose.origin);
             // Apply light range compression.
             for(int i = 0; i < 3; ++i)
             {
@@ -470,7 +481,6 @@ static void setupModelParamsForParticle(vissprite_t &spr, const ParticleInfo *pi
             spr.light.ambientColor.z = color.z;
         }
         else
-#endif
         {
             const Vec4f color = pinfo->bspLeaf->subspace().subsector().as<Subsector>()
                                        .lightSourceColorfIntensity();
@@ -575,7 +585,7 @@ static void drawParticles(int rtype, bool withBlend)
     {
         const OrderedParticle *slot = &order[i];
         const Generator *gen        = slot->generator;
-        const ParticleInfo &pinfo   = gen->particleInfo()[slot->particleId];
+        const ParticleInfo pinfo    = gen->particleInfo(slot->particleId);
 
         const GeneratorParticleStage *st = &gen->stages[pinfo.stage];
         const ded_ptcstage_t *stDef      = &gen->def->stages[pinfo.stage];
@@ -0,0 +1,375 @@
+/** @file renderbench.cpp  Renderer CPU benchmark.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "de_platform.h"
+#include "render/renderbench.h"
+
+#include "gl/gl_main.h"
+#include "render/viewports.h"
+#include "world/p_players.h"
+
+#include <doomsday/console/cmd.h>
+#include <doomsday/console/exec.h>
+#include <de/app.h>
+#include <de/filesystem.h>
+#include <de/folder.h>
+#include <de/list.h>
+#include <de/log.h>
+#include <de/time.h>
+#include <de/writer.h>
+
+#include <algorithm>
+#include <sstream>
+
+using namespace de;
+
+/// Number of frames for spinning in place when no camera path has been recorded.
+static const int SPIN_FRAMES = 360;
+
+static const char *phaseNames[RBP_COUNT] = { "other", "visibility", "geometry", "draw" };
+
+static struct RenderBench
+{
+    enum State { Idle, Recording, Running };
+
+    State           state = Idle;
+    int             consoleNum = 0;
+    List<viewer_t>  path;
+    bool            spinning = false;   ///< Turning around in place instead of a path.
+    viewer_t        spinOrigin;
+    int             frame = 0;
+    int             frameCount = 0;
+    bool            inFrame = false;    ///< Benchmarked view being rendered.
+    bool            quitWhenDone = false;
+    bool            wasNullBackend = false;
+    double          phaseTimes[RBP_COUNT];
+    List<double>    frameTimes[RBP_COUNT];  ///< Milliseconds per frame.
+    List<DGLFrameStats> frameStats;
+
+    void start(int frames, bool quit)
+    {
+        consoleNum   = consolePlayer;
+        spinning     = path.isEmpty();
+        frame        = 0;
+        frameCount   = (spinning? SPIN_FRAMES : path.sizei());
+        if (frames > 0) frameCount = frames;
+        quitWhenDone = quit;
+        inFrame      = false;
+        for (auto &times : frameTimes) times.clear();
+        frameStats.clear();
+
+        wasNullBackend = DGL_IsNullBackend();
+        DGL_SetNullBackend(true);
+        state = Running;
+
+        LOG_SCR_MSG("Benchmarking the renderer for %i frames (%s)")
+                << frameCount << (spinning? "turning around in place" : "camera path");
+    }
+
+    void finish()
+    {
+        state = Idle;
+        DGL_SetNullBackend(wasNullBackend);
+        report();
+
+        if (quitWhenDone)
+        {
+            Con_Execute(CMDS_DDAY, "quit!", true, false);
+        }
+    }
+
+    static double percentile(List<double> values, double fraction)
+    {
+        if (values.isEmpty()) return 0;
+        std::sort(values.begin(), values.end());
+        return values[de::min(values.size() - 1, dsize(fraction * values.size()))];
+    }
+
+    void report() const
+    {
+        const dsize count = frameStats.size();
+        if (!count)
+        {
+            LOG_SCR_WARNING("No frames were benchmarked");
+            return;
+        }
+
+        LOG_SCR_MSG(_E(b) "Renderer benchmark: %i frames") << count;
+        LOG_SCR_MSG("CPU time per frame (ms): mean / median / 95%% / max");
+        for (int i = 0; i < RBP_COUNT; ++i)
+        {
+            const auto &times = frameTimes[i];
+            double sum = 0;
+            for (double t : times) sum += t;
+            LOG_SCR_MSG("  %-10s %7.3f / %7.3f / %7.3f / %7.3f")
+                    << phaseNames[i] << sum / count << percentile(times, .5)
+                    << percentile(times, .95) << percentile(times, 1);
+        }
+
+        double drawCalls = 0, batches = 0, merged = 0, vertices = 0, stateChanges = 0,
+               primSwitches = 0;
+        for (const DGLFrameStats &stats : frameStats)
+        {
+            drawCalls    += stats.drawCalls;
+            batches      += stats.batches;
+            merged       += stats.mergedSections;
+            vertices     += stats.vertices;
+            stateChanges += stats.stateChanges;
+            primSwitches += stats.primitiveSwitches;
+        }
+        LOG_SCR_MSG("DGL per frame: %.1f draw calls, %.1f batches (%.1f merged sections), "
+                    "%.0f vertices, %.1f state changes, %.1f primitive switches")
+                << drawCalls / count << batches / count << merged / count << vertices / count
+                << stateChanges / count << primSwitches / count;
+    }
+
+    void updateViewer(int console, viewer_t &view)
+    {
+        if (console != consoleNum) return;
+
+        if (state == Recording)
+        {
+            path << view;
+        }
+        else if (state == Running)
+        {
+            if (spinning)
+            {
+                if (frame == 0) spinOrigin = view;
+                view = spinOrigin;
+                view.setAngle(spinOrigin.angleWithoutHeadTracking() +
+                              angle_t(double(frame) / frameCount * 4294967296.0));
+            }
+            else
+            {
+                view = path.at(frame % path.sizei());
+            }
+            for (double &t : phaseTimes) t = 0;
+            inFrame = true;
+        }
+    }
+
+    void endFrame(int console)
+    {
+        if (state != Running || !inFrame || console != consoleNum) return;
+
+        inFrame = false;
+
+        // The other phases are nested inside the view.
+        for (int i = RBP_VIEW + 1; i < RBP_COUNT; ++i)
+        {
+            phaseTimes[RBP_VIEW] -= phaseTimes[i];
+        }
+        phaseTimes[RBP_VIEW] = de::max(0.0, phaseTimes[RBP_VIEW]);
+
+        for (int i = 0; i < RBP_COUNT; ++i)
+        {
+            frameTimes[i] << phaseTimes[i] * 1000;
+        }
+        frameStats << DGL_FrameStats();
+
+        if (++frame >= frameCount)
+        {
+            finish();
+        }
+    }
+
+    static Folder &fileFolder(const String &name)
+    {
+        // Relative paths are in the user's runtime folder.
+        return name.beginsWith("/")? App::rootFolder() : App::homeFolder();
+    }
+
+    bool save(const String &name) const
+    {
+        try
+        {
+            File &file = fileFolder(name).replaceFile(name);
+            Writer out(file);
+            out.writeText("# Doomsday renderer benchmark camera path: x y z angle pitch\n");
+            for (const viewer_t &view : path)
+            {
+                out.writeText(Stringf("%.3f %.3f %.3f %u %.3f\n",
+                                      view.origin.x, view.origin.y, view.origin.z,
+                                      view.angleWithoutHeadTracking(), view.pitch));
+            }
+            file.release();
+            LOG_SCR_MSG("Saved %i camera positions to %s") << path.size() << file.description();
+            return true;
+        }
+        catch (const Error &er)
+        {
+            LOG_SCR_ERROR("Failed to save the camera path: %s") << er.asText();
+        }
+        return false;
+    }
+
+    bool load(const String &name)
+    {
+        try
+        {
+            const File &file = fileFolder(name).locate<const File>(name);
+            std::istringstream in(String::fromUtf8(file).toStdString());
+            List<viewer_t> loaded;
+            std::string line;
+            while (std::getline(in, line))
+            {
+                if (line.empty() || line[0] == '#') continue;
+
+                std::istringstream fields(line);
+                Vec3d origin;
+                angle_t angle;
+                float pitch;
+                if (!(fields >> origin.x >> origin.y >> origin.z >> angle >> pitch))
+                {
+                    LOG_SCR_ERROR("Invalid camera position in %s: %s")
+                            << file.description() << line.c_str();
+                    return false;
+                }
+                loaded << viewer_t(origin, angle, pitch);
+            }
+            path = loaded;
+            LOG_SCR_MSG("Loaded %i camera positions from %s") << path.size() << file.description();
+            return true;
+        }
+        catch (const Error &er)
+        {
+            LOG_SCR_ERROR("Failed to load the camera path: %s") << er.asText();
+        }
+        return false;
+    }
+} bench;
+
+bool RenderBench_IsRunning()
+{
+    return bench.state == RenderBench::Running;
+}
+
+void RenderBench_UpdateViewer(int consoleNum, viewer_t &view)
+{
+    if (bench.state == RenderBench::Idle) return;
+    bench.updateViewer(consoleNum, view);
+}
+
+void RenderBench_EndFrame(int consoleNum)
+{
+    bench.endFrame(consoleNum);
+}
+
+RenderBenchTimer::RenderBenchTimer(RenderBenchPhase phase)
+    : _phase(phase)
+    , _timing(bench.inFrame)
+{}
+
+RenderBenchTimer::~RenderBenchTimer()
+{
+    stop();
+}
+
+void RenderBenchTimer::switchTo(RenderBenchPhase phase)
+{
+    stop();
+    _phase  = phase;
+    _timing = bench.inFrame;
+    if (_timing) _startedAt = Time();
+}
+
+void RenderBenchTimer::stop()
+{
+    if (_timing && bench.inFrame)
+    {
+        bench.phaseTimes[_phase] += _startedAt.since();
+    }
+    _timing = false;
+}
+
+D_CMD(RenderBench)
+{
+    DE_UNUSED(src);
+
+    const String cmd = (argc > 1? argv[1] : "");
+
+    if (!cmd.compareWithoutCase("record") && argc == 2)
+    {
+        if (bench.state == RenderBench::Running) bench.finish();
+        bench.path.clear();
+        bench.consoleNum = consolePlayer;
+        bench.state = RenderBench::Recording;
+        LOG_SCR_MSG("Recording the camera path; use \"%s stop\" to finish") << argv[0];
+        return true;
+    }
+    if (!cmd.compareWithoutCase("stop") && argc == 2)
+    {
+        if (bench.state == RenderBench::Recording)
+        {
+            bench.state = RenderBench::Idle;
+            LOG_SCR_MSG("Recorded %i camera positions") << bench.path.size();
+        }
+        else if (bench.state == RenderBench::Running)
+        {
+            bench.finish();
+        }
+        return true;
+    }
+    if (!cmd.compareWithoutCase("save") && argc == 3)
+    {
+        return bench.save(argv[2]);
+    }
+    if (!cmd.compareWithoutCase("load") && argc == 3)
+    {
+        return bench.load(argv[2]);
+    }
+    if (!cmd.compareWithoutCase("run") && argc >= 2 && argc <= 4)
+    {
+        if (bench.state != RenderBench::Idle)
+        {
+            LOG_SCR_ERROR("The benchmark is already recording or running");
+            return false;
+        }
+        int frames = 0;
+        bool quit = false;
+        for (int i = 2; i < argc; ++i)
+        {
+            if (!String(argv[i]).compareWithoutCase("quit"))
+            {
+                quit = true;
+            }
+            else
+            {
+                frames = String(argv[i]).toInt();
+            }
+        }
+        bench.start(frames, quit);
+        return true;
+    }
+
+    LOG_SCR_NOTE("Usage:\n"
+                 "  %s record\n"
+                 "  %s stop\n"
+                 "  %s save/load (file)\n"
+                 "  %s run [frames] [quit]\n"
+                 "Without a recorded or loaded camera path, the camera turns around in place.")
+            << argv[0] << argv[0] << argv[0] << argv[0];
+    return true;
+}
+
+void RenderBench_Register()
+{
+    C_CMD_FLAGS("renderbench", nullptr, RenderBench, CMDF_NO_DEDICATED);
+}
@@ -29,6 +29,7 @@
 #include "render/environ.h"
 #include "render/rend_main.h"
 #include "render/rend_halo.h"
+#include "render/renderbench.h"
 #include "render/angleclipper.h"
 #include "render/iworldrenderer.h"
 #include "render/modelrenderer.h"
@@ -585,4 +586,5 @@ void RenderSystem::consoleRegister()
     Viewports_Register();
     Rend_Register();
     H_Register();
+    RenderBench_Register();
 }
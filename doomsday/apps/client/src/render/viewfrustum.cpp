@@ -0,0 +1,90 @@
+/** @file viewfrustum.cpp  View frustum for culling.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "render/viewfrustum.h"
+
+#include <cmath>
+
+ViewFrustum::ViewFrustum()
+{
+    setUnbounded();
+}
+
+void ViewFrustum::setUnbounded()
+{
+    for (Plane &plane : _planes)
+    {
+        plane.normal[0] = plane.normal[1] = plane.normal[2] = 0;
+        plane.dist = 1;
+    }
+    _unbounded = true;
+}
+
+void ViewFrustum::setMatrix(const float mvp[16])
+{
+    // A point is inside the view volume if -w <= x, y, z <= w in clip space. Each of
+    // the six conditions is a plane: the fourth row of the matrix plus or minus one of
+    // the other rows.
+    auto element = [mvp] (int r, int c) { return double(mvp[c * 4 + r]); };
+
+    for (int i = 0; i < 6; ++i)
+    {
+        const int axis = i / 2;
+        const double sign = (i % 2? -1 : 1);
+
+        // GL space is (x, z, y) in map space.
+        double gl[4];
+        for (int c = 0; c < 4; ++c)
+        {
+            gl[c] = element(3, c) + sign * element(axis, c);
+        }
+
+        Plane &plane = _planes[i];
+        plane.normal[0] = gl[0];
+        plane.normal[1] = gl[2];
+        plane.normal[2] = gl[1];
+        plane.dist      = gl[3];
+
+        const double len = std::sqrt(gl[0] * gl[0] + gl[1] * gl[1] + gl[2] * gl[2]);
+        if (len > 0)
+        {
+            for (double &n : plane.normal) n /= len;
+            plane.dist /= len;
+        }
+    }
+    _unbounded = false;
+}
+
+bool ViewFrustum::isBoxVisible(const double min[3], const double max[3]) const
+{
+    if (_unbounded) return true;
+
+    for (const Plane &plane : _planes)
+    {
+        // The corner furthest along the normal is the last one to leave the plane's
+        // inner side.
+        double dist = plane.dist;
+        for (int k = 0; k < 3; ++k)
+        {
+            dist += plane.normal[k] * (plane.normal[k] >= 0? max[k] : min[k]);
+        }
+        if (dist < 0) return false;
+    }
+    return true;
+}
@@ -43,6 +43,7 @@
 #include "render/playerweaponanimator.h"
 #include "render/r_draw.h"
 #include "render/r_main.h"
+#include "render/renderbench.h"
 #include "render/rendersystem.h"
 #include "render/rendpoly.h"
 #include "render/skydrawable.h"
@@ -51,6 +52,8 @@
 
 #include "network/net_demo.h"
 
+#include "resource/clienttexture.h"
+
 #include "world/p_object.h"
 #include "world/p_players.h"
 #include "world/convexsubspace.h"
@@ -625,6 +628,9 @@ void R_UpdateViewer(dint consoleNum)
         }
     }
 
+    // The renderer benchmark may be recording or replacing the view.
+    RenderBench_UpdateViewer(consoleNum, vd->current);
+
     // Update viewer.
     const angle_t viewYaw = vd->current.angle();
 
@@ -1228,7 +1234,10 @@ void R_RenderViewPort(int playerNum)
 
     R_UpdateViewer(vp->console);
 
-    gx.DrawViewPort(localNum, &vpGeometry, &vdWindow, displayPlayer, /* layer: */ 0);
+    {
+        RenderBenchTimer benchTimer(RBP_VIEW);
+        gx.DrawViewPort(localNum, &vpGeometry, &vdWindow, displayPlayer, /* layer: */ 0);
+    }
 
     // Apply camera lens effects on the rendered view.
     LensFx_Draw(vp->console);
@@ -1242,6 +1251,11 @@ void R_RenderViewPort(int playerNum)
     // affect the window's FPS counter.
     frameCount++;
 
+    RenderBench_EndFrame(vp->console);
+
+    // Stay within the texture memory budget.
+    ClientTexture::Variant::releaseIdle(frameCount);
+
     // Keep reseting until a new sharp world has arrived.
     if(resetNextViewer > 1) resetNextViewer = 0;
 
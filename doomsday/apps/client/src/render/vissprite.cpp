@@ -21,6 +21,7 @@
  */
 
 #include "render/vissprite.h"
+#include "render/depthsort.h"
 
 #include "clientapp.h"
 
@@ -40,6 +41,9 @@ vissprite_t visSprSortedHead;
 
 static vissprite_t overflowVisSprite;
 
+static DepthSorter visSpriteSorter;
+static std::vector<double> visSpriteDistances;
+
 void R_ClearVisSprites()
 {
     visSpriteP = visSprites;
@@ -117,66 +121,39 @@ void VisSprite_SetupModel(vissprite_t *spr, const VisEntityPose &pose, const Vis
 
 void R_SortVisSprites()
 {
-    if(!visSpriteP) return;
+    visSprSortedHead.next = visSprSortedHead.prev = &visSprSortedHead;
 
-    const dint count = visSpriteP - visSprites;
-    if(count <= 0) return;
+    if (!visSpriteP) return;
 
-    vissprite_t unsorted;
-    unsorted.next = unsorted.prev = &unsorted;
+    const dint count = visSpriteP - visSprites;
+    if (count <= 0) return;
 
-    for(vissprite_t *ds = visSprites; ds < visSpriteP; ds++)
+    // Pull the vissprites out by distance, farthest first. Sprites at equal distance
+    // are drawn in reverse order of creation.
+    visSpriteDistances.resize(count);
+    for (dint i = 0; i < count; ++i)
     {
-        ds->next = ds + 1;
-        ds->prev = ds - 1;
+        visSpriteDistances[i] = visSprites[i].pose.distance;
     }
-    visSprites[0].prev = &unsorted;
-    unsorted.next = &visSprites[0];
-    (visSpriteP - 1)->next = &unsorted;
-    unsorted.prev = visSpriteP - 1;
-
-    // Pull the vissprites out by distance.
-    visSprSortedHead.next = visSprSortedHead.prev = &visSprSortedHead;
-
-    /// @todo Optimize:
-    /// Profile results from nuts.wad show over 25% of total execution time
-    /// was spent sorting vissprites (nuts.wad map01 is a perfect pathological
-    /// test case).
-    ///
-    /// Rather than try to speed up the sort, it would make more sense to
-    /// actually construct the vissprites in z order if it can be done in
-    /// linear time.
-
-    vissprite_t *best = nullptr;
-    for(dint i = 0; i < count; ++i)
+    vissprite_t *prev = &visSprSortedHead;
+    for (duint32 index : visSpriteSorter.sort(visSpriteDistances.data(), duint32(count)))
     {
-        ddouble bestdist = 0;
-        for(vissprite_t *ds = unsorted.next; ds != &unsorted; ds = ds->next)
-        {
-            if(ds->pose.distance >= bestdist)
-            {
-                bestdist = ds->pose.distance;
-                best = ds;
-            }
-        }
-
-        best->next->prev = best->prev;
-        best->prev->next = best->next;
-        best->next = &visSprSortedHead;
-        best->prev = visSprSortedHead.prev;
-        visSprSortedHead.prev->next = best;
-        visSprSortedHead.prev = best;
+        vissprite_t *spr = &visSprites[index];
+        spr->prev  = prev;
+        prev->next = spr;
+        prev       = spr;
     }
+    prev->next = &visSprSortedHead;
+    visSprSortedHead.prev = prev;
 }
 
 void VisEntityLighting::setupLighting(const Vec3d &origin, ddouble distance,
                                       const world::BspLeaf &bspLeaf)
 {
-#if 0
-    world::Map &map = ClientApp::world().map();
-    if(useBias && map.hasLightGrid())
+    const Map &map = bspLeaf.map().as<Map>();
+    if(useLightGrid && map.hasLightGrid())
     {
-        Vec4f color = map.lightGrid().evaluate(origin);
+        Vec3f color = map.evaluateLightGrid(origin);
 
         // Apply light range compression.
         for(dint i = 0; i < 3; ++i)
@@ -189,7 +166,6 @@ void VisEntityLighting::setupLighting(const Vec3d &origin, ddouble distance,
         ambientColor.z = color.z;
     }
     else
-#endif
     {
         const auto &subsec = bspLeaf.subspace().subsector().as<Subsector>();
         const Vec4f color  = subsec.lightSourceColorfIntensity();
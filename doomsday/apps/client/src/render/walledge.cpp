@@ -22,6 +22,7 @@
 
 #include "world/convexsubspace.h"
 #include "world/p_players.h"
+#include "world/map.h"
 #include "world/maputil.h"
 #include "world/surface.h"
 #include "world/subsector.h"
@@ -37,20 +38,46 @@
 using namespace de;
 
 /**
- * Determines whether normal smoothing should be performed for the given pair of
- * map surfaces (which are assumed to share an edge).
- *
- * Yes if the angle between the two surfaces is less than 45 degrees.
- * @todo Should be user customizable with a Material property. -ds
- *
- * @param sufA       The "left"  map surface which shares an edge with @a sufB.
- * @param sufB       The "right" map surface which shares an edge with @a sufA.
- * @param angleDiff  Angle difference (i.e., normal delta) between the two surfaces.
+ * The map's lines as seen by the edge normal cache.
  */
-static bool shouldSmoothNormals(Surface &sufA, Surface &sufB, binangle_t angleDiff)
+struct MapLineTopology : public EdgeNormals::Topology
 {
-    DE_UNUSED(sufA, sufB);
-    return INRANGE_OF(angleDiff, BANG_180, BANG_45);
+    EdgeNormals &normals(Line line, int side) const override
+    {
+        return static_cast<world::Line *>(line)->side(side).as<LineSide>().edgeNormals();
+    }
+
+    void forAllLinesAtVertex(Line line, int to,
+                             const std::function<void (Line)> &func) const override
+    {
+        // Polyobj lines have no owner rings.
+        world::LineOwner *base = static_cast<world::Line *>(line)->vertex(to).firstLineOwner();
+        if (!base) return;
+
+        world::LineOwner *own = base;
+        do
+        {
+            func(&own->line());
+            own = own->next();
+        } while (own != base);
+    }
+
+    void forAllSectorLines(Sector sector,
+                           const std::function<void (Line)> &func) const override
+    {
+        static_cast<world::Sector *>(sector)->forAllSides([&func] (world::LineSide &side)
+        {
+            func(&side.line());
+            return LoopContinue;
+        });
+    }
+};
+
+static MapLineTopology mapLineTopology;
+
+static inline EdgeNormals::Normal toNormal(const Vec3f &vec)
+{
+    return EdgeNormals::Normal {{ vec.x, vec.y, vec.z }};
 }
 
 WallEdge::Event::Event()
@@ -733,28 +760,31 @@ struct WallEdge::Impl : public IHPlane
     }
 
     /**
-     * Determine the (possibly smoothed) edge normal.
-     * @todo Cache the smoothed normal value somewhere...
+     * Determine the (possibly smoothed) edge normal. Finding the blend neighbor is
+     * relatively expensive, so the result is cached in the line side.
      */
     void updateNormal()
     {
         needUpdateNormal = false;
 
-        auto &lineSide   = lineSideSegment().lineSide();
+        auto &lineSide   = lineSideSegment().lineSide().as<LineSide>();
         Surface &surface = lineSide.surface(spec.section).as<Surface>();
 
-        binangle_t angleDiff;
-        Surface *blendSurface = findBlendNeighbor(angleDiff);
-
-        if(blendSurface && shouldSmoothNormals(surface, *blendSurface, angleDiff))
-        {
-            // Average normals.
-            normal = Vec3f(surface.normal() + blendSurface->normal()) / 2;
-        }
-        else
+        if (spec.flags.testFlag(WallSpec::NoEdgeNormalSmoothing))
         {
             normal = surface.normal();
+            return;
         }
+
+        normal = Vec3f(lineSide.edgeNormals().normal(spec.section, edge, [this, &surface] ()
+        {
+            binangle_t angleDiff;
+            const Surface *blendSurface = findBlendNeighbor(angleDiff);
+            const EdgeNormals::Normal own = toNormal(surface.normal());
+            if (!blendSurface) return own;
+            const EdgeNormals::Normal blend = toNormal(blendSurface->normal());
+            return EdgeNormals::smooth(own, &blend, angleDiff);
+        }).data());
     }
 };
 
@@ -794,6 +824,16 @@ Vec3f WallEdge::normal() const
     return d->normal;
 }
 
+void WallEdge::invalidateNormals(world::Line &line)
+{
+    EdgeNormals::invalidateAroundLine(mapLineTopology, &line);
+}
+
+void WallEdge::invalidateNormals(world::Sector &sector)
+{
+    EdgeNormals::invalidateAroundSector(mapLineTopology, &sector);
+}
+
 const WallSpec &WallEdge::spec() const
 {
     return d->spec;
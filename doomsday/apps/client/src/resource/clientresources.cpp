@@ -28,6 +28,7 @@
 #include <de/directoryfeed.h>
 #include <de/dscript.h>
 #include <de/hash.h>
+#include <de/set.h>
 #include <de/logbuffer.h>
 #include <de/loop.h>
 //#include <de/module.h>
@@ -36,6 +37,7 @@
 #include <de/reader.h>
 #include <de/stringpool.h>
 #include <de/task.h>
+#include <de/taskpool.h>
 #include <de/time.h>
 
 #include <doomsday/console/cmd.h>
@@ -68,6 +70,8 @@
 #include "gl/gl_texmanager.h"
 #include "gl/svg.h"
 #include "resource/clienttexture.h"
+#include "resource/compositecache.h"
+#include "resource/texturepreparer.h"
 #include "render/rend_model.h"
 #include "render/rend_particle.h"  // Rend_ParticleReleaseSystemTextures
 #include "render/rendersystem.h"
@@ -87,6 +91,7 @@
 #include <doomsday/world/sector.h>
 #include <doomsday/world/thinkers.h>
 
+
 using namespace de;
 using namespace res;
 
@@ -129,14 +134,29 @@ DE_PIMPL(ClientResources)
 
     typedef StringPool ModelRepository;
     ModelRepository *modelRepository;  ///< Owns FrameModel instances.
+    Set<modelid_t> failedModelIds;     ///< Model files that could not be loaded.
+
+    /// A Model definition (DED index) and the model definition it is set up into.
+    struct ModelDefChoice
+    {
+        int dedIndex;
+        int modefIndex;
+    };
 
     /// A list of specifications for material variants.
     typedef List<MaterialVariantSpec *> MaterialSpecs;
     MaterialSpecs materialSpecs;
+    /// Material specifications by their (interned) primary texture specification.
+    std::unordered_multimap<const TextureVariantSpec *, MaterialVariantSpec *> materialSpecsByPrimary;
 
     typedef List<TextureVariantSpec *> TextureSpecs;
     TextureSpecs textureSpecs;
     TextureSpecs detailTextureSpecs[DETAILVARIANT_CONTRAST_HASHSIZE];
+    /// General texture specifications by TextureVariantSpec::hash().
+    typedef std::unordered_multimap<duint32, TextureVariantSpec *> TextureSpecHash;
+    TextureSpecHash textureSpecHash;
+
+    TextureContentCache textureContentCache;
 
     struct CacheTask
     {
@@ -170,6 +190,8 @@ DE_PIMPL(ClientResources)
     /// the material is destroyed in the mean time.
     typedef List<CacheTask *> CacheQueue;
     CacheQueue cacheQueue;
+    /// Materials with a task in the cache queue, and the specs they are queued with.
+    std::unordered_multimap<const ClientMaterial *, const MaterialVariantSpec *> queuedMaterials;
 
     Impl(Public *i)
         : Base(i)
@@ -252,20 +274,24 @@ DE_PIMPL(ClientResources)
     {
         deleteAll(materialSpecs);
         materialSpecs.clear();
+        materialSpecsByPrimary.clear();
     }
 
     MaterialVariantSpec *findMaterialSpec(const MaterialVariantSpec &tpl,
         bool canCreate)
     {
-        for (MaterialVariantSpec *spec : materialSpecs)
+        const auto found = materialSpecsByPrimary.equal_range(tpl.primarySpec);
+        for (auto i = found.first; i != found.second; ++i)
         {
-            if (spec->compare(tpl)) return spec;
+            if (i->second->compare(tpl)) return i->second;
         }
 
         if (!canCreate) return 0;
 
-        materialSpecs.append(new MaterialVariantSpec(tpl));
-        return materialSpecs.back();
+        auto *spec = new MaterialVariantSpec(tpl);
+        materialSpecs.append(spec);
+        materialSpecsByPrimary.insert(std::make_pair(spec->primarySpec, spec));
+        return spec;
     }
 
     MaterialVariantSpec &getMaterialSpecForContext(MaterialContextId contextId,
@@ -376,6 +402,7 @@ DE_PIMPL(ClientResources)
         {
         case TST_GENERAL:
             textureSpecs.append(spec);
+            textureSpecHash.insert(std::make_pair(spec->hash(), spec));
             break;
         case TST_DETAIL: {
             int hash = hashDetailTextureSpec(spec->detailVariant);
@@ -392,11 +419,12 @@ DE_PIMPL(ClientResources)
         switch (tpl.type)
         {
         case TST_GENERAL: {
-            for (TextureVariantSpec *varSpec : textureSpecs)
+            const auto found = textureSpecHash.equal_range(tpl.hash());
+            for (auto i = found.first; i != found.second; ++i)
             {
-                if (*varSpec == tpl)
+                if (*i->second == tpl)
                 {
-                    return varSpec;
+                    return i->second;
                 }
             }
             break; }
@@ -458,30 +486,33 @@ DE_PIMPL(ClientResources)
         return findTextureSpec(tpl, true);
     }
 
-    bool textureSpecInUse(const TextureVariantSpec &spec)
+    /// Collects the specifications of all existing texture variants.
+    Set<const TextureVariantSpec *> textureSpecsInUse()
     {
+        Set<const TextureVariantSpec *> inUse;
         for (res::Texture *texture : self().textures().allTextures())
         {
             for (TextureVariant *variant : static_cast<ClientTexture *>(texture)->variants())
             {
-                if (&variant->spec() == &spec)
-                {
-                    return true; // Found one; stop.
-                }
+                inUse.insert(&variant->spec());
             }
         }
-        return false;
+        return inUse;
     }
 
-    int pruneUnusedTextureSpecs(TextureSpecs &list)
+    int pruneUnusedTextureSpecs(TextureSpecs &list, const Set<const TextureVariantSpec *> &inUse)
     {
         int numPruned = 0;
         for (auto i = list.begin(); i != list.end(); )
         {
             TextureVariantSpec *spec = *i;
-            if (!textureSpecInUse(*spec))
+            if (!inUse.contains(spec))
             {
                 i = list.erase(i);
+                if (spec->type == TST_GENERAL)
+                {
+                    multiRemove(textureSpecHash, spec->hash(), spec);
+                }
                 delete spec;
                 numPruned += 1;
             }
@@ -495,14 +526,15 @@ DE_PIMPL(ClientResources)
 
     int pruneUnusedTextureSpecs(texturevariantspecificationtype_t specType)
     {
+        const auto inUse = textureSpecsInUse();
         switch (specType)
         {
-        case TST_GENERAL: return pruneUnusedTextureSpecs(textureSpecs);
+        case TST_GENERAL: return pruneUnusedTextureSpecs(textureSpecs, inUse);
         case TST_DETAIL: {
             int numPruned = 0;
             for (int i = 0; i < DETAILVARIANT_CONTRAST_HASHSIZE; ++i)
             {
-                numPruned += pruneUnusedTextureSpecs(detailTextureSpecs[i]);
+                numPruned += pruneUnusedTextureSpecs(detailTextureSpecs[i], inUse);
             }
             return numPruned; }
         }
@@ -513,6 +545,7 @@ DE_PIMPL(ClientResources)
     {
         deleteAll(textureSpecs);
         textureSpecs.clear();
+        textureSpecHash.clear();
 
         for (int i = 0; i < DETAILVARIANT_CONTRAST_HASHSIZE; ++i)
         {
@@ -523,11 +556,39 @@ DE_PIMPL(ClientResources)
 
     void processCacheQueue()
     {
+        // Texture images are processed in worker threads while the queue is being
+        // processed; the finished ones are submitted for uploading as we go.
+        // Composite textures share patches, so decoded patches are kept meanwhile.
+        TexturePreparer preparer;
+        CompositeCache compositeCache;
+        const Time begunAt;
+        int taskCount = 0;
         while (!cacheQueue.isEmpty())
         {
             std::unique_ptr<CacheTask> task(cacheQueue.takeFirst());
+            if (auto *materialTask = dynamic_cast<MaterialCacheTask *>(task.get()))
+            {
+                multiRemove(queuedMaterials, materialTask->material, materialTask->spec);
+            }
             task->run();
+            preparer.poll();
+            taskCount++;
         }
+        if (taskCount)
+        {
+            LOGDEV_RES_VERBOSE("Processed %i cache tasks in %.2f seconds")
+                << taskCount << begunAt.since();
+        }
+    }
+
+    bool isQueued(const ClientMaterial &material, const MaterialVariantSpec &contextSpec) const
+    {
+        const auto found = queuedMaterials.equal_range(&material);
+        for (auto i = found.first; i != found.second; ++i)
+        {
+            if (i->second == &contextSpec) return true;
+        }
+        return false;
     }
 
     void queueCacheTasksForMaterial(ClientMaterial &material,
@@ -535,22 +596,10 @@ DE_PIMPL(ClientResources)
                                     bool cacheGroups = true)
     {
         // Already in the queue?
-        bool alreadyQueued = false;
-        for (CacheTask *baseTask : cacheQueue)
-        {
-            if (MaterialCacheTask *task = dynamic_cast<MaterialCacheTask *>(baseTask))
-            {
-                if (&material == task->material && &contextSpec == task->spec)
-                {
-                    alreadyQueued = true;
-                    break;
-                }
-            }
-        }
-
-        if (!alreadyQueued)
+        if (!isQueued(material, contextSpec))
         {
             cacheQueue.append(new MaterialCacheTask(material, contextSpec));
+            queuedMaterials.insert(std::make_pair(&material, &contextSpec));
         }
 
         if (!cacheGroups) return;
@@ -635,6 +684,7 @@ DE_PIMPL(ClientResources)
         stateModefs.clear();
 
         clearModelList();
+        failedModelIds.clear();
 
         if (modelRepository)
         {
@@ -705,6 +755,29 @@ DE_PIMPL(ClientResources)
         return md;
     }
 
+    /**
+     * Chooses the model definition that @a def will be set up into. Definitions are
+     * chosen in reverse order, so the latest one is used for each ID and for each
+     * state/intermark/selector.
+     *
+     * @return  Index of the model definition, or -1 if @a def is overridden or invalid.
+     */
+    int chooseModelDef(const defn::Model &def)
+    {
+        // Is this an ID'd model?
+        FrameModelDef *modef = getModelDefWithId(def.gets("id"));
+        if (!modef)
+        {
+            // No, normal State-model.
+            const int statenum = DED_Definitions()->getStateNum(def.gets("state"));
+            if (statenum < 0) return -1;
+
+            modef = getModelDef(statenum + def.geti("off"), def.getf("interMark"), def.geti("selector"));
+            if (!modef) return -1; // Overridden or invalid definition.
+        }
+        return self().indexOf(modef);
+    }
+
     String findSkinPath(const Path &skinPath, const Path &modelFilePath)
     {
         //DE_ASSERT(!skinPath.isEmpty());
@@ -889,6 +962,110 @@ DE_PIMPL(ClientResources)
         return maxRadius;
     }
 
+    /**
+     * Adds a loaded model to the repository.
+     */
+    void addModel(modelid_t modelId, FrameModel *mdl, const String &path)
+    {
+        mdl->setModelId(modelId);
+        modelRepository->setUserPointer(modelId, mdl);
+
+        defineAllSkins(*mdl);
+
+        // Enlarge the vertex buffers in preparation for drawing of this model.
+        if (!Rend_ModelExpandVertexBuffers(mdl->vertexCount()))
+        {
+            LOG_RES_WARNING("Model \"%s\" contains more than %u max vertices (%i), it will not be rendered")
+                << NativePath(path).pretty()
+                << uint(RENDER_MAX_MODEL_VERTS) << mdl->vertexCount();
+        }
+    }
+
+    /**
+     * Loads all the model files that will be needed by the chosen definitions, before
+     * the definitions are set up. The files are read in the calling thread, but the
+     * models are decoded in parallel in worker threads. Models are added to the
+     * repository once all of them are done, so setupModel() will find them there.
+     * Files that fail to load are recorded so setupModel() does not try them again.
+     */
+    void preloadModels(const List<ModelDefChoice> &chosen)
+    {
+        struct Pending
+        {
+            modelid_t id;
+            String path;
+            Block data;
+            FrameModel *model = nullptr;
+        };
+        List<Pending *> pending;
+        Set<modelid_t> queued;
+
+        auto &defs = *DED_Definitions();
+
+        for (const ModelDefChoice &choice : chosen)
+        {
+            const defn::Model def(defs.models[choice.dedIndex]);
+            for (int k = 0; k < def.subCount(); ++k)
+            {
+                const res::Uri searchPath(def.sub(k).gets("filename"));
+                if (searchPath.isEmpty()) continue;
+                try
+                {
+                    const String foundPath = App_BasePath() /
+                        fileSys().findPath(searchPath, RLF_DEFAULT, self().resClass(RC_MODEL));
+
+                    const modelid_t modelId = modelRepository->intern(foundPath);
+                    if (modelForId(modelId) || failedModelIds.contains(modelId) ||
+                        queued.contains(modelId)) continue;
+                    queued.insert(modelId);
+
+                    std::unique_ptr<FileHandle> hndl(&fileSys().openFile(foundPath, "rb"));
+                    auto *job = new Pending;
+                    job->id   = modelId;
+                    job->path = foundPath;
+                    job->data.resize(hndl->length());
+                    hndl->read(job->data.data(), job->data.size());
+                    fileSys().releaseFile(hndl->file());
+                    pending << job;
+                }
+                catch (const FS1::NotFoundError &)
+                {} // setupModel() will complain.
+            }
+        }
+
+        if (pending.isEmpty()) return;
+
+        Time begunAt;
+        {
+            TaskPool tasks;
+            const float aspect = modelAspectMod;
+            for (Pending *job : pending)
+            {
+                tasks.start([job, aspect] ()
+                {
+                    job->model = FrameModel::loadFromData(job->data, job->path, aspect);
+                });
+            }
+            tasks.waitForDone();
+        }
+
+        for (Pending *job : pending)
+        {
+            if (job->model)
+            {
+                addModel(job->id, job->model, job->path);
+            }
+            else
+            {
+                LOG_RES_WARNING("Failed to load model \"%s\"") << NativePath(job->path).pretty();
+                failedModelIds.insert(job->id);
+            }
+        }
+        LOGDEV_RES_VERBOSE("Decoded %i model files in %.2f seconds")
+            << pending.count() << begunAt.since();
+        deleteAll(pending);
+    }
+
     /**
      * Creates a modeldef based on the given DED info. A pretty straightforward
      * operation. No interlinks are set yet. Autoscaling is done and the scale
@@ -896,25 +1073,14 @@ DE_PIMPL(ClientResources)
      * Model DEDs, each State that has a model will have a pointer to the one
      * with the smallest intermark (start of a chain).
      */
-    void setupModel(const defn::Model &def)
+    void setupModel(const defn::Model &def, FrameModelDef *modef)
     {
         LOG_AS("setupModel");
+        DE_ASSERT(modef);
 
         auto &defs = *DED_Definitions();
 
         const int modelScopeFlags = def.geti("flags") | defs.modelFlags;
-        const int statenum = defs.getStateNum(def.gets("state"));
-
-        // Is this an ID'd model?
-        FrameModelDef *modef = getModelDefWithId(def.gets("id"));
-        if (!modef)
-        {
-            // No, normal State-model.
-            if (statenum < 0) return;
-
-            modef = getModelDef(statenum + def.geti("off"), def.getf("interMark"), def.geti("selector"));
-            if (!modef) return; // Overridden or invalid definition.
-        }
 
         // Init modef info (state & intermark already set).
         modef->def       = def;
@@ -955,7 +1121,7 @@ DE_PIMPL(ClientResources)
                 // Have we already loaded this?
                 modelid_t modelId = modelRepository->intern(foundPath);
                 FrameModel *mdl = modelForId(modelId);
-                if (!mdl)
+                if (!mdl && !failedModelIds.contains(modelId))
                 {
                     // Attempt to load it in now.
                     std::unique_ptr<FileHandle> hndl(&fileSys().openFile(foundPath, "rb"));
@@ -966,22 +1132,8 @@ DE_PIMPL(ClientResources)
                     fileSys().releaseFile(hndl->file());
 
                     // Loaded?
-                    if (mdl)
-                    {
-                        // Add it to the repository,
-                        mdl->setModelId(modelId);
-                        modelRepository->setUserPointer(modelId, mdl);
-
-                        defineAllSkins(*mdl);
-
-                        // Enlarge the vertex buffers in preparation for drawing of this model.
-                        if (!Rend_ModelExpandVertexBuffers(mdl->vertexCount()))
-                        {
-                            LOG_RES_WARNING("Model \"%s\" contains more than %u max vertices (%i), it will not be rendered")
-                                << NativePath(foundPath).pretty()
-                                << uint(RENDER_MAX_MODEL_VERTS) << mdl->vertexCount();
-                        }
-                    }
+                    if (mdl) addModel(modelId, mdl, foundPath);
+                    else     failedModelIds.insert(modelId);
                 }
 
                 // Loaded?
@@ -1826,6 +1978,7 @@ void ClientResources::initModels()
 
     d->clearModelList();
     d->modefs.clear();
+    d->failedModelIds.clear();
 
     delete d->modelRepository;
     d->modelRepository = new StringPool();
@@ -1842,17 +1995,26 @@ void ClientResources::initModels()
         d->stateModefs[i] = -1;
     }
 
-    // Read in the model files and their data.
     // Use the latest definition available for each sprite ID.
+    List<Impl::ModelDefChoice> chosen;
     for (int i = int(defs.models.size()) - 1; i >= 0; --i)
     {
-        if (!(i % 100))
+        const int modefIndex = d->chooseModelDef(defs.models[i]);
+        if (modefIndex >= 0) chosen << Impl::ModelDefChoice{i, modefIndex};
+    }
+
+    // Read in the model files and their data.
+    d->preloadModels(chosen);
+
+    for (const Impl::ModelDefChoice &choice : chosen)
+    {
+        if (!(choice.dedIndex % 100))
         {
             // This may take a while, so keep updating the progress.
-            Con_SetProgress(130 + 70*(defs.models.size() - i)/defs.models.size());
+            Con_SetProgress(130 + 70*(defs.models.size() - choice.dedIndex)/defs.models.size());
         }
 
-        d->setupModel(defs.models[i]);
+        d->setupModel(defs.models[choice.dedIndex], &d->modefs[choice.modefIndex]);
     }
 
     // Create interlinks. Note that the order in which the defs were loaded
@@ -1940,6 +2102,12 @@ void ClientResources::purgeCacheQueue()
 {
     deleteAll(d->cacheQueue);
     d->cacheQueue.clear();
+    d->queuedMaterials.clear();
+}
+
+TextureContentCache &ClientResources::textureContentCache()
+{
+    return d->textureContentCache;
 }
 
 void ClientResources::processCacheQueue()
@@ -2191,6 +2359,30 @@ D_CMD(ListFonts)
     return true;
 }
 
+D_CMD(TextureResidency)
+{
+    DE_UNUSED(src, argc, argv);
+
+    const TextureResidency &res = ClientTexture::Variant::residency();
+    const TextureResidency::Counters counters = res.counters();
+    const double MiB = 1024.0 * 1024.0;
+
+    LOG_MSG(_E(b) "Texture residency:");
+    LOG_MSG("  Resident: %i textures, %.1f MiB (peak %.1f MiB)")
+        << counters.residentCount << counters.residentBytes / MiB << counters.peakBytes / MiB;
+    if (res.budget())
+    {
+        LOG_MSG("  Budget: %.1f MiB") << res.budget() / MiB;
+    }
+    else
+    {
+        LOG_MSG("  Budget: unlimited");
+    }
+    LOG_MSG("  Released: %i textures, %.1f MiB; %i prepared again")
+        << counters.evictionCount << counters.evictedBytes / MiB << counters.reloadCount;
+    return true;
+}
+
 #ifdef DE_DEBUG
 D_CMD(PrintFontStats)
 {
@@ -2218,6 +2410,7 @@ void ClientResources::consoleRegister() // static
     C_CMD("listfonts",      "ss",   ListFonts)
     C_CMD("listfonts",      "s",    ListFonts)
     C_CMD("listfonts",      "",     ListFonts)
+    C_CMD("texresidency",   "",     TextureResidency)
 #ifdef DE_DEBUG
     C_CMD("fontstats",      NULL,   PrintFontStats)
 #endif
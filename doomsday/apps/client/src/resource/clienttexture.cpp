@@ -26,6 +26,7 @@
 #include <de/error.h>
 #include <de/log.h>
 #include <de/legacy/memory.h>
+#include <unordered_map>
 
 using namespace de;
 
@@ -34,6 +35,9 @@ DE_PIMPL(ClientTexture)
     /// Set of (render-) context variants.
     Variants variants;
 
+    /// Variants by the hash of their specification.
+    std::unordered_multimap<duint32, Variant *> variantsBySpec;
+
     Impl(Public *i) : Base(i) {}
 
     ~Impl()
@@ -43,6 +47,7 @@ DE_PIMPL(ClientTexture)
 
     void clearVariants()
     {
+        variantsBySpec.clear();
         while (!variants.isEmpty())
         {
             ClientTexture::Variant *variant = variants.takeFirst();
@@ -82,8 +87,11 @@ ClientTexture::Variant *ClientTexture::chooseVariant(ChooseVariantMethod method,
                                                      const TextureVariantSpec &spec,
                                                      bool canCreate)
 {
-    for (Variant *variant : d->variants)
+    // Only variants whose specification has the same hash can match.
+    const auto found = d->variantsBySpec.equal_range(spec.hash());
+    for (auto i = found.first; i != found.second; ++i)
     {
+        Variant *variant = i->second;
         const TextureVariantSpec &cand = variant->spec();
         switch (method)
         {
@@ -121,8 +129,10 @@ ClientTexture::Variant *ClientTexture::chooseVariant(ChooseVariantMethod method,
 
     if (!canCreate) return 0;
 
-    d->variants.push_back(new Variant(*this, spec));
-    return d->variants.back();
+    Variant *variant = new Variant(*this, spec);
+    d->variants.push_back(variant);
+    d->variantsBySpec.insert(std::make_pair(variant->spec().hash(), variant));
+    return variant;
 }
 
 ClientTexture::Variant *ClientTexture::prepareVariant(const TextureVariantSpec &spec)
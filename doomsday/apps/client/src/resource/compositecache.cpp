@@ -0,0 +1,120 @@
+/** @file compositecache.cpp  Cache for building composite textures.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "de_base.h"
+#include "resource/compositecache.h"
+
+#include <de/hash.h>
+#include <de/log.h>
+#include <map>
+
+using namespace de;
+
+static thread_local CompositeCache *activeCompositeCache;
+
+DE_PIMPL_NOREF(CompositeCache)
+{
+    CompositeCache *previouslyActive = nullptr;
+    dsize maxBytes;
+    dsize totalBytes = 0;
+    Hash<duint64, DecodedPatch> patches;
+    std::map<std::pair<const res::Texture *, int>, Block> composites;
+    int hits = 0;
+    int misses = 0;
+
+    static duint64 patchKey(lumpnum_t lumpNum, int loadFlags)
+    {
+        return (duint64(duint32(loadFlags)) << 32) | duint32(lumpNum);
+    }
+
+    /// Makes room for @a bytes more.
+    void reserve(dsize bytes)
+    {
+        if (totalBytes + bytes > maxBytes)
+        {
+            patches.clear();
+            composites.clear();
+            totalBytes = 0;
+        }
+        totalBytes += bytes;
+    }
+};
+
+CompositeCache::CompositeCache(dsize maxBytes)
+    : d(new Impl)
+{
+    d->maxBytes = maxBytes;
+    d->previouslyActive = activeCompositeCache;
+    activeCompositeCache = this;
+}
+
+CompositeCache::~CompositeCache()
+{
+    DE_ASSERT(activeCompositeCache == this);
+    activeCompositeCache = d->previouslyActive;
+
+    if (d->hits)
+    {
+        LOGDEV_RES_VERBOSE("Composite cache: %i hits, %i misses")
+            << d->hits << d->misses;
+    }
+}
+
+const CompositeCache::DecodedPatch *CompositeCache::patch(lumpnum_t lumpNum, int loadFlags) const
+{
+    auto found = d->patches.find(Impl::patchKey(lumpNum, loadFlags));
+    if (found != d->patches.end())
+    {
+        d->hits++;
+        return &found->second;
+    }
+    d->misses++;
+    return nullptr;
+}
+
+const CompositeCache::DecodedPatch &CompositeCache::insertPatch(lumpnum_t lumpNum, int loadFlags,
+                                                                DecodedPatch decoded)
+{
+    d->reserve(decoded.pixels.size());
+    return d->patches.insert(Impl::patchKey(lumpNum, loadFlags), std::move(decoded))->second;
+}
+
+const Block *CompositeCache::composite(const res::Texture &texture, int buildFlags) const
+{
+    auto found = d->composites.find(std::make_pair(&texture, buildFlags));
+    if (found != d->composites.end())
+    {
+        d->hits++;
+        return &found->second;
+    }
+    d->misses++;
+    return nullptr;
+}
+
+void CompositeCache::insertComposite(const res::Texture &texture, int buildFlags,
+                                     const Block &pixels)
+{
+    d->reserve(pixels.size());
+    d->composites[std::make_pair(&texture, buildFlags)] = pixels;
+}
+
+CompositeCache *CompositeCache::active()
+{
+    return activeCompositeCache;
+}
@@ -28,10 +28,42 @@
 #include <de/range.h>
 #include <de/bitarray.h>
 #include <de/legacy/memory.h>
+#include <cstring>
 
 using namespace de;
 using namespace res;
 
+/**
+ * Reads model data from memory, like a FileHandle. Reading past the end yields zeros.
+ * The model loaders work on data that has already been read from the file so that
+ * they can be used in any thread.
+ */
+class ModelReader
+{
+public:
+    ModelReader(const Block &data) : _data(data) {}
+
+    size_t read(uint8_t *buffer, size_t count)
+    {
+        const size_t avail = (_pos < _data.size()? _data.size() - _pos : 0);
+        const size_t num   = de::min(count, avail);
+        if (num) std::memcpy(buffer, _data.data() + _pos, num);
+        if (num < count) std::memset(buffer + num, 0, count - num);
+        _pos += num;
+        return num;
+    }
+
+    void seek(long offset, SeekMethod whence)
+    {
+        const long base = (whence == SeekCur? long(_pos) : whence == SeekEnd? long(_data.size()) : 0);
+        _pos = size_t(de::max(0L, base + offset));
+    }
+
+private:
+    const Block &_data;
+    size_t _pos = 0;
+};
+
 bool FrameModel::DetailLevel::hasVertex(int number) const
 {
     return model.lodVertexUsage().testBit(number * model.lodCount() + level);
@@ -76,7 +108,8 @@ struct md2_header_t
 };
 #pragma pack()
 
-static bool readMd2Header(FileHandle &file, md2_header_t &hdr)
+template <typename Stream>
+static bool readMd2Header(Stream &file, md2_header_t &hdr)
 {
     size_t readBytes = file.read((uint8_t *)&hdr, sizeof(md2_header_t));
     if(readBytes < sizeof(md2_header_t)) return false;
@@ -113,7 +146,8 @@ struct dmd_header_t
 };
 #pragma pack()
 
-static bool readHeaderDmd(FileHandle &file, dmd_header_t &hdr)
+template <typename Stream>
+static bool readHeaderDmd(Stream &file, dmd_header_t &hdr)
 {
     size_t readBytes = file.read((uint8_t *)&hdr, sizeof(dmd_header_t));
     if(readBytes < sizeof(dmd_header_t)) return false;
@@ -124,7 +158,7 @@ static bool readHeaderDmd(FileHandle &file, dmd_header_t &hdr)
     return true;
 }
 
-static void *allocAndLoad(FileHandle &file, int offset, int len)
+static void *allocAndLoad(ModelReader &file, int offset, int len)
 {
     uint8_t *ptr = (uint8_t *) M_Malloc(len);
     file.seek(offset, SeekSet);
@@ -188,7 +222,7 @@ DE_PIMPL(FrameModel)
     /**
      * Note vertex Z/Y are swapped here (ordered XYZ in the serialized data).
      */
-    static FrameModel *loadMd2(FileHandle &file, float aspectScale)
+    static FrameModel *loadMd2(ModelReader &file, float aspectScale)
     {
         // Determine whether this appears to be a MD2 model.
         md2_header_t hdr;
@@ -354,7 +388,7 @@ DE_PIMPL(FrameModel)
     /**
      * Note vertex Z/Y are swapped here (ordered XYZ in the serialized data).
      */
-    static FrameModel *loadDmd(FileHandle &file, float aspectScale)
+    static FrameModel *loadDmd(ModelReader &file, float aspectScale)
     {
         // Determine whether this appears to be a DMD model.
         dmd_header_t hdr;
@@ -642,10 +676,19 @@ struct ModelFileType
     String name; ///< Symbolic name of the resource type.
     String ext;  ///< Known file extension.
 
-    FrameModel *(*loadFunc)(FileHandle &hndl, float aspectScale);
+    FrameModel *(*loadFunc)(ModelReader &file, float aspectScale);
 };
 
 FrameModel *FrameModel::loadFromFile(FileHandle &hndl, float aspectScale) //static
+{
+    Block data(hndl.length());
+    hndl.seek(0, SeekSet);
+    hndl.read(data.data(), data.size());
+    return loadFromData(data, hndl.file().composePath(), aspectScale);
+}
+
+FrameModel *FrameModel::loadFromData(const Block &data, const String &filePath,
+                                     float aspectScale) //static
 {
     LOG_AS("FrameModel");
 
@@ -657,8 +700,7 @@ FrameModel *FrameModel::loadFromFile(FileHandle &hndl, float aspectScale) //stat
 
     // Firstly, attempt to guess the resource type from the file extension.
     const ModelFileType *rtypeGuess = 0;
-    String filePath = hndl.file().composePath();
-    String ext      = filePath.fileNameExtension();
+    String ext = filePath.fileNameExtension();
     if (!ext.isEmpty())
     {
         for (const auto &rtype : modelTypes)
@@ -666,7 +708,8 @@ FrameModel *FrameModel::loadFromFile(FileHandle &hndl, float aspectScale) //stat
             if (!rtype.ext.compareWithoutCase(ext))
             {
                 rtypeGuess = &rtype;
-                if (FrameModel *mdl = rtype.loadFunc(hndl, aspectScale))
+                ModelReader reader(data);
+                if (FrameModel *mdl = rtype.loadFunc(reader, aspectScale))
                 {
                     LOG_RES_VERBOSE("Interpreted \"" + NativePath(filePath).pretty() + "\" as a " + rtype.name + " model");
                     return mdl;
@@ -682,7 +725,8 @@ FrameModel *FrameModel::loadFromFile(FileHandle &hndl, float aspectScale) //stat
         // Already tried this?
         if (&rtype == rtypeGuess) continue;
 
-        if (FrameModel *mdl = rtype.loadFunc(hndl, aspectScale))
+        ModelReader reader(data);
+        if (FrameModel *mdl = rtype.loadFunc(reader, aspectScale))
         {
             LOG_RES_VERBOSE("Interpreted \"" + NativePath(filePath).pretty() + "\" as a " + rtype.name + " model");
             return mdl;
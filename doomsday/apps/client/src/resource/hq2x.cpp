@@ -18,15 +18,16 @@
  * http://www.gnu.org/licenses</small>
  */
 
-#include "de_platform.h"
 #include "resource/hq2x.h"
+#include "gl/gl_texkernels.h"
 
 #include <cstdlib>
+#include <cstring>
 #include <de/legacy/memory.h>
-#include "dd_main.h"
-#include "dd_types.h"
-#include "dd_share.h"
-#include "resource/image.h"
+#include <de/app.h>
+#include <de/math.h>
+#include <de/taskpool.h>
+#include <thread>
 
 /*
  * RGB color space.
@@ -151,7 +152,6 @@
 #define PIXEL11_100     Interp10(pOut+BpL+4, w[5], w[6], w[8]);
 
 static uint32_t lutBGR888toYUV888[32*64*32];
-static uint32_t YUV1, YUV2;
 
 void LerpColor(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3, uint32_t f1,
     uint32_t f2, uint32_t f3)
@@ -188,14 +188,22 @@ void LerpColor(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3, uint32_t f1,
     *((uint32_t*)pc) = ABGR8888_PACK(out[3], out[2], out[1], out[0]);
 }
 
-static __inline int Diff(uint32_t c1, uint32_t c2)
+/**
+ * Returns the key used for comparing colors: YUV888, with the high byte set if the
+ * color is not fully transparent (see ImageKernels::hqPatterns).
+ */
+static __inline uint32_t ColorKey(uint32_t c)
 {
-    YUV1 = ABGR8888toYUV888(c1);
-    YUV2 = ABGR8888toYUV888(c2);
-    return ( ((ABGR8888_COMP(3, c1) != 0) != ((ABGR8888_COMP(3, c2) != 0))) ||
-             (abs(int(YUV1 & YUV888_Ymask) - int(YUV2 & YUV888_Ymask)) > ((trY & (int)0xFF) << 16)) ||
-             (abs(int(YUV1 & YUV888_Umask) - int(YUV2 & YUV888_Umask)) > ((trU & (int)0xFF) << 8)) ||
-             (abs(int(YUV1 & YUV888_Vmask) - int(YUV2 & YUV888_Vmask)) > ((trV & (int)0xFF)) ));
+    return ABGR8888toYUV888(c) | (ABGR8888_COMP(3, c) != 0? 0xFF000000u : 0);
+}
+
+/// Compares two color keys (see ColorKey()).
+static __inline int Diff(uint32_t k1, uint32_t k2)
+{
+    return ( ((k1 & 0xFF000000u) != (k2 & 0xFF000000u)) ||
+             (abs(int(k1 & YUV888_Ymask) - int(k2 & YUV888_Ymask)) > ((trY & (int)0xFF) << 16)) ||
+             (abs(int(k1 & YUV888_Umask) - int(k2 & YUV888_Umask)) > ((trU & (int)0xFF) << 8)) ||
+             (abs(int(k1 & YUV888_Vmask) - int(k2 & YUV888_Vmask)) > ((trV & (int)0xFF)) ));
 }
 
 static __inline void Transl(uint8_t* pc, uint32_t c)
@@ -260,21 +268,79 @@ void GL_InitSmartFilterHQ2x(void)
             }
 }
 
-uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags)
-{
 #define BPP             (4) // Bytes Per Pixel.
-#define OFFSET(x, y)    (BPP*(y)*width + BPP*(x))
 
-    assert(src);
+namespace {
+
+/**
+ * Source image with a one pixel border, so that the neighbors of each pixel can be
+ * read without checking for the edges. The border is either wrapped around or
+ * clamped to the edge pixels. Color keys (see ColorKey()) are stored alongside.
+ */
+struct PaddedImage
+{
+    int width;
+    int height;
+    int stride;
+    uint32_t *colors;
+    uint32_t *keys;
+
+    PaddedImage(const uint8_t *src, int width, int height, bool wrapH, bool wrapV)
+        : width(width), height(height), stride(width + 2)
     {
-    dd_bool wrapH = (flags & ICF_UPSCALE_SAMPLE_WRAPH) != 0;
-    dd_bool wrapV = (flags & ICF_UPSCALE_SAMPLE_WRAPV) != 0;
-    int pattern, flag, BpL, xA, xB, yA, yB;
-    uint8_t* pOut, *dst;
-    uint32_t w[10];
+        const size_t count = size_t(stride) * (height + 2);
+        colors = (uint32_t *) M_Malloc(sizeof(uint32_t) * count);
+        keys   = (uint32_t *) M_Malloc(sizeof(uint32_t) * count);
 
-    if(width <= 0 || height <= 0)
-        return 0;
+        for(int y = 0; y < height; ++y)
+        {
+            const uint8_t *in = src + BPP * width * y;
+            uint32_t *out = colors + stride * (y + 1) + 1;
+            for(int x = 0; x < width; ++x, in += BPP)
+            {
+                // Read as little-endian.
+                out[x] = uint32_t(in[0]) | (uint32_t(in[1]) << 8) | (uint32_t(in[2]) << 16) |
+                         (uint32_t(in[3]) << 24);
+            }
+            out[-1]    = out[wrapH? width - 1 : 0];
+            out[width] = out[wrapH? 0 : width - 1];
+        }
+        std::memcpy(colors, colors + stride * (wrapV? height : 1), sizeof(uint32_t) * stride);
+        std::memcpy(colors + stride * (height + 1), colors + stride * (wrapV? 1 : height),
+                    sizeof(uint32_t) * stride);
+
+        for(size_t i = 0; i < count; ++i)
+        {
+            keys[i] = ColorKey(colors[i]);
+        }
+    }
+
+    ~PaddedImage()
+    {
+        M_Free(keys);
+        M_Free(colors);
+    }
+
+    /// Returns the colors of row @a y (-1...height). Indices -1...width are valid.
+    const uint32_t *colorRow(int y) const { return colors + stride * (y + 1) + 1; }
+
+    /// Returns the keys of row @a y (-1...height). Indices -1...width are valid.
+    const uint32_t *keyRow(int y) const { return keys + stride * (y + 1) + 1; }
+};
+
+} // namespace
+
+/**
+ * Upscales the source rows [y0, y1) into @a dst, which is the full output image.
+ */
+static void upscaleRows(const PaddedImage &image, uint8_t *dst, int y0, int y1)
+{
+    const ImageKernels &kernels = GL_ImageKernels();
+    const int width = image.width;
+    const int BpL = BPP * 2 * width; // (Out) Bytes per Line.
+    uint8_t *patterns = (uint8_t *) M_Malloc(width);
+    uint8_t *pOut = dst + 2 * BpL * y0;
+    uint32_t w[10], p[10];
 
     // +----+----+----+
     // | w1 | w2 | w3 |
@@ -284,91 +350,28 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
     // | w7 | w8 | w9 |
     // +----+----+----+
 
-    if(0 == (dst = (uint8_t *) M_Malloc(BPP * 2 * width * height * 2)))
-        App_Error("GL_SmartFilterHQ2x: Failed on allocation of %lu bytes for "
-                  "output buffer.", (unsigned long) (BPP * 2 * width * height * 2));
-
-    pOut = dst;
-    BpL = BPP * 2 * width; // (Out) Bytes per Line.
-    { int y;
-    for(y = 0; y < height; ++y)
+    for(int y = y0; y < y1; ++y)
     {
-        { int x;
-        for(x = 0; x < width; ++x)
-        {
-            w[5] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x, y)) ) );
-
-            // Horizontal neighbors.
-            if(wrapH)
-            {
-                w[4] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x == 0? width-1 : x-1, y)) ) );
-                w[6] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x == width-1? 0 : x+1, y)) ) );
-            }
-            else
-            {
-                if(x != 0)
-                    w[4] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x-1, y)) ) );
-                else
-                    w[4] = w[5];
+        const uint32_t *above = image.colorRow(y - 1);
+        const uint32_t *row   = image.colorRow(y);
+        const uint32_t *below = image.colorRow(y + 1);
+        const uint32_t *keysAbove = image.keyRow(y - 1);
+        const uint32_t *keysRow   = image.keyRow(y);
+        const uint32_t *keysBelow = image.keyRow(y + 1);
 
-                if(x != width-1)
-                    w[6] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x+1, y)) ) );
-                else
-                    w[6] = w[5];
-            }
-
-            // Vertical neighbors.
-            if(wrapV)
-            {
-                w[2] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x, y == 0? height-1 : y-1)) ) );
-                w[8] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x, y == height-1? 0 : y+1)) ) );
-            }
-            else
-            {
-                if(y != 0)
-                    w[2] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x, y-1)) ) );
-                else
-                    w[2] = w[5];
-
-                if(y != height-1)
-                    w[8] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x, y+1)) ) );
-                else
-                    w[8] = w[5];
-            }
-
-            // Corners.
-            xA =        x == 0? ( wrapH?  width-1 : 0) : x-1;
-            xB =  x == width-1? (!wrapH?  width-1 : 0) : x+1;
-            yA =        y == 0? ( wrapV? height-1 : 0) : y-1;
-            yB = y == height-1? (!wrapV? height-1 : 0) : y+1;
-
-            w[1] = DD_ULONG( *( (uint32_t*)(src + OFFSET(xA, yA)) ) );
-            w[7] = DD_ULONG( *( (uint32_t*)(src + OFFSET(xA, yB)) ) );
-            w[3] = DD_ULONG( *( (uint32_t*)(src + OFFSET(xB, yA)) ) );
-            w[9] = DD_ULONG( *( (uint32_t*)(src + OFFSET(xB, yB)) ) );
+        kernels.hqPatterns(keysAbove, keysRow, keysBelow, width, patterns);
 
-            pattern = 0;
-            flag = 1;
-            YUV1 = ABGR8888toYUV888(w[5]);
-
-            { int k;
-            for(k = 1; k <= 9; ++k)
-            {
-                if(k == 5)
-                    continue;
+        for(int x = 0; x < width; ++x)
+        {
+            w[1] = above[x - 1]; w[2] = above[x]; w[3] = above[x + 1];
+            w[4] = row  [x - 1]; w[5] = row  [x]; w[6] = row  [x + 1];
+            w[7] = below[x - 1]; w[8] = below[x]; w[9] = below[x + 1];
 
-                if(w[k] != w[5])
-                {
-                    YUV2 = ABGR8888toYUV888(w[k]);
-                    if(((ABGR8888_COMP(3, w[5]) != 0) != (ABGR8888_COMP(3, w[k]) != 0)) ||
-                       (abs(int(YUV1 & YUV888_Ymask) - int(YUV2 & YUV888_Ymask)) > ((trY & (int)0xFF) << 16)) ||
-                       (abs(int(YUV1 & YUV888_Umask) - int(YUV2 & YUV888_Umask)) > ((trU & (int)0xFF) << 8)) ||
-                       (abs(int(YUV1 & YUV888_Vmask) - int(YUV2 & YUV888_Vmask)) > ((trV & (int)0xFF) )) )
-                        pattern |= flag;
-                }
-                flag <<= 1;
-            }}
+            p[1] = keysAbove[x - 1]; p[2] = keysAbove[x]; p[3] = keysAbove[x + 1];
+            p[4] = keysRow  [x - 1]; p[5] = keysRow  [x]; p[6] = keysRow  [x + 1];
+            p[7] = keysBelow[x - 1]; p[8] = keysBelow[x]; p[9] = keysBelow[x + 1];
 
+            const int pattern = patterns[x];
             switch(pattern)
             {
             case 0:
@@ -463,7 +466,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 18:
             case 50: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
@@ -473,7 +476,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 80:
             case 81: {
-                    PIXEL00_20 PIXEL01_22 PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL00_20 PIXEL01_22 PIXEL10_21 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -483,7 +486,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 72:
             case 76: {
-                    PIXEL00_21 PIXEL01_20 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_20 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
@@ -493,7 +496,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 10:
             case 138: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
@@ -529,7 +532,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 22:
             case 54: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
@@ -539,7 +542,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 208:
             case 209: {
-                    PIXEL00_20 PIXEL01_22 PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL00_20 PIXEL01_22 PIXEL10_21 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -549,7 +552,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 104:
             case 108: {
-                    PIXEL00_21 PIXEL01_20 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_20 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -559,7 +562,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 11:
             case 139: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
@@ -569,7 +572,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 19:
             case 51: {
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL00_11 PIXEL01_10}
                     else {
@@ -578,7 +581,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 146:
             case 178: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10 PIXEL11_12}
                     else {
@@ -587,7 +590,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 84:
             case 85: {
-                    PIXEL00_20 if(Diff(w[6], w[8]))
+                    PIXEL00_20 if(Diff(p[6], p[8]))
                     {
                     PIXEL01_11 PIXEL11_10}
                     else {
@@ -596,7 +599,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 112:
             case 113: {
-                    PIXEL00_20 PIXEL01_22 if(Diff(w[6], w[8]))
+                    PIXEL00_20 PIXEL01_22 if(Diff(p[6], p[8]))
                     {
                     PIXEL10_12 PIXEL11_10}
                     else {
@@ -605,7 +608,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 200:
             case 204: {
-                    PIXEL00_21 PIXEL01_20 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_20 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10 PIXEL11_11}
                     else {
@@ -614,7 +617,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 73:
             case 77: {
-                    if(Diff(w[8], w[4]))
+                    if(Diff(p[8], p[4]))
                     {
                     PIXEL00_12 PIXEL10_10}
                     else {
@@ -623,7 +626,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 42:
             case 170: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10 PIXEL10_11}
                     else {
@@ -632,7 +635,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 14:
             case 142: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10 PIXEL01_12}
                     else {
@@ -665,13 +668,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 26:
             case 31: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
@@ -681,13 +684,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 82:
             case 214: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL10_21 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -697,13 +700,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 88:
             case 248: {
-                    PIXEL00_21 PIXEL01_22 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_22 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_20}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -713,13 +716,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 74:
             case 107: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    PIXEL01_21 if(Diff(w[8], w[4]))
+                    PIXEL01_21 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -728,7 +731,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_22 break;
               }
             case 27: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
@@ -737,7 +740,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL01_10 PIXEL10_22 PIXEL11_21 break;
               }
             case 86: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
@@ -746,7 +749,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_21 PIXEL11_10 break;
               }
             case 216: {
-                    PIXEL00_21 PIXEL01_22 PIXEL10_10 if(Diff(w[6], w[8]))
+                    PIXEL00_21 PIXEL01_22 PIXEL10_10 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -755,7 +758,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 106: {
-                    PIXEL00_10 PIXEL01_21 if(Diff(w[8], w[4]))
+                    PIXEL00_10 PIXEL01_21 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -764,7 +767,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_22 break;
               }
             case 30: {
-                    PIXEL00_10 if(Diff(w[2], w[6]))
+                    PIXEL00_10 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
@@ -773,7 +776,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_22 PIXEL11_21 break;
               }
             case 210: {
-                    PIXEL00_22 PIXEL01_10 PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL00_22 PIXEL01_10 PIXEL10_21 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -782,7 +785,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 120: {
-                    PIXEL00_21 PIXEL01_22 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_22 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -791,7 +794,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_10 break;
               }
             case 75: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
@@ -836,13 +839,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL00_12 PIXEL01_22 PIXEL10_22 PIXEL11_12 break;
               }
             case 58: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
@@ -851,13 +854,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 PIXEL11_21 break;
               }
             case 83: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL10_21 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -866,13 +869,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 92: {
-                    PIXEL00_21 PIXEL01_11 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_11 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -881,13 +884,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 202: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    PIXEL01_21 if(Diff(w[8], w[4]))
+                    PIXEL01_21 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
@@ -896,13 +899,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_11 break;
               }
             case 78: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL01_12 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
@@ -911,13 +914,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_22 break;
               }
             case 154: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
@@ -926,13 +929,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_22 PIXEL11_12 break;
               }
             case 114: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL10_12 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -941,13 +944,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 89: {
-                    PIXEL00_12 PIXEL01_22 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_22 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -956,25 +959,25 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 90: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    if(Diff(w[8], w[4]))
+                    if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -984,7 +987,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 55:
             case 23: {
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL00_11 PIXEL01_0}
                     else {
@@ -993,7 +996,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 182:
             case 150: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0 PIXEL11_12}
                     else {
@@ -1002,7 +1005,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 213:
             case 212: {
-                    PIXEL00_20 if(Diff(w[6], w[8]))
+                    PIXEL00_20 if(Diff(p[6], p[8]))
                     {
                     PIXEL01_11 PIXEL11_0}
                     else {
@@ -1011,7 +1014,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 241:
             case 240: {
-                    PIXEL00_20 PIXEL01_22 if(Diff(w[6], w[8]))
+                    PIXEL00_20 PIXEL01_22 if(Diff(p[6], p[8]))
                     {
                     PIXEL10_12 PIXEL11_0}
                     else {
@@ -1020,7 +1023,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 236:
             case 232: {
-                    PIXEL00_21 PIXEL01_20 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_20 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0 PIXEL11_11}
                     else {
@@ -1029,7 +1032,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 109:
             case 105: {
-                    if(Diff(w[8], w[4]))
+                    if(Diff(p[8], p[4]))
                     {
                     PIXEL00_12 PIXEL10_0}
                     else {
@@ -1038,7 +1041,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 171:
             case 43: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0 PIXEL10_11}
                     else {
@@ -1047,7 +1050,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 143:
             case 15: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0 PIXEL01_12}
                     else {
@@ -1055,7 +1058,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_22 PIXEL11_20 break;
               }
             case 124: {
-                    PIXEL00_21 PIXEL01_11 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_11 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -1064,7 +1067,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_10 break;
               }
             case 203: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
@@ -1073,7 +1076,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL01_21 PIXEL10_10 PIXEL11_11 break;
               }
             case 62: {
-                    PIXEL00_10 if(Diff(w[2], w[6]))
+                    PIXEL00_10 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
@@ -1082,7 +1085,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 PIXEL11_21 break;
               }
             case 211: {
-                    PIXEL00_11 PIXEL01_10 PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL00_11 PIXEL01_10 PIXEL10_21 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1091,7 +1094,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 118: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
@@ -1100,7 +1103,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_12 PIXEL11_10 break;
               }
             case 217: {
-                    PIXEL00_12 PIXEL01_22 PIXEL10_10 if(Diff(w[6], w[8]))
+                    PIXEL00_12 PIXEL01_22 PIXEL10_10 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1109,7 +1112,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 110: {
-                    PIXEL00_10 PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL00_10 PIXEL01_12 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -1118,7 +1121,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_22 break;
               }
             case 155: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
@@ -1151,13 +1154,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL00_11 PIXEL01_12 PIXEL10_21 PIXEL11_11 break;
               }
             case 220: {
-                    PIXEL00_21 PIXEL01_11 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_11 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1166,13 +1169,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 158: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
@@ -1181,13 +1184,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_22 PIXEL11_12 break;
               }
             case 234: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    PIXEL01_21 if(Diff(w[8], w[4]))
+                    PIXEL01_21 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -1196,13 +1199,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_11 break;
               }
             case 242: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL10_12 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1211,13 +1214,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 59: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
@@ -1226,13 +1229,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 PIXEL11_21 break;
               }
             case 121: {
-                    PIXEL00_12 PIXEL01_22 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_22 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_20}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -1241,13 +1244,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 87: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL10_21 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -1256,13 +1259,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 79: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL01_12 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
@@ -1271,25 +1274,25 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_22 break;
               }
             case 122: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    if(Diff(w[8], w[4]))
+                    if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_20}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -1298,25 +1301,25 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 94: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    if(Diff(w[8], w[4]))
+                    if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -1325,25 +1328,25 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 218: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    if(Diff(w[8], w[4]))
+                    if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1352,25 +1355,25 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 91: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    if(Diff(w[8], w[4]))
+                    if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -1391,13 +1394,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL00_20 PIXEL01_11 PIXEL10_20 PIXEL11_12 break;
               }
             case 186: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
@@ -1406,13 +1409,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 PIXEL11_12 break;
               }
             case 115: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
                     {
                     PIXEL01_70}
-                    PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL10_12 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -1421,13 +1424,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 93: {
-                    PIXEL00_12 PIXEL01_11 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_11 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
                     {
                     PIXEL10_70}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -1436,13 +1439,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 206: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
                     {
                     PIXEL00_70}
-                    PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL01_12 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
@@ -1452,7 +1455,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 205:
             case 201: {
-                    PIXEL00_12 PIXEL01_20 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_20 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_10}
                     else
@@ -1462,7 +1465,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 174:
             case 46: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_10}
                     else
@@ -1472,7 +1475,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 179:
             case 147: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_10}
                     else
@@ -1482,7 +1485,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 117:
             case 116: {
-                    PIXEL00_20 PIXEL01_11 PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL00_20 PIXEL01_11 PIXEL10_12 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_10}
                     else
@@ -1497,13 +1500,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL00_11 PIXEL01_12 PIXEL10_12 PIXEL11_11 break;
               }
             case 126: {
-                    PIXEL00_10 if(Diff(w[2], w[6]))
+                    PIXEL00_10 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    if(Diff(w[8], w[4]))
+                    if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -1512,13 +1515,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_10 break;
               }
             case 219: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    PIXEL01_10 PIXEL10_10 if(Diff(w[6], w[8]))
+                    PIXEL01_10 PIXEL10_10 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1527,7 +1530,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 125: {
-                    if(Diff(w[8], w[4]))
+                    if(Diff(p[8], p[4]))
                     {
                     PIXEL00_12 PIXEL10_0}
                     else {
@@ -1535,7 +1538,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL01_11 PIXEL11_10 break;
               }
             case 221: {
-                    PIXEL00_12 if(Diff(w[6], w[8]))
+                    PIXEL00_12 if(Diff(p[6], p[8]))
                     {
                     PIXEL01_11 PIXEL11_0}
                     else {
@@ -1543,7 +1546,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_10 break;
               }
             case 207: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0 PIXEL01_12}
                     else {
@@ -1551,7 +1554,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_10 PIXEL11_11 break;
               }
             case 238: {
-                    PIXEL00_10 PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL00_10 PIXEL01_12 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0 PIXEL11_11}
                     else {
@@ -1559,7 +1562,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 190: {
-                    PIXEL00_10 if(Diff(w[2], w[6]))
+                    PIXEL00_10 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0 PIXEL11_12}
                     else {
@@ -1567,7 +1570,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 break;
               }
             case 187: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0 PIXEL10_11}
                     else {
@@ -1575,7 +1578,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL01_10 PIXEL11_12 break;
               }
             case 243: {
-                    PIXEL00_11 PIXEL01_10 if(Diff(w[6], w[8]))
+                    PIXEL00_11 PIXEL01_10 if(Diff(p[6], p[8]))
                     {
                     PIXEL10_12 PIXEL11_0}
                     else {
@@ -1583,7 +1586,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 119: {
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL00_11 PIXEL01_0}
                     else {
@@ -1592,7 +1595,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 237:
             case 233: {
-                    PIXEL00_12 PIXEL01_20 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_20 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -1602,7 +1605,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 175:
             case 47: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
@@ -1612,7 +1615,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 183:
             case 151: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
@@ -1622,7 +1625,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
               }
             case 245:
             case 244: {
-                    PIXEL00_20 PIXEL01_11 PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL00_20 PIXEL01_11 PIXEL10_12 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1631,13 +1634,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 250: {
-                    PIXEL00_10 PIXEL01_10 if(Diff(w[8], w[4]))
+                    PIXEL00_10 PIXEL01_10 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_20}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1646,13 +1649,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 123: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    PIXEL01_10 if(Diff(w[8], w[4]))
+                    PIXEL01_10 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -1661,13 +1664,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_10 break;
               }
             case 95: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
@@ -1676,13 +1679,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_10 PIXEL11_10 break;
               }
             case 222: {
-                    PIXEL00_10 if(Diff(w[2], w[6]))
+                    PIXEL00_10 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    PIXEL10_10 if(Diff(w[6], w[8]))
+                    PIXEL10_10 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1691,13 +1694,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 252: {
-                    PIXEL00_21 PIXEL01_11 if(Diff(w[8], w[4]))
+                    PIXEL00_21 PIXEL01_11 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_20}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1706,13 +1709,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 249: {
-                    PIXEL00_12 PIXEL01_22 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_22 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_100}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1721,13 +1724,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 235: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    PIXEL01_21 if(Diff(w[8], w[4]))
+                    PIXEL01_21 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -1736,13 +1739,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_11 break;
               }
             case 111: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_100}
-                    PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL01_12 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -1751,13 +1754,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_22 break;
               }
             case 63: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_100}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
@@ -1766,13 +1769,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 PIXEL11_21 break;
               }
             case 159: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
@@ -1781,13 +1784,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_22 PIXEL11_12 break;
               }
             case 215: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_100}
-                    PIXEL10_21 if(Diff(w[6], w[8]))
+                    PIXEL10_21 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1796,13 +1799,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 246: {
-                    PIXEL00_22 if(Diff(w[2], w[6]))
+                    PIXEL00_22 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL10_12 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1811,19 +1814,19 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 254: {
-                    PIXEL00_10 if(Diff(w[2], w[6]))
+                    PIXEL00_10 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    if(Diff(w[8], w[4]))
+                    if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_20}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1832,13 +1835,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 253: {
-                    PIXEL00_12 PIXEL01_11 if(Diff(w[8], w[4]))
+                    PIXEL00_12 PIXEL01_11 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_100}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1847,19 +1850,19 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 251: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    PIXEL01_10 if(Diff(w[8], w[4]))
+                    PIXEL01_10 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_100}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1868,13 +1871,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 239: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_100}
-                    PIXEL01_12 if(Diff(w[8], w[4]))
+                    PIXEL01_12 if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -1883,19 +1886,19 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_11 break;
               }
             case 127: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_100}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_20}
-                    if(Diff(w[8], w[4]))
+                    if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
@@ -1904,13 +1907,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL11_10 break;
               }
             case 191: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_100}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
@@ -1919,19 +1922,19 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     PIXEL10_11 PIXEL11_12 break;
               }
             case 223: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_20}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_100}
-                    PIXEL10_10 if(Diff(w[6], w[8]))
+                    PIXEL10_10 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1940,13 +1943,13 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 247: {
-                    PIXEL00_11 if(Diff(w[2], w[6]))
+                    PIXEL00_11 if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_100}
-                    PIXEL10_12 if(Diff(w[6], w[8]))
+                    PIXEL10_12 if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1955,25 +1958,25 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             case 255: {
-                    if(Diff(w[4], w[2]))
+                    if(Diff(p[4], p[2]))
                     {
                     PIXEL00_0}
                     else
                     {
                     PIXEL00_100}
-                    if(Diff(w[2], w[6]))
+                    if(Diff(p[2], p[6]))
                     {
                     PIXEL01_0}
                     else
                     {
                     PIXEL01_100}
-                    if(Diff(w[8], w[4]))
+                    if(Diff(p[8], p[4]))
                     {
                     PIXEL10_0}
                     else
                     {
                     PIXEL10_100}
-                    if(Diff(w[6], w[8]))
+                    if(Diff(p[6], p[8]))
                     {
                     PIXEL11_0}
                     else
@@ -1982,17 +1985,53 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                     break;
               }
             default:
-                App_Error("GL_SmartFilterHQ2x: Invalid pattern %i.", pattern);
+                DE_ASSERT_FAIL("GL_SmartFilterHQ2x: Invalid pattern");
                 break;
             }
             pOut += 2 * BPP;
-        }}
+        }
         pOut += BpL;
-    }}
+    }
 
-    return dst;
+    M_Free(patterns);
+}
+
+uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int wrapH, int wrapV)
+{
+    assert(src);
+
+    if(width <= 0 || height <= 0)
+        return 0;
+
+    uint8_t *dst = (uint8_t *) M_Malloc(BPP * 2 * width * height * 2);
+
+    const PaddedImage image(src, width, height, wrapH != 0, wrapV != 0);
+
+    // Large images are split into bands of rows that are upscaled in parallel. Images
+    // prepared in worker threads are not split further, as those threads are already
+    // running in the task pool.
+    int bandCount = 1;
+    if(de::App::inMainThread() && width * height >= 256 * 256)
+    {
+        bandCount = de::clamp(1, int(std::thread::hardware_concurrency()), height / 32);
     }
+    if(bandCount > 1)
+    {
+        de::TaskPool tasks;
+        for(int i = 1; i < bandCount; ++i)
+        {
+            const int y0 = height * i / bandCount;
+            const int y1 = height * (i + 1) / bandCount;
+            tasks.start([&image, dst, y0, y1] () { upscaleRows(image, dst, y0, y1); });
+        }
+        upscaleRows(image, dst, 0, height / bandCount);
+        tasks.waitForDone();
+    }
+    else
+    {
+        upscaleRows(image, dst, 0, height);
+    }
+    return dst;
+}
 
-#undef OFFSET
 #undef BPP
-}
@@ -20,6 +20,7 @@
 
 #include "de_platform.h"
 #include "resource/image.h"
+#include "resource/compositecache.h"
 #include "resource/tga.h"
 #include "dd_main.h"
 #include "gl/gl_tex.h"
@@ -495,14 +496,13 @@ static Source loadExternalTexture(image_t &image, String encodedSearchPath,
  *
  * @param dst               The composite buffer (drawn to).
  * @param dstDimensions     Pixel dimensions of @a dst.
- * @param src               The component image to be composited (read from).
+ * @param src               The component image to be composited (read from):
+ *                          color indices followed by alpha values.
  * @param srcDimensions     Pixel dimensions of @a src.
  * @param origin            Coordinates (topleft) in @a dst to draw @a src.
- *
- * @todo Optimize: Should be redesigned to composite whole rows -ds
  */
 static void compositePaletted(dbyte *dst, const Vec2ui &dstDimensions,
-    const IByteArray &src, const Vec2ui &srcDimensions, const Vec2i &origin)
+    const Block &src, const Vec2ui &srcDimensions, const Vec2i &origin)
 {
     if (dstDimensions == Vec2ui()) return;
     if (srcDimensions == Vec2ui()) return;
@@ -510,27 +510,33 @@ static void compositePaletted(dbyte *dst, const Vec2ui &dstDimensions,
     const int srcW = srcDimensions.x;
     const int srcH = srcDimensions.y;
     const size_t srcPels = srcW * srcH;
+    DE_ASSERT(src.size() >= 2 * srcPels);
 
     const int dstW = dstDimensions.x;
     const int dstH = dstDimensions.y;
     const size_t dstPels = dstW * dstH;
 
-    int dstX, dstY;
+    // Clip the drawn area to the composite.
+    const int srcX0 = de::max(0, -origin.x);
+    const int srcX1 = de::min(srcW, dstW - origin.x);
+    const int srcY0 = de::max(0, -origin.y);
+    const int srcY1 = de::min(srcH, dstH - origin.y);
+    if (srcX0 >= srcX1 || srcY0 >= srcY1) return;
 
-    for (int srcY = 0; srcY < srcH; ++srcY)
-    for (int srcX = 0; srcX < srcW; ++srcX)
+    for (int srcY = srcY0; srcY < srcY1; ++srcY)
     {
-        dstX = origin.x + srcX;
-        dstY = origin.y + srcY;
-        if (dstX < 0 || dstX >= dstW) continue;
-        if (dstY < 0 || dstY >= dstH) continue;
+        const dbyte *srcColor = src.data() + srcY * srcW;
+        const dbyte *srcAlpha = srcColor + srcPels;
+        dbyte *dstColor = dst + (origin.y + srcY) * dstW + origin.x;
+        dbyte *dstAlpha = dstColor + dstPels;
 
-        dbyte srcAlpha;
-        src.get(srcY * srcW + srcX + srcPels, &srcAlpha, 1);
-        if (srcAlpha)
+        for (int srcX = srcX0; srcX < srcX1; ++srcX)
         {
-            src.get(srcY * srcW + srcX, &dst[dstY * dstW + dstX], 1);
-            dst[dstY * dstW + dstX + dstPels] = srcAlpha;
+            if (srcAlpha[srcX])
+            {
+                dstColor[srcX] = srcColor[srcX];
+                dstAlpha[srcX] = srcAlpha[srcX];
+            }
         }
     }
 }
@@ -630,40 +636,69 @@ static Source loadPatchComposite(image_t &image, const Texture &tex,
     image.size      = Vec2ui(tex.width(), tex.height());
     image.paletteId = App_Resources().colorPalettes().defaultColorPalette();
 
-    image.pixels = (uint8_t *) M_Calloc(2 * image.size.x * image.size.y);
+    const dsize pixelBytes = 2 * image.size.x * image.size.y;
+    image.pixels = (uint8_t *) M_Calloc(pixelBytes);
 
-    const res::Composite &texDef = *reinterpret_cast<res::Composite *>(tex.userDataPointer());
-    DE_FOR_EACH_CONST(res::Composite::Components, i, texDef.components())
+    // When many textures are being prepared, patches and composites are reused.
+    CompositeCache *cache = CompositeCache::active();
+    const int buildFlags = (maskZero? 1 : 0) | (useZeroOriginIfOneComponent? 2 : 0);
+    const Block *cached = (cache? cache->composite(tex, buildFlags) : nullptr);
+    if (cached && cached->size() == pixelBytes)
     {
-        File1 &file           = App_FileSystem().lump(i->lumpNum());
-        ByteRefArray fileData = ByteRefArray(file.cache(), file.size());
-
-        // A DOOM patch?
-        if (Patch::recognize(fileData))
+        std::memcpy(image.pixels, cached->data(), pixelBytes);
+    }
+    else
+    {
+        const res::Composite &texDef = *reinterpret_cast<res::Composite *>(tex.userDataPointer());
+        DE_FOR_EACH_CONST(res::Composite::Components, i, texDef.components())
         {
-            try
-            {
-                Flags loadFlags;
-                if (maskZero) loadFlags |= Patch::MaskZero;
+            const int loadFlags = (maskZero? Patch::MaskZero : 0);
 
-                PatchMetadata info;
-                Block patchImg = Patch::load(fileData, &info, loadFlags);
+            CompositeCache::DecodedPatch decoded;
+            const CompositeCache::DecodedPatch *patch =
+                    (cache? cache->patch(i->lumpNum(), loadFlags) : nullptr);
+            if (!patch)
+            {
+                File1 &file           = App_FileSystem().lump(i->lumpNum());
+                ByteRefArray fileData = ByteRefArray(file.cache(), file.size());
 
-                Vec2i origin = i->origin();
-                if (useZeroOriginIfOneComponent && texDef.componentCount() == 1)
+                // A DOOM patch?
+                if (Patch::recognize(fileData))
                 {
-                    origin = Vec2i(0, 0);
+                    try
+                    {
+                        decoded.pixels = Patch::load(fileData, &decoded.info, Flags(loadFlags));
+                    }
+                    catch (const IByteArray::OffsetError &)
+                    {
+                        // Ignore this error.
+                        decoded = CompositeCache::DecodedPatch();
+                    }
                 }
 
-                // Draw the patch in the buffer.
-                compositePaletted(image.pixels, image.size,
-                                  patchImg, info.dimensions, origin);
+                file.unlock();
+
+                patch = (cache? &cache->insertPatch(i->lumpNum(), loadFlags, std::move(decoded))
+                              : &decoded);
             }
-            catch (const IByteArray::OffsetError &)
-            {} // Ignore this error.
+
+            if (patch->pixels.isEmpty()) continue;
+
+            Vec2i origin = i->origin();
+            if (useZeroOriginIfOneComponent && texDef.componentCount() == 1)
+            {
+                origin = Vec2i(0, 0);
+            }
+
+            // Draw the patch in the buffer.
+            compositePaletted(image.pixels, image.size,
+                              patch->pixels, patch->info.dimensions, origin);
         }
 
-        file.unlock();
+        if (cache)
+        {
+            cache->insertComposite(tex, buildFlags, Block(image.pixels, pixelBytes));
+        }
     }
 
     if (maskZero || palettedIsMasked(image.pixels, image.size.x, image.size.y))
@@ -59,6 +59,8 @@ static DGLuint prepareFlaremap(ClientTexture *texture, int oldIdx)
     {
         if (const TextureVariant *variant = texture->prepareVariant(Rend_HaloTextureSpec()))
         {
+            // The GL-name is kept for drawing halos.
+            variant->pin();
             return variant->glName();
         }
         // Dang...
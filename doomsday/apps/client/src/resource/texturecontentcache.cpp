@@ -0,0 +1,307 @@
+/** @file texturecontentcache.cpp  Persistent cache of processed texture content.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "de_base.h"
+#include "resource/texturecontentcache.h"
+#include "resource/clientresources.h"
+#include "render/rend_main.h" // fillOutlines
+
+#include <doomsday/res/colorpalettes.h>
+#include <de/directoryfeed.h>
+#include <de/filesystem.h>
+#include <de/folder.h>
+#include <de/legacy/memory.h>
+#include <de/logbuffer.h>
+#include <de/nativefile.h>
+#include <de/reader.h>
+#include <de/writer.h>
+#include <atomic>
+#include <map>
+#include <thread>
+
+using namespace de;
+
+byte texContentCacheEnabled = true;
+int  texContentCacheSize    = 512;
+
+/// Incremented whenever image processing changes in a way that affects the output.
+static const duint32 TEXCONTENT_CACHE_VERSION = 2;
+
+DE_STATIC_STRING(texContentCachePath, "/home/cache/textures");
+
+DE_PIMPL_NOREF(TextureContentCache), public Lockable
+{
+    bool initialized = false;
+    NativePath folder;
+
+    /// Cache entries in order of last use (oldest first).
+    std::multimap<Time, String> byLastUse;
+    Hash<String, Time> lastUse;
+    dint64 totalBytes = 0;
+    Hash<String, dint64> entrySize;
+
+    NativePath entryPath(const String &name) const
+    {
+        return folder / name;
+    }
+
+    void touch(const String &name, const Time &at)
+    {
+        auto found = lastUse.find(name);
+        if (found != lastUse.end())
+        {
+            auto range = byLastUse.equal_range(found->second);
+            for (auto i = range.first; i != range.second; ++i)
+            {
+                if (i->second == name) { byLastUse.erase(i); break; }
+            }
+        }
+        lastUse.insert(name, at);
+        byLastUse.insert(std::make_pair(at, name));
+    }
+
+    void forget(const String &name)
+    {
+        auto found = lastUse.find(name);
+        if (found == lastUse.end()) return;
+        auto range = byLastUse.equal_range(found->second);
+        for (auto i = range.first; i != range.second; ++i)
+        {
+            if (i->second == name) { byLastUse.erase(i); break; }
+        }
+        lastUse.erase(found);
+        totalBytes -= entrySize[name];
+        entrySize.remove(name);
+    }
+
+    /// Removes least recently used entries until the cache fits in its size limit.
+    void evict()
+    {
+        const dint64 limit = dint64(de::max(0, texContentCacheSize)) * 1024 * 1024;
+        while (totalBytes > limit && !byLastUse.empty())
+        {
+            const String name = byLastUse.begin()->second;
+            forget(name);
+            entryPath(name).remove();
+        }
+    }
+};
+
+TextureContentCache::TextureContentCache() : d(new Impl)
+{}
+
+void TextureContentCache::initialize()
+{
+    DE_ASSERT_IN_MAIN_THREAD();
+    LOG_AS("TextureContentCache");
+
+    DE_GUARD(d);
+    if (d->initialized) return;
+
+    try
+    {
+        Folder &folder = FS::get().makeFolder(texContentCachePath());
+        d->folder = folder.correspondingNativePath();
+        if (d->folder.isEmpty()) return;
+
+        folder.forContents([this] (const String &name, File &file)
+        {
+            const dint64 size = dint64(file.status().size);
+            d->entrySize.insert(name, size);
+            d->totalBytes += size;
+            d->touch(name, file.status().modifiedAt);
+            return LoopContinue;
+        });
+        d->initialized = true;
+        d->evict();
+
+        LOG_RES_VERBOSE("%i entries (%.1f MiB) in %s")
+            << d->lastUse.size() << (d->totalBytes / 1048576.0) << d->folder.pretty();
+    }
+    catch (const Error &er)
+    {
+        LOG_RES_WARNING("Cache not available: %s") << er.asText();
+    }
+}
+
+bool TextureContentCache::isEnabled() const
+{
+    return texContentCacheEnabled && texContentCacheSize > 0 && d->initialized;
+}
+
+Block TextureContentCache::key(const image_t &source, const TextureVariantSpec &spec) const
+{
+    Block id;
+    Writer writer(id);
+    writer << TEXCONTENT_CACHE_VERSION
+           << duint32(source.size.x) << duint32(source.size.y)
+           << duint32(source.pixelSize) << dint32(source.flags);
+
+    // Processing that involves the palette depends on the actual colors.
+    if (source.paletteId)
+    {
+        const res::ColorPalette &palette =
+                App_Resources().colorPalettes().colorPalette(source.paletteId);
+        writer << dint32(palette.colorCount());
+        for (int i = 0; i < palette.colorCount(); ++i)
+        {
+            const Vec3ub color = palette.color(i);
+            writer << color.x << color.y << color.z;
+        }
+    }
+    else
+    {
+        writer << dint32(0);
+    }
+
+    // Only the parts of the specification that affect processing are included.
+    writer << dint32(spec.type);
+    if (spec.type == TST_GENERAL)
+    {
+        writer << dint32(spec.variant.flags & ~TSF_INTERNAL_MASK)
+               << dbyte(spec.variant.toAlpha)
+               << dbyte(fillOutlines)
+               // The smart filter of uploading may be applied, too.
+               << dint32(useSmartFilter)
+               << dbyte(spec.variant.gammaCorrection)
+               << texGamma;
+    }
+
+    writer << Block(source.pixels, source.size.x * source.size.y * source.pixelSize);
+    return id.md5Hash();
+}
+
+bool TextureContentCache::load(const Block &key, image_t &image, Processed &processed)
+{
+    if (!isEnabled()) return false;
+
+    const String name = key.asHexadecimalText();
+    {
+        DE_GUARD(d);
+        if (!d->lastUse.contains(name)) return false;
+        d->touch(name, Time());
+    }
+    const NativePath path = d->entryPath(name);
+    try
+    {
+        Block data;
+        {
+            std::unique_ptr<NativeFile> file(NativeFile::newStandalone(path));
+            *file >> data;
+        }
+        Reader reader(data);
+        duint32 version, width, height, pixelSize;
+        dint32 flags;
+        dbyte paletted;
+        Block pixels;
+        reader.withHeader()
+                >> version
+                >> processed.format >> processed.baMul >> processed.hiMul >> processed.loMul
+                >> width >> height >> pixelSize >> flags >> paletted
+                >> pixels;
+        if (version != TEXCONTENT_CACHE_VERSION ||
+            pixels.size() != dsize(width) * height * pixelSize)
+        {
+            throw Error("TextureContentCache::load", "Entry is outdated or corrupt");
+        }
+
+        Image_ClearPixelData(image);
+        image.size      = image_t::Size(width, height);
+        image.pixelSize = int(pixelSize);
+        image.flags     = flags;
+        if (!paletted) image.paletteId = 0;
+        image.pixels = reinterpret_cast<uint8_t *>(M_Malloc(pixels.size()));
+        std::memcpy(image.pixels, pixels.data(), pixels.size());
+
+        // Remember the use in later sessions, too.
+        DirectoryFeed::setFileModifiedTime(path, Time());
+        return true;
+    }
+    catch (const Error &er)
+    {
+        LOGDEV_RES_WARNING("Failed to read cached texture content %s: %s")
+            << name << er.asText();
+
+        DE_GUARD(d);
+        d->forget(name);
+        path.remove();
+    }
+    return false;
+}
+
+void TextureContentCache::store(const Block &key, const image_t &image, const Processed &processed)
+{
+    if (!isEnabled()) return;
+
+    const String name = key.asHexadecimalText();
+    Block data;
+    Writer(data).withHeader()
+            << TEXCONTENT_CACHE_VERSION
+            << processed.format << processed.baMul << processed.hiMul << processed.loMul
+            << duint32(image.size.x) << duint32(image.size.y) << duint32(image.pixelSize)
+            << dint32(image.flags) << dbyte(image.paletteId != 0)
+            << Block(image.pixels, image.size.x * image.size.y * image.pixelSize);
+
+    // Several threads may store the same content at the same time, so each one writes
+    // its own temporary file. The complete entry then replaces any existing one.
+    static std::atomic_uint tempCounter { 0 };
+    const NativePath path     = d->entryPath(name);
+    const NativePath tempPath = path.toString() +
+            Stringf(".%zx-%u.tmp", std::hash<std::thread::id>()(std::this_thread::get_id()),
+                    tempCounter++);
+    try
+    {
+        {
+            std::unique_ptr<NativeFile> file(NativeFile::newStandalone(tempPath));
+            file->setMode(File::Write);
+            file->clear();
+            *file << data;
+            file->release();
+        }
+        if (!tempPath.renameReplacing(path))
+        {
+            tempPath.remove();
+            return;
+        }
+    }
+    catch (const Error &er)
+    {
+        LOGDEV_RES_WARNING("Failed to write cached texture content %s: %s")
+            << name << er.asText();
+        return;
+    }
+
+    DE_GUARD(d);
+    d->forget(name);
+    d->entrySize.insert(name, dint64(data.size()));
+    d->totalBytes += dint64(data.size());
+    d->touch(name, Time());
+    d->evict();
+}
+
+void TextureContentCache::clear()
+{
+    DE_GUARD(d);
+    while (!d->byLastUse.empty())
+    {
+        const String name = d->byLastUse.begin()->second;
+        d->forget(name);
+        d->entryPath(name).remove();
+    }
+}
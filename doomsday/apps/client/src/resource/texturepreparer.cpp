@@ -0,0 +1,235 @@
+/** @file texturepreparer.cpp  Asynchronous texture variant preparation.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "de_base.h"
+#include "resource/texturepreparer.h"
+#include "resource/clientresources.h"
+#include "gl/gl_tex.h"
+#include "gl/texturecontent.h"
+
+#include <doomsday/res/colorpalettes.h>
+#include <de/logbuffer.h>
+#include <de/taskpool.h>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace de;
+
+static thread_local TexturePreparer *activePreparer;
+
+static std::mutex preparersMutex;
+static std::set<TexturePreparer *> allPreparers;
+
+DE_PIMPL_NOREF(TexturePreparer)
+{
+    struct Job
+    {
+        const ClientTexture::Variant *variant = nullptr;
+        // Copied so that the worker never needs to access the variant.
+        GLuint glName = 0;
+        TextureVariantSpec spec;
+        const res::TextureManifest *manifest = nullptr;
+        image_t image;
+        const res::ColorPalette *palette = nullptr;  ///< Of a color-indexed image.
+        bool findAverageColor = false;  ///< Not yet known for the texture.
+        ColorRawf averageColor;
+        texturecontent_t content;
+        uint8_t *filteredPixels = nullptr;  ///< Referenced by the content, if not null.
+        bool cancelled = false;
+    };
+
+    TexturePreparer *previouslyActive = nullptr;
+    int maxPending;
+    TaskPool tasks;
+
+    std::mutex mutex;
+    std::condition_variable jobFinished;
+    List<Job *> pending;  ///< Being processed in workers.
+    List<Job *> finished; ///< Ready to be submitted.
+
+    ~Impl()
+    {
+        // Any jobs still around were cancelled or their variants have been
+        // submitted already; just free the data.
+        for (Job *job : finished)
+        {
+            Image_ClearPixelData(job->image);
+            M_Free(job->filteredPixels);
+            delete job;
+        }
+    }
+
+    void processInWorker(Job *job)
+    {
+        if (job->findAverageColor)
+        {
+            // Used for the placeholders of later preparations of the texture.
+            const image_t &img = job->image;
+            if (job->palette)
+            {
+                FindAverageColorIdx(img.pixels, img.size.x, img.size.y, *job->palette,
+                                    false, &job->averageColor);
+            }
+            else
+            {
+                FindAverageColor(img.pixels, img.size.x, img.size.y, img.pixelSize,
+                                 &job->averageColor);
+            }
+        }
+
+        GL_PrepareTextureContent(job->content, job->glName, job->image, job->spec,
+                                 *job->manifest);
+
+        // Upscaling is done here rather than in the thread that uploads.
+        job->filteredPixels = GL_SmartFilterTextureContent(job->content);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.removeOne(job);
+        finished << job;
+        jobFinished.notify_all();
+    }
+
+    void submitFinished()
+    {
+        List<Job *> jobs;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::swap(jobs, finished);
+        }
+        for (Job *job : jobs)
+        {
+            if (!job->cancelled)
+            {
+                auto *variant = const_cast<ClientTexture::Variant *>(job->variant);
+                if (job->findAverageColor)
+                {
+                    recordAverageColor(variant->base(), job->averageColor);
+                }
+                variant->finishPrepare(job->content, job->image);
+            }
+            Image_ClearPixelData(job->image);
+            M_Free(job->filteredPixels);
+            delete job;
+        }
+    }
+
+    static void recordAverageColor(ClientTexture &tex, const ColorRawf &color)
+    {
+        if (tex.analysisDataPointer(ClientTexture::AverageColorAnalysis)) return;
+
+        auto *ac = (averagecolor_analysis_t *) M_Malloc(sizeof(*ac));
+        ac->color = color;
+        tex.setAnalysisDataPointer(ClientTexture::AverageColorAnalysis, ac);
+    }
+
+    void cancel(const ClientTexture::Variant &variant)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Job *job : pending)  if (job->variant == &variant) job->cancelled = true;
+        for (Job *job : finished) if (job->variant == &variant) job->cancelled = true;
+    }
+};
+
+TexturePreparer::TexturePreparer(int maxPending)
+    : d(new Impl)
+{
+    d->maxPending = maxPending > 0? maxPending
+                                  : de::max(2, 2 * int(std::thread::hardware_concurrency()));
+    d->previouslyActive = activePreparer;
+    activePreparer = this;
+
+    std::lock_guard<std::mutex> lock(preparersMutex);
+    allPreparers.insert(this);
+}
+
+TexturePreparer::~TexturePreparer()
+{
+    waitForAll();
+
+    DE_ASSERT(activePreparer == this);
+    activePreparer = d->previouslyActive;
+
+    std::lock_guard<std::mutex> lock(preparersMutex);
+    allPreparers.erase(this);
+}
+
+void TexturePreparer::poll()
+{
+    DE_ASSERT(activePreparer == this);
+    d->submitFinished();
+}
+
+void TexturePreparer::waitForAll()
+{
+    DE_ASSERT(activePreparer == this);
+    d->tasks.waitForDone();
+    d->submitFinished();
+}
+
+void TexturePreparer::process(ClientTexture::Variant &variant, image_t &image)
+{
+    DE_ASSERT(activePreparer == this);
+    DE_ASSERT(variant.glName() != 0);
+
+    auto *job     = new Impl::Job;
+    job->variant  = &variant;
+    job->glName   = variant.glName();
+    job->spec     = variant.spec();
+    job->manifest = &variant.base().manifest();
+    job->image    = image;
+    Image_Init(image); // Owned by the job now.
+
+    const image_t &img = job->image;
+    if (!(img.flags & IMGF_IS_MASKED) && (img.paletteId || img.pixelSize >= 3) &&
+        !variant.base().analysisDataPointer(ClientTexture::AverageColorAnalysis))
+    {
+        job->findAverageColor = true;
+        if (img.paletteId)
+        {
+            job->palette = &App_Resources().colorPalettes().colorPalette(img.paletteId);
+        }
+    }
+
+    {
+        // Apply back-pressure: don't let the amount of pending image data grow
+        // unbounded while the workers are busy.
+        std::unique_lock<std::mutex> lock(d->mutex);
+        d->jobFinished.wait(lock, [this] () { return d->pending.sizei() < d->maxPending; });
+        d->pending << job;
+    }
+    d->tasks.start([this, job] () { d->processInWorker(job); });
+
+    d->submitFinished();
+}
+
+TexturePreparer *TexturePreparer::active()
+{
+    return activePreparer;
+}
+
+void TexturePreparer::forget(const ClientTexture::Variant &variant)
+{
+    std::lock_guard<std::mutex> lock(preparersMutex);
+    for (TexturePreparer *preparer : allPreparers)
+    {
+        preparer->d->cancel(variant);
+    }
+}
@@ -0,0 +1,183 @@
+/** @file textureresidency.cpp  Texture memory budget and eviction of unused textures.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "resource/textureresidency.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+struct TextureResidency::Impl
+{
+    struct Entry
+    {
+        uint64_t bytes;
+        int lastUsed;
+    };
+
+    Backend &backend;
+    mutable std::mutex mutex;
+    uint64_t budget = 0;
+    int minIdleFrames = 2;
+    int lastEvictFrame = -1;
+    std::unordered_map<Item, Entry> resident;
+    std::unordered_set<Item> evicted;
+    std::unordered_set<Item> pinned;
+    Counters counters;
+
+    Impl(Backend &backend) : backend(backend) {}
+
+    void removeResident(Item item)
+    {
+        auto found = resident.find(item);
+        if (found == resident.end()) return;
+        counters.residentBytes -= found->second.bytes;
+        resident.erase(found);
+    }
+};
+
+TextureResidency::TextureResidency(Backend &backend)
+    : d(new Impl(backend))
+{}
+
+TextureResidency::~TextureResidency()
+{}
+
+void TextureResidency::setBudget(uint64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    d->budget = bytes;
+}
+
+uint64_t TextureResidency::budget() const
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    return d->budget;
+}
+
+void TextureResidency::setMinIdleFrames(int frames)
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    d->minIdleFrames = std::max(1, frames);
+}
+
+void TextureResidency::add(Item item, uint64_t bytes, int frame)
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    d->removeResident(item);
+    d->resident[item] = Impl::Entry{bytes, frame};
+    d->counters.residentBytes += bytes;
+    d->counters.peakBytes = std::max(d->counters.peakBytes, d->counters.residentBytes);
+    if (d->evicted.erase(item))
+    {
+        d->counters.reloadCount++;
+    }
+}
+
+void TextureResidency::touch(Item item, int frame)
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    auto found = d->resident.find(item);
+    if (found != d->resident.end())
+    {
+        found->second.lastUsed = frame;
+    }
+}
+
+void TextureResidency::pin(Item item)
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    d->pinned.insert(item);
+}
+
+bool TextureResidency::isPinned(Item item) const
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    return d->pinned.count(item) != 0;
+}
+
+void TextureResidency::remove(Item item)
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    d->removeResident(item);
+    d->evicted.erase(item);
+    d->pinned.erase(item);
+}
+
+int TextureResidency::evictIdle(int frame)
+{
+    std::vector<Item> victims;
+    {
+        std::lock_guard<std::mutex> lock(d->mutex);
+        if (!d->budget || d->counters.residentBytes <= d->budget) return 0;
+        if (frame == d->lastEvictFrame) return 0;
+        d->lastEvictFrame = frame;
+
+        // Least recently used first.
+        std::vector<std::pair<int, Item>> candidates;
+        for (const auto &entry : d->resident)
+        {
+            if (frame - entry.second.lastUsed >= d->minIdleFrames &&
+                !d->pinned.count(entry.first))
+            {
+                candidates.emplace_back(entry.second.lastUsed, entry.first);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [] (const std::pair<int, Item> &a, const std::pair<int, Item> &b) {
+            return a.first < b.first;
+        });
+
+        // Leave some headroom so that eviction isn't needed again right away.
+        const uint64_t target = d->budget - d->budget / 8;
+        for (const auto &candidate : candidates)
+        {
+            if (d->counters.residentBytes <= target) break;
+            const uint64_t bytes = d->resident[candidate.second].bytes;
+            d->removeResident(candidate.second);
+            d->counters.evictionCount++;
+            d->counters.evictedBytes += bytes;
+            victims.push_back(candidate.second);
+        }
+    }
+
+    for (Item item : victims)
+    {
+        d->backend.evict(item);
+    }
+
+    // Remember the evictions so that reloads can be counted.
+    std::lock_guard<std::mutex> lock(d->mutex);
+    for (Item item : victims)
+    {
+        if (!d->resident.count(item)) d->evicted.insert(item);
+    }
+    return int(victims.size());
+}
+
+TextureResidency::Counters TextureResidency::counters() const
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    Counters counters = d->counters;
+    counters.residentCount = d->resident.size();
+    return counters;
+}
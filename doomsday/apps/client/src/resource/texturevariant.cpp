@@ -26,8 +26,10 @@
 #include "gl/texturecontent.h"
 
 #include "resource/image.h" // GL_LoadSourceImage
+#include "resource/texturepreparer.h"
 
 #include "render/rend_main.h" // misc global vars awaiting new home
+#include "render/viewports.h" // R_FrameCount
 
 #include <doomsday/res/colorpalettes.h>
 #include <doomsday/res/texture.h>
@@ -37,6 +39,25 @@
 
 using namespace de;
 
+int texMemoryBudget = 0;
+
+/// Number of frames a variant must be unused before its texture can be released.
+static const int TEXTURE_MIN_IDLE_FRAMES = 35;
+
+namespace {
+
+/// Releases the GL textures of variants evicted by the residency manager.
+struct VariantEvictor : public TextureResidency::Backend
+{
+    void evict(TextureResidency::Item item) override
+    {
+        auto *variant = static_cast<const ClientTexture::Variant *>(item);
+        const_cast<ClientTexture::Variant *>(variant)->release();
+    }
+};
+
+} // namespace
+
 variantspecification_t::variantspecification_t()
     : context(TC_UNKNOWN)
     , flags(0)
@@ -93,6 +114,37 @@ bool variantspecification_t::operator == (const variantspecification_t &other) c
     return 1; // Equal.
 }
 
+/// Combines @a value into a running FNV-1a hash.
+static inline duint32 combineSpecHash(duint32 hash, duint32 value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        hash = (hash ^ ((value >> (8 * i)) & 0xff)) * 16777619u;
+    }
+    return hash;
+}
+
+duint32 variantspecification_t::hash() const
+{
+    // Must agree with operator ==.
+    duint32 h = 2166136261u;
+    h = combineSpecHash(h, duint32(context));
+    h = combineSpecHash(h, duint32(flags));
+    h = combineSpecHash(h, duint32(wrapS));
+    h = combineSpecHash(h, duint32(wrapT));
+    h = combineSpecHash(h, duint32(mipmapped));
+    h = combineSpecHash(h, duint32(noStretch));
+    h = combineSpecHash(h, duint32(gammaCorrection));
+    h = combineSpecHash(h, duint32(toAlpha));
+    h = combineSpecHash(h, duint32(border));
+    if (flags & TSF_HAS_COLORPALETTE_XLAT)
+    {
+        h = combineSpecHash(h, duint32(tClass));
+        h = combineSpecHash(h, duint32(tMap));
+    }
+    return h;
+}
+
 GLenum variantspecification_t::glMinFilter() const
 {
     if (minFilter >= 0) // Constant logical value.
@@ -143,6 +195,11 @@ bool detailvariantspecification_t::operator == (const detailvariantspecification
     return contrast == other.contrast; // Equal.
 }
 
+duint32 detailvariantspecification_t::hash() const
+{
+    return contrast;
+}
+
 bool TextureVariantSpec::operator == (const TextureVariantSpec &other) const
 {
     if(this == &other) return true; // trivial
@@ -156,6 +213,17 @@ bool TextureVariantSpec::operator == (const TextureVariantSpec &other) const
     return false;
 }
 
+duint32 TextureVariantSpec::hash() const
+{
+    switch(type)
+    {
+    case TST_GENERAL: return combineSpecHash(TST_GENERAL, variant.hash());
+    case TST_DETAIL:  return combineSpecHash(TST_DETAIL,  detailVariant.hash());
+    }
+    DE_ASSERT_FAIL("Invalid texture variant specification type");
+    return 0;
+}
+
 static String nameForGLTextureWrapMode(GLenum mode)
 {
     if(mode == GL_REPEAT) return "repeat";
@@ -277,6 +345,9 @@ DE_PIMPL(ClientTexture::Variant)
     /// Prepared coordinates for the bottom right of the texture minus border.
     float s, t;
 
+    /// Content is being processed by a TexturePreparer.
+    bool pending = false;
+
     Impl(Public *i, ClientTexture &generalCase, const TextureVariantSpec &spec)
         : Base(i)
         , texture(generalCase)
@@ -503,11 +574,48 @@ static void performImageAnalyses(const image_t &image,
     }
 }
 
+/**
+ * Uploads a single texel as the content of @a glName. This is drawn until the processed
+ * image is uploaded. If the average color of @a tex is already known (the preparer
+ * records it), the texel has that color. Otherwise, and for masked
+ * and luminance images, the texel is transparent, so nothing is drawn in the meantime.
+ */
+static void uploadPlaceholderTexture(GLuint glName, const image_t &image,
+                                     const ClientTexture &tex)
+{
+    uint8_t texel[4] = { 0, 0, 0, 0 };
+    if(!(image.flags & IMGF_IS_MASKED) && (image.paletteId || image.pixelSize >= 3))
+    {
+        if(const auto *ac = reinterpret_cast<const averagecolor_analysis_t *>(
+                   tex.analysisDataPointer(ClientTexture::AverageColorAnalysis)))
+        {
+            for(int i = 0; i < 3; ++i)
+            {
+                texel[i] = uint8_t(de::clamp(0, int(ac->color.rgb[i] * 255 + .5f), 255));
+            }
+            texel[3] = 255;
+        }
+    }
+
+    texturecontent_t c;
+    GL_InitTextureContent(&c);
+    c.name   = glName;
+    c.format = DGL_RGBA;
+    c.pixels = texel;
+    c.width  = 1;
+    c.height = 1;
+    c.flags  = TXCF_NO_COMPRESSION;
+    GL_UploadTextureContent(c, gfx::Deferred);
+}
+
 uint ClientTexture::Variant::prepare()
 {
     // Have we already prepared this?
     if(isPrepared())
+    {
+        residency().touch(this, R_FrameCount());
         return d->glTexName;
+    }
 
     LOG_AS("TextureVariant::prepare");
 
@@ -534,9 +642,31 @@ uint ClientTexture::Variant::prepare()
         d->texSource = source;
     }
 
+    // Process the image in a worker thread, if possible.
+    if(TexturePreparer *preparer = TexturePreparer::active())
+    {
+        uploadPlaceholderTexture(d->glTexName, image, d->texture);
+        d->pending = true;
+        preparer->process(*this, image);
+        return d->glTexName;
+    }
+
     // Prepare texture content for uploading.
     texturecontent_t c;
     GL_PrepareTextureContent(c, d->glTexName, image, d->spec, d->texture.manifest());
+    finishPrepare(c, image);
+
+    // We're done with the image data.
+    Image_ClearPixelData(image);
+
+    return d->glTexName;
+}
+
+void ClientTexture::Variant::finishPrepare(const texturecontent_t &c, const image_t &image)
+{
+    LOG_AS("TextureVariant::prepare");
+
+    d->pending = false;
 
     /**
      * Calculate GL texture coordinates based on the image dimensions. The
@@ -567,6 +697,8 @@ uint ClientTexture::Variant::prepare()
     gfx::UploadMethod uploadMethod = GL_ChooseUploadMethod(&c);
     GL_UploadTextureContent(c, uploadMethod);
 
+    residency().add(this, GL_TextureContentSize(c), R_FrameCount());
+
     LOGDEV_RES_XVERBOSE("Prepared \"%s\" variant (glName:%u)%s",
                         d->texture.manifest().composeUri() << uint(d->glTexName) <<
                         (uploadMethod == gfx::Immediate? " while not busy!" : ""));
@@ -582,15 +714,16 @@ uint ClientTexture::Variant::prepare()
 
         d->texture.setDimensions(image.size);
     }
-
-    // We're done with the image data.
-    Image_ClearPixelData(image);
-
-    return d->glTexName;
 }
 
 void ClientTexture::Variant::release()
 {
+    residency().remove(this);
+    if (d->pending)
+    {
+        TexturePreparer::forget(*this);
+        d->pending = false;
+    }
     if (isPrepared())
     {
         Deferred_glDeleteTextures(1, (const GLuint *) &d->glTexName);
@@ -598,6 +731,11 @@ void ClientTexture::Variant::release()
     }
 }
 
+bool ClientTexture::Variant::isPending() const
+{
+    return d->pending;
+}
+
 ClientTexture &ClientTexture::Variant::base() const
 {
     return d->texture;
@@ -635,3 +773,27 @@ uint ClientTexture::Variant::glName() const
 {
     return d->glTexName;
 }
+
+void ClientTexture::Variant::pin() const
+{
+    residency().pin(this);
+}
+
+TextureResidency &ClientTexture::Variant::residency() // static
+{
+    static VariantEvictor evictor;
+    static TextureResidency residency(evictor);
+    return residency;
+}
+
+void ClientTexture::Variant::releaseIdle(int frame) // static
+{
+    TextureResidency &res = residency();
+    res.setBudget(uint64_t(de::max(0, texMemoryBudget)) * 1024 * 1024);
+    res.setMinIdleFrames(TEXTURE_MIN_IDLE_FRAMES);
+    if (int count = res.evictIdle(frame))
+    {
+        LOGDEV_RES_VERBOSE("Released %i idle textures to stay within the %i MiB budget")
+            << count << texMemoryBudget;
+    }
+}
@@ -255,8 +255,11 @@ DE_GUI_PIMPL(RendererAppearanceEditor)
                 << new ChoiceItem("No filter, linear mip",      4)
                 << new ChoiceItem("Linear filter, linear mip",  5);
 
-        matGroup->addSpace();
-        matGroup->addToggle("rend-tex-filter-smart", "2x Smart Filtering");
+        matGroup->addLabel("Smart Filtering:");
+        matGroup->addChoice("rend-tex-filter-smart")->items()
+                << new ChoiceItem("Off", 0)
+                << new ChoiceItem("2x",  1)
+                << new ChoiceItem("4x for small textures", 2);
 
         matGroup->addLabel("Bilinear Filtering:");
         matGroup->addToggle("rend-tex-filter-sprite", "Sprites");
@@ -188,17 +188,21 @@ void Mobj_SpawnDamageParticleGen(const mobj_t *mob, const mobj_t *inflictor, int
 
 #if defined(__CLIENT__)
 
-void Mobj_OriginSmoothed(const mobj_t *mob, coord_t origin[3])
+bool Mobj_OriginSmoothed(const mobj_t *mob, coord_t origin[3], bool withSRVO,
+                         bool withViewOrigin)
 {
-    if (!origin) return;
+    if (!origin) return false;
 
     V3d_Set(origin, 0, 0, 0);
-    if (!mob) return;
+    if (!mob) return false;
 
     V3d_Copy(origin, mob->origin);
 
+    // Client mobjs are drawn at an origin interpolated from the received states.
+    const bool interpolated = netState.isClient && ClMobj_HistoryOrigin(mob, origin);
+
     // Apply a Short Range Visual Offset?
-    if (useSRVO && mob->state && mob->tics >= 0)
+    if (withSRVO && !interpolated && useSRVO && mob->state && mob->tics >= 0)
     {
         const ddouble mul = mob->tics / dfloat( mob->state->tics );
         vec3d_t srvo;
@@ -215,8 +219,11 @@ void Mobj_OriginSmoothed(const mobj_t *mob, coord_t origin[3])
             // $voodoodolls: Must be a real player to use the smoothed origin.
             && mob->dPlayer->mo == mob)
         {
-            const viewdata_t *vd = &DD_Player(consolePlayer)->viewport();
-            V3d_Set(origin, vd->current.origin.x, vd->current.origin.y, vd->current.origin.z);
+            if (withViewOrigin)
+            {
+                const viewdata_t *vd = &DD_Player(consolePlayer)->viewport();
+                V3d_Set(origin, vd->current.origin.x, vd->current.origin.y, vd->current.origin.z);
+            }
         }
         // The client may have a Smoother for this object.
         else if (netState.isClient)
@@ -224,6 +231,7 @@ void Mobj_OriginSmoothed(const mobj_t *mob, coord_t origin[3])
             Smoother_Evaluate(DD_Player(P_GetDDPlayerIdx(mob->dPlayer))->smoother(), origin);
         }
     }
+    return interpolated;
 }
 
 angle_t Mobj_AngleSmoothed(const mobj_t *mob)
@@ -21,6 +21,7 @@
 
 #include "world/contact.h"
 #include "world/subsector.h"
+#include "render/lumobj.h"
 #include "render/rend_main.h"  // Rend_mapSurfaceMaterialSpec
 #include "resource/materialanimator.h"
 #include "render/walledge.h"
@@ -55,18 +56,28 @@ struct ContactSpreader
 {
     const world::Blockmap &_blockmap;
     BitArray *_spreadBlocks = nullptr;
+    duint _geometryStamp = 0;
+    int _spreadCount = 0;
 
     struct SpreadState
     {
         Contact *contact = nullptr;
         AABoxd contactBounds;
+        ContactSpreadCache *cache = nullptr; ///< Reached subspaces are recorded here.
     };
     SpreadState _spread;
 
-    ContactSpreader(const world::Blockmap &blockmap, BitArray *spreadBlocks = nullptr)
+    ContactSpreader(const world::Blockmap &blockmap, BitArray *spreadBlocks = nullptr,
+                    duint geometryStamp = 0)
         : _blockmap(blockmap)
     {
-        _spreadBlocks = spreadBlocks;
+        _spreadBlocks  = spreadBlocks;
+        _geometryStamp = geometryStamp;
+    }
+
+    int spreadCount() const
+    {
+        return _spreadCount;
     }
 
     /**
@@ -110,17 +121,82 @@ private:
      */
     void spreadContact(Contact &contact)
     {
-        ConvexSubspace &subspace = contact.objectBspLeafAtOrigin().subspace().as<ConvexSubspace>();
+        ContactSpreadCache *cache = cachedSpread(contact);
+        if (cache && cache->geometryStamp)
+        {
+            // Nothing has changed since the contact was last spread.
+            for (ConvexSubspace *subspace : cache->subspaces)
+            {
+                R_ContactList(*subspace, contact.type()).link(&contact);
+            }
+            return;
+        }
 
-        R_ContactList(subspace, contact.type()).link(&contact);
+        _spreadCount++;
 
-        // Spread to neighboring BSP leafs.
-        subspace.setValidCount(++World::validCount);
+        ConvexSubspace &subspace = contact.objectBspLeafAtOrigin().subspace().as<ConvexSubspace>();
 
         _spread.contact       = &contact;
         _spread.contactBounds = contact.objectBounds();
+        _spread.cache         = cache;
+        if (cache)
+        {
+            cache->geometryStamp = _geometryStamp;
+            cache->subspaces.clear();
+        }
+
+        linkContact(subspace);
+
+        // Spread to neighboring BSP leafs.
+        subspace.setValidCount(++World::validCount);
 
         spreadInSubspace(subspace);
+
+        _spread.cache = nullptr;
+    }
+
+    /**
+     * Finds the cached spread of the contact of a static light source. The cache is
+     * marked out of date (zero stamp) if the source has moved or changed size, or if
+     * the geometry of one of the reached subsectors has changed since.
+     *
+     * @return Cache, or @c nullptr if the contact should not be cached.
+     */
+    ContactSpreadCache *cachedSpread(const Contact &contact)
+    {
+        if (!_geometryStamp || contact.type() != ContactLumobj) return nullptr;
+
+        const Lumobj::Source *source = contact.objectAs<Lumobj>().source();
+        if (!source) return nullptr;
+
+        ContactSpreadCache &cache = source->contactSpreadCache();
+        const Vec3d origin = contact.objectOrigin();
+        const double radius = contact.objectRadius();
+        if (cache.origin != origin || !fequal(cache.radius, radius))
+        {
+            cache.origin        = origin;
+            cache.radius        = radius;
+            cache.geometryStamp = 0;
+        }
+        for (const ConvexSubspace *subspace : cache.subspaces)
+        {
+            if (!cache.geometryStamp) break;
+            if (subspace->subsector().as<Subsector>().geometryStamp() > cache.geometryStamp)
+            {
+                cache.geometryStamp = 0;
+            }
+        }
+        return &cache;
+    }
+
+    void linkContact(ConvexSubspace &subspace)
+    {
+        R_ContactList(subspace, _spread.contact->type()).link(_spread.contact);
+
+        if (_spread.cache)
+        {
+            _spread.cache->subspaces.append(&subspace);
+        }
     }
 
     void maybeSpreadOverEdge(mesh::HEdge *hedge)
@@ -232,7 +308,7 @@ private:
         // During the next step this contact will spread from the back leaf.
         backSubspace.setValidCount(World::validCount);
 
-        R_ContactList(backSubspace, _spread.contact->type()).link(_spread.contact);
+        linkContact(backSubspace);
 
         spreadInSubspace(backSubspace);
     }
@@ -257,7 +333,10 @@ private:
     }
 };
 
-void spreadContacts(const world::Blockmap &blockmap, const AABoxd &region, BitArray *spreadBlocks)
+int spreadContacts(const world::Blockmap &blockmap, const AABoxd &region, BitArray *spreadBlocks,
+                   duint geometryStamp)
 {
-    ContactSpreader(blockmap, spreadBlocks).spread(region);
+    ContactSpreader spreader(blockmap, spreadBlocks, geometryStamp);
+    spreader.spread(region);
+    return spreader.spreadCount();
 }
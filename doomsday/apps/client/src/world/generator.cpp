@@ -29,21 +29,28 @@
 #include "render/rend_particle.h"
 #include "api_sound.h"
 #include "dd_def.h"
+#include "dd_main.h"
 #include "clientapp.h"
 
+#include <doomsday/console/cmd.h>
 #include <doomsday/console/var.h>
 #include <doomsday/mesh/face.h>
 #include <doomsday/net.h>
 #include <doomsday/world/bspleaf.h>
+#include <doomsday/world/lineblockmap.h>
+#include <doomsday/world/polyobj.h>
 #include <doomsday/world/thinkers.h>
 #include <doomsday/tab_tables.h>
 #include <de/string.h>
+#include <de/taskpool.h>
 #include <de/time.h>
 #include <de/legacy/fixedpoint.h>
 #include <de/legacy/memoryzone.h>
 #include <de/legacy/timer.h>
 #include <de/legacy/vector1.h>
+#include <atomic>
 #include <cmath>
+#include <thread>
 
 using namespace de;
 using world::World;
@@ -56,6 +63,7 @@ using world::World;
 #define VECCPY(a,b)         ( a[0] = b[0], a[1] = b[1] )
 
 static float particleSpawnRate = 1; // Unmodified (cvar).
+static bool  particleSoundsMuted;   // While benchmarking.
 
 /**
  * The offset is spherical and random.
@@ -127,8 +135,10 @@ Vec3d Generator::origin() const
 
 void Generator::clearParticles()
 {
-    Z_Free(_pinfo);
-    _pinfo = nullptr;
+    Z_Free(_particles.block());
+    _particles.setBlock(nullptr, 0);
+    Z_Free(_stageForces);
+    _stageForces = nullptr;
 }
 
 void Generator::configureFromDef(const ded_ptcgen_t *newDef)
@@ -143,8 +153,9 @@ void Generator::configureFromDef(const ded_ptcgen_t *newDef)
 
     def    = newDef;
     _flags = Flags(def->flags);
-    _pinfo = (ParticleInfo *) Z_Calloc(sizeof(ParticleInfo) * count, PU_MAP, 0);
+    _particles.setBlock(Z_Calloc(ParticleArrays::blockSize(count), PU_MAP, 0), count);
     stages = (ParticleStage *) Z_Calloc(sizeof(ParticleStage) * def->stages.size(), PU_MAP, 0);
+    _stageForces = (ParticleStageForces *) Z_Calloc(sizeof(ParticleStageForces) * def->stages.size(), PU_MAP, 0);
 
     for(int i = 0; i < def->stages.size(); ++i)
     {
@@ -175,8 +186,7 @@ void Generator::configureFromDef(const ded_ptcgen_t *newDef)
     // Mark unused.
     for(int i = 0; i < count; ++i)
     {
-        ParticleInfo* pinfo = &_pinfo[i];
-        pinfo->stage = -1;
+        _particles.stage[i] = -1;
     }
 }
 
@@ -191,6 +201,34 @@ void Generator::presimulate(int tics)
     _age = 0;
 }
 
+Generator::TickState Generator::tickState() const
+{
+    TickState state;
+    state.source     = source;
+    state.age        = _age;
+    state.spawnCount = _spawnCount;
+    state.spawnCP    = _spawnCP;
+    for(int i = 0; i < _particles.count; ++i)
+    {
+        state.particles.append(particleInfo(i));
+    }
+    return state;
+}
+
+void Generator::restoreTickState(const TickState &state)
+{
+    DE_ASSERT(state.particles.sizei() == _particles.count);
+
+    source      = state.source;
+    _age        = state.age;
+    _spawnCount = state.spawnCount;
+    _spawnCP    = state.spawnCP;
+    for(int i = 0; i < _particles.count; ++i)
+    {
+        setParticleInfo(i, state.particles[i]);
+    }
+}
+
 bool Generator::isStatic() const
 {
     return _flags.testFlag(Static);
@@ -220,9 +258,9 @@ blendmode_t Generator::blendmode() const
 int Generator::activeParticleCount() const
 {
     int numActive = 0;
-    for(int i = 0; i < count; ++i)
+    for(int i = 0; i < _particles.count; ++i)
     {
-        if(_pinfo[i].stage >= 0)
+        if(_particles.stage[i] >= 0)
         {
             numActive += 1;
         }
@@ -230,31 +268,65 @@ int Generator::activeParticleCount() const
     return numActive;
 }
 
-const ParticleInfo *Generator::particleInfo() const
+const ParticleArrays &Generator::particles() const
+{
+    return _particles;
+}
+
+ParticleInfo Generator::particleInfo(int index) const
 {
-    return _pinfo;
+    DE_ASSERT(index >= 0 && index < _particles.count);
+
+    ParticleInfo pinfo;
+    pinfo.stage   = _particles.stage[index];
+    pinfo.tics    = _particles.tics[index];
+    for(int i = 0; i < 3; ++i)
+    {
+        pinfo.origin[i] = _particles.origin[i][index];
+        pinfo.mov[i]    = _particles.mov[i][index];
+    }
+    pinfo.bspLeaf = _particles.bspLeaf[index];
+    pinfo.contact = _particles.contact[index];
+    pinfo.yaw     = _particles.yaw[index];
+    pinfo.pitch   = _particles.pitch[index];
+    return pinfo;
 }
 
-static void setParticleAngles(ParticleInfo *pinfo, int flags)
+void Generator::setParticleInfo(int index, const ParticleInfo &pinfo)
 {
-    DE_ASSERT(pinfo);
+    DE_ASSERT(index >= 0 && index < _particles.count);
 
+    _particles.stage[index] = pinfo.stage;
+    _particles.tics[index]  = pinfo.tics;
+    for(int i = 0; i < 3; ++i)
+    {
+        _particles.origin[i][index] = pinfo.origin[i];
+        _particles.mov[i][index]    = pinfo.mov[i];
+    }
+    _particles.bspLeaf[index] = pinfo.bspLeaf;
+    _particles.contact[index] = pinfo.contact;
+    _particles.yaw[index]     = pinfo.yaw;
+    _particles.pitch[index]   = pinfo.pitch;
+}
+
+static void setParticleAngles(uint16_t &yaw, uint16_t &pitch, int flags)
+{
     if(flags & Generator::ParticleStage::ZeroYaw)
-        pinfo->yaw = 0;
+        yaw = 0;
     if(flags & Generator::ParticleStage::ZeroPitch)
-        pinfo->pitch = 0;
+        pitch = 0;
     if(flags & Generator::ParticleStage::RandomYaw)
-        pinfo->yaw = RNG_RandFloat() * 65536;
+        yaw = RNG_RandFloat() * 65536;
     if(flags & Generator::ParticleStage::RandomPitch)
-        pinfo->pitch = RNG_RandFloat() * 65536;
+        pitch = RNG_RandFloat() * 65536;
 }
 
-static void particleSound(fixed_t pos[3], ded_embsound_t *sound)
+static void particleSound(const fixed_t pos[3], const ded_embsound_t *sound)
 {
     DE_ASSERT(pos && sound);
 
     // Is there any sound to play?
-    if(!sound->id || sound->volume <= 0) return;
+    if(!sound->id || sound->volume <= 0 || particleSoundsMuted) return;
 
     double orig[3];
     for (int i = 0; i < 3; ++i)
@@ -287,8 +359,9 @@ int Generator::newParticle()
 
     const int newParticleIdx = _spawnCP;
 
-    // Set the particle's data.
-    ParticleInfo *pinfo = &_pinfo[_spawnCP];
+    // Set the particle's data. It is stored back in the arrays when done.
+    ParticleInfo particle = particleInfo(_spawnCP);
+    ParticleInfo *pinfo   = &particle;
     pinfo->stage = 0;
     if(RNG_RandFloat() < def->altStartVariance)
     {
@@ -462,6 +535,7 @@ int Generator::newParticle()
         if(!subspace)
         {
             pinfo->stage = -1;
+            setParticleInfo(newParticleIdx, particle);
             return -1;
         }
 
@@ -486,6 +560,7 @@ int Generator::newParticle()
         if(tries == 10) // No good place found?
         {
             pinfo->stage = -1; // Damn.
+            setParticleInfo(newParticleIdx, particle);
             return -1;
         }
     }
@@ -500,7 +575,7 @@ int Generator::newParticle()
     }
 
     // Initial angles for the particle.
-    setParticleAngles(pinfo, def->stages[pinfo->stage].flags);
+    setParticleAngles(pinfo->yaw, pinfo->pitch, def->stages[pinfo->stage].flags);
 
     // The other place where this gets updated is after moving over
     // a two-sided line.
@@ -517,10 +592,13 @@ int Generator::newParticle()
         if(!pinfo->bspLeaf->hasSubspace())
         {
             pinfo->stage = -1;
+            setParticleInfo(newParticleIdx, particle);
             return -1;
         }
     }
 
+    setParticleInfo(newParticleIdx, particle);
+
     // Play a stage sound?
     particleSound(pinfo->origin, &def->stages[pinfo->stage].sound);
 
@@ -560,45 +638,26 @@ static int newGeneratorParticlesWorker(mobj_t *cmo, void *context)
 #endif
 
 /**
- * Particle touches something solid. Returns false iff the particle dies.
+ * Returns the height of a particle in @a bspLeaf whose Z coordinate is @a z. Particles
+ * stuck to a plane have a Z of DDMININT or DDMAXINT.
  */
-static int touchParticle(ParticleInfo *pinfo, Generator::ParticleStage *stage,
-    ded_ptcstage_t *stageDef, bool touchWall)
+static float particleHeight(const world::BspLeaf &bspLeaf, fixed_t z)
 {
-    // Play a hit sound.
-    particleSound(pinfo->origin, &stageDef->hitSound);
-
-    if(stage->flags.testFlag(Generator::ParticleStage::DieTouch))
+    const auto &subsec = bspLeaf.subspace().subsector().as<Subsector>();
+    if(z == DDMAXINT)
     {
-        // Particle dies from touch.
-        pinfo->stage = -1;
-        return false;
+        return subsec.visCeiling().heightSmoothed() - 2;
     }
-
-    if(stage->flags.testFlag(Generator::ParticleStage::StageTouch) ||
-       (touchWall && stage->flags.testFlag(Generator::ParticleStage::StageWallTouch)) ||
-       (!touchWall && stage->flags.testFlag(Generator::ParticleStage::StageFlatTouch)))
+    if(z == DDMININT)
     {
-        // Particle advances to the next stage.
-        pinfo->tics = 0;
+        return (subsec.visFloor().heightSmoothed() + 2);
     }
-
-    // Particle survives the touch.
-    return true;
+    return FIX2FLT(z);
 }
 
 float Generator::particleZ(const ParticleInfo &pinfo) const
 {
-    const auto &subsec = pinfo.bspLeaf->subspace().subsector().as<Subsector>();
-    if(pinfo.origin[2] == DDMAXINT)
-    {
-        return subsec.visCeiling().heightSmoothed() - 2;
-    }
-    if(pinfo.origin[2] == DDMININT)
-    {
-        return (subsec.visFloor().heightSmoothed() + 2);
-    }
-    return FIX2FLT(pinfo.origin[2]);
+    return particleHeight(*pinfo.bspLeaf, pinfo.origin[2]);
 }
 
 Vec3f Generator::particleOrigin(const ParticleInfo &pt) const
@@ -611,76 +670,341 @@ Vec3f Generator::particleMomentum(const ParticleInfo &pt) const
     return Vec3f(FIX2FLT(pt.mov[0]), FIX2FLT(pt.mov[1]), FIX2FLT(pt.mov[2]));
 }
 
-void Generator::spinParticle(ParticleInfo &pinfo)
+/**
+ * Time spent in each phase of ticking the generators, collected while the particle
+ * benchmark is running (see the "ptcbench" command).
+ */
+static struct ParticleProfile
 {
-    static int const yawSigns[4]   = { 1,  1, -1, -1 };
-    static int const pitchSigns[4] = { 1, -1,  1, -1 };
+    enum Phase { Spawn, Stages, Forces, Movement, PhaseCount };
 
-    const ded_ptcstage_t *stDef = &def->stages[pinfo.stage];
-    const duint spinIndex        = uint(&pinfo - &_pinfo[id() / 8]) % 4;
+    bool   active = false;
+    Time   lapStart;
+    double phaseTimes[PhaseCount] {};
+    dsize  movedCount   = 0; ///< Particles moved.
+    dsize  xyMovedCount = 0; ///< Particles moved on the XY plane (checked against lines).
+    dsize  cachedCount  = 0; ///< XY moves checked against the cached lines.
+    dsize  lineCount    = 0; ///< Lines checked.
 
-    DE_ASSERT(spinIndex < 4);
+    void reset()
+    {
+        for (double &t : phaseTimes) t = 0;
+        movedCount = xyMovedCount = cachedCount = lineCount = 0;
+    }
 
-    const int yawSign   =   yawSigns[spinIndex];
-    const int pitchSign = pitchSigns[spinIndex];
+    void begin()
+    {
+        if (active) lapStart = Time();
+    }
 
-    if(stDef->spin[0] != 0)
+    /// Adds the time since the previous lap to @a phase.
+    void lap(Phase phase)
     {
-        pinfo.yaw   += 65536 * yawSign   * stDef->spin[0] / (360 * TICSPERSEC);
+        if (!active) return;
+        phaseTimes[phase] += lapStart.since();
+        lapStart = Time();
     }
-    if(stDef->spin[1] != 0)
+} ptcProfile;
+
+struct checklineworker_params_t
+{
+    AABoxd box;
+    fixed_t tmpz, tmprad, tmpx1, tmpx2, tmpy1, tmpy2;
+    bool tmcross;
+    Line *ptcHitLine;
+    dsize checkedLines;
+};
+
+/**
+ * Checks whether a particle moving as described in @a parm hits @a line.
+ */
+static LoopResult checkParticleLine(checklineworker_params_t &parm, world::Line &line)
+{
+    parm.checkedLines++;
+
+    // Does the bounding box miss the line completely?
+    if (parm.box.maxX <= line.bounds().minX || parm.box.minX >= line.bounds().maxX ||
+        parm.box.maxY <= line.bounds().minY || parm.box.minY >= line.bounds().maxY)
+    {
+        return LoopContinue;
+    }
+
+    // Movement must cross the line.
+    if ((line.pointOnSide(Vec2d(FIX2FLT(parm.tmpx1), FIX2FLT(parm.tmpy1))) < 0) ==
+        (line.pointOnSide(Vec2d(FIX2FLT(parm.tmpx2), FIX2FLT(parm.tmpy2))) < 0))
+    {
+        return LoopContinue;
+    }
+
+    /*
+     * We are possibly hitting something here.
+     */
+
+    // Bounce if we hit a solid wall.
+    /// @todo fixme: What about "one-way" window lines?
+    parm.ptcHitLine = &line.as<Line>();
+    if (!line.back().hasSector())
     {
-        pinfo.pitch += 65536 * pitchSign * stDef->spin[1] / (360 * TICSPERSEC);
+        return LoopAbort; // Boing!
     }
 
-    pinfo.yaw   *= 1 - stDef->spinResistance[0];
-    pinfo.pitch *= 1 - stDef->spinResistance[1];
+    auto *front = line.front().sectorPtr();
+    auto *back  = line.back().sectorPtr();
+
+    // Determine the opening we have here.
+    /// @todo Use R_OpenRange()
+    fixed_t ceil;
+    if (front->ceiling().height() < back->ceiling().height())
+    {
+        ceil = FLT2FIX(front->ceiling().height());
+    }
+    else
+    {
+        ceil = FLT2FIX(back->ceiling().height());
+    }
+
+    fixed_t floor;
+    if (front->floor().height() > back->floor().height())
+    {
+        floor = FLT2FIX(front->floor().height());
+    }
+    else
+    {
+        floor = FLT2FIX(back->floor().height());
+    }
+
+    // There is a backsector. We possibly might hit something.
+    if (parm.tmpz - parm.tmprad < floor || parm.tmpz + parm.tmprad > ceil)
+    {
+        return LoopAbort; // Boing!
+    }
+
+    // False alarm, continue checking.
+    parm.ptcHitLine = nullptr;
+    // There is a possibility that the new position is in a new sector.
+    parm.tmcross    = true; // Afterwards, update the sector pointer.
+    return LoopContinue;
 }
 
-void Generator::moveParticle(int index)
+/**
+ * Iterates the polyobj and sector lines in the blockmap cells touching @a box, like
+ * Map::forAllLinesInBox() does. The lines are not marked with a valid count, so this
+ * can be used from several threads at once; a line spanning several cells may be
+ * visited more than once.
+ */
+static LoopResult forAllParticleLinesInBox(const Map &map, const AABoxd &box,
+                                           const std::function<LoopResult (world::Line &)> &func)
 {
-    DE_ASSERT(index >= 0 && index < count);
+    LoopResult result = LoopContinue;
+    if (map.polyobjCount())
+    {
+        result = map.polyobjBlockmap().forAllInBox(box, [&func] (void *object)
+        {
+            for (world::Line *line : reinterpret_cast<Polyobj *>(object)->lines())
+            {
+                if (auto result = func(*line)) return result;
+            }
+            return LoopResult(); // continue
+        });
+    }
+    if (!result)
+    {
+        result = map.lineBlockmap().forAllInBox(box, [&func] (void *object)
+        {
+            return func(*reinterpret_cast<world::Line *>(object));
+        });
+    }
+    return result;
+}
+
+/**
+ * Lines around the particles of a generator.
+ *
+ * The particles of a generator usually stay close to each other, so the lines are
+ * collected from the blockmap once per tick and each particle only checks the short
+ * list. Particles moving outside the collected area fall back to a blockmap query.
+ */
+struct ParticleLineCache
+{
+    static constexpr coord_t MARGIN    = 64;   ///< Added around the particles.
+    static constexpr coord_t MAX_SIZE  = 2048; ///< Larger areas are not cached.
+    static constexpr dsize   MAX_LINES = 64;   ///< Long lists are slower than the blockmap.
+
+    AABoxd box;
+    List<world::Line *> lines;
+    bool valid = false;
+
+    void update(const Map &map, const ParticleArrays &particles)
+    {
+        valid = false;
+        lines.clear();
+
+        bool first = true;
+        for (int i = 0; i < particles.count; ++i)
+        {
+            if (particles.stage[i] < 0) continue;
+
+            const coord_t x = FIX2FLT(particles.origin[0][i]);
+            const coord_t y = FIX2FLT(particles.origin[1][i]);
+            if (first)
+            {
+                box = AABoxd(x, y, x, y);
+                first = false;
+            }
+            else
+            {
+                box.minX = de::min(box.minX, x);
+                box.minY = de::min(box.minY, y);
+                box.maxX = de::max(box.maxX, x);
+                box.maxY = de::max(box.maxY, y);
+            }
+        }
+        if (first) return; // No particles.
 
-    ParticleInfo *pinfo   = &_pinfo[index];
-    ParticleStage *st     = &stages[pinfo->stage];
-    ded_ptcstage_t *stDef = &def->stages[pinfo->stage];
+        box.minX -= MARGIN; box.minY -= MARGIN;
+        box.maxX += MARGIN; box.maxY += MARGIN;
+        if (box.maxX - box.minX > MAX_SIZE || box.maxY - box.minY > MAX_SIZE) return;
 
-    // Particle rotates according to spin speed.
-    spinParticle(*pinfo);
+        forAllParticleLinesInBox(map, box, [this] (world::Line &line)
+        {
+            if (!lines.contains(&line)) lines.append(&line);
+            return lines.size() > MAX_LINES? LoopAbort : LoopContinue;
+        });
+        valid = (lines.size() <= MAX_LINES);
+    }
 
-    // Changes to momentum.
-    /// @todo Do not assume generator is from the CURRENT map.
-    pinfo->mov[2] -= FixedMul(FLT2FIX(map().gravity()), st->gravity);
+    bool covers(const AABoxd &other) const
+    {
+        return valid && other.minX >= box.minX && other.maxX <= box.maxX &&
+                        other.minY >= box.minY && other.maxY <= box.maxY;
+    }
+};
 
-    // Vector force.
-    if(stDef->vectorForce[0] != 0 || stDef->vectorForce[1] != 0 ||
-       stDef->vectorForce[2] != 0)
+/**
+ * Moving the particles of a generator only changes the generator itself. Everything
+ * else, i.e., the sounds and the statistics, is collected here and applied once all the
+ * generators have been moved.
+ */
+struct Generator::MotionContext
+{
+    struct HitSound
     {
+        fixed_t origin[3];
+        const ded_embsound_t *sound;
+    };
+
+    ParticleLineCache lineCache;
+    List<HitSound>    hitSounds;
+    dsize movedCount   = 0;
+    dsize xyMovedCount = 0;
+    dsize cachedCount  = 0;
+    dsize lineCount    = 0;
+};
+
+/**
+ * Particle touches something solid. Returns false iff the particle dies.
+ */
+static int touchParticle(ParticleArrays &particles, int index, const Generator::ParticleStage *stage,
+    const ded_ptcstage_t *stageDef, bool touchWall, Generator::MotionContext &motion)
+{
+    // Play a hit sound (after the motion).
+    const ded_embsound_t &sound = stageDef->hitSound;
+    if(sound.id && sound.volume > 0)
+    {
+        Generator::MotionContext::HitSound hit;
         for(int i = 0; i < 3; ++i)
         {
-            pinfo->mov[i] += FLT2FIX(stDef->vectorForce[i]);
+            hit.origin[i] = particles.origin[i][index];
         }
+        hit.sound = &sound;
+        motion.hitSounds.append(hit);
     }
 
+    if(stage->flags.testFlag(Generator::ParticleStage::DieTouch))
+    {
+        // Particle dies from touch.
+        particles.stage[index] = -1;
+        return false;
+    }
+
+    if(stage->flags.testFlag(Generator::ParticleStage::StageTouch) ||
+       (touchWall && stage->flags.testFlag(Generator::ParticleStage::StageWallTouch)) ||
+       (!touchWall && stage->flags.testFlag(Generator::ParticleStage::StageFlatTouch)))
+    {
+        // Particle advances to the next stage.
+        particles.tics[index] = 0;
+    }
+
+    // Particle survives the touch.
+    return true;
+}
+
+void Generator::accelerateParticles()
+{
     // Sphere force pull and turn.
     // Only applicable to sourced or untriggered generators. For other
     // types it's difficult to define the center coordinates.
-    if(st->flags.testFlag(ParticleStage::SphereForce) &&
-       (source || isUntriggered()))
+    const bool sphereForce = (source || isUntriggered());
+    bool anySphereForce = false;
+
+    // Forces of each stage.
+    for(int s = 0; s < def->stages.size(); ++s)
+    {
+        const ParticleStage *st     = &stages[s];
+        const ded_ptcstage_t *stDef = &def->stages[s];
+        ParticleStageForces &forces = _stageForces[s];
+
+        for(int i = 0; i < 3; ++i)
+        {
+            forces.accel[i] = FLT2FIX(stDef->vectorForce[i]);
+        }
+        /// @todo Do not assume generator is from the CURRENT map.
+        forces.accel[2] -= FixedMul(FLT2FIX(map().gravity()), st->gravity);
+
+        // The sphere force is applied before the resistance (below).
+        if(sphereForce && st->flags.testFlag(ParticleStage::SphereForce))
+        {
+            forces.resistance = FRACUNIT;
+            anySphereForce = true;
+        }
+        else
+        {
+            forces.resistance = st->resistance;
+        }
+
+        for(int i = 0; i < 2; ++i)
+        {
+            forces.spin[i]       = 65536 * stDef->spin[i] / (360 * TICSPERSEC);
+            forces.spinFactor[i] = 1 - stDef->spinResistance[i];
+        }
+    }
+
+    // Spin, gravity, vector force and resistance.
+    Particle_Kernels().applyForces(_particles, _stageForces, -(id() / 8) & 3);
+
+    if(!anySphereForce) return;
+
+    for(int p = 0; p < _particles.count; ++p)
     {
+        if(_particles.stage[p] < 0) continue;
+
+        const ParticleStage *st = &stages[_particles.stage[p]];
+        if(!st->flags.testFlag(ParticleStage::SphereForce)) continue;
+
         float delta[3];
 
         if(source)
         {
-            delta[0] = FIX2FLT(pinfo->origin[0]) - source->origin[0];
-            delta[1] = FIX2FLT(pinfo->origin[1]) - source->origin[1];
-            delta[2] = particleZ(*pinfo) - (source->origin[2] + FIX2FLT(originAtSpawn[2]));
+            delta[0] = FIX2FLT(_particles.origin[0][p]) - source->origin[0];
+            delta[1] = FIX2FLT(_particles.origin[1][p]) - source->origin[1];
+            delta[2] = particleHeight(*_particles.bspLeaf[p], _particles.origin[2][p]) -
+                       (source->origin[2] + FIX2FLT(originAtSpawn[2]));
         }
         else
         {
             for(int i = 0; i < 3; ++i)
             {
-                delta[i] = FIX2FLT(pinfo->origin[i] - originAtSpawn[i]);
+                delta[i] = FIX2FLT(_particles.origin[i][p] - originAtSpawn[i]);
             }
         }
 
@@ -703,7 +1027,7 @@ void Generator::moveParticle(int index)
                 // multiply with radial force strength.
                 for(int i = 0; i < 3; ++i)
                 {
-                    pinfo->mov[i] -= FLT2FIX(
+                    _particles.mov[i][p] -= FLT2FIX(
                         ((delta[i] / dist) * (dist - def->forceRadius)) * def->force);
                 }
             }
@@ -716,19 +1040,32 @@ void Generator::moveParticle(int index)
 
                 for(int i = 0; i < 3; ++i)
                 {
-                    pinfo->mov[i] += FLT2FIX(cross[i]) >> 8;
+                    _particles.mov[i][p] += FLT2FIX(cross[i]) >> 8;
                 }
             }
         }
-    }
 
-    if(st->resistance != FRACUNIT)
-    {
-        for(int i = 0; i < 3; ++i)
+        if(st->resistance != FRACUNIT)
         {
-            pinfo->mov[i] = FixedMul(pinfo->mov[i], st->resistance);
+            for(int i = 0; i < 3; ++i)
+            {
+                _particles.mov[i][p] = FixedMul(_particles.mov[i][p], st->resistance);
+            }
         }
     }
+}
+
+void Generator::moveParticle(int index, MotionContext &motion)
+{
+    DE_ASSERT(index >= 0 && index < count);
+
+    ParticleArrays &pt    = _particles;
+    ParticleStage *st     = &stages[pt.stage[index]];
+    ded_ptcstage_t *stDef = &def->stages[pt.stage[index]];
+    fixed_t *origin[3]    = { &pt.origin[0][index], &pt.origin[1][index], &pt.origin[2][index] };
+    fixed_t mov[3]        = { pt.mov[0][index], pt.mov[1][index], pt.mov[2][index] };
+
+    motion.movedCount++;
 
     // The particle is 'soft': half of radius is ignored.
     // The exception is plane flat particles, which are rendered flat
@@ -742,22 +1079,22 @@ void Generator::moveParticle(int index)
     }
 
     // Check the new Z position only if not stuck to a plane.
-    fixed_t z = pinfo->origin[2] + pinfo->mov[2];
+    fixed_t z = *origin[2] + mov[2];
     bool zBounce = false, hitFloor = false;
-    if(pinfo->origin[2] != DDMININT && pinfo->origin[2] != DDMAXINT && pinfo->bspLeaf)
+    if(*origin[2] != DDMININT && *origin[2] != DDMAXINT && pt.bspLeaf[index])
     {
-        auto &subsec = pinfo->bspLeaf->subspace().subsector().as<Subsector>();
+        auto &subsec = pt.bspLeaf[index]->subspace().subsector().as<Subsector>();
         if(z > FLT2FIX(subsec.visCeiling().heightSmoothed()) - hardRadius)
         {
             // The Z is through the roof!
             if(subsec.visCeiling().surface().hasSkyMaskedMaterial())
             {
                 // Special case: particle gets lost in the sky.
-                pinfo->stage = -1;
+                pt.stage[index] = -1;
                 return;
             }
 
-            if(!touchParticle(pinfo, st, stDef, false))
+            if(!touchParticle(pt, index, st, stDef, false, motion))
                 return;
 
             z = FLT2FIX(subsec.visCeiling().heightSmoothed()) - hardRadius;
@@ -770,11 +1107,11 @@ void Generator::moveParticle(int index)
         {
             if(subsec.visFloor().surface().hasSkyMaskedMaterial())
             {
-                pinfo->stage = -1;
+                pt.stage[index] = -1;
                 return;
             }
 
-            if(!touchParticle(pinfo, st, stDef, false))
+            if(!touchParticle(pt, index, st, stDef, false, motion))
                 return;
 
             z = FLT2FIX(subsec.visFloor().heightSmoothed()) + hardRadius;
@@ -784,8 +1121,8 @@ void Generator::moveParticle(int index)
 
         if(zBounce)
         {
-            pinfo->mov[2] = FixedMul(-pinfo->mov[2], st->bounce);
-            if(!pinfo->mov[2])
+            mov[2] = pt.mov[2][index] = FixedMul(-mov[2], st->bounce);
+            if(!mov[2])
             {
                 // The particle has stopped moving. This means its Z-movement
                 // has ceased because of the collision with a plane. Plane-flat
@@ -799,40 +1136,33 @@ void Generator::moveParticle(int index)
         }
 
         // Move to the new Z coordinate.
-        pinfo->origin[2] = z;
+        *origin[2] = z;
     }
 
     // Now check the XY direction.
     // - Check if the movement crosses any solid lines.
     // - If it does, quit when first one contacted and apply appropriate
     //   bounce (result depends on the angle of the contacted wall).
-    fixed_t x = pinfo->origin[0] + pinfo->mov[0];
-    fixed_t y = pinfo->origin[1] + pinfo->mov[1];
+    fixed_t x = *origin[0] + mov[0];
+    fixed_t y = *origin[1] + mov[1];
 
-    struct checklineworker_params_t
-    {
-        AABoxd box;
-        fixed_t tmpz, tmprad, tmpx1, tmpx2, tmpy1, tmpy2;
-        bool tmcross;
-        Line *ptcHitLine;
-    };
     checklineworker_params_t clParm; zap(clParm);
     clParm.tmcross = false; // Has crossed potential sector boundary?
 
     // XY movement can be skipped if the particle is not moving on the
     // XY plane.
-    if(!pinfo->mov[0] && !pinfo->mov[1])
+    if(!mov[0] && !mov[1])
     {
         // If the particle is contacting a line, there is a chance that the
         // particle should be killed (if it's moving slowly at max).
-        if(pinfo->contact)
+        if(pt.contact[index])
         {
-            auto *front = pinfo->contact->front().sectorPtr();
-            auto *back  = pinfo->contact->back().sectorPtr();
+            auto *front = pt.contact[index]->front().sectorPtr();
+            auto *back  = pt.contact[index]->back().sectorPtr();
 
-            if (front && back && abs(pinfo->mov[2]) < FRACUNIT / 2)
+            if (front && back && abs(mov[2]) < FRACUNIT / 2)
             {
-                const coord_t pz = particleZ(*pinfo);
+                const coord_t pz = particleHeight(*pt.bspLeaf[index], *origin[2]);
 
                 coord_t fz;
                 if (front->floor().height() > back->floor().height())
@@ -859,7 +1189,7 @@ void Generator::moveParticle(int index)
                 if (pz > fz && pz < cz)
                 {
                     // Kill the particle.
-                    pinfo->stage = -1;
+                    pt.stage[index] = -1;
                     return;
                 }
             }
@@ -870,100 +1200,50 @@ void Generator::moveParticle(int index)
     }
 
     // We're moving in XY, so if we don't hit anything there can't be any line contact.
-    pinfo->contact = 0;
+    pt.contact[index] = 0;
 
     // Bounding box of the movement line.
     clParm.tmpz = z;
     clParm.tmprad = hardRadius;
-    clParm.tmpx1 = pinfo->origin[0];
+    clParm.tmpx1 = *origin[0];
     clParm.tmpx2 = x;
-    clParm.tmpy1 = pinfo->origin[1];
+    clParm.tmpy1 = *origin[1];
     clParm.tmpy2 = y;
 
     vec2d_t point;
-    V2d_Set(point, FIX2FLT(MIN_OF(x, pinfo->origin[0]) - st->radius),
-                   FIX2FLT(MIN_OF(y, pinfo->origin[1]) - st->radius));
+    V2d_Set(point, FIX2FLT(MIN_OF(x, *origin[0]) - st->radius),
+                   FIX2FLT(MIN_OF(y, *origin[1]) - st->radius));
     V2d_InitBox(clParm.box.arvec2, point);
-    V2d_Set(point, FIX2FLT(MAX_OF(x, pinfo->origin[0]) + st->radius),
-                   FIX2FLT(MAX_OF(y, pinfo->origin[1]) + st->radius));
+    V2d_Set(point, FIX2FLT(MAX_OF(x, *origin[0]) + st->radius),
+                   FIX2FLT(MAX_OF(y, *origin[1]) + st->radius));
     V2d_AddToBox(clParm.box.arvec2, point);
 
     // Iterate the lines in the contacted blocks.
-
-    World::validCount++;
     DE_ASSERT(!clParm.ptcHitLine);
-    map().forAllLinesInBox(clParm.box, [&clParm] (world::Line &line)
+    motion.xyMovedCount++;
+    if (motion.lineCache.covers(clParm.box))
     {
-        // Does the bounding box miss the line completely?
-        if (clParm.box.maxX <= line.bounds().minX || clParm.box.minX >= line.bounds().maxX ||
-            clParm.box.maxY <= line.bounds().minY || clParm.box.minY >= line.bounds().maxY)
+        motion.cachedCount++;
+        for (world::Line *line : motion.lineCache.lines)
         {
-            return LoopContinue;
+            if (checkParticleLine(clParm, *line)) break;
         }
-
-        // Movement must cross the line.
-        if ((line.pointOnSide(Vec2d(FIX2FLT(clParm.tmpx1), FIX2FLT(clParm.tmpy1))) < 0) ==
-            (line.pointOnSide(Vec2d(FIX2FLT(clParm.tmpx2), FIX2FLT(clParm.tmpy2))) < 0))
-        {
-            return LoopContinue;
-        }
-
-        /*
-         * We are possibly hitting something here.
-         */
-
-        // Bounce if we hit a solid wall.
-        /// @todo fixme: What about "one-way" window lines?
-        clParm.ptcHitLine = &line.as<Line>();
-        if (!line.back().hasSector())
-        {
-            return LoopAbort; // Boing!
-        }
-
-        auto *front = line.front().sectorPtr();
-        auto *back  = line.back().sectorPtr();
-
-        // Determine the opening we have here.
-        /// @todo Use R_OpenRange()
-        fixed_t ceil;
-        if (front->ceiling().height() < back->ceiling().height())
-        {
-            ceil = FLT2FIX(front->ceiling().height());
-        }
-        else
-        {
-            ceil = FLT2FIX(back->ceiling().height());
-        }
-
-        fixed_t floor;
-        if (front->floor().height() > back->floor().height())
-        {
-            floor = FLT2FIX(front->floor().height());
-        }
-        else
-        {
-            floor = FLT2FIX(back->floor().height());
-        }
-
-        // There is a backsector. We possibly might hit something.
-        if (clParm.tmpz - clParm.tmprad < floor || clParm.tmpz + clParm.tmprad > ceil)
+    }
+    else
+    {
+        forAllParticleLinesInBox(map(), clParm.box, [&clParm] (world::Line &line)
         {
-            return LoopAbort; // Boing!
-        }
-
-        // False alarm, continue checking.
-        clParm.ptcHitLine = nullptr;
-        // There is a possibility that the new position is in a new sector.
-        clParm.tmcross    = true; // Afterwards, update the sector pointer.
-        return LoopContinue;
-    });
+            return checkParticleLine(clParm, line);
+        });
+    }
+    motion.lineCount += clParm.checkedLines;
 
     if(clParm.ptcHitLine)
     {
         fixed_t normal[2], dotp;
 
         // Must survive the touch.
-        if(!touchParticle(pinfo, st, stDef, true))
+        if(!touchParticle(pt, index, st, stDef, true, motion))
             return;
 
         // There was a hit! Calculate bounce vector.
@@ -980,43 +1260,62 @@ void Generator::moveParticle(int index)
             goto quit_iteration;
 
         // Calculate as floating point so we don't overflow.
-        dotp = FRACUNIT * (DOT2F(pinfo->mov, normal) / DOT2F(normal, normal));
+        dotp = FRACUNIT * (DOT2F(mov, normal) / DOT2F(normal, normal));
         VECMUL(normal, dotp);
-        VECSUB(normal, pinfo->mov);
-        VECMULADD(pinfo->mov, 2 * FRACUNIT, normal);
-        VECMUL(pinfo->mov, st->bounce);
+        VECSUB(normal, mov);
+        VECMULADD(mov, 2 * FRACUNIT, normal);
+        VECMUL(mov, st->bounce);
+        pt.mov[0][index] = mov[0];
+        pt.mov[1][index] = mov[1];
 
         // Continue from the old position.
-        x = pinfo->origin[0];
-        y = pinfo->origin[1];
+        x = *origin[0];
+        y = *origin[1];
         clParm.tmcross = false; // Sector can't change if XY doesn't.
 
         // This line is the latest contacted line.
-        pinfo->contact = clParm.ptcHitLine;
+        pt.contact[index] = clParm.ptcHitLine;
         goto quit_iteration;
     }
 
   quit_iteration:
     // The move is now OK.
-    pinfo->origin[0] = x;
-    pinfo->origin[1] = y;
+    *origin[0] = x;
+    *origin[1] = y;
 
     // Should we update the sector pointer?
     if(clParm.tmcross)
     {
-        pinfo->bspLeaf = &map().bspLeafAt(Vec2d(FIX2FLT(x), FIX2FLT(y)));
+        pt.bspLeaf[index] = &map().bspLeafAt(Vec2d(FIX2FLT(x), FIX2FLT(y)));
 
         // A BSP leaf with no geometry is not a suitable place for a particle.
-        if(!pinfo->bspLeaf->hasSubspace())
+        if(!pt.bspLeaf[index]->hasSubspace())
         {
             // Kill the particle.
-            pinfo->stage = -1;
+            pt.stage[index] = -1;
         }
     }
 }
 
-void Generator::runTick()
+void Generator::moveParticles(MotionContext &motion)
 {
+    // Apply forces. The momentum of a particle does not depend on the others, so
+    // this is done in its own pass, separately from the collision checks.
+    accelerateParticles();
+    ptcProfile.lap(ParticleProfile::Forces);
+
+    motion.lineCache.update(map(), _particles);
+    for(int i = 0; i < _particles.count; ++i)
+    {
+        if(_particles.stage[i] >= 0) moveParticle(i, motion);
+    }
+    ptcProfile.lap(ParticleProfile::Movement);
+}
+
+bool Generator::beginTick()
+{
+    ptcProfile.begin();
+
     // Source has been destroyed?
     if(!isUntriggered() && !map().thinkers().isUsedMobjId(srcid))
     {
@@ -1029,7 +1328,7 @@ void Generator::runTick()
     if(++_age > def->maxAge && def->maxAge >= 0)
     {
         Generator_Delete(this);
-        return;
+        return false;
     }
 
     // Spawn new particles?
@@ -1085,40 +1384,207 @@ void Generator::runTick()
         }
     }
 
-    // Move particles.
-    ParticleInfo *pinfo = _pinfo;
-    for(int i = 0; i < count; ++i, pinfo++)
+    ptcProfile.lap(ParticleProfile::Spawn);
+
+    // Advance the particle stages.
+    ParticleArrays &pt = _particles;
+    for(int i = 0; i < pt.count; ++i)
     {
-        if(pinfo->stage < 0) continue; // Not in use.
+        if(pt.stage[i] < 0) continue; // Not in use.
 
-        if(pinfo->tics-- <= 0)
+        if(pt.tics[i]-- <= 0)
         {
             // Advance to next stage.
-            if(++pinfo->stage == def->stages.size() ||
-               stages[pinfo->stage].type == PTC_NONE)
+            if(++pt.stage[i] == def->stages.size() ||
+               stages[pt.stage[i]].type == PTC_NONE)
             {
                 // Kill the particle.
-                pinfo->stage = -1;
+                pt.stage[i] = -1;
                 continue;
             }
 
-            pinfo->tics = def->stages[pinfo->stage].tics * (1 - def->stages[pinfo->stage].variance * RNG_RandFloat());
+            const ded_ptcstage_t &stDef = def->stages[pt.stage[i]];
+            pt.tics[i] = stDef.tics * (1 - stDef.variance * RNG_RandFloat());
 
             // Change in particle angles?
-            setParticleAngles(pinfo, def->stages[pinfo->stage].flags);
+            setParticleAngles(pt.yaw[i], pt.pitch[i], stDef.flags);
 
             // Play a sound?
-            particleSound(pinfo->origin, &def->stages[pinfo->stage].sound);
+            const fixed_t origin[3] = { pt.origin[0][i], pt.origin[1][i], pt.origin[2][i] };
+            particleSound(origin, &stDef.sound);
+        }
+    }
+    ptcProfile.lap(ParticleProfile::Stages);
+    return true;
+}
+
+void Generator::finishTicks(const List<Generator *> &gens) // static
+{
+    /// Below this many particles in total, the generators are moved in this thread.
+    static const int MIN_PARALLEL_PARTICLES = 2048;
+
+    if(gens.isEmpty()) return;
+
+    List<MotionContext> motions(gens.size());
+
+    int particleCount = 0;
+    for(const Generator *gen : gens)
+    {
+        particleCount += gen->count;
+    }
+
+    const int taskCount = (particleCount < MIN_PARALLEL_PARTICLES || ptcProfile.active? 1 :
+                           de::min(gens.sizei(), int(std::thread::hardware_concurrency())));
+    if(taskCount <= 1)
+    {
+        for(dsize i = 0; i < gens.size(); ++i)
+        {
+            gens[i]->moveParticles(motions[i]);
+        }
+    }
+    else
+    {
+        // Each task takes the next unmoved generator until all have been moved.
+        std::atomic<dsize> next(0);
+        auto moveGenerators = [&gens, &motions, &next] ()
+        {
+            for(dsize i = next++; i < gens.size(); i = next++)
+            {
+                gens[i]->moveParticles(motions[i]);
+            }
+        };
+        TaskPool tasks;
+        for(int i = 1; i < taskCount; ++i)
+        {
+            tasks.start(moveGenerators);
+        }
+        moveGenerators();
+        tasks.waitForDone();
+    }
+
+    for(const MotionContext &motion : motions)
+    {
+        for(const auto &hit : motion.hitSounds)
+        {
+            particleSound(hit.origin, hit.sound);
+        }
+        ptcProfile.movedCount   += motion.movedCount;
+        ptcProfile.xyMovedCount += motion.xyMovedCount;
+        ptcProfile.cachedCount  += motion.cachedCount;
+        ptcProfile.lineCount    += motion.lineCount;
+    }
+}
+
+void Generator::runTick()
+{
+    if(beginTick())
+    {
+        finishTicks({this});
+    }
+}
+
+/**
+ * $ptcbench: Ticks the particle generators of the current map a number of times and
+ * prints how long each phase of the tick took. The phases are timed with the generators
+ * moved one at a time; the same tics are then run again moving the generators in
+ * parallel, as the thinkers do. The generators are returned to their original state
+ * afterwards, and no particle sounds are played while benchmarking.
+ */
+D_CMD(ParticleBenchmark)
+{
+    DE_UNUSED(src);
+
+    if (!World::get().hasMap())
+    {
+        LOG_SCR_ERROR("No map loaded");
+        return false;
+    }
+
+    const int tics = (argc > 1? de::max(1, String(argv[1]).toInt()) : TICSPERSEC * 10);
+    const Map &map = App_World().map();
+
+    List<std::pair<Generator *, Generator::TickState>> saved;
+    map.forAllGenerators([&saved] (Generator &gen)
+    {
+        saved.append(std::make_pair(&gen, gen.tickState()));
+        return LoopContinue;
+    });
+
+    ptcProfile.reset();
+    ptcProfile.active   = true;
+    particleSoundsMuted = true;
+    dsize particleCount = 0;
+    for (int i = 0; i < tics; ++i)
+    {
+        for (auto &entry : saved)
+        {
+            Generator &gen = *entry.first;
+
+            // A generator reaching its maximum age would be deleted.
+            if (gen.def->maxAge >= 0 && gen.age() >= gen.def->maxAge) continue;
+
+            gen.runTick();
+            particleCount += gen.activeParticleCount();
         }
+    }
+    ptcProfile.active = false;
 
-        // Try to move.
-        moveParticle(i);
+    const auto restoreAll = [&saved] ()
+    {
+        for (const auto &entry : saved)
+        {
+            entry.first->restoreTickState(entry.second);
+        }
+    };
+    restoreAll();
+
+    const Time parallelStart;
+    for (int i = 0; i < tics; ++i)
+    {
+        List<Generator *> gens;
+        for (auto &entry : saved)
+        {
+            Generator &gen = *entry.first;
+            if (gen.def->maxAge >= 0 && gen.age() >= gen.def->maxAge) continue;
+            if (gen.beginTick()) gens.append(&gen);
+        }
+        Generator::finishTicks(gens);
+    }
+    const double parallelTime = parallelStart.since();
+    particleSoundsMuted = false;
+
+    restoreAll();
+
+    static const char *phaseNames[ParticleProfile::PhaseCount] = {
+        "spawning", "stages", "forces", "movement"
+    };
+    double total = 0;
+    for (double t : ptcProfile.phaseTimes) total += t;
+
+    LOG_SCR_MSG(_E(b) "Particle benchmark: %i tics, %.0f particles per tic")
+            << tics << double(particleCount) / tics;
+    for (int i = 0; i < ParticleProfile::PhaseCount; ++i)
+    {
+        LOG_SCR_MSG("  %-10s %7.3f ms/tic (%4.1f%%)")
+                << phaseNames[i] << ptcProfile.phaseTimes[i] * 1000 / tics
+                << (total > 0? ptcProfile.phaseTimes[i] * 100 / total : 0.0);
     }
+    const auto &prof = ptcProfile;
+    LOG_SCR_MSG("%.0f%% of the moved particles were checked against lines, "
+                "%.0f%% of those using the cached lines; %.1f lines checked per particle")
+            << (prof.movedCount?   prof.xyMovedCount * 100.0 / prof.movedCount   : 0.0)
+            << (prof.xyMovedCount? prof.cachedCount  * 100.0 / prof.xyMovedCount : 0.0)
+            << (prof.xyMovedCount? double(prof.lineCount) / prof.xyMovedCount    : 0.0);
+    LOG_SCR_MSG("Moving the generators in parallel: %.3f ms/tic in total (%.3f ms/tic one at a time)")
+            << parallelTime * 1000 / tics << total * 1000 / tics;
+    return true;
 }
 
 void Generator::consoleRegister() //static
 {
     C_VAR_FLOAT("rend-particle-rate", &particleSpawnRate, 0, 0, 5);
+
+    C_CMD_FLAGS("ptcbench", nullptr, ParticleBenchmark, CMDF_NO_DEDICATED);
 }
 
 void Generator_Delete(Generator *gen)
@@ -1134,5 +1600,9 @@ void Generator_Delete(Generator *gen)
 void Generator_Thinker(Generator *gen)
 {
     DE_ASSERT(gen != 0);
-    gen->runTick();
+    if(gen->beginTick())
+    {
+        // The particles are moved after all the thinkers have run.
+        gen->map().scheduleParticleMotion(*gen);
+    }
 }
@@ -43,6 +43,7 @@
 #include "client/clskyplane.h"
 #include "world/contact.h"
 #include "world/contactspreader.h"
+#include "render/ambientlightgrid.h"
 #include "render/lightdecoration.h"
 #include "render/lumobj.h"
 #include "render/rend_main.h"
@@ -50,6 +51,7 @@
 #include "render/viewports.h"
 #include "render/walledge.h"
 
+#include <doomsday/console/var.h>
 #include <doomsday/defs/mapinfo.h>
 #include <doomsday/defs/sky.h>
 #include <doomsday/world/entitydatabase.h>
@@ -79,12 +81,20 @@
 #include <de/legacy/vector1.h>
 #include <de/legacy/timer.h>
 
+#include <algorithm>
 #include <array>
+#include <iterator>
 #include <map>
+#include <tuple>
+#include <unordered_map>
 
 using namespace de;
 using world::World;
 
+static int devContactSpreadCount; ///< Contacts spread during the previous frame (cvar).
+
+static const double LIGHTGRID_CELL_SIZE = 64;
+
 /// Milliseconds it takes for Unpredictable and Hidden mobjs to be
 /// removed from the hash. Under normal circumstances, the special
 /// status should be removed fairly quickly.
@@ -121,6 +131,9 @@ DE_PIMPL(Map)
         // Array of list heads containing links from linkStore to generators in activeGens.
         ListNode **lists = nullptr;
 
+        // Generators whose particles are moved after the thinkers have run.
+        List<Generator *> pendingMotion;
+
         ~Generators()
         {
             Z_Free(lists);
@@ -194,14 +207,20 @@ DE_PIMPL(Map)
             }
         }
 
-        void spread(const AABoxd &region)
+        int spread(const AABoxd &region, duint geometryStamp = 0)
         {
-            spreadContacts(*this, region, &spreadBlocks);
+            return spreadContacts(*this, region, &spreadBlocks, geometryStamp);
         }
     };
 
     std::unique_ptr<ContactBlockmap> mobjContactBlockmap;  /// @todo Redundant?
     std::unique_ptr<ContactBlockmap> lumobjContactBlockmap;
+    AmbientLightGrid lightGrid;
+    List<Subsector *> lightGridRegions;
+    std::unordered_map<const world::Subsector *, int> lightGridRegionIndices;
+    std::vector<AmbientLightGrid::Light> lightGridLights;  ///< Static lights in the grid (sorted).
+    duint geometryStamp = 1;  ///< Incremented on changes that affect contact spreading.
+    int contactSpreadCount = 0;  ///< Contacts spread during the current frame.
 
     PlaneSet trackedPlanes;
     SurfaceSet scrollingSurfaces;
@@ -267,12 +286,132 @@ DE_PIMPL(Map)
     // Clear the "contact" blockmaps (BSP leaf => object).
     void removeAllContacts()
     {
+        devContactSpreadCount = contactSpreadCount;
+        contactSpreadCount = 0;
+
         mobjContactBlockmap->clear();
         lumobjContactBlockmap->clear();
 
         R_ClearContactLists(*thisPublic);
     }
 
+    /// Light regions of the map for the ambient light grid (the subsectors).
+    struct LightGridMapInfo : public AmbientLightGrid::MapInfo
+    {
+        const Map &map;
+        const std::unordered_map<const world::Subsector *, int> &regionIndices;
+
+        LightGridMapInfo(const Map &map, const std::unordered_map<const world::Subsector *, int> &indices)
+            : map(map), regionIndices(indices)
+        {}
+
+        int regionAt(double x, double y) const override
+        {
+            const auto &bspLeaf = map.bspLeafAt(Vec2d(x, y));
+            if (!bspLeaf.hasSubspace()) return -1;
+            auto found = regionIndices.find(&bspLeaf.subspace().subsector());
+            return found != regionIndices.end()? found->second : -1;
+        }
+    };
+
+    static bool lightGridLightLess(const AmbientLightGrid::Light &a, const AmbientLightGrid::Light &b)
+    {
+        return std::tie(a.origin[0], a.origin[1], a.origin[2], a.radius, a.color[0], a.color[1], a.color[2])
+             < std::tie(b.origin[0], b.origin[1], b.origin[2], b.radius, b.color[0], b.color[1], b.color[2]);
+    }
+
+    /**
+     * Collects the static light sources of the ambient light grid, i.e., the current
+     * lumobjs of light decorations, in sorted order.
+     */
+    std::vector<AmbientLightGrid::Light> lightGridStaticLights() const
+    {
+        std::vector<AmbientLightGrid::Light> lights;
+        for (const Lumobj *lum : lumobjs)
+        {
+            if (!lum->source()) continue; // Only static sources.
+            lights.push_back({ {lum->x(), lum->y(), lum->z() + lum->zOffset()}, lum->radius(),
+                               {lum->color().x, lum->color().y, lum->color().z} });
+        }
+        std::sort(lights.begin(), lights.end(), lightGridLightLess);
+        return lights;
+    }
+
+    /**
+     * Bakes the ambient light grid using the sector light regions and the given static
+     * light sources.
+     */
+    void bakeLightGrid(const std::vector<AmbientLightGrid::Light> &lights)
+    {
+        const Time begunAt;
+
+        lightGridRegionIndices.clear();
+        lightGridRegions.clear();
+        double minZ = DDMAXFLOAT, maxZ = DDMINFLOAT;
+        self().forAllSectors([this, &minZ, &maxZ] (world::Sector &sector)
+        {
+            minZ = de::min(minZ, sector.floor().height());
+            maxZ = de::max(maxZ, sector.ceiling().height());
+            sector.forAllSubsectors([this] (world::Subsector &subsec)
+            {
+                lightGridRegionIndices[&subsec] = lightGridRegions.sizei();
+                lightGridRegions.append(&subsec.as<Subsector>());
+                return LoopContinue;
+            });
+            return LoopContinue;
+        });
+        if (lightGridRegions.isEmpty()) return;
+
+        const AABoxd &bounds = self().bounds();
+        lightGrid.bake({ {bounds.minX, bounds.minY, minZ}, {bounds.maxX, bounds.maxY, maxZ} },
+                       LIGHTGRID_CELL_SIZE, lightGridRegions.sizei(),
+                       LightGridMapInfo(self(), lightGridRegionIndices), lights);
+
+        LOGDEV_MAP_VERBOSE("Baked ambient light grid with %i cells and %i lights in %.2f seconds")
+                << lightGrid.cellCount() << lights.size() << begunAt.since();
+    }
+
+    /**
+     * Bakes the light grid if needed, and brings it up to date with the current static
+     * light sources and the light of each region.
+     *
+     * Decoration lumobjs are generated again on every frame. Ones that appear, vanish,
+     * move or change color (e.g., redecoration, moving planes, sector light changes, or
+     * toggling decorations) are removed from or added to the grid. Only the cells near
+     * those lights are touched, so the grid never goes out of date.
+     */
+    void updateLightGrid()
+    {
+        std::vector<AmbientLightGrid::Light> lights = lightGridStaticLights();
+        if (!lightGrid.isBaked())
+        {
+            bakeLightGrid(lights);
+        }
+        else
+        {
+            std::vector<AmbientLightGrid::Light> removed, added;
+            std::set_difference(lightGridLights.begin(), lightGridLights.end(),
+                                lights.begin(), lights.end(),
+                                std::back_inserter(removed), lightGridLightLess);
+            std::set_difference(lights.begin(), lights.end(),
+                                lightGridLights.begin(), lightGridLights.end(),
+                                std::back_inserter(added), lightGridLightLess);
+            if (!removed.empty() || !added.empty())
+            {
+                lightGrid.updateLights(LightGridMapInfo(self(), lightGridRegionIndices),
+                                       removed, added);
+            }
+        }
+        lightGridLights = std::move(lights);
+
+        for (int i = 0; i < lightGridRegions.sizei(); ++i)
+        {
+            const Vec4f color = lightGridRegions[i]->lightSourceColorfIntensity();
+            const float rgb[3] = { color.x * color.w, color.y * color.w, color.z * color.w };
+            lightGrid.setRegionLight(i, rgb);
+        }
+    }
+
     /**
      * Interpolate the smoothed height of planes.
      */
@@ -604,13 +743,13 @@ DE_PIMPL(Map)
             {
                 if (!gen) continue;
 
-                const ParticleInfo *pInfo = gen->particleInfo();
-                for (int i = 0; i < gen->count; ++i, pInfo++)
+                const ParticleArrays &particles = gen->particles();
+                for (int i = 0; i < particles.count; ++i)
                 {
-                    if (pInfo->stage < 0 || !pInfo->bspLeaf)
+                    if (particles.stage[i] < 0 || !particles.bspLeaf[i])
                         continue;
 
-                    int listIndex = pInfo->bspLeaf->sectorPtr()->indexInMap();
+                    int listIndex = particles.bspLeaf[i]->sectorPtr()->indexInMap();
                     DE_ASSERT((unsigned)listIndex < gens.listsSize);
 
                     // Must check that it isn't already there...
@@ -644,6 +783,7 @@ DE_PIMPL(Map)
     void thinkerBeingDeleted(thinker_s &th)
     {
         clMobjHash.remove(th.id);
+        ClMobj_ForgetHistory(th.id);
     }
 };
 
@@ -709,6 +849,9 @@ void Map::initRadio()
             const Vec2d sv1 = vtx1.origin() + vo1->extendedShadowOffset();
             V2d_AddToBoxXY(bounds.arvec2, sv1.x, sv1.y);
 
+            // Remembered for culling the shadows against the view.
+            side.setShadowBounds(bounds);
+
             // Link the shadowing line to all the subspaces whose axis-aligned bounding box
             // intersects 'bounds'.
             const int localValidCount = ++World::validCount;
@@ -748,13 +891,70 @@ void Map::initContactBlockmaps()
 void Map::spreadAllContacts(const AABoxd &region)
 {
     // Expand the region according by the maxium radius of each contact type.
-    d->mobjContactBlockmap->
+    d->contactSpreadCount += d->mobjContactBlockmap->
         spread(AABoxd(region.minX - DDMOBJ_RADIUS_MAX, region.minY - DDMOBJ_RADIUS_MAX,
                       region.maxX + DDMOBJ_RADIUS_MAX, region.maxY + DDMOBJ_RADIUS_MAX));
 
-    d->lumobjContactBlockmap->
+    d->contactSpreadCount += d->lumobjContactBlockmap->
         spread(AABoxd(region.minX - Lumobj::radiusMax(), region.minY - Lumobj::radiusMax(),
-                      region.maxX + Lumobj::radiusMax(), region.maxY + Lumobj::radiusMax()));
+                      region.maxX + Lumobj::radiusMax(), region.maxY + Lumobj::radiusMax()),
+               d->geometryStamp);
+}
+
+bool Map::hasLightGrid() const
+{
+    return d->lightGrid.isBaked();
+}
+
+Vec3f Map::evaluateLightGrid(const Vec3d &point) const
+{
+    if (!hasLightGrid())
+    {
+        /// @throw MissingLightGridError  The light grid has not been baked.
+        throw MissingLightGridError("Map::evaluateLightGrid", "The light grid has not been baked");
+    }
+    float rgb[3];
+    d->lightGrid.evaluate(point.constPtr(), rgb);
+    return Vec3f(rgb);
+}
+
+/**
+ * Stamps the subsectors of @a sector with the current geometry stamp of the map.
+ */
+static void stampSubsectors(world::Sector &sector, duint stamp)
+{
+    sector.forAllSubsectors([stamp] (world::Subsector &subsec)
+    {
+        subsec.as<Subsector>().setGeometryStamp(stamp);
+        return LoopContinue;
+    });
+}
+
+void Map::markGeometryChanged(world::Sector &sector)
+{
+    const duint stamp = ++d->geometryStamp;
+    stampSubsectors(sector, stamp);
+
+    WallEdge::invalidateNormals(sector);
+
+    // Spreading into the sector is decided in the neighbors.
+    sector.forAllSides([stamp] (world::LineSide &side)
+    {
+        if (side.back().hasSector())
+        {
+            stampSubsectors(side.back().sector(), stamp);
+        }
+        return LoopContinue;
+    });
+}
+
+void Map::markGeometryChanged(world::Line &line)
+{
+    WallEdge::invalidateNormals(line);
+
+    const duint stamp = ++d->geometryStamp;
+    if (line.front().hasSector()) stampSubsectors(line.front().sector(), stamp);
+    if (line.back().hasSector())  stampSubsectors(line.back().sector(), stamp);
 }
 
 void Map::initGenerators()
@@ -1035,6 +1235,21 @@ void Map::unlinkGenerator(Generator &generator)
             break;
         }
     }
+    gens.pendingMotion.removeAll(&generator);
+}
+
+void Map::scheduleParticleMotion(Generator &generator)
+{
+    d->getGenerators().pendingMotion.append(&generator);
+}
+
+void Map::moveGeneratorParticles()
+{
+    if (!d->generators) return;
+
+    auto &pending = d->getGenerators().pendingMotion;
+    Generator::finishTicks(pending);
+    pending.clear();
 }
 
 LoopResult Map::forAllGenerators(const std::function<LoopResult (Generator &)>& func) const
@@ -1263,13 +1478,6 @@ void Map::worldFrameState(world::World::FrameState frameState)
 
     if (!freezeRLs)
     {
-#if 0
-        // Initialize and/or update the LightGrid.
-        initLightGrid();
-
-        d->biasBeginFrame();
-#endif
-
         removeAllLumobjs();
 
         d->removeAllContacts();
@@ -1307,6 +1515,17 @@ void Map::worldFrameState(world::World::FrameState frameState)
             });
         }
 
+        // The light grid uses the lumobjs of decorations as static light sources.
+        if (useLightGrid)
+        {
+            d->updateLightGrid();
+        }
+        else if (d->lightGrid.isBaked())
+        {
+            d->lightGrid.clear();
+            d->lightGridLights.clear();
+        }
+
         d->generateMobjContacts();
         d->linkAllParticles();
         d->linkAllContacts();
@@ -1397,6 +1616,9 @@ void Map::consoleRegister() // static
 {
     world::Map::consoleRegister();
 
+    C_VAR_INT("rend-dev-light-spread", &devContactSpreadCount,
+              CVF_NO_ARCHIVE | CVF_READ_ONLY | CVF_NO_MAX, 0, 0);
+
     Mobj_ConsoleRegister();
 }
 
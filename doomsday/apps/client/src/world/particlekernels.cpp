@@ -0,0 +1,384 @@
+/** @file particlekernels.cpp  Particle storage and the inner loops of particle ticking.
+ *
+ * @authors Copyright © 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "world/particlekernels.h"
+#include "simd.h"
+
+static_assert(sizeof(ParticleStageForces) == 8 * sizeof(int32_t),
+              "The vectorized kernels index ParticleStageForces as eight 32-bit values");
+
+size_t ParticleArrays::blockSize(int count)
+{
+    // Pointers first, so that every array is aligned for its elements.
+    return size_t(count) * (sizeof(world::BspLeaf *) + sizeof(Line *) +
+                            7 * sizeof(int32_t) + 3 * sizeof(uint16_t));
+}
+
+void ParticleArrays::setBlock(void *block, int count)
+{
+    this->count = count;
+
+    auto *ptr = static_cast<uint8_t *>(block);
+    auto take = [&ptr, count] (size_t elementSize)
+    {
+        void *array = ptr;
+        ptr += elementSize * size_t(count);
+        return array;
+    };
+    bspLeaf = static_cast<world::BspLeaf **>(take(sizeof(world::BspLeaf *)));
+    contact = static_cast<Line **>          (take(sizeof(Line *)));
+    stage   = static_cast<int32_t *>        (take(sizeof(int32_t)));
+    for (auto &array : origin) array = static_cast<int32_t *>(take(sizeof(int32_t)));
+    for (auto &array : mov)    array = static_cast<int32_t *>(take(sizeof(int32_t)));
+    tics    = static_cast<int16_t *>        (take(sizeof(int16_t)));
+    yaw     = static_cast<uint16_t *>       (take(sizeof(uint16_t)));
+    pitch   = static_cast<uint16_t *>       (take(sizeof(uint16_t)));
+}
+
+void *ParticleArrays::block() const
+{
+    return bspLeaf;
+}
+
+/*
+ * Portable implementations. These also process the leftovers of the vectorized loops.
+ */
+namespace scalar {
+
+static inline int32_t fixedMul(int32_t a, int32_t b)
+{
+    return int32_t(uint32_t((int64_t(a) * b) / 65536));
+}
+
+static inline uint16_t spinAngle(uint16_t angle, float delta, float factor)
+{
+    const uint16_t spun = uint16_t(int32_t(float(angle) + delta));
+    return uint16_t(int32_t(float(spun) * factor));
+}
+
+static void applyForces(const ParticleArrays &particles, int begin,
+                        const ParticleStageForces *forces, int spinPhase)
+{
+    for (int i = begin; i < particles.count; ++i)
+    {
+        const int32_t stage = particles.stage[i];
+        if (stage < 0) continue;
+
+        const ParticleStageForces &f = forces[stage];
+        const int k = (i + spinPhase) & 3;
+
+        particles.yaw[i]   = spinAngle(particles.yaw[i],   k & 2? -f.spin[0] : f.spin[0],
+                                       f.spinFactor[0]);
+        particles.pitch[i] = spinAngle(particles.pitch[i], k & 1? -f.spin[1] : f.spin[1],
+                                       f.spinFactor[1]);
+        for (int c = 0; c < 3; ++c)
+        {
+            const int32_t mov = int32_t(uint32_t(particles.mov[c][i]) + uint32_t(f.accel[c]));
+            particles.mov[c][i] = fixedMul(mov, f.resistance);
+        }
+    }
+}
+
+static void applyForces(const ParticleArrays &particles, const ParticleStageForces *forces,
+                        int spinPhase)
+{
+    applyForces(particles, 0, forces, spinPhase);
+}
+
+} // namespace scalar
+
+#ifdef DE_SIMD_SSE2
+
+namespace sse2 {
+
+/// Fixed-point multiplication of four lanes, truncated toward zero (see scalar::fixedMul).
+static inline __m128i fixedMul(__m128i a, __m128i b)
+{
+    const __m128i sign  = _mm_srai_epi32(_mm_xor_si128(a, b), 31);
+    const __m128i signA = _mm_srai_epi32(a, 31);
+    const __m128i signB = _mm_srai_epi32(b, 31);
+    const __m128i absA  = _mm_sub_epi32(_mm_xor_si128(a, signA), signA);
+    const __m128i absB  = _mm_sub_epi32(_mm_xor_si128(b, signB), signB);
+
+    // 64-bit products of the even and the odd lanes.
+    const __m128i even = _mm_srli_epi64(_mm_mul_epu32(absA, absB), 16);
+    const __m128i odd  = _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(absA, 32),
+                                                      _mm_srli_epi64(absB, 32)), 16);
+    const __m128i product = _mm_or_si128(_mm_and_si128(even, _mm_set_epi32(0, -1, 0, -1)),
+                                         _mm_slli_epi64(odd, 32));
+    return _mm_sub_epi32(_mm_xor_si128(product, sign), sign);
+}
+
+static inline __m128i spinAngles(__m128i angles, __m128 delta, __m128 factor)
+{
+    const __m128i mask = _mm_set1_epi32(0xffff);
+    const __m128i spun = _mm_and_si128(_mm_cvttps_epi32(_mm_add_ps(_mm_cvtepi32_ps(angles), delta)), mask);
+    return _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(spun), factor)), mask);
+}
+
+static inline __m128i loadAngles(const uint16_t *angles)
+{
+    return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(angles)),
+                              _mm_setzero_si128());
+}
+
+static inline void storeAngles(uint16_t *angles, __m128i values)
+{
+    // There is no unsigned 32-bit pack in SSE2, so the values are biased for a signed one.
+    const __m128i packed = _mm_packs_epi32(_mm_sub_epi32(values, _mm_set1_epi32(0x8000)),
+                                           _mm_setzero_si128());
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(angles),
+                     _mm_xor_si128(packed, _mm_set1_epi16(short(0x8000))));
+}
+
+static inline __m128i select(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static void applyForces(const ParticleArrays &particles, const ParticleStageForces *forces,
+                        int spinPhase)
+{
+    // Sign bits of the spin of each lane.
+    alignas(16) int32_t yawSigns[4], pitchSigns[4];
+    for (int j = 0; j < 4; ++j)
+    {
+        const int k = (j + spinPhase) & 3;
+        yawSigns[j]   = (k & 2)? int32_t(0x80000000) : 0;
+        pitchSigns[j] = (k & 1)? int32_t(0x80000000) : 0;
+    }
+    const __m128 yawSign   = _mm_castsi128_ps(_mm_load_si128(reinterpret_cast<const __m128i *>(yawSigns)));
+    const __m128 pitchSign = _mm_castsi128_ps(_mm_load_si128(reinterpret_cast<const __m128i *>(pitchSigns)));
+
+    int i = 0;
+    for (; i + 4 <= particles.count; i += 4)
+    {
+        const __m128i stage  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(particles.stage + i));
+        const __m128i active = _mm_cmpgt_epi32(stage, _mm_set1_epi32(-1));
+        if (!_mm_movemask_epi8(active)) continue;
+
+        __m128i accel[3], resistance;
+        __m128 spin[2], spinFactor[2];
+        const int32_t first = particles.stage[i];
+        if (first >= 0 &&
+            _mm_movemask_epi8(_mm_cmpeq_epi32(stage, _mm_set1_epi32(first))) == 0xffff)
+        {
+            // Usually the neighbors are in the same stage.
+            const ParticleStageForces &f = forces[first];
+            for (int c = 0; c < 3; ++c) accel[c] = _mm_set1_epi32(f.accel[c]);
+            resistance = _mm_set1_epi32(f.resistance);
+            for (int a = 0; a < 2; ++a)
+            {
+                spin[a]       = _mm_set1_ps(f.spin[a]);
+                spinFactor[a] = _mm_set1_ps(f.spinFactor[a]);
+            }
+        }
+        else
+        {
+            // The nonexistent particles use the first stage; the results are discarded.
+            const ParticleStageForces *f[4];
+            for (int j = 0; j < 4; ++j)
+            {
+                f[j] = &forces[particles.stage[i + j] >= 0? particles.stage[i + j] : 0];
+            }
+            for (int c = 0; c < 3; ++c)
+            {
+                accel[c] = _mm_set_epi32(f[3]->accel[c], f[2]->accel[c], f[1]->accel[c], f[0]->accel[c]);
+            }
+            resistance = _mm_set_epi32(f[3]->resistance, f[2]->resistance, f[1]->resistance,
+                                       f[0]->resistance);
+            for (int a = 0; a < 2; ++a)
+            {
+                spin[a]       = _mm_set_ps(f[3]->spin[a], f[2]->spin[a], f[1]->spin[a], f[0]->spin[a]);
+                spinFactor[a] = _mm_set_ps(f[3]->spinFactor[a], f[2]->spinFactor[a],
+                                           f[1]->spinFactor[a], f[0]->spinFactor[a]);
+            }
+        }
+
+        const __m128i yaw   = loadAngles(particles.yaw + i);
+        const __m128i pitch = loadAngles(particles.pitch + i);
+        storeAngles(particles.yaw + i,
+                    select(active, spinAngles(yaw, _mm_xor_ps(spin[0], yawSign), spinFactor[0]), yaw));
+        storeAngles(particles.pitch + i,
+                    select(active, spinAngles(pitch, _mm_xor_ps(spin[1], pitchSign), spinFactor[1]), pitch));
+
+        for (int c = 0; c < 3; ++c)
+        {
+            auto *mov = reinterpret_cast<__m128i *>(particles.mov[c] + i);
+            const __m128i old = _mm_loadu_si128(mov);
+            _mm_storeu_si128(mov, select(active, fixedMul(_mm_add_epi32(old, accel[c]), resistance), old));
+        }
+    }
+    scalar::applyForces(particles, i, forces, spinPhase);
+}
+
+} // namespace sse2
+
+#endif // DE_SIMD_SSE2
+
+#ifdef DE_SIMD_AVX2
+
+namespace avx2 {
+
+/// Fixed-point multiplication of eight lanes, truncated toward zero (see scalar::fixedMul).
+DE_TARGET_AVX2 static inline __m256i fixedMul(__m256i a, __m256i b)
+{
+    const __m256i sign = _mm256_srai_epi32(_mm256_xor_si256(a, b), 31);
+    const __m256i absA = _mm256_abs_epi32(a);
+    const __m256i absB = _mm256_abs_epi32(b);
+
+    // 64-bit products of the even and the odd lanes.
+    const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(absA, absB), 16);
+    const __m256i odd  = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(absA, 32),
+                                                            _mm256_srli_epi64(absB, 32)), 16);
+    const __m256i product = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xaa);
+    return _mm256_sub_epi32(_mm256_xor_si256(product, sign), sign);
+}
+
+DE_TARGET_AVX2 static inline __m256i spinAngles(__m256i angles, __m256 delta, __m256 factor)
+{
+    const __m256i mask = _mm256_set1_epi32(0xffff);
+    const __m256i spun = _mm256_and_si256(
+        _mm256_cvttps_epi32(_mm256_add_ps(_mm256_cvtepi32_ps(angles), delta)), mask);
+    return _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(spun), factor)), mask);
+}
+
+DE_TARGET_AVX2 static inline __m256i loadAngles(const uint16_t *angles)
+{
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(angles)));
+}
+
+DE_TARGET_AVX2 static inline void storeAngles(uint16_t *angles, __m256i values)
+{
+    // The pack works within 128-bit halves; move the results to the low half.
+    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(values, values), 0x08);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(angles), _mm256_castsi256_si128(packed));
+}
+
+DE_TARGET_AVX2 static void applyForces(const ParticleArrays &particles,
+                                       const ParticleStageForces *forces, int spinPhase)
+{
+    // Sign bits of the spin of each lane.
+    alignas(32) int32_t yawSigns[8], pitchSigns[8];
+    for (int j = 0; j < 8; ++j)
+    {
+        const int k = (j + spinPhase) & 3;
+        yawSigns[j]   = (k & 2)? int32_t(0x80000000) : 0;
+        pitchSigns[j] = (k & 1)? int32_t(0x80000000) : 0;
+    }
+    const __m256 yawSign   = _mm256_castsi256_ps(_mm256_load_si256(reinterpret_cast<const __m256i *>(yawSigns)));
+    const __m256 pitchSign = _mm256_castsi256_ps(_mm256_load_si256(reinterpret_cast<const __m256i *>(pitchSigns)));
+
+    const auto *forceInts   = reinterpret_cast<const int *>(forces);
+    const auto *forceFloats = reinterpret_cast<const float *>(forces);
+
+    int i = 0;
+    for (; i + 8 <= particles.count; i += 8)
+    {
+        const __m256i stage  = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(particles.stage + i));
+        const __m256i active = _mm256_cmpgt_epi32(stage, _mm256_set1_epi32(-1));
+        if (_mm256_testz_si256(active, active)) continue;
+
+        // The nonexistent particles use the first stage; the results are discarded.
+        const __m256i index = _mm256_slli_epi32(_mm256_max_epi32(stage, _mm256_setzero_si256()), 3);
+        __m256i accel[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            accel[c] = _mm256_i32gather_epi32(forceInts + c, index, 4);
+        }
+        const __m256i resistance = _mm256_i32gather_epi32(forceInts + 3, index, 4);
+        const __m256 yawSpin     = _mm256_i32gather_ps(forceFloats + 4, index, 4);
+        const __m256 pitchSpin   = _mm256_i32gather_ps(forceFloats + 5, index, 4);
+        const __m256 yawFactor   = _mm256_i32gather_ps(forceFloats + 6, index, 4);
+        const __m256 pitchFactor = _mm256_i32gather_ps(forceFloats + 7, index, 4);
+
+        const __m256i yaw   = loadAngles(particles.yaw + i);
+        const __m256i pitch = loadAngles(particles.pitch + i);
+        storeAngles(particles.yaw + i, _mm256_blendv_epi8(
+            yaw, spinAngles(yaw, _mm256_xor_ps(yawSpin, yawSign), yawFactor), active));
+        storeAngles(particles.pitch + i, _mm256_blendv_epi8(
+            pitch, spinAngles(pitch, _mm256_xor_ps(pitchSpin, pitchSign), pitchFactor), active));
+
+        for (int c = 0; c < 3; ++c)
+        {
+            auto *mov = reinterpret_cast<__m256i *>(particles.mov[c] + i);
+            const __m256i old = _mm256_loadu_si256(mov);
+            _mm256_storeu_si256(mov, _mm256_blendv_epi8(
+                old, fixedMul(_mm256_add_epi32(old, accel[c]), resistance), active));
+        }
+    }
+    scalar::applyForces(particles, i, forces, spinPhase);
+}
+
+} // namespace avx2
+
+#endif // DE_SIMD_AVX2
+
+static const ParticleKernels scalarKernels = {
+    ParticleKernels::Scalar, "scalar", scalar::applyForces
+};
+
+#ifdef DE_SIMD_SSE2
+static const ParticleKernels sse2Kernels = {
+    ParticleKernels::SSE2, "SSE2", sse2::applyForces
+};
+#endif
+
+#ifdef DE_SIMD_AVX2
+static const ParticleKernels avx2Kernels = {
+    ParticleKernels::AVX2, "AVX2", avx2::applyForces
+};
+#endif
+
+const ParticleKernels *Particle_KernelsAtLevel(ParticleKernels::Level level)
+{
+    switch (level)
+    {
+    case ParticleKernels::Scalar:
+        return &scalarKernels;
+
+#ifdef DE_SIMD_SSE2
+    case ParticleKernels::SSE2:
+        return &sse2Kernels;
+#endif
+
+#ifdef DE_SIMD_AVX2
+    case ParticleKernels::AVX2: {
+        return SIMD_CPUSupportsAVX2()? &avx2Kernels : nullptr; }
+#endif
+
+    default:
+        return nullptr;
+    }
+}
+
+const ParticleKernels &Particle_Kernels()
+{
+    static const ParticleKernels *best = [] () {
+        for (int level = ParticleKernels::LevelCount - 1; level > ParticleKernels::Scalar; --level)
+        {
+            if (const ParticleKernels *kernels = Particle_KernelsAtLevel(ParticleKernels::Level(level)))
+            {
+                return kernels;
+            }
+        }
+        return &scalarKernels;
+    }();
+    return *best;
+}
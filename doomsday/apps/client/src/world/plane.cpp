@@ -237,6 +237,9 @@ Generator *Plane::tryFindGenerator() const
 
 void Plane::notifySmoothedHeightChanged()
 {
+    // Wall edge normals and light spreading depend on the plane heights.
+    if (hasMap()) map().markGeometryChanged(sector());
+
     DE_NOTIFY_VAR(HeightSmoothedChange, i) i->planeHeightSmoothedChanged(*this);
 }
 
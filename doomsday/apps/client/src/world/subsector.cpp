@@ -198,6 +198,7 @@ DE_PIMPL(Subsector)
     int validFrame;
     bool hasWorldVolumeInValidFrame;
     bool hasInvisibleTop = false;
+    duint geometryStamp = 0;
 
     bool           needClassify = true; ///< @c true= (Re)classification is necessary.
     SubsectorFlags flags        = 0;
@@ -1686,6 +1687,16 @@ const Subsector::AudioEnvironment &Subsector::reverb() const
     return d->reverb;
 }
 
+duint Subsector::geometryStamp() const
+{
+    return d->geometryStamp;
+}
+
+void Subsector::setGeometryStamp(duint stamp)
+{
+    d->geometryStamp = stamp;
+}
+
 #if 0
 void Subsector::markVisPlanesDirty()
 {
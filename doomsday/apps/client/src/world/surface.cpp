@@ -47,6 +47,19 @@ Surface::Surface(world::MapElement &owner, float opacity, const Vec3f &color)
             map().scrollingSurfaces().insert(this);
         }
     };
+
+    if (owner.type() == DMU_SIDE)
+    {
+        // Wall edge normal smoothing and light spreading depend on these. The origin
+        // (material offset) does not; it changes on every tic when scrolling.
+        auto geometryChanged = [this] ()
+        {
+            if (hasMap()) map().markGeometryChanged(parent().as<world::LineSide>().line());
+        };
+        audienceForNormalChange()   += geometryChanged;
+        audienceForMaterialChange() += geometryChanged;
+        audienceForOpacityChange()  += geometryChanged;
+    }
 }
 
 Surface::~Surface()
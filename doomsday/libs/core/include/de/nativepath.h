@@ -169,6 +169,15 @@ public:
      */
     bool remove() const;
 
+    /**
+     * Renames the native file at the path to @a destination. An existing file at
+     * @a destination is replaced in one step, so the destination is never left
+     * partially written or missing.
+     *
+     * @return @c true on success.
+     */
+    bool renameReplacing(const NativePath &destination) const;
+
 public:
     /**
      * Returns the current native working path.
@@ -25,6 +25,10 @@
 #include <the_Foundation/fileinfo.h>
 #include <the_Foundation/path.h>
 #include <cstdio>
+#ifdef WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#endif
 
 /**
  * @def NATIVE_BASE_SYMBOLIC
@@ -271,6 +275,17 @@ bool NativePath::remove() const
     return ::remove(c_str()) == 0; // stdio.h
 }
 
+bool NativePath::renameReplacing(const NativePath &destination) const
+{
+#if defined (WIN32)
+    return MoveFileExW(toString().toWideString().c_str(),
+                       destination.toString().toWideString().c_str(),
+                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(c_str(), destination.c_str()) == 0; // replaces atomically
+#endif
+}
+
 static std::unique_ptr<NativePath> currentNativeWorkPath;
 
 NativePath NativePath::workPath()
@@ -137,6 +137,19 @@ public:
      */
     int nearestIndex(const de::Vec3ub &rgb) const;
 
+    /**
+     * Finds the closest matching color indices of many colors at once. The
+     * palette should have at most 256 colors.
+     *
+     * @param pixels     R8G8B8 colors, @a pixelSize bytes apart.
+     * @param pixelSize  Size of a pixel in bytes (at least 3).
+     * @param count      Number of pixels.
+     * @param indices    Closest matching color index of each pixel is written here.
+     *                   Zero if there are no colors in the palette.
+     */
+    void nearestIndices(const de::dbyte *pixels, int pixelSize, de::dsize count,
+                        de::dbyte *indices) const;
+
     /**
      * Clear all translation maps.
      */
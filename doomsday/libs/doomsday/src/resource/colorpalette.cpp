@@ -26,6 +26,11 @@
 #include <de/legacy/reader.h>
 #include <de/legacy/mathutil.h>
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 using namespace de;
 
 #define RGB18(r, g, b)      ((r)+((g)<<6)+((b)<<12))
@@ -169,10 +174,11 @@ DE_PIMPL(ColorPalette)
     typedef KeyMap<String, Translation> Translations;
     Translations translations;
 
-    /// 18-bit to 8-bit, nearest color translation table.
-    typedef List<int> XLat18To8;
-    std::unique_ptr<XLat18To8> xlat18To8;
+    /// 18-bit to 8-bit, nearest color translation table: a 64x64x64 color cube.
+    typedef std::vector<duint16> XLat18To8;
+    std::shared_ptr<const XLat18To8> xlat18To8;
     bool need18To8Update = false;  // Table built only when needed.
+    std::mutex xlatMutex;          // Nearest color lookups may happen in any thread.
 
     Id id;
 
@@ -199,42 +205,89 @@ DE_PIMPL(ColorPalette)
         }
     }
 
-    /// @note A time-consuming operation.
-    void prepareNearestLUT()
+    /**
+     * Returns the nearest color translation table, building it first if needed.
+     * A rebuilt table replaces the old one instead of overwriting it, so the
+     * returned table stays unchanged for as long as the caller holds on to it.
+     */
+    std::shared_ptr<const XLat18To8> nearestLUT()
+    {
+        std::lock_guard<std::mutex> lock(xlatMutex);
+        if (need18To8Update || !xlat18To8)
+        {
+            need18To8Update = false;
+            xlat18To8 = prepareNearestLUT();
+        }
+        return xlat18To8;
+    }
+
+    /**
+     * Builds a new 18-bit to 8-bit table. For each cell, the palette is searched
+     * outward from the cell's red component in red-sorted order, stopping once
+     * the red difference alone exceeds the best match. The result is the same as
+     * with an exhaustive search: ties go to the lowest color index.
+     */
+    std::shared_ptr<const XLat18To8> prepareNearestLUT() const
     {
 #define COLORS18BIT 262144
 
-        need18To8Update = false;
+        auto table = std::make_shared<XLat18To8>(COLORS18BIT);
 
-        if (!xlat18To8)
+        struct SortedColor { int r, g, b, index; };
+        std::vector<SortedColor> sorted;
+        sorted.reserve(colors.size());
+        for (int i = 0; i < colors.count(); ++i)
         {
-            xlat18To8.reset(new XLat18To8(COLORS18BIT));
+            sorted.push_back(SortedColor{colors[i].x, colors[i].y, colors[i].z, i});
         }
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [] (const SortedColor &a, const SortedColor &b) { return a.r < b.r; });
+        const int count = int(sorted.size());
 
         for (int r = 0; r < 64; ++r)
-        for (int g = 0; g < 64; ++g)
-        for (int b = 0; b < 64; ++b)
         {
-            int nearest = 0;
-            int smallestDiff = DDMAXINT;
-            for (int i = 0; i < colors.count(); ++i)
+            const int red = r << 2;
+            const int start = int(std::lower_bound(sorted.begin(), sorted.end(), red,
+                                                   [] (const SortedColor &c, int value) {
+                                                       return c.r < value;
+                                                   }) - sorted.begin());
+            for (int g = 0; g < 64; ++g)
+            for (int b = 0; b < 64; ++b)
             {
-                const Color &color = colors[i];
-                int diff = (color.x - (r << 2)) * (color.x - (r << 2)) +
-                           (color.y - (g << 2)) * (color.y - (g << 2)) +
-                           (color.z - (b << 2)) * (color.z - (b << 2));
-
-                if (diff < smallestDiff)
+                const int green = g << 2;
+                const int blue  = b << 2;
+
+                int nearest = DDMAXINT;
+                int smallestDiff = DDMAXINT;
+                auto consider = [&] (const SortedColor &c) {
+                    const int diff = (c.r - red)   * (c.r - red) +
+                                     (c.g - green) * (c.g - green) +
+                                     (c.b - blue)  * (c.b - blue);
+                    if (diff < smallestDiff || (diff == smallestDiff && c.index < nearest))
+                    {
+                        smallestDiff = diff;
+                        nearest = c.index;
+                    }
+                };
+                // Equal red differences may still produce a tie with a lower index,
+                // so the scan only stops when the difference is strictly larger.
+                for (int i = start; i < count; ++i)
                 {
-                    smallestDiff = diff;
-                    nearest = i;
+                    if ((sorted[i].r - red) * (sorted[i].r - red) > smallestDiff) break;
+                    consider(sorted[i]);
+                }
+                for (int i = start - 1; i >= 0; --i)
+                {
+                    if ((sorted[i].r - red) * (sorted[i].r - red) > smallestDiff) break;
+                    consider(sorted[i]);
                 }
-            }
 
-            (*xlat18To8)[RGB18(r, g, b)] = nearest;
+                (*table)[RGB18(r, g, b)] = duint16(nearest);
+            }
         }
 
 #undef COLORS18BIT
+        return table;
     }
 };
 
@@ -263,11 +316,14 @@ ColorPalette &ColorPalette::replaceColorTable(const ColorTable &colorTable)
 
     const int colorCountBefore = colorCount();
 
-    // We may need a new 18 => 8 bit xlat table.
-    d->need18To8Update = true;
-
-    // Replace the whole color table.
-    d->colors = colorTable;
+    // Replace the whole color table. Nearest color lookups in other threads read
+    // the colors while building the 18 => 8 bit xlat table, which we may now need
+    // to rebuild.
+    {
+        std::lock_guard<std::mutex> lock(d->xlatMutex);
+        d->colors = colorTable;
+        d->need18To8Update = true;
+    }
 
     // Notify interested parties.
     d->notifyColorTableChanged();
@@ -311,13 +367,26 @@ int ColorPalette::nearestIndex(const Vec3ub &rgb) const
 
     if (d->colors.isEmpty()) return -1;
 
-    // Ensure we've prepared the 18 to 8 table.
-    if (d->need18To8Update || !d->xlat18To8)
+    return (*d->nearestLUT())[RGB18(rgb.x >> 2, rgb.y >> 2, rgb.z >> 2)];
+}
+
+void ColorPalette::nearestIndices(const dbyte *pixels, int pixelSize, dsize count,
+                                  dbyte *indices) const
+{
+    DE_ASSERT(pixelSize >= 3);
+
+    if (d->colors.isEmpty())
     {
-        d->prepareNearestLUT();
+        std::fill(indices, indices + count, dbyte(0));
+        return;
     }
 
-    return (*d->xlat18To8)[RGB18(rgb.x >> 2, rgb.y >> 2, rgb.z >> 2)];
+    const auto lutRef = d->nearestLUT();
+    const auto &lut   = *lutRef;
+    for (dsize i = 0; i < count; ++i, pixels += pixelSize)
+    {
+        indices[i] = dbyte(lut[RGB18(pixels[0] >> 2, pixels[1] >> 2, pixels[2] >> 2)]);
+    }
 }
 
 void ColorPalette::clearTranslations()
@@ -139,6 +139,14 @@ public:
      */
     void setEntryPoint(const Module::EntryPoint &entryPoint);
 
+    /**
+     * Returns the total number of instructions the script has executed since the module
+     * was loaded (for profiling; not serialized).
+     */
+    de::duint64 executedInstructionCount() const;
+
+    void addExecutedInstructions(de::duint count);
+
     void read(Reader1 *reader);
     void write(Writer1 *writer) const;
 
@@ -166,6 +166,7 @@ typedef struct libcommon_config_s {
     byte            confirmQuickGameSave;
     byte            confirmRebornLoad;
     byte            loadLastSaveOnReborn;
+    byte            saveInBackground;
 
     // Multiplayer:
     char *          netEpisode;
@@ -188,6 +188,10 @@ public:  // Saved session management -------------------------------------------
     /**
      * Save the current game state to a new @em user saved session.
      *
+     * If saving in the background is enabled, the game state is only captured here and
+     * the package is compressed and written to disk in a background thread. Success is
+     * reported once the package has been written.
+     *
      * @param saveName         Name of the new saved session.
      * @param userDescription  Textual description of the current game state provided either
      *                         by the user or possibly generated automatically.
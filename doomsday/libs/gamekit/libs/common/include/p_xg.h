@@ -28,6 +28,7 @@
 #define LIBCOMMON_HAVE_XG 1
 
 DE_EXTERN_C int xgDev;
+DE_EXTERN_C int xgIdle;
 DE_EXTERN_C dd_bool xgDataLumps;
 
 #ifdef __cplusplus
@@ -358,6 +358,8 @@ typedef struct {
     float           fdata;
     int             chIdx; // Chain sequence index.
     float           chTimer; // Chain sequence timer.
+    int             wakeTime; // While mapTime is less than this, the line is idle (see XL_Thinker).
+    int             idleTics; // Number of tics skipped while idle, not yet applied to the timers.
 } xgline_t;
 
 // The XG line Classes
@@ -381,6 +383,17 @@ void XL_Update(void);
 
 void XL_Thinker(void *xlThinkerPtr);
 
+/**
+ * Applies the timer changes of the tics an idle XG line has skipped, so that its
+ * state is the same as if it had been thinking all along. The line remains idle.
+ */
+void XL_CatchUp(xgline_t *xg);
+
+/**
+ * Catches up and wakes an idle XG line so that it resumes thinking on every tic.
+ */
+void XL_Wake(xgline_t *xg);
+
 /**
  * Looks for line type definition and sets the line type if one is found.
  */
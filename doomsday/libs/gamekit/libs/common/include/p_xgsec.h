@@ -125,6 +125,8 @@ typedef struct {
     sectortype_t info;
     int timer;
     int chainTimer[DDLT_MAX_CHAINS];
+    int wakeTime; // While mapTime is less than this, the sector is idle (see XS_Thinker).
+    int idleTics; // Number of tics skipped while idle, not yet applied to the timers.
 } xgsector_t;
 
 typedef struct xgplanemover_s {
@@ -164,6 +166,17 @@ void XS_Update(void);
 
 void XS_Thinker(void *xsThinker);
 
+/**
+ * Applies the timer changes of the tics an idle XG sector has skipped, so that its
+ * state is the same as if it had been thinking all along. The sector remains idle.
+ */
+void XS_CatchUp(xgsector_t *xg);
+
+/**
+ * Catches up and wakes an idle XG sector so that it resumes thinking on every tic.
+ */
+void XS_Wake(xgsector_t *xg);
+
 coord_t XS_Gravity(Sector *sector);
 coord_t XS_Friction(const Sector *sector);
 
@@ -1111,9 +1111,13 @@ void Interpreter::think()
 
         currentScriptNumber = script().entryPoint().scriptNumber;
 
+        duint executed = 1;
         while((action = findCommand(DD_LONG(*pcodePtr++))(*this)) == Continue)
-        {}
+        {
+            executed++;
+        }
 
+        script().addExecutedInstructions(executed);
         currentScriptNumber = -1;
     }
 
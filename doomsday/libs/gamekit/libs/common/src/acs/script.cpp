@@ -47,6 +47,7 @@ DE_PIMPL_NOREF(Script)
     const Module::EntryPoint *entryPoint = nullptr;
     State state   = Inactive;
     int waitValue = 0;
+    duint64 executedCount = 0;
 
     void wait(State waitState, int value)
     {
@@ -86,7 +87,8 @@ String Script::describe() const
 String Script::description() const
 {
     return DE2_ESC(l) "State: " DE2_ESC(.) DE2_ESC(i) + stateAsText(d->state) + DE2_ESC(.)
-         + (isWaiting()? DE2_ESC(l) " Wait-for: " DE2_ESC(.) DE2_ESC(i) + String::asText(d->waitValue) : "");
+         + (isWaiting()? DE2_ESC(l) " Wait-for: " DE2_ESC(.) DE2_ESC(i) + String::asText(d->waitValue) : "")
+         + DE2_ESC(l) " Executed: " DE2_ESC(.) DE2_ESC(i) + String::asText(d->executedCount);
 }
 
 bool Script::start(const Args &args, mobj_t *activator, Line *line, int side, int delayCount)
@@ -206,6 +208,16 @@ void Script::write(writer_s *writer) const
     Writer_WriteInt16(writer, d->waitValue);
 }
 
+duint64 Script::executedInstructionCount() const
+{
+    return d->executedCount;
+}
+
+void Script::addExecutedInstructions(duint count)
+{
+    d->executedCount += count;
+}
+
 void Script::read(reader_s *reader)
 {
     DE_ASSERT(reader);
@@ -3076,6 +3076,7 @@ void G_ConsoleRegister()
     /* Alias */ C_VAR_BYTE("menu-quick-ask",     &cfg.common.confirmQuickGameSave,  0, 0, 1);
     C_VAR_BYTE("game-save-confirm-loadonreborn", &cfg.common.confirmRebornLoad,     0, 0, 1);
     C_VAR_BYTE("game-save-last-loadonreborn",    &cfg.common.loadLastSaveOnReborn,  0, 0, 1);
+    C_VAR_BYTE("game-save-background",           &cfg.common.saveInBackground,      0, 0, 1);
 
     C_CMD("deletegamesave",     "ss",       DeleteSaveGame);
     C_CMD("deletegamesave",     "s",        DeleteSaveGame);
@@ -23,6 +23,8 @@
 #include <de/app.h>
 #include <de/commandline.h>
 #include <de/arrayvalue.h>
+#include <de/async.h>
+#include <de/nativefile.h>
 #include <de/numbervalue.h>
 #include <de/recordvalue.h>
 #include <de/packageloader.h>
@@ -51,6 +53,8 @@
 #include "p_sound.h"
 #include "p_tick.h"
 #include "r_common.h"
+
+#include <atomic>
 #if __JDOOM__
 #  include "doomv9mapstatereader.h"
 #endif
@@ -118,6 +122,10 @@ DE_PIMPL(GameSession)
 
     acs::System acscriptSys;  ///< The One acs::System instance.
 
+    struct SaveSnapshot;
+    AsyncScope backgroundSaves;  ///< Packages being written by saveInBackground().
+    std::shared_ptr<SaveSnapshot> pendingSave;  ///< Not yet completed on the main thread.
+
     Impl(Public *i) : Base(i)
     {}
 
@@ -262,7 +270,8 @@ DE_PIMPL(GameSession)
      * Update/create a new GameStateFolder at the specified @a path from the current
      * game state.
      */
-    GameStateFolder &updateGameStateFolder(const String &path, const GameStateMetadata &metadata)
+    GameStateFolder &updateGameStateFolder(const String &path, const GameStateMetadata &metadata,
+                                           bool flush = true)
     {
         DE_ASSERT(self().hasBegun());
 
@@ -306,12 +315,220 @@ DE_PIMPL(GameSession)
         //DoomsdayApp::app().gameSessionWasSaved(self(), *saved);
         //self().setThinkerMapping(nullptr);
 
-        saved->release();  // No need to populate; FS2 Files already in sync with source data.
+        if (flush)
+        {
+            saved->release();  // No need to populate; FS2 Files already in sync with source data.
+        }
         saved->cacheMetadata(metadata);  // Avoid immediately reopening the .save package.
 
         return *saved;
     }
 
+    /**
+     * Contents of a .save package captured on the game thread. The entry data is shared
+     * copy-on-write with the internal backing store, so capturing is cheap and the game
+     * may continue to modify the store while the package is encoded and written.
+     */
+    struct SaveSnapshot
+    {
+        String savePath;
+        NativePath nativePath;
+        GameStateMetadata metadata;
+        List<std::pair<String, Block>> entries;
+        Time startedAt;                      ///< When saving began.
+        std::atomic_int progress { 0 };      ///< Percentage, updated by the background thread.
+        std::atomic<dsize> size { 0 };       ///< Bytes in the written package.
+        std::atomic_bool written { false };  ///< Set by the background thread.
+    };
+
+    static void collectEntries(const Archive &arch, const String &folder, SaveSnapshot &snapshot)
+    {
+        Archive::Names names;
+        arch.listFiles(names, folder);
+        for (const String &name : names)
+        {
+            const String entryPath = folder / name;
+            snapshot.entries << std::make_pair(entryPath, arch.entryBlock(entryPath));
+        }
+        names.clear();
+        arch.listFolders(names, folder);
+        for (const String &name : names)
+        {
+            collectEntries(arch, folder / name, snapshot);
+        }
+    }
+
+    /**
+     * Writes the .save package of @a snapshot to the native file system. The package is
+     * first written to a temporary file which then replaces the destination, so a crash
+     * midway through never leaves behind a partially written savegame.
+     *
+     * Called from a background thread.
+     */
+    static bool writeSnapshot(SaveSnapshot &snapshot)
+    {
+        ZipArchive arch;
+        for (const auto &entry : snapshot.entries)
+        {
+            arch.add(entry.first, entry.second);
+        }
+        snapshot.progress = 10;
+
+        Block package;
+        de::Writer(package) << arch;  // Compresses the entries.
+        snapshot.size     = package.size();
+        snapshot.progress = 80;
+
+        const NativePath tempPath = snapshot.nativePath.toString() + ".tmp";
+        try
+        {
+            {
+                std::unique_ptr<NativeFile> temp(NativeFile::newStandalone(tempPath));
+                temp->setMode(File::Write);
+                temp->clear();
+                *temp << package;
+                temp->release();
+            }
+            snapshot.progress = 95;
+
+            // Replace the destination in one step, so there is always a complete package.
+            if (!tempPath.renameReplacing(snapshot.nativePath))
+            {
+                tempPath.remove();
+                return false;
+            }
+        }
+        catch (const Error &er)
+        {
+            LOG_RES_WARNING("Error writing \"%s\": %s") << tempPath << er.asText();
+            tempPath.remove();  // Don't leave a partially written package behind.
+            return false;
+        }
+        snapshot.progress = 100;
+        return true;
+    }
+
+    /**
+     * Finishes a save written in the background: the file system is told about the
+     * new package and success is reported. Called on the main thread, either when the
+     * background thread has finished or by finishBackgroundSaves(), whichever happens
+     * first.
+     */
+    void completeBackgroundSave(std::shared_ptr<SaveSnapshot> snapshot)
+    {
+        if (pendingSave != snapshot) return;  // Already completed.
+        pendingSave.reset();
+
+        LOG_AS("GameSession");
+        if (!snapshot->written)
+        {
+            LOG_RES_WARNING("Failed to write \"%s\"") << snapshot->nativePath;
+            return;
+        }
+
+        // Let the file system know about the new package.
+        auto &folder = App::rootFolder().locate<Folder>(snapshot->savePath.fileNamePath());
+        folder.populate(Folder::PopulateOnlyThisFolder);
+        if (auto *written = App::rootFolder().tryLocate<GameStateFolder>(snapshot->savePath))
+        {
+            written->cacheMetadata(snapshot->metadata);
+        }
+        LOG_RES_MSG("Saved \"%s\" (%.1f KB) in %.2f seconds")
+                << snapshot->savePath << snapshot->size / 1024.0 << snapshot->startedAt.since();
+
+        P_SetMessage(&players[CONSOLEPLAYER], TXT_GAMESAVED);
+
+        /// @todo After the engine has the primary responsibility of saving the game,
+        /// this notification is unnecessary.
+        Plug_Notify(DD_NOTIFY_GAME_SAVED, nullptr);
+    }
+
+    /**
+     * Saves the current game state to @a savePath. The internal backing store is updated
+     * in memory and a snapshot of it is taken on the game thread; compressing and writing
+     * the package is then done in a background thread.
+     *
+     * The map state is serialized on the game thread because MapStateWriter reads the
+     * live players, thinkers and map elements, which the game changes every tic. Copying
+     * them for another thread would be a pass over the same data as serializing them.
+     * The serialized entries are much smaller than the map, and zip compression and disk
+     * I/O are the slow part of saving.
+     *
+     * The internal backing store is not flushed to its file here, because that would
+     * compress the package on the game thread. The store is only read back through the
+     * file system during the session, and any leftover internal save is removed when a
+     * session begins; the store's file is updated when the package is next flushed or
+     * released.
+     *
+     * @return @c false if the destination cannot be written to natively and the caller
+     * should fall back to saving synchronously.
+     */
+    bool saveInBackground(const String &savePath, const GameStateMetadata &metadata)
+    {
+        const NativePath folderPath =
+                App::rootFolder().locate<Folder>(savePath.fileNamePath()).correspondingNativePath();
+        if (folderPath.isEmpty()) return false;
+
+        // Wait for the previous save to finish, in case it had the same destination.
+        finishBackgroundSaves();
+
+        const Time startedAt;
+
+        const auto &saved = updateGameStateFolder(internalSavePath(), metadata, false /*don't flush*/);
+
+        std::shared_ptr<SaveSnapshot> snapshot(new SaveSnapshot);
+        snapshot->savePath   = savePath;
+        snapshot->nativePath = folderPath / savePath.fileName();
+        snapshot->metadata   = metadata;
+        snapshot->startedAt  = startedAt;
+        collectEntries(saved.archive(), "", *snapshot);
+
+        LOG_RES_VERBOSE("Writing \"%s\" in the background (%i entries)...")
+                << savePath << snapshot->entries.size();
+
+        // In networked games the server tells the clients to save also. This is done now
+        // so that the clients save the same tic as the snapshot.
+        NetSv_SaveGame(metadata.getui("sessionId"));
+
+        pendingSave = snapshot;
+        backgroundSaves += async([snapshot] () -> int
+        {
+            snapshot->written = writeSnapshot(*snapshot);
+            return 0;
+        },
+        [this, snapshot] (int)
+        {
+            completeBackgroundSave(snapshot);
+        });
+        return true;
+    }
+
+    int backgroundSaveProgress() const
+    {
+        return pendingSave? pendingSave->progress.load() : -1;
+    }
+
+    /**
+     * Waits until saves being written in the background are finished and completes
+     * them immediately, so the saved sessions can be accessed.
+     */
+    void finishBackgroundSaves()
+    {
+        const int progress = backgroundSaveProgress();
+        if (progress >= 0 && progress < 100)
+        {
+            LOG_AS("GameSession");
+            LOG_RES_MSG("Waiting for \"%s\" to be written (%i%% done)...")
+                    << pendingSave->savePath << progress;
+        }
+        backgroundSaves.waitForFinished();
+        if (pendingSave)
+        {
+            // Don't wait for the main loop to call the completion.
+            completeBackgroundSave(pendingSave);
+        }
+    }
+
 #if __JDOOM__ || __JDOOM64__
     /**
      * @todo fixme: (Kludge) Assumes the original mobj info tic timing values have
@@ -1044,6 +1261,8 @@ void GameSession::end()
 {
     if (!hasBegun()) return;
 
+    d->finishBackgroundSaves();
+
     // Reset state of relevant subsystems.
 #if __JHEXEN__
     d->acscriptSys.reset();
@@ -1354,6 +1573,12 @@ void GameSession::save(const String &saveName, const String &userDescription)
         GameStateMetadata metadata = d->metadata();
         metadata.set("userDescription", chooseSaveDescription(savePath, userDescription));
 
+        if (cfg.common.saveInBackground && d->saveInBackground(savePath, metadata))
+        {
+            // Success is reported when the package has been written.
+            return;
+        }
+
         // Update the existing internal .save package.
         d->updateGameStateFolder(internalSavePath(), metadata);
 
@@ -1382,18 +1607,21 @@ void GameSession::load(const String &saveName)
 {
     const String savePath = d->userSavePath(saveName);
     LOG_MSG("Loading game from \"%s\"...") << savePath;
+    d->finishBackgroundSaves();
     d->loadSaved(savePath);
     P_SetMessage(&players[CONSOLEPLAYER], "Game loaded");
 }
 
 void GameSession::copySaved(const String &destName, const String &sourceName)
 {
+    d->finishBackgroundSaves();
     AbstractSession::copySaved(d->userSavePath(destName), d->userSavePath(sourceName));
     LOG_MSG("Copied savegame \"%s\" to \"%s\"") << sourceName << destName;
 }
 
 void GameSession::removeSaved(const String &saveName)
 {
+    d->finishBackgroundSaves();
     AbstractSession::removeSaved(d->userSavePath(saveName));
 }
 
@@ -43,6 +43,7 @@
 #include "p_tick.h"
 #include "p_sound.h"
 #include "p_switch.h"
+#include "pause.h"
 
 using namespace de;
 
@@ -132,6 +133,7 @@ int XLTrav_ChangeWallMaterial(Line *line, dd_bool ceiling, void *context, void *
 int XLTrav_LineTeleport(Line *line, dd_bool ceiling, void *context, void *context2, mobj_t *activator);
 
 int xgDev = 0; // Print dev messages.
+int xgIdle = 1; // Allow idle XG sectors and lines to skip thinking.
 
 static linetype_t typebuffer;
 static char msgbuf[80];
@@ -727,13 +729,184 @@ xgclass_t xgClasses[NUMXGCLASSES] =
     }
 };
 
+/// FNV-1a hash of the bytes of a value.
+template <typename T>
+static void hashValue(uint64_t &hash, const T &value)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    for(size_t i = 0; i < sizeof(value); ++i)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+}
+
+static int hashMobj(thinker_t *th, void *context)
+{
+    const mobj_t *mo = reinterpret_cast<mobj_t *>(th);
+    uint64_t &hash   = *static_cast<uint64_t *>(context);
+
+    hashValue(hash, mo->type);
+    hashValue(hash, mo->origin);
+    hashValue(hash, mo->mom);
+    hashValue(hash, mo->angle);
+    hashValue(hash, mo->health);
+    hashValue(hash, mo->tics);
+    return false; // Continue iteration.
+}
+
+/**
+ * Calculates a checksum of the map state affected by XG: the XG sector and line
+ * states, sector planes and lighting, and map objects. Idle sectors and lines are
+ * caught up first, so the result does not depend on whether they were idle.
+ */
+static uint64_t XG_StateChecksum()
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    hashValue(hash, mapTime);
+
+    for(int i = 0; i < numsectors; ++i)
+    {
+        Sector *sector = (Sector *)P_ToPtr(DMU_SECTOR, i);
+        float rgb[3];
+
+        hashValue(hash, P_GetDoublep(sector, DMU_FLOOR_HEIGHT));
+        hashValue(hash, P_GetDoublep(sector, DMU_CEILING_HEIGHT));
+        hashValue(hash, P_GetFloatp(sector, DMU_LIGHT_LEVEL));
+        P_GetFloatpv(sector, DMU_COLOR, rgb);
+        hashValue(hash, rgb);
+
+        if(xgsector_t *xg = P_ToXSector(sector)->xg)
+        {
+            XS_CatchUp(xg);
+            hashValue(hash, xg->disabled);
+            hashValue(hash, xg->timer);
+            hashValue(hash, xg->chainTimer);
+            const function_t *functions[] = {
+                &xg->rgb[0], &xg->rgb[1], &xg->rgb[2], &xg->plane[0], &xg->plane[1], &xg->light
+            };
+            for(const function_t *fn : functions)
+            {
+                hashValue(hash, fn->pos);
+                hashValue(hash, fn->repeat);
+                hashValue(hash, fn->timer);
+                hashValue(hash, fn->value);
+            }
+        }
+    }
+
+    for(int i = 0; i < numlines; ++i)
+    {
+        if(xgline_t *xg = P_ToXLine((Line *)P_ToPtr(DMU_LINE, i))->xg)
+        {
+            XL_CatchUp(xg);
+            hashValue(hash, xg->info.actCount);
+            hashValue(hash, xg->active);
+            hashValue(hash, xg->disabled);
+            hashValue(hash, xg->timer);
+            hashValue(hash, xg->tickerTimer);
+            hashValue(hash, xg->idata);
+            hashValue(hash, xg->fdata);
+            hashValue(hash, xg->chIdx);
+            hashValue(hash, xg->chTimer);
+        }
+    }
+
+    Thinker_Iterate(P_MobjThinker, hashMobj, &hash);
+    return hash;
+}
+
+static int XL_NextWakeTime(const xgline_t *xg);
+
+/**
+ * Counts the idle XG lines that would wake up later than they should. Each idle line
+ * is caught up on a copy and its wake time is determined again; it must not be earlier
+ * than the one the line has. This catches events that change the state of a line
+ * without waking it.
+ */
+static int XL_CountLateWakes()
+{
+    int late = 0;
+    for(int i = 0; i < numlines; ++i)
+    {
+        const xgline_t *xg = P_ToXLine((Line *)P_ToPtr(DMU_LINE, i))->xg;
+        if(!xg || xg->disabled || mapTime >= xg->wakeTime) continue;
+
+        xgline_t caughtUp = *xg;
+        XL_CatchUp(&caughtUp);
+        if(XL_NextWakeTime(&caughtUp) < xg->wakeTime)
+        {
+            late++;
+        }
+    }
+    return late;
+}
+
+/**
+ * $xgbench: Runs the game for a number of tics as fast as possible, and prints the
+ * time taken and a checksum of the resulting map state. Running it with xg-idle on
+ * and off from the same starting point (e.g., right after loading a map or savegame)
+ * must give the same checksum. With xg-idle on, the idle lines are also checked after
+ * every tic for missed wake-ups (see XL_CountLateWakes()); the check is not timed.
+ *
+ * The map is not restored afterwards: it stays advanced by the number of tics that
+ * were run. Because the clients would not see the usual ticking, the benchmark is
+ * refused in netgames.
+ */
+D_CMD(XGBenchmark)
+{
+    DE_UNUSED(src);
+
+    if(argc > 2)
+    {
+        App_Log(DE2_SCR_NOTE, "Usage: %s [tics]", argv[0]);
+        App_Log(DE2_LOG_SCR, "The default is one minute of game time. The current map is "
+                             "permanently advanced by the number of tics that are run.");
+        return true;
+    }
+    if(IS_NETGAME)
+    {
+        App_Log(DE2_SCR_ERROR, "The benchmark cannot be run in a netgame");
+        return false;
+    }
+    if(G_GameState() != GS_MAP || Pause_IsPaused())
+    {
+        App_Log(DE2_SCR_ERROR, "The benchmark requires a running map");
+        return false;
+    }
+
+    const int tics = (argc > 1? atoi(argv[1]) : 60 * TICSPERSEC);
+    double elapsed = 0;
+    int lateWakes  = 0;
+    for(int i = 0; i < tics; ++i)
+    {
+        const double startedAt = Timer_RealSeconds();
+        P_DoTick();
+        elapsed += Timer_RealSeconds() - startedAt;
+
+        if(xgIdle) lateWakes += XL_CountLateWakes();
+    }
+
+    App_Log(DE2_LOG_SCR, "Ran %i tics in %.0f ms (%.3f ms per tic), xg-idle %i",
+            tics, elapsed * 1000, tics > 0? elapsed * 1000 / tics : 0.0, xgIdle);
+    App_Log(DE2_LOG_SCR, "Map state checksum: %016llx",
+            (unsigned long long) XG_StateChecksum());
+    if(lateWakes)
+    {
+        App_Log(DE2_SCR_ERROR, "%i idle lines were not woken up in time", lateWakes);
+    }
+    return true;
+}
+
 void XG_Register()
 {
     C_VAR_INT("xg-dev", &xgDev, CVF_NO_ARCHIVE, 0, 1);
+    C_VAR_INT("xg-idle", &xgIdle, CVF_NO_ARCHIVE, 0, 1);
 
     C_CMD("movefloor",  0, MovePlane);
     C_CMD("moveceil",   0, MovePlane);
     C_CMD("movesec",    0, MovePlane);
+    C_CMD("xgbench",    0, XGBenchmark);
 }
 
 /**
@@ -924,6 +1097,8 @@ void XL_SetLineType(Line *line, int id)
         xline->xg->disabled    = false;
         xline->xg->timer       = 0;
         xline->xg->tickerTimer = 0;
+        xline->xg->wakeTime    = 0;
+        xline->xg->idleTics    = 0;
         std::memcpy(&xline->xg->info, &typebuffer, sizeof(linetype_t));
 
         // Initial active state.
@@ -1498,6 +1673,7 @@ int XLTrav_QuickActivate(Line *line, dd_bool /*ceiling*/, void *context, void *
         xline_t *xline = P_ToXLine(line);
         if(xline->xg)
         {
+            XL_Wake(xline->xg);
             xline->xg->active = (context? true : false);
             xline->xg->timer  = XLTIMER_STOPPED; // Stop timer.
         }
@@ -1565,6 +1741,7 @@ int XL_DoChainSequence(Line *line, dd_bool /*ceiling*/, void * /*context*/,
         {
             linetype_t *info = static_cast<linetype_t *>(context2);
 
+            XL_Wake(xline->xg);
             xline->xg->chIdx = 1; // This is the first.
             // Start counting the first interval.
             xline->xg->chTimer =
@@ -1811,6 +1988,8 @@ int XLTrav_LineCount(Line *line, dd_bool /*ceiling*/, void * /*context*/,
         xline_t *xline = P_ToXLine(line);
         if(xline->xg)
         {
+            // A forced function may depend on the count.
+            XL_Wake(xline->xg);
             if(info->iparm[2])
             {
                 xline->xg->info.actCount = info->iparm[3];
@@ -2138,6 +2317,7 @@ int XLTrav_DisableLine(Line *line, dd_bool /*ceiling*/, void *context,
         {
             xline_t *origLine = P_ToXLine((Line *) context);
 
+            XL_Wake(xline->xg);
             xline->xg->disabled = origLine->xg->active;
         }
     }
@@ -2155,6 +2335,7 @@ int XLTrav_EnableLine(Line *line, dd_bool /*ceiling*/, void *context,
         {
             xline_t *origLine = P_ToXLine((Line*) context);
 
+            XL_Wake(xline->xg);
             xline->xg->disabled = !origLine->xg->active;
         }
     }
@@ -2330,6 +2511,7 @@ void XL_ActivateLine(dd_bool activating, linetype_t *info, Line *line, int siden
 
     DE_ASSERT(xline->xg);
     xgline_t &xgline = *xline->xg;
+    XL_Wake(&xgline);
     if(xgline.disabled)
     {
         LOG_MAP_MSG_XGDEVONLY("LINE DISABLED, ABORTING");
@@ -2532,6 +2714,9 @@ int XL_LineEvent(int evtype, int linetype, Line* line, int sidenum,
     info = &xg->info;
     active = xg->active;
 
+    // The event may change the state of the line.
+    XL_Wake(xg);
+
     if(activator_thing)
         activator = activator_thing->player;
 
@@ -2863,6 +3048,7 @@ void XL_DoChain(Line *line, int chain, dd_bool activating, mobj_t *actThing)
     LOG_MAP_MSG_XGDEVONLY2("(dummy line will show up as %i)", P_ToIndex(dummyLineDef));
 
     // Copy all properties to the dummies.
+    XL_CatchUp(P_ToXLine(line)->xg);
     P_CopyLine(dummyLineDef, line);
 
     xdummyLineDef->xg->active = !activating;
@@ -2874,8 +3060,97 @@ void XL_DoChain(Line *line, int chain, dd_bool activating, mobj_t *actThing)
     P_FreeDummyLine(dummyLineDef);
 }
 
+void XL_CatchUp(xgline_t *xg)
+{
+    if(!xg || !xg->idleTics) return;
+
+    // The timers only run while the timer has not been stopped.
+    if(xg->timer >= 0)
+    {
+        xg->timer       += xg->idleTics;
+        xg->tickerTimer += xg->idleTics;
+    }
+
+    xg->idleTics = 0;
+}
+
+void XL_Wake(xgline_t *xg)
+{
+    if(!xg) return;
+
+    XL_CatchUp(xg);
+    xg->wakeTime = 0;
+}
+
+/**
+ * Determines when the XG line will next need to do something other than count up its
+ * timers. Called after the line has thought, on the server. Any event that changes
+ * the state of the line wakes it up (see XL_Wake()).
+ *
+ * @return  Map time when the line must resume thinking, or the current map time if
+ * the line cannot be idle. Waking up early is harmless.
+ */
+static int XL_NextWakeTime(const xgline_t *xg)
+{
+    const linetype_t *info = &xg->info;
+    const bool timerRunning = xg->timer >= 0;
+
+    // Material movement and chain sequences require thinking on every tic.
+    if(info->materialMoveSpeed) return mapTime;
+    if(xg->active && info->lineClass == LTC_CHAIN_SEQUENCE) return mapTime;
+
+    int wake = DDMAXINT;
+
+    // Ticker events and forced functions.
+    const bool forced =
+        (((info->flags2 & LTF2_WHEN_ACTIVE) && xg->active) ||
+         ((info->flags2 & LTF2_WHEN_INACTIVE) && !xg->active)) &&
+        (!(info->flags2 & LTF2_WHEN_LAST) || info->actCount == 1);
+    if((info->flags & LTF_TICKER) || forced)
+    {
+        const float flevtime = TIC2FLT(mapTime);
+        if(info->tickerEnd > 0 && flevtime > info->tickerEnd)
+        {
+            // Never again.
+        }
+        else if(timerRunning || xg->tickerTimer > info->tickerInterval)
+        {
+            int tickerWake = mapTime;
+            if(info->tickerEnd > 0 && flevtime < info->tickerStart)
+            {
+                tickerWake = FLT2TIC(info->tickerStart) - 1;
+            }
+            if(xg->tickerTimer <= info->tickerInterval)
+            {
+                tickerWake = de::max(tickerWake, mapTime + info->tickerInterval - xg->tickerTimer);
+            }
+            if(tickerWake <= mapTime) return mapTime;
+            wake = de::min(wake, tickerWake);
+        }
+    }
+
+    // Automatic (de)activation.
+    if(((info->actType == LTACT_COUNTED_OFF ||
+         info->actType == LTACT_FLIP_COUNTED_OFF) && xg->active) ||
+       ((info->actType == LTACT_COUNTED_ON ||
+         info->actType == LTACT_FLIP_COUNTED_ON) && !xg->active))
+    {
+        if(info->actTime >= 0 && timerRunning)
+        {
+            wake = de::min(wake, mapTime + FLT2TIC(info->actTime) - xg->timer);
+        }
+    }
+
+    return de::max(wake, mapTime);
+}
+
 /**
  * XG lines get to think.
+ *
+ * Lines with nothing to do until some later time go idle: they only count the tics
+ * they skip, which are applied to the timers when they next think (see XL_CatchUp()).
+ * Like XG sectors, the thinkers are kept in the thinker list so that the order of XG
+ * events does not change.
  */
 void XL_Thinker(void *xlThinkerPtr)
 {
@@ -2901,6 +3176,14 @@ void XL_Thinker(void *xlThinkerPtr)
     // If disabled do nothing.
     if(xg->disabled) return;
 
+    if(mapTime < xg->wakeTime)
+    {
+        // Idle.
+        xg->idleTics++;
+        return;
+    }
+    XL_Wake(xg);
+
     linetype_t *info = &xg->info;
     float levtime = TIC2FLT(mapTime);
 
@@ -3060,6 +3343,12 @@ void XL_Thinker(void *xlThinkerPtr)
             P_SetDoublepv(side, DMU_BOTTOM_MATERIAL_OFFSET_XY, current);
         }
     }
+
+    if(xgIdle && !xg->disabled)
+    {
+        const int wake = XL_NextWakeTime(xg);
+        if(wake > mapTime) xg->wakeTime = wake;
+    }
 }
 
 /**
@@ -46,6 +46,9 @@ void SV_WriteXGLine(Line *li, MapStateWriter *msw)
     xgline_t *xg = xline->xg;
     linetype_t *info = &xg->info;
 
+    // Bring the timers up to date if the line is idle.
+    XL_CatchUp(xg);
+
     Writer_WriteInt32(writer, info->id);
     Writer_WriteInt32(writer, info->actCount);
 
@@ -131,6 +134,9 @@ void SV_WriteXGSector(Sector *sec, Writer1 *writer)
     xgsector_t *xg     = xsec->xg;
     sectortype_t *info = &xg->info;
 
+    // Bring the timers up to date if the sector is idle.
+    XS_CatchUp(xg);
+
     // Version byte.
     Writer_WriteByte(writer, 1);
 
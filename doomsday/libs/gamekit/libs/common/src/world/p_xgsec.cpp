@@ -403,6 +403,9 @@ void XS_SetSectorType(Sector *sec, int special)
     }
 }
 
+/// Set while XS_Init() runs the first tick; idling begins with the regular tics.
+static dd_bool xsInitializing;
+
 void XS_Init()
 {
     /*  // Clients rely on the server, they don't do XG themselves.
@@ -426,10 +429,12 @@ void XS_Init()
     }
 
     // Run the first tick now, so sector lights are initialized according to the functions.
+    xsInitializing = true;
     P_IterateThinkers(XS_Thinker, [](thinker_t *th) {
         XS_Thinker(th);
         return de::LoopContinue;
     });
+    xsInitializing = false;
 }
 
 void XS_SectorSound(Sector *sec, int soundId)
@@ -2185,7 +2190,11 @@ int C_DECL XSTrav_MimicSector(Sector *sector, dd_bool /*ceiling*/,
     XS_SetSectorType(sector, P_ToXSector(from)->special);
 
     if(P_ToXSector(from)->xg)
+    {
+        XS_CatchUp(P_ToXSector(from)->xg);
         memcpy(P_ToXSector(sector)->xg, P_ToXSector(from)->xg, sizeof(xgsector_t));
+        XS_Wake(P_ToXSector(sector)->xg);
+    }
 
     return true;
 }
@@ -2859,8 +2868,99 @@ void XS_ConstrainPlaneOffset(float *offset)
         *offset += 64;
 }
 
+void XS_CatchUp(xgsector_t *xg)
+{
+    if(!xg || !xg->idleTics) return;
+
+    for(int i = 0; i < XSCE_NUM_CHAINS; ++i)
+        xg->chainTimer[i] -= xg->idleTics;
+
+    if(xg->info.ambientSound)
+        xg->timer -= xg->idleTics;
+
+    xg->idleTics = 0;
+}
+
+void XS_Wake(xgsector_t *xg)
+{
+    if(!xg) return;
+
+    XS_CatchUp(xg);
+    xg->wakeTime = 0;
+}
+
+/**
+ * Determines when the XG sector will next need to do something other than count down
+ * its timers. Called after the sector has thought, on the server.
+ *
+ * @return  Map time when the sector must resume thinking, or the current map time if
+ * the sector cannot be idle.
+ */
+static int XS_NextWakeTime(const xgsector_t *xg)
+{
+    const sectortype_t *info = &xg->info;
+
+    // Functions and sector movement require thinking on every tic.
+    for(int i = 0; i < 3; ++i)
+    {
+        const function_t *fn = &xg->rgb[i];
+        if(UPDFUNC(fn)) return mapTime;
+    }
+    for(int i = 0; i < 2; ++i)
+    {
+        const function_t *fn = &xg->plane[i];
+        if(UPDFUNC(fn)) return mapTime;
+    }
+    {
+        const function_t *fn = &xg->light;
+        if(UPDFUNC(fn)) return mapTime;
+    }
+    if(info->materialMoveSpeed[0] != 0 || info->materialMoveSpeed[1] != 0 ||
+       info->windSpeed || info->verticalWind)
+    {
+        return mapTime;
+    }
+
+    int wake = DDMAXINT;
+
+    // Chains are only checked once their timer runs out, and are then rejected by
+    // XS_DoChain() if their counter is used up or they are not in operation.
+    const float flevtime = TIC2FLT(mapTime);
+    for(int i = 0; i < XSCE_NUM_CHAINS; ++i)
+    {
+        if(!info->chain[i] || !info->count[i]) continue;
+        if(info->end[i] > 0 && flevtime > info->end[i]) continue; // Never again.
+
+        if(flevtime < info->start[i])
+        {
+            // Waking a bit early is harmless.
+            wake = de::min(wake, FLT2TIC(info->start[i]) - 1);
+        }
+        else if(xg->chainTimer[i] > 0)
+        {
+            wake = de::min(wake, mapTime + xg->chainTimer[i]);
+        }
+        else
+        {
+            return mapTime;
+        }
+    }
+
+    if(info->ambientSound)
+    {
+        wake = de::min(wake, mapTime + xg->timer + 1);
+    }
+
+    return de::max(wake, mapTime);
+}
+
 /**
  * XG sectors get to think.
+ *
+ * Sectors with nothing to do until some later time go idle: they only count the tics
+ * they skip, which are applied to the timers when they next think (see XS_CatchUp()).
+ * The thinkers are kept in the thinker list so that the order of XG events, and thus
+ * the random number sequence, does not change.
  */
 void XS_Thinker(void *xsThinker)
 {
@@ -2878,6 +2978,14 @@ void XS_Thinker(void *xsThinker)
 
     if(xg->disabled) return; // This sector is disabled.
 
+    if(mapTime < xg->wakeTime)
+    {
+        // Idle.
+        xg->idleTics++;
+        return;
+    }
+    XS_Wake(xg);
+
     info = &xg->info;
 
     if(!IS_CLIENT)
@@ -2961,6 +3069,12 @@ void XS_Thinker(void *xsThinker)
                 S_SectorSound(sector, xg->info.ambientSound);
             }
         }
+
+        if(xgIdle && !xsInitializing)
+        {
+            const int wake = XS_NextWakeTime(xg);
+            if(wake > mapTime) xg->wakeTime = wake;
+        }
     }
 
     // Floor Texture movement
@@ -220,6 +220,7 @@ void D64_PreInit()
     cfg.common.confirmQuickGameSave = true;
     cfg.common.confirmRebornLoad = true;
     cfg.common.loadLastSaveOnReborn = false;
+    cfg.common.saveInBackground = false;
 
     cfg.maxSkulls = true;
     cfg.allowSkullsInWalls = false;
@@ -231,6 +231,7 @@ void H_PreInit()
     cfg.common.confirmQuickGameSave = true;
     cfg.common.confirmRebornLoad = true;
     cfg.common.loadLastSaveOnReborn = false;
+    cfg.common.saveInBackground = false;
 
     cfg.monstersStuckInDoors = false;
     cfg.avoidDropoffs = true;
@@ -195,6 +195,7 @@ void X_PreInit()
     cfg.common.confirmQuickGameSave = true;
     cfg.common.confirmRebornLoad = true;
     cfg.common.loadLastSaveOnReborn = false;
+    cfg.common.saveInBackground = false;
 
     cfg.common.hudFog = 5;
     cfg.common.menuSlam = true;
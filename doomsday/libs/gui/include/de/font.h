@@ -354,6 +354,16 @@ public:
      */
     static bool load(const String &name, const Block &data);
 
+    /**
+     * Rasterizes glyphs of a font into the glyph cache that is shared by all threads.
+     * Text drawn later using these glyphs will be rasterized faster. This can be
+     * called in any thread.
+     *
+     * @param params  Font.
+     * @param chars   Characters to rasterize.
+     */
+    static void prewarm(const FontParams &params, const String &chars);
+
 private:
     DE_PRIVATE(d)
 };
@@ -402,6 +402,11 @@ bool Font::load(const String &name, const Block &data) // static
     return PlatformFont::load(name, data);
 }
 
+void Font::prewarm(const FontParams &params, const String &chars) // static
+{
+    Impl::makePlatformFont(params).prewarmGlyphs(chars);
+}
+
 //------------------------------------------------------------------------------------------------
 
 FontParams::FontParams()
@@ -20,6 +20,7 @@
 #include "de/font.h"
 #include <de/scripting/scriptedinfo.h>
 #include <de/block.h>
+#include <de/taskpool.h>
 #include <de/time.h>
 #include <de/config.h>
 
@@ -27,6 +28,11 @@ namespace de {
 
 static const String BLOCK_FONT = "font";
 
+/// Glyphs that are rasterized in the background when a font is loaded.
+static const char *PREWARM_GLYPHS =
+    " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`"
+    "abcdefghijklmnopqrstuvwxyz{|}~";
+
 DE_PIMPL(FontBank)
 {
     struct FontSource : public ISource
@@ -77,6 +83,7 @@ DE_PIMPL(FontBank)
         {
             FontParams params;
             initParams(params);
+            bank.d->prewarm(params);
             return new Font(params);
         }
 
@@ -86,6 +93,7 @@ DE_PIMPL(FontBank)
             FontParams params;
             initParams(params);
             font.initialize(params);
+            bank.d->prewarm(params);
         }
     };
 
@@ -102,11 +110,24 @@ DE_PIMPL(FontBank)
 
     SafePtr<const File> sourceFile;
     float               fontSizeFactor;
+    TaskPool            prewarmTasks;
 
     Impl(Public *i)
         : Base(i)
         , fontSizeFactor(1.f)
     {}
+
+    /**
+     * Rasterizes the commonly used glyphs of a font in a background thread so they
+     * are ready when text is first drawn.
+     */
+    void prewarm(const FontParams &params)
+    {
+        prewarmTasks.start([params] ()
+        {
+            Font::prewarm(params, PREWARM_GLYPHS);
+        });
+    }
 };
 
 FontBank::FontBank()
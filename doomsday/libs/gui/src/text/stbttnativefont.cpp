@@ -23,6 +23,11 @@
 #include <de/threadlocal.h>
 #include <de/nativepath.h>
 
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #define STB_TRUETYPE_IMPLEMENTATION
 #include "../src/text/stb_truetype.h"
 
@@ -91,9 +96,200 @@ struct FontDatabase
 
 static FontDatabase fontDb;
 
+/// Glyphs are positioned with this precision (1/N pixels) so that their rasterized
+/// images can be reused.
+static const int GLYPH_SUBPIXELS = 4;
+
+/**
+ * Horizontal metrics and bitmap box of a glyph at a given scale and subpixel offset.
+ */
+struct GlyphInfo
+{
+    int        advance;
+    int        leftSideBearing;
+    Rectanglei box[GLYPH_SUBPIXELS];
+    bool       hasBox[GLYPH_SUBPIXELS];
+};
+
+/// Identifies a font independently of the thread-local stbtt_fontinfo.
+static inline const void *fontKey(const stbtt_fontinfo *font)
+{
+    return font->data + font->fontstart;
+}
+
+struct GlyphKey
+{
+    const void *font; // see fontKey()
+    float       scale;
+    int         ucp;
+
+    bool operator==(const GlyphKey &other) const
+    {
+        return font == other.font && scale == other.scale && ucp == other.ucp;
+    }
+};
+
+struct GlyphKeyHash
+{
+    size_t operator()(const GlyphKey &key) const
+    {
+        return std::hash<const void *>()(key.font) ^ (std::hash<float>()(key.scale) << 1) ^
+               (size_t(key.ucp) * 0x9e3779b9u);
+    }
+};
+
+/**
+ * Rasterized glyph coverage and rasterized glyph runs, shared by all threads. The
+ * background threads that wrap and rasterize text fill the cache, and the results
+ * are reused by all subsequent text using the same glyphs (or the exact same runs,
+ * e.g., repeated labels). The cache is cleared when it grows too large.
+ */
+struct SharedGlyphCache
+{
+    static const dsize MAX_GLYPH_BYTES = 4 * 1024 * 1024;
+    static const dsize MAX_RUN_BYTES   = 8 * 1024 * 1024;
+    static const dsize MAX_RUN_LENGTH  = 128;
+
+    struct CoverageKey
+    {
+        GlyphKey glyph;
+        int      subpixel;
+
+        bool operator==(const CoverageKey &other) const
+        {
+            return glyph == other.glyph && subpixel == other.subpixel;
+        }
+    };
+    struct CoverageKeyHash
+    {
+        size_t operator()(const CoverageKey &key) const
+        {
+            return GlyphKeyHash()(key.glyph) ^ size_t(key.subpixel);
+        }
+    };
+    struct RunKey
+    {
+        const void *font;
+        float       scale;
+        String      text;
+        duint32     foreground;
+        duint32     background;
+
+        bool operator==(const RunKey &other) const
+        {
+            return font == other.font && scale == other.scale && text == other.text &&
+                   foreground == other.foreground && background == other.background;
+        }
+    };
+    struct RunKeyHash
+    {
+        size_t operator()(const RunKey &key) const
+        {
+            return std::hash<const void *>()(key.font) ^ std::hash<String>()(key.text) ^
+                   (size_t(key.foreground) * 31 + key.background);
+        }
+    };
+
+    std::mutex mutex;
+    std::unordered_map<CoverageKey, std::shared_ptr<const Block>, CoverageKeyHash> coverage;
+    std::unordered_map<RunKey, Image, RunKeyHash> runs;
+    dsize coverageBytes = 0;
+    dsize runBytes      = 0;
+
+    std::shared_ptr<const Block> findCoverage(const CoverageKey &key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = coverage.find(key);
+        return found != coverage.end()? found->second : nullptr;
+    }
+
+    void insertCoverage(const CoverageKey &key, const std::shared_ptr<const Block> &bitmap)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (coverageBytes + bitmap->size() > MAX_GLYPH_BYTES)
+        {
+            coverage.clear();
+            coverageBytes = 0;
+        }
+        if (coverage.emplace(key, bitmap).second)
+        {
+            coverageBytes += bitmap->size();
+        }
+    }
+
+    bool findRun(const RunKey &key, Image &image)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = runs.find(key);
+        if (found == runs.end()) return false;
+        image = found->second;
+        return true;
+    }
+
+    void insertRun(const RunKey &key, const Image &image)
+    {
+        const dsize bytes = image.byteCount();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (runBytes + bytes > MAX_RUN_BYTES)
+        {
+            runs.clear();
+            runBytes = 0;
+        }
+        if (runs.emplace(key, image).second)
+        {
+            runBytes += bytes;
+        }
+    }
+};
+
+static SharedGlyphCache s_sharedGlyphs;
+
 struct FontCache // thread-local
 {
+    static const dsize MAX_GLYPHS = 8192;
+
     KeyMap<FontSpec, stbtt_fontinfo> fonts; // loaded fonts
+    std::unordered_map<GlyphKey, GlyphInfo, GlyphKeyHash> glyphs;
+
+    GlyphInfo &glyph(const stbtt_fontinfo *font, float scale, int ucp)
+    {
+        const GlyphKey key{fontKey(font), scale, ucp};
+        auto found = glyphs.find(key);
+        if (found != glyphs.end())
+        {
+            return found->second;
+        }
+        if (glyphs.size() >= MAX_GLYPHS)
+        {
+            glyphs.clear();
+        }
+        GlyphInfo &info = glyphs[key];
+        stbtt_GetCodepointHMetrics(font, ucp, &info.advance, &info.leftSideBearing);
+        for (bool &has : info.hasBox) has = false;
+        return info;
+    }
+
+    const Rectanglei &glyphBox(const stbtt_fontinfo *font, float scale, int ucp,
+                               GlyphInfo &info, int subpixel)
+    {
+        if (!info.hasBox[subpixel])
+        {
+            Vec2i glyphPoint[2];
+            stbtt_GetCodepointBitmapBoxSubpixel(font,
+                                                ucp,
+                                                scale,
+                                                scale,
+                                                float(subpixel) / GLYPH_SUBPIXELS,
+                                                0.0f,
+                                                &glyphPoint[0].x,
+                                                &glyphPoint[0].y,
+                                                &glyphPoint[1].x,
+                                                &glyphPoint[1].y);
+            info.box[subpixel]    = Rectanglei(glyphPoint[0], glyphPoint[1]);
+            info.hasBox[subpixel] = true;
+        }
+        return info.box[subpixel];
+    }
 
     const stbtt_fontinfo *load(const String &name)
     {
@@ -158,6 +354,7 @@ DE_PIMPL(StbTtNativeFont)
     Impl(Public *i, const Impl &d)
         : Base(i)
         , font(d.font)
+        , fontScale(d.fontScale)
         , height(d.height)
         , ascent(d.ascent)
         , descent(d.descent)
@@ -210,6 +407,31 @@ DE_PIMPL(StbTtNativeFont)
         return str;
     }
 
+    /**
+     * Returns the rasterized coverage of a glyph, from the shared cache if possible.
+     */
+    std::shared_ptr<const Block> glyphCoverage(int ucp, int subpixel, const Vec2ui &size) const
+    {
+        const SharedGlyphCache::CoverageKey key{{fontKey(font), fontScale, ucp}, subpixel};
+        if (auto cached = s_sharedGlyphs.findCoverage(key))
+        {
+            return cached;
+        }
+        auto raster = std::make_shared<Block>(size.x * size.y);
+        stbtt_MakeCodepointBitmapSubpixel(font,
+                                          raster->data(),
+                                          int(size.x),
+                                          int(size.y),
+                                          int(size.x),
+                                          fontScale,
+                                          fontScale,
+                                          float(subpixel) / GLYPH_SUBPIXELS,
+                                          0.0f,
+                                          ucp);
+        s_sharedGlyphs.insertCoverage(key, raster);
+        return raster;
+    }
+
     /**
      * Rasterize or just measure a text string.
      *
@@ -229,6 +451,7 @@ DE_PIMPL(StbTtNativeFont)
         {
             image->fill(background);
         }
+        FontCache &cache = s_fontCache.get();
         Rectanglei bounds;
         float xPos = 0.0f;
         int previousUcp = 0;
@@ -240,24 +463,12 @@ DE_PIMPL(StbTtNativeFont)
                 xPos += fontScale * stbtt_GetCodepointKernAdvance(font, previousUcp, ucp);
             }
 
-            int advance;
-            int leftSideBearing;
-            Vec2i glyphPoint[2];
-            stbtt_GetCodepointHMetrics(font, ucp, &advance, &leftSideBearing);
+            GlyphInfo &glyph = cache.glyph(font, fontScale, ucp);
             // Why the LSB*0.5? Don't know, but it seems to work nicely...
-            float xLeft  = xPos - fontScale * leftSideBearing * 0.5f;
-            float xShift = xLeft - std::floor(xLeft);
-            stbtt_GetCodepointBitmapBoxSubpixel(font,
-                                                ucp,
-                                                fontScale,
-                                                fontScale,
-                                                xShift,
-                                                0.0f,
-                                                &glyphPoint[0].x,
-                                                &glyphPoint[0].y,
-                                                &glyphPoint[1].x,
-                                                &glyphPoint[1].y);
-            Rectanglei glyphBounds{glyphPoint[0], glyphPoint[1]};
+            const float xLeft = std::floor((xPos - fontScale * glyph.leftSideBearing * 0.5f) *
+                                           GLYPH_SUBPIXELS + 0.5f) / GLYPH_SUBPIXELS;
+            const int subpixel = int((xLeft - std::floor(xLeft)) * GLYPH_SUBPIXELS);
+            Rectanglei glyphBounds = cache.glyphBox(font, fontScale, ucp, glyph, subpixel);
             glyphBounds.move({int(xLeft), 0});
             if (bounds.isNull())
             {
@@ -268,24 +479,13 @@ DE_PIMPL(StbTtNativeFont)
                 bounds |= glyphBounds;
             }
 
-            if (image)
+            if (image && glyphBounds.area() > 0)
             {
-                // Rasterize the glyph.
-                Block raster(glyphBounds.area());
-                stbtt_MakeCodepointBitmapSubpixel(font,
-                                                  raster.data(),
-                                                  glyphBounds.width(),
-                                                  glyphBounds.height(),
-                                                  glyphBounds.width(),
-                                                  fontScale,
-                                                  fontScale,
-                                                  xShift,
-                                                  0.0f,
-                                                  ucp);
+                const auto raster = glyphCoverage(ucp, subpixel, glyphBounds.size());
 
                 for (int y = glyphBounds.top(), sy = 0; y < glyphBounds.bottom(); ++y, ++sy)
                 {
-                    const duint8 *src = &raster[sy * glyphBounds.width()];
+                    const duint8 *src = raster->data() + sy * glyphBounds.width();
                     duint32 *dst = image->row32(imageOrigin.y + y);
                     for (int x = glyphBounds.left(), sx = 0; x < glyphBounds.right(); ++x, ++sx)
                     {
@@ -299,8 +499,8 @@ DE_PIMPL(StbTtNativeFont)
                 }
             }
 
-            xPos += fontScale * advance;
-            
+            xPos += fontScale * glyph.advance;
+
             previousUcp = ucp;
         }
         if (advanceWidth)
@@ -374,14 +574,51 @@ Image StbTtNativeFont::nativeFontRasterize(const String &      text,
     if (!d->font) return {};
 
     const String displayText = d->transform(text);
+
+    // Short runs are likely to be repeated (e.g., labels and list items).
+    const bool cacheable = displayText.size() <= SharedGlyphCache::MAX_RUN_LENGTH;
+    const SharedGlyphCache::RunKey runKey{fontKey(d->font), d->fontScale, displayText,
+                                          Image::packColor(foreground),
+                                          Image::packColor(background)};
+    Image img;
+    if (cacheable && s_sharedGlyphs.findRun(runKey, img))
+    {
+        return img;
+    }
+
     Rectanglei bounds = d->rasterize(displayText, nullptr, nullptr);
-    Image img{bounds.size(), Image::RGBA_8888};
+    img = Image{bounds.size(), Image::RGBA_8888};
     d->rasterize(displayText, nullptr, &img, -bounds.topLeft, foreground, background);
     img.setOrigin(bounds.topLeft);
 //    img.save(Stringf("raster_%p.png", cstr_String(text)));
+    if (cacheable)
+    {
+        s_sharedGlyphs.insertRun(runKey, img);
+    }
     return img;
 }
 
+void StbTtNativeFont::prewarmGlyphs(const String &chars) const
+{
+    height(); // makes sure the font is ready
+    if (!d->font) return;
+
+    FontCache &cache = s_fontCache.get();
+    for (Char ch : d->transform(chars))
+    {
+        const int ucp = int(ch.unicode());
+        GlyphInfo &glyph = cache.glyph(d->font, d->fontScale, ucp);
+        for (int subpixel = 0; subpixel < GLYPH_SUBPIXELS; ++subpixel)
+        {
+            const Rectanglei box = cache.glyphBox(d->font, d->fontScale, ucp, glyph, subpixel);
+            if (box.area() > 0)
+            {
+                d->glyphCoverage(ucp, subpixel, box.size());
+            }
+        }
+    }
+}
+
 bool StbTtNativeFont::load(const String &fontName, const Block &fontData) // static
 {
     return fontDb.addSource(fontName, fontData);
@@ -37,6 +37,12 @@ public:
 
     static bool load(const String &fontName, const Block &fontData);
 
+    /**
+     * Rasterizes the glyphs of @a chars into the glyph cache that is shared by all
+     * threads, so that text using them can later be rasterized quickly.
+     */
+    void prewarmGlyphs(const String &chars) const;
+
 protected:
     void commit() const override;
 
@@ -0,0 +1,325 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Verifies the sampled values of the baked ambient light grid, including updates of
+ * the static lights, and measures the cost of baking and sampling. Runs without a
+ * display.
+ */
+
+#include "render/ambientlightgrid.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    if (!(cond)) { cout << "FAILED (line " << __LINE__ << "): " #cond << endl; failures++; }
+
+static bool near(float a, float b, float epsilon = 1e-4f)
+{
+    return fabs(a - b) <= epsilon;
+}
+
+/// Two rooms side by side: region 0 is x < 512, region 1 is x >= 512. Nothing
+/// exists at y >= 512.
+struct TwoRooms : public AmbientLightGrid::MapInfo
+{
+    int regionAt(double x, double y) const override
+    {
+        if (x < 0 || x >= 1024 || y < 0 || y >= 512) return -1;
+        return x < 512? 0 : 1;
+    }
+};
+
+static const AmbientLightGrid::Bounds twoRoomsBounds { {0, 0, 0}, {1024, 1024, 256} };
+
+static void sample(const AmbientLightGrid &grid, double x, double y, double z, float rgb[3])
+{
+    const double point[3] { x, y, z };
+    grid.evaluate(point, rgb);
+}
+
+static void testRegionLight()
+{
+    TwoRooms map;
+    AmbientLightGrid grid;
+    float rgb[3];
+
+    // Not baked yet.
+    sample(grid, 100, 100, 100, rgb);
+    CHECK(rgb[0] == 0 && rgb[1] == 0 && rgb[2] == 0);
+
+    grid.bake(twoRoomsBounds, 64, 2, map, {});
+    CHECK(grid.isBaked());
+    CHECK(grid.cellCount() == 16 * 16 * 4);
+
+    const float dark[3]   { .2f, .2f, .2f };
+    const float bright[3] { 1.f, .5f, .25f };
+    grid.setRegionLight(0, dark);
+    grid.setRegionLight(1, bright);
+
+    // Well inside each room, the room's own light.
+    sample(grid, 100, 100, 50, rgb);
+    CHECK(near(rgb[0], .2f) && near(rgb[1], .2f) && near(rgb[2], .2f));
+    sample(grid, 900, 300, 200, rgb);
+    CHECK(near(rgb[0], 1.f) && near(rgb[1], .5f) && near(rgb[2], .25f));
+
+    // Exactly on the boundary, halfway between.
+    sample(grid, 512, 300, 100, rgb);
+    CHECK(near(rgb[0], .6f) && near(rgb[1], .35f) && near(rgb[2], .225f));
+
+    // The void outside the map does not darken the edges.
+    sample(grid, 100, 510, 100, rgb);
+    CHECK(near(rgb[0], .2f));
+    sample(grid, 1023, 1, 0, rgb);
+    CHECK(near(rgb[0], 1.f));
+
+    // Region light changes take effect immediately.
+    const float red[3] { 1, 0, 0 };
+    grid.setRegionLight(0, red);
+    sample(grid, 100, 100, 50, rgb);
+    CHECK(near(rgb[0], 1.f) && near(rgb[1], 0.f));
+
+    // Invalid regions are ignored.
+    grid.setRegionLight(-1, red);
+    grid.setRegionLight(2, red);
+
+    grid.clear();
+    CHECK(!grid.isBaked());
+    sample(grid, 100, 100, 50, rgb);
+    CHECK(rgb[0] == 0);
+}
+
+static void testStaticLights()
+{
+    TwoRooms map;
+    AmbientLightGrid grid;
+    float rgb[3];
+
+    // A light in the left room, close to the wall between the rooms.
+    const vector<AmbientLightGrid::Light> lights {
+        { {480, 256, 128}, 256, {1, 1, 0} }
+    };
+    grid.bake({ {0, 0, 0}, {1024, 1024, 512} }, 32, 2, map, lights);
+
+    // Full intensity near the light.
+    sample(grid, 480, 256, 128, rgb);
+    CHECK(rgb[0] > .9f && rgb[1] > .9f && near(rgb[2], 0.f));
+
+    // Fades out with distance, in three dimensions.
+    float nearby[3], farther[3];
+    sample(grid, 400, 256, 128, nearby);
+    sample(grid, 300, 256, 128, farther);
+    CHECK(nearby[0] > farther[0] && farther[0] > 0);
+    sample(grid, 480, 256, 328, rgb);
+    CHECK(rgb[0] < nearby[0] && rgb[0] > 0);
+    sample(grid, 100, 100, 128, rgb);
+    CHECK(near(rgb[0], 0.f));
+
+    // Does not leak through the wall into the other room.
+    sample(grid, 560, 256, 128, rgb);
+    CHECK(near(rgb[0], 0.f));
+
+    // Region light is added on top.
+    const float ambient[3] { .1f, .1f, .1f };
+    grid.setRegionLight(0, ambient);
+    float lit[3];
+    sample(grid, 400, 256, 128, lit);
+    CHECK(near(lit[0], nearby[0] + .1f) && near(lit[2], .1f));
+}
+
+static void testThreadsAgree()
+{
+    TwoRooms map;
+    mt19937 rng(1234);
+    uniform_real_distribution<double> pos(0, 1024);
+    vector<AmbientLightGrid::Light> lights;
+    for (int i = 0; i < 200; ++i)
+    {
+        lights.push_back({ {pos(rng), pos(rng) / 2, pos(rng) / 4}, 64 + pos(rng) / 4,
+                           {.5f, .25f, 1} });
+    }
+
+    AmbientLightGrid single, multi;
+    single.bake(twoRoomsBounds, 16, 2, map, lights, 1);
+    multi .bake(twoRoomsBounds, 16, 2, map, lights, 7);
+
+    bool same = true;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const double point[3] { pos(rng), pos(rng), pos(rng) / 4 };
+        float a[3], b[3];
+        single.evaluate(point, a);
+        multi .evaluate(point, b);
+        if (a[0] != b[0] || a[1] != b[1] || a[2] != b[2]) same = false;
+    }
+    CHECK(same);
+}
+
+static void testUpdateLights()
+{
+    TwoRooms map;
+    mt19937 rng(4321);
+    uniform_real_distribution<double> pos(0, 1024);
+    auto randomLight = [&rng, &pos] () -> AmbientLightGrid::Light {
+        return { {pos(rng), pos(rng) / 2, pos(rng) / 4}, 64 + pos(rng) / 4, {1, .5f, .25f} };
+    };
+    vector<AmbientLightGrid::Light> before, removed, added;
+    for (int i = 0; i < 100; ++i) before.push_back(randomLight());
+
+    // Some lights vanish, some change color, some are new.
+    vector<AmbientLightGrid::Light> after;
+    for (int i = 0; i < 100; ++i)
+    {
+        if (i % 10 == 0)
+        {
+            removed.push_back(before[i]);
+        }
+        else if (i % 10 == 1)
+        {
+            removed.push_back(before[i]);
+            AmbientLightGrid::Light changed = before[i];
+            changed.color[0] = .1f;
+            added.push_back(changed);
+            after.push_back(changed);
+        }
+        else
+        {
+            after.push_back(before[i]);
+        }
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        added.push_back(randomLight());
+        after.push_back(added.back());
+    }
+
+    AmbientLightGrid updated, baked;
+    updated.bake(twoRoomsBounds, 16, 2, map, before);
+    updated.updateLights(map, removed, added);
+    baked.bake(twoRoomsBounds, 16, 2, map, after);
+
+    bool same = true;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const double point[3] { pos(rng), pos(rng), pos(rng) / 4 };
+        float a[3], b[3];
+        updated.evaluate(point, a);
+        baked  .evaluate(point, b);
+        if (!near(a[0], b[0]) || !near(a[1], b[1]) || !near(a[2], b[2])) same = false;
+    }
+    CHECK(same);
+
+    // Removing everything leaves no static light.
+    updated.updateLights(map, after, {});
+    float rgb[3];
+    sample(updated, 480, 256, 128, rgb);
+    CHECK(near(rgb[0], 0.f) && near(rgb[1], 0.f) && near(rgb[2], 0.f));
+}
+
+static void testSizeLimit()
+{
+    struct Everywhere : public AmbientLightGrid::MapInfo
+    {
+        int regionAt(double, double) const override { return 0; }
+    } map;
+
+    // Very large map with a small cell size: the cells are enlarged.
+    AmbientLightGrid grid;
+    grid.bake({ {-32768, -32768, -8192}, {32768, 32768, 8192} }, 8, 1, map, {});
+    CHECK(grid.cellSize() > 8);
+    CHECK(grid.cellCount() <= 4 * 1024 * 1024);
+}
+
+static void benchmark()
+{
+    // A large map with lots of light decorations.
+    struct Grid : public AmbientLightGrid::MapInfo
+    {
+        int regionAt(double x, double y) const override
+        {
+            return int(x / 256) + int(y / 256) * 32;
+        }
+    } map;
+
+    mt19937 rng(5678);
+    uniform_real_distribution<double> pos(0, 8192);
+    vector<AmbientLightGrid::Light> lights;
+    for (int i = 0; i < 5000; ++i)
+    {
+        lights.push_back({ {pos(rng), pos(rng), pos(rng) / 8}, 128 + pos(rng) / 64,
+                           {1, .8f, .6f} });
+    }
+
+    AmbientLightGrid grid;
+    auto start = chrono::steady_clock::now();
+    grid.bake({ {0, 0, 0}, {8192, 8192, 1024} }, 32, 32 * 32, map, lights);
+    chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+    cout << grid.cellCount() << " cells, " << lights.size() << " lights: baked in "
+         << elapsed.count() << " ms" << endl;
+
+    // A hundred lights change color (e.g., flickering sector light).
+    vector<AmbientLightGrid::Light> changed(lights.begin(), lights.begin() + 100);
+    for (auto &light : changed) light.color[0] = .5f;
+    start = chrono::steady_clock::now();
+    grid.updateLights(map, vector<AmbientLightGrid::Light>(lights.begin(), lights.begin() + 100),
+                      changed);
+    elapsed = chrono::steady_clock::now() - start;
+    cout << changed.size() << " lights changed: updated in " << elapsed.count() << " ms" << endl;
+
+    vector<array<double, 3>> points(100000);
+    for (auto &point : points) point = { pos(rng), pos(rng), pos(rng) / 8 };
+    float checksum = 0;
+    start = chrono::steady_clock::now();
+    for (const auto &point : points)
+    {
+        float rgb[3];
+        grid.evaluate(point.data(), rgb);
+        checksum += rgb[0];
+    }
+    elapsed = chrono::steady_clock::now() - start;
+    cout << points.size() << " samples: " << elapsed.count() * 1e6 / points.size()
+         << " ns per sample (checksum " << checksum << ")" << endl;
+}
+
+int main(int, char **)
+{
+    testRegionLight();
+    testStaticLights();
+    testThreadsAgree();
+    testUpdateLights();
+    testSizeLimit();
+    benchmark();
+
+    if (failures)
+    {
+        cout << failures << " checks failed" << endl;
+        return 1;
+    }
+    cout << "All checks passed" << endl;
+    return 0;
+}
@@ -0,0 +1,746 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Verifies that the flat angle range lists of the angle clipper produce the same
+ * ranges and culling results as the original linked lists, both with random ranges
+ * and when replaying a camera path through a generated map, and measures their
+ * performance. Runs without a display.
+ */
+
+#include "render/anglerangelist.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    if (!(cond)) { cout << "FAILED (line " << __LINE__ << "): " #cond << endl; failures++; }
+
+typedef OcclusionRangeList::Occluder Occluder;
+
+static binangle_t pointToAngle(double x, double y)
+{
+    return RAD2BANG(atan2f(float(y), float(x)));
+}
+
+/// Decides which of two occluders to keep, like the angle clipper does (but without
+/// the engine's fixed-point tables).
+static int mergeOccluders(const Occluder &orange, const Occluder &other)
+{
+    const float *a = orange.normal;
+    const float *b = other.normal;
+    if (!a[2]) return 0;
+
+    float cross[3] = { a[1] * b[2] - a[2] * b[1],
+                       a[2] * b[0] - a[0] * b[2],
+                       a[0] * b[1] - a[1] * b[0] };
+    if (!cross[0] && !cross[1] && !cross[2]) return 1;
+
+    binangle_t crossAngle = pointToAngle(cross[0], cross[1]);
+    if (crossAngle >= orange.from && crossAngle <= orange.to) return 0;
+    crossAngle += BANG_180;
+    if (crossAngle >= orange.from && crossAngle <= orange.to) return 0;
+
+    const double mid = BANG2RAD((orange.from + orange.to) / 2);
+    const float x = float(100 * cos(mid));
+    const float y = float(100 * sin(mid));
+    const float z = -(a[0] * x + a[1] * y) / a[2];
+    return (x * b[0] + y * b[1] + z * b[2] < 0)? 2 : 1;
+}
+
+/**
+ * The original linked list implementation of the angle clipper's ranges.
+ *
+ * Merging occluders advances to the correct next occluder when the removed one is
+ * not the immediate successor (the original skipped one occluder in that case).
+ */
+struct LinkedRanges
+{
+    struct Clipper : public AngleRange
+    {
+        Clipper *prev = nullptr;
+        Clipper *next = nullptr;
+    };
+    struct Orange : public Occluder
+    {
+        Orange *prev = nullptr;
+        Orange *next = nullptr;
+    };
+    Clipper *clipHead = nullptr;
+    Orange *occHead = nullptr;
+
+    ~LinkedRanges() { clear(); }
+
+    void clear()
+    {
+        while (clipHead) { auto *next = clipHead->next; delete clipHead; clipHead = next; }
+        while (occHead)  { auto *next = occHead->next;  delete occHead;  occHead  = next; }
+    }
+
+    bool isRangeVisible(binangle_t from, binangle_t to) const
+    {
+        for (Clipper *i = clipHead; i; i = i->next)
+        {
+            if (from >= i->from && to <= i->to) return false;
+        }
+        return true;
+    }
+
+    bool isAngleVisible(binangle_t bang) const
+    {
+        for (Clipper *i = clipHead; i; i = i->next)
+        {
+            if (bang > i->from && bang < i->to) return false;
+        }
+        return true;
+    }
+
+    bool isFull() const
+    {
+        return clipHead && clipHead->from == 0 && clipHead->to == BANG_MAX;
+    }
+
+    void removeRange(Clipper *crange)
+    {
+        if (clipHead == crange) clipHead = crange->next;
+        if (crange->prev) crange->prev->next = crange->next;
+        if (crange->next) crange->next->prev = crange->prev;
+        delete crange;
+    }
+
+    Clipper *newClipNode(binangle_t from, binangle_t to)
+    {
+        auto *crange = new Clipper;
+        crange->from = from;
+        crange->to   = to;
+        return crange;
+    }
+
+    void addRange(binangle_t from, binangle_t to)
+    {
+        cutOcclusionRange(from, to);
+
+        if (!clipHead)
+        {
+            clipHead = newClipNode(from, to);
+            return;
+        }
+        for (Clipper *i = clipHead; i; i = i->next)
+        {
+            if (from >= i->from && to <= i->to) return;
+        }
+        for (Clipper *i = clipHead; i; )
+        {
+            if (i->from >= from && i->to <= to)
+            {
+                Clipper *contained = i;
+                i = i->next;
+                removeRange(contained);
+                continue;
+            }
+            i = i->next;
+        }
+        Clipper *crange = nullptr;
+        for (Clipper *i = clipHead; i; i = i->next)
+        {
+            if (i->from < to) crange = i;
+            if (i->from >= from && i->from <= to)
+            {
+                i->from = from;
+                return;
+            }
+            if (i->to >= from && i->to <= to)
+            {
+                crange = i->next;
+                if (!crange)
+                {
+                    i->to = to;
+                }
+                else if (crange->from <= to)
+                {
+                    i->to = crange->to;
+                    removeRange(crange);
+                }
+                else
+                {
+                    i->to = to;
+                }
+                return;
+            }
+        }
+        if (!crange)
+        {
+            crange = clipHead;
+            clipHead = newClipNode(from, to);
+            clipHead->next = crange;
+            if (crange) crange->prev = clipHead;
+        }
+        else
+        {
+            Clipper *added = newClipNode(from, to);
+            added->next = crange->next;
+            if (added->next) added->next->prev = added;
+            added->prev = crange;
+            crange->next = added;
+        }
+    }
+
+    void removeOcclusionRange(Orange *orange)
+    {
+        if (occHead == orange) occHead = orange->next;
+        if (orange->prev) orange->prev->next = orange->next;
+        if (orange->next) orange->next->prev = orange->prev;
+        delete orange;
+    }
+
+    void addOcclusionRange(const Occluder &occluder)
+    {
+        if (occluder.from > occluder.to) return;
+
+        Orange *newor = new Orange;
+        static_cast<Occluder &>(*newor) = occluder;
+        if (!occHead)
+        {
+            occHead = newor;
+            return;
+        }
+        Orange *after = nullptr;
+        for (Orange *orange = occHead; orange; orange = orange->next)
+        {
+            if (orange->from > occluder.from)
+            {
+                newor->next = orange;
+                newor->prev = orange->prev;
+                orange->prev = newor;
+                if (newor->prev) newor->prev->next = newor;
+                else occHead = newor;
+                return;
+            }
+            after = orange;
+        }
+        after->next = newor;
+        newor->prev = after;
+    }
+
+    void mergeOccludes()
+    {
+        for (Orange *orange = occHead; orange && orange->next; )
+        {
+            Orange *next = orange->next;
+            for (Orange *other = next; other && orange->from == other->from; other = other->next)
+            {
+                if (other->topHalf != orange->topHalf) continue;
+                if (orange->to != other->to) continue;
+
+                const int result = mergeOccluders(*orange, *other);
+                if (result == 1)
+                {
+                    removeOcclusionRange(orange);
+                }
+                else if (result == 2)
+                {
+                    if (other == next) next = next->next;
+                    removeOcclusionRange(other);
+                }
+                break;
+            }
+            orange = next;
+        }
+    }
+
+    void cutOcclusionRange(binangle_t from, binangle_t to)
+    {
+        Orange *after = nullptr;
+        for (Orange *orange = occHead; orange && orange->from < to; orange = orange->next)
+        {
+            after = orange;
+        }
+        for (Orange *orange = occHead; orange; )
+        {
+            Orange *next = orange->next;
+            if (from <= orange->to)
+            {
+                if (orange->from >= to) break;
+
+                switch (orange->relationship(AngleRange(from, to)))
+                {
+                case 0:
+                    removeOcclusionRange(orange);
+                    break;
+                case 1:
+                    orange->from = to;
+                    break;
+                case 2:
+                    orange->to = from;
+                    break;
+                case 3: {
+                    Orange *part = new Orange;
+                    static_cast<Occluder &>(*part) = *orange;
+                    part->from = to;
+                    part->prev = after;
+                    if (after)
+                    {
+                        part->next = after->next;
+                        after->next = part;
+                    }
+                    else
+                    {
+                        part->next = occHead;
+                        occHead = part;
+                    }
+                    if (part->next) part->next->prev = part;
+                    orange->to = from;
+                    break; }
+                default:
+                    break;
+                }
+            }
+            orange = next;
+        }
+        mergeOccludes();
+    }
+
+    bool isPointVisible(const double viewRelPoint[3]) const
+    {
+        const binangle_t angle = pointToAngle(viewRelPoint[0], viewRelPoint[1]);
+        if (!isAngleVisible(angle)) return false;
+        for (Orange *orange = occHead; orange; orange = orange->next)
+        {
+            if (angle >= orange->from && angle <= orange->to)
+            {
+                if (viewRelPoint[0] * orange->normal[0] + viewRelPoint[1] * orange->normal[1] +
+                    viewRelPoint[2] * orange->normal[2] > 0) return false;
+            }
+        }
+        return true;
+    }
+};
+
+/// The angle clipper's use of the flat range lists.
+struct FlatRanges
+{
+    ClipRangeList clipRanges;
+    OcclusionRangeList occRanges;
+
+    void clear()
+    {
+        clipRanges.clear();
+        occRanges.clear();
+    }
+
+    bool isRangeVisible(binangle_t from, binangle_t to) const
+    {
+        return !clipRanges.contains(from, to);
+    }
+
+    bool isAngleVisible(binangle_t bang) const
+    {
+        return !clipRanges.containsAngle(bang);
+    }
+
+    bool isFull() const
+    {
+        return clipRanges.isFull();
+    }
+
+    void addRange(binangle_t from, binangle_t to)
+    {
+        occRanges.cut(from, to, mergeOccluders);
+        clipRanges.add(from, to);
+    }
+
+    void addOcclusionRange(const Occluder &occluder)
+    {
+        occRanges.add(occluder);
+    }
+
+    bool isPointVisible(const double viewRelPoint[3]) const
+    {
+        const binangle_t angle = pointToAngle(viewRelPoint[0], viewRelPoint[1]);
+        if (!isAngleVisible(angle)) return false;
+        for (const Occluder &orange : occRanges.occluders())
+        {
+            if (orange.from > angle) break;
+            if (angle <= orange.to)
+            {
+                if (viewRelPoint[0] * orange.normal[0] + viewRelPoint[1] * orange.normal[1] +
+                    viewRelPoint[2] * orange.normal[2] > 0) return false;
+            }
+        }
+        return true;
+    }
+};
+
+/// Operations of the angle clipper, on either implementation.
+template <typename Ranges>
+struct Clipper : public Ranges
+{
+    bool safeCheckRange(binangle_t from, binangle_t to) const
+    {
+        if (from > to)
+        {
+            return this->isRangeVisible(from, BANG_MAX) || this->isRangeVisible(0, to);
+        }
+        return this->isRangeVisible(from, to);
+    }
+
+    void safeAddRange(binangle_t from, binangle_t to)
+    {
+        if (from > to)
+        {
+            this->addRange(from, BANG_MAX);
+            this->addRange(0, to);
+        }
+        else
+        {
+            this->addRange(from, to);
+        }
+    }
+
+    void safeAddOcclusionRange(binangle_t from, binangle_t to, const float normal[3], bool topHalf)
+    {
+        if (!safeCheckRange(from, to)) return;
+
+        Occluder orange;
+        orange.topHalf = topHalf;
+        copy(normal, normal + 3, orange.normal);
+        if (from > to)
+        {
+            orange.from = from; orange.to = BANG_MAX;
+            this->addOcclusionRange(orange);
+            orange.from = 0; orange.to = to;
+            this->addOcclusionRange(orange);
+        }
+        else
+        {
+            orange.from = from; orange.to = to;
+            this->addOcclusionRange(orange);
+        }
+    }
+};
+
+static bool sameRanges(const LinkedRanges &linked, const FlatRanges &flat)
+{
+    size_t i = 0;
+    const auto &ranges = flat.clipRanges.ranges();
+    for (auto *c = linked.clipHead; c; c = c->next, ++i)
+    {
+        if (i >= ranges.size() || c->from != ranges[i].from || c->to != ranges[i].to) return false;
+    }
+    if (i != ranges.size()) return false;
+
+    i = 0;
+    const auto &oranges = flat.occRanges.occluders();
+    for (auto *o = linked.occHead; o; o = o->next, ++i)
+    {
+        if (i >= oranges.size()) return false;
+        const Occluder &other = oranges[i];
+        if (o->from != other.from || o->to != other.to || o->topHalf != other.topHalf ||
+            !equal(o->normal, o->normal + 3, other.normal)) return false;
+    }
+    return i == oranges.size();
+}
+
+static void testRandomRanges()
+{
+    mt19937 rng(1234);
+    uniform_int_distribution<int> angle(0, BANG_MAX);
+    uniform_int_distribution<int> percent(0, 99);
+    uniform_int_distribution<int> normalComponent(-4, 4);
+
+    Clipper<LinkedRanges> linked;
+    Clipper<FlatRanges> flat;
+
+    int mismatches = 0;
+    for (int round = 0; round < 400; ++round)
+    {
+        linked.clear();
+        flat.clear();
+
+        // Short ranges make merges and cuts at shared angles likely.
+        const int maxLen = (round % 4 == 0? 16 : round % 4 == 1? 512 : 8192);
+        uniform_int_distribution<int> length(0, maxLen);
+        for (int op = 0; op < 200 && !linked.isFull(); ++op)
+        {
+            const binangle_t from = binangle_t(angle(rng) & ~(round % 2? 0xf : 0));
+            const binangle_t to   = binangle_t(from + length(rng));
+            if (percent(rng) < 40)
+            {
+                linked.safeAddRange(from, to);
+                flat.safeAddRange(from, to);
+            }
+            else
+            {
+                // Few distinct normals, so that equal planes are common.
+                float normal[3] = { float(normalComponent(rng)), float(normalComponent(rng)),
+                                    float(normalComponent(rng)) };
+                const bool topHalf = percent(rng) < 50;
+                linked.safeAddOcclusionRange(from, to, normal, topHalf);
+                flat.safeAddOcclusionRange(from, to, normal, topHalf);
+            }
+            if (!sameRanges(linked, flat)) mismatches++;
+
+            for (int q = 0; q < 8; ++q)
+            {
+                const binangle_t qFrom = binangle_t(angle(rng));
+                const binangle_t qTo   = binangle_t(qFrom + length(rng));
+                if (linked.safeCheckRange(qFrom, qTo) != flat.safeCheckRange(qFrom, qTo)) mismatches++;
+                if (linked.isAngleVisible(qFrom) != flat.isAngleVisible(qFrom)) mismatches++;
+            }
+        }
+        if (linked.isFull() != flat.isFull()) mismatches++;
+    }
+    CHECK(mismatches == 0);
+}
+
+static void testEdgeCases()
+{
+    Clipper<FlatRanges> clipper;
+
+    // Touching ranges are merged, adjacent ones are not.
+    clipper.safeAddRange(10, 20);
+    clipper.safeAddRange(20, 30);
+    clipper.safeAddRange(31, 40);
+    CHECK(clipper.clipRanges.ranges().size() == 2);
+    CHECK(!clipper.safeCheckRange(10, 30));
+    CHECK(clipper.safeCheckRange(25, 35));
+    CHECK(clipper.isAngleVisible(10));
+    CHECK(!clipper.isAngleVisible(11));
+
+    // Wrapping around.
+    clipper.safeAddRange(BANG_MAX - 5, 5);
+    CHECK(!clipper.safeCheckRange(BANG_MAX - 3, 2));
+    CHECK(clipper.safeCheckRange(BANG_MAX - 3, 8));
+    CHECK(!clipper.isFull());
+    clipper.safeAddRange(0, BANG_MAX);
+    CHECK(clipper.isFull());
+    CHECK(clipper.clipRanges.ranges().size() == 1);
+
+    // Solid ranges cut occlusion ranges in two.
+    clipper.clear();
+    const float normal[3] = { 0, 0, 1 };
+    clipper.safeAddOcclusionRange(100, 200, normal, true);
+    clipper.safeAddRange(140, 160);
+    const auto &oranges = clipper.occRanges.occluders();
+    CHECK(oranges.size() == 2);
+    CHECK(oranges.size() == 2 && oranges[0].from == 100 && oranges[0].to == 140);
+    CHECK(oranges.size() == 2 && oranges[1].from == 160 && oranges[1].to == 200);
+
+    // Equal planes are merged.
+    clipper.safeAddOcclusionRange(300, 400, normal, true);
+    clipper.safeAddOcclusionRange(250, 400, normal, true);
+    clipper.safeAddRange(250, 300);
+    CHECK(oranges.size() == 3);
+}
+
+/// Walls of a generated map, as seen from the camera.
+struct Wall
+{
+    double from[2];
+    double to[2];
+    bool solid;        ///< One-sided, or a closed door.
+    double height;     ///< Of the opening, for two-sided walls.
+};
+
+static vector<Wall> generateMap(mt19937 &rng, int count)
+{
+    uniform_real_distribution<double> pos(-4096, 4096);
+    uniform_real_distribution<double> len(8, 64);
+    uniform_real_distribution<double> dir(0, 6.2831853);
+    uniform_real_distribution<double> height(-128, 256);
+    uniform_int_distribution<int> percent(0, 99);
+
+    vector<Wall> walls(static_cast<size_t>(count));
+    for (Wall &wall : walls)
+    {
+        const double a = dir(rng), l = len(rng);
+        wall.from[0] = pos(rng);
+        wall.from[1] = pos(rng);
+        wall.to[0] = wall.from[0] + cos(a) * l;
+        wall.to[1] = wall.from[1] + sin(a) * l;
+        wall.solid = percent(rng) < 25;
+        wall.height = height(rng);
+    }
+    return walls;
+}
+
+/**
+ * Culls a frame like the renderer does: the walls are visited front to back; solid
+ * walls are added as clipped ranges and the others as occlusion ranges. Returns the
+ * visible walls and points.
+ */
+template <typename Ranges>
+static vector<bool> cullFrame(Clipper<Ranges> &clipper, const vector<Wall> &walls,
+                              const vector<size_t> &order, const vector<array<double, 3>> &points,
+                              const double eye[3], binangle_t viewAngle)
+{
+    vector<bool> visible;
+    visible.reserve(walls.size() + points.size());
+
+    clipper.clear();
+
+    // The backside range.
+    const binangle_t startAngle = binangle_t(BANG_45 * 2);
+    const binangle_t angLen = binangle_t(BANG_180 - startAngle);
+    const binangle_t viewside = binangle_t(viewAngle + startAngle);
+    clipper.safeAddRange(viewside, binangle_t(viewside + angLen));
+    clipper.safeAddRange(binangle_t(viewside + angLen), binangle_t(viewside + 2 * angLen));
+
+    for (size_t index : order)
+    {
+        const Wall &wall = walls[index];
+        const double *v1 = wall.from;
+        const double *v2 = wall.to;
+        binangle_t from = pointToAngle(v2[0] - eye[0], v2[1] - eye[1]);
+        binangle_t to   = pointToAngle(v1[0] - eye[0], v1[1] - eye[1]);
+
+        // Walls are seen from the front.
+        if (binangle_t(to - from) > BANG_180)
+        {
+            swap(v1, v2);
+            swap(from, to);
+        }
+
+        const bool isVisible = clipper.safeCheckRange(binangle_t(from - BANG_45/90),
+                                                      binangle_t(to + BANG_45/90));
+        visible.push_back(isVisible);
+        if (!isVisible || clipper.isFull()) continue;
+
+        if (wall.solid)
+        {
+            clipper.safeAddRange(from, to);
+        }
+        else if (from != to)
+        {
+            const double eyeToV1[3] = { v1[0] - eye[0], v1[1] - eye[1], wall.height - eye[2] };
+            const double eyeToV2[3] = { v2[0] - eye[0], v2[1] - eye[1], wall.height - eye[2] };
+            const bool topHalf = wall.height > eye[2];
+            const double *a = topHalf? eyeToV2 : eyeToV1;
+            const double *b = topHalf? eyeToV1 : eyeToV2;
+            const float normal[3] = { float(a[1] * b[2] - a[2] * b[1]),
+                                      float(a[2] * b[0] - a[0] * b[2]),
+                                      float(a[0] * b[1] - a[1] * b[0]) };
+            clipper.safeAddOcclusionRange(from, to, normal, topHalf);
+        }
+    }
+
+    for (const auto &point : points)
+    {
+        const double rel[3] = { point[0] - eye[0], point[1] - eye[1], point[2] - eye[2] };
+        visible.push_back(clipper.isPointVisible(rel));
+    }
+    return visible;
+}
+
+/// Camera positions along a closed path through the map.
+static void cameraAt(int frame, int frameCount, double eye[3], binangle_t &viewAngle)
+{
+    const double t = 6.2831853 * frame / frameCount;
+    eye[0] = 3000 * sin(t);
+    eye[1] = 2000 * sin(2 * t);
+    eye[2] = 41 + 64 * sin(5 * t);
+    viewAngle = RAD2BANG(atan2(4000 * cos(2 * t), 3000 * cos(t)));
+}
+
+static vector<size_t> frontToBack(const vector<Wall> &walls, const double eye[3])
+{
+    vector<double> dist(walls.size());
+    for (size_t i = 0; i < walls.size(); ++i)
+    {
+        const double mx = (walls[i].from[0] + walls[i].to[0]) / 2 - eye[0];
+        const double my = (walls[i].from[1] + walls[i].to[1]) / 2 - eye[1];
+        dist[i] = mx * mx + my * my;
+    }
+    vector<size_t> order(walls.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    sort(order.begin(), order.end(), [&dist] (size_t a, size_t b) { return dist[a] < dist[b]; });
+    return order;
+}
+
+static void testCameraPath()
+{
+    mt19937 rng(5678);
+    const auto walls = generateMap(rng, 6000);
+
+    uniform_real_distribution<double> pos(-4096, 4096);
+    uniform_real_distribution<double> height(-128, 256);
+    vector<array<double, 3>> points(2000);
+    for (auto &point : points) point = {{ pos(rng), pos(rng), height(rng) }};
+
+    Clipper<LinkedRanges> linked;
+    Clipper<FlatRanges> flat;
+
+    const int frameCount = 300;
+    int mismatches = 0;
+    size_t visibleCount = 0;
+    size_t rangeCount = 0;
+    double linkedTime = 0, flatTime = 0;
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        double eye[3];
+        binangle_t viewAngle;
+        cameraAt(frame, frameCount, eye, viewAngle);
+        const auto order = frontToBack(walls, eye);
+
+        auto start = chrono::steady_clock::now();
+        const auto expected = cullFrame(linked, walls, order, points, eye, viewAngle);
+        auto mid = chrono::steady_clock::now();
+        const auto result = cullFrame(flat, walls, order, points, eye, viewAngle);
+        auto end = chrono::steady_clock::now();
+
+        linkedTime += chrono::duration<double, milli>(mid - start).count();
+        flatTime   += chrono::duration<double, milli>(end - mid).count();
+
+        if (result != expected || !sameRanges(linked, flat)) mismatches++;
+        visibleCount += size_t(count(result.begin(), result.end(), true));
+        rangeCount   += flat.clipRanges.ranges().size() + flat.occRanges.occluders().size();
+    }
+    CHECK(mismatches == 0);
+    CHECK(visibleCount > 0);
+
+    cout << frameCount << " frames, " << walls.size() << " walls: "
+         << linkedTime / frameCount << " ms per frame with linked lists, "
+         << flatTime / frameCount << " ms with flat arrays ("
+         << double(visibleCount) / frameCount << " visible and "
+         << double(rangeCount) / frameCount << " ranges per frame)" << endl;
+}
+
+int main(int, char **)
+{
+    testRandomRanges();
+    testEdgeCases();
+    testCameraPath();
+
+    if (failures)
+    {
+        cout << failures << " checks failed" << endl;
+        return 1;
+    }
+    cout << "All checks passed" << endl;
+    return 0;
+}
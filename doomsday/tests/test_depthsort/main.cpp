@@ -0,0 +1,157 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Verifies that the vissprite depth sort produces the same order as the original
+ * selection sort, and measures its performance with large numbers of projected
+ * sprites. Runs without a display.
+ */
+
+#include "render/depthsort.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    if (!(cond)) { cout << "FAILED (line " << __LINE__ << "): " #cond << endl; failures++; }
+
+/// The original vissprite ordering: repeatedly pull out the farthest remaining
+/// sprite (the last one of equally distant sprites).
+static vector<uint32_t> selectionSort(const vector<double> &depths)
+{
+    vector<uint32_t> unsorted;
+    for (uint32_t i = 0; i < depths.size(); ++i) unsorted.push_back(i);
+
+    vector<uint32_t> sorted;
+    while (!unsorted.empty())
+    {
+        size_t best = 0;
+        double bestDist = 0;
+        for (size_t i = 0; i < unsorted.size(); ++i)
+        {
+            if (depths[unsorted[i]] >= bestDist)
+            {
+                bestDist = depths[unsorted[i]];
+                best = i;
+            }
+        }
+        sorted.push_back(unsorted[best]);
+        unsorted.erase(unsorted.begin() + long(best));
+    }
+    return sorted;
+}
+
+/// Distances of sprites in a map: many are in the same spot (e.g., items and
+/// monsters placed on a grid), so there are plenty of ties.
+static vector<double> randomDepths(size_t count, mt19937 &rng)
+{
+    uniform_real_distribution<double> dist(0.0, 8192.0);
+    uniform_int_distribution<int> percent(0, 99);
+    vector<double> depths(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i > 0 && percent(rng) < 20)
+        {
+            depths[i] = depths[uniform_int_distribution<size_t>(0, i - 1)(rng)];
+        }
+        else if (percent(rng) < 10)
+        {
+            depths[i] = double(int(dist(rng)) / 64 * 64);
+        }
+        else
+        {
+            depths[i] = dist(rng);
+        }
+    }
+    return depths;
+}
+
+static void testMatchesSelectionSort()
+{
+    mt19937 rng(1234);
+    DepthSorter sorter;
+    for (size_t count : {0, 1, 2, 3, 17, 63, 64, 65, 500, 3000})
+    {
+        const auto depths = randomDepths(count, rng);
+        CHECK(sorter.sort(depths.data(), uint32_t(count)) == selectionSort(depths));
+    }
+}
+
+static void testEdgeCases()
+{
+    DepthSorter sorter;
+
+    // All at the same distance: reverse order of creation.
+    vector<double> same(100, 42.0);
+    const auto &order = sorter.sort(same.data(), uint32_t(same.size()));
+    CHECK(order.size() == 100);
+    CHECK(order.front() == 99 && order.back() == 0);
+
+    // Very close distances must not be merged.
+    vector<double> close { 100.0, 100.0 + 1e-9, 100.0 - 1e-9, 0.0, 1e6 };
+    const vector<uint32_t> expected { 4, 1, 0, 2, 3 };
+    CHECK(sorter.sort(close.data(), uint32_t(close.size())) == expected);
+
+    // Buffers are reused for a smaller set.
+    vector<double> more(1000);
+    for (size_t i = 0; i < more.size(); ++i) more[i] = double(i % 10);
+    CHECK(sorter.sort(more.data(), uint32_t(more.size())) == selectionSort(more));
+    CHECK(sorter.sort(close.data(), uint32_t(close.size())) == expected);
+}
+
+static void benchmark()
+{
+    mt19937 rng(5678);
+    DepthSorter sorter;
+    for (size_t count : {10000, 25000, 50000})
+    {
+        const auto depths = randomDepths(count, rng);
+        const int rounds = 50;
+        uint64_t checksum = 0;
+        const auto start = chrono::steady_clock::now();
+        for (int i = 0; i < rounds; ++i)
+        {
+            checksum += sorter.sort(depths.data(), uint32_t(count)).front();
+        }
+        const chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        cout << count << " sprites: " << elapsed.count() / rounds << " ms per sort"
+             << " (checksum " << checksum << ")" << endl;
+    }
+}
+
+int main(int, char **)
+{
+    testMatchesSelectionSort();
+    testEdgeCases();
+    benchmark();
+
+    if (failures)
+    {
+        cout << failures << " checks failed" << endl;
+        return 1;
+    }
+    cout << "All checks passed" << endl;
+    return 0;
+}
@@ -0,0 +1,246 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Draws DrawLists through DGL with the null backend, without a window or a GL context,
+ * and checks the draw calls, batches and vertices that DGL would have submitted. Also
+ * measures the CPU cost of drawing a list.
+ */
+
+#include "de_base.h"
+#include "gl/gl_main.h"
+#include "render/drawlist.h"
+#include "render/store.h"
+#include "nullclient.h"
+
+#include <de/glstate.h>
+#include <de/liblegacy.h>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+using namespace de;
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(cond) if (!(cond)) { cout << "FAILED (line " << __LINE__ << "): " #cond << endl; failures++; }
+
+static const TexUnitMap texUnitMap {{ AttributeSpec::TexCoord0, AttributeSpec::TexCoord1 }};
+
+/**
+ * Writes @a count quads to @a list, each as a triangle fan of its own. The quads have
+ * different texture offsets if @a distinctOffsets is set, so their texture matrices
+ * differ.
+ */
+static void writeQuads(DrawList &list, Store &store, int count, bool distinctOffsets = false)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const duint base = store.allocateVertices(4);
+        duint indices[4];
+        for (duint k = 0; k < 4; ++k)
+        {
+            const duint idx = base + k;
+            store.posCoords[idx]    = Vec3f(float(i + (k == 1 || k == 2)), float(k >= 2), 0);
+            store.colorCoords[idx]  = Vec4ub(255, 255, 255, 255);
+            store.texCoords[0][idx] = Vec2f(float(k == 1 || k == 2), float(k >= 2));
+            store.texCoords[1][idx] = store.texCoords[0][idx];
+            store.modCoords[idx]    = Vec2f();
+            indices[k] = idx;
+        }
+        list.write(store, indices, 4,
+                   DrawList::PrimitiveParams(gfx::TriangleFan, Vec2f(1, 1),
+                                             Vec2f(distinctOffsets? float(i) : 0.f, 0)));
+    }
+}
+
+/**
+ * Writes @a count triangle strips of @a length vertices to @a list.
+ */
+static void writeStrips(DrawList &list, Store &store, int count, int length)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const duint base = store.allocateVertices(duint(length));
+        DrawList::Indices indices;
+        for (int k = 0; k < length; ++k)
+        {
+            const duint idx = base + duint(k);
+            store.posCoords[idx]    = Vec3f(float(k / 2), float(k % 2), float(i));
+            store.colorCoords[idx]  = Vec4ub(255, 255, 255, 255);
+            store.texCoords[0][idx] = Vec2f(float(k / 2), float(k % 2));
+            store.texCoords[1][idx] = store.texCoords[0][idx];
+            store.modCoords[idx]    = Vec2f();
+            indices.append(idx);
+        }
+        list.write(store, indices, gfx::TriangleStrip);
+    }
+}
+
+/**
+ * Draws @a list in a frame of its own and returns what DGL drew.
+ */
+static DGLFrameStats drawFrame(const DrawList &list)
+{
+    DGL_BeginFrame();
+    list.draw(DM_ALL, texUnitMap);
+    DGL_Flush();
+    return DGL_FrameStats();
+}
+
+static void testUntexturedList()
+{
+    Store store;
+    const DrawList::Spec spec(UnlitGeom);
+    DrawList list(spec);
+    writeQuads(list, store, 10);
+    writeStrips(list, store, 5, 6);
+
+    // All the sections use the same uniforms, so they are merged into one batch. Fans
+    // of n vertices become strips of 2n - 2 vertices, and each section after the first
+    // is joined to the previous one with two extra vertices.
+    const DGLFrameStats stats = drawFrame(list);
+    CHECK(stats.drawCalls == 1);
+    CHECK(stats.batches == 1);
+    CHECK(stats.mergedSections == 14);
+    CHECK(stats.vertices == 10 * 6 + 5 * 6 + 14 * 2);
+    CHECK(stats.primitiveSwitches == 0);
+    CHECK(stats.stateChanges == 1);
+
+    // Drawing the same list again gives the same results.
+    const DGLFrameStats again = drawFrame(list);
+    CHECK(again.drawCalls == stats.drawCalls);
+    CHECK(again.vertices == stats.vertices);
+}
+
+static void testTexturedLists()
+{
+    Store store;
+    DrawList::Spec untexturedSpec(UnlitGeom);
+    DrawList::Spec texturedSpec(UnlitGeom);
+    texturedSpec.unit(TU_PRIMARY) = GLTextureUnit(7);
+
+    DrawList untextured(untexturedSpec);
+    DrawList textured(texturedSpec);
+    writeQuads(untextured, store, 10);
+    writeQuads(textured, store, 10);
+
+    // Lists with different textures are drawn in separate batches of the same draw call.
+    DGL_BeginFrame();
+    untextured.draw(DM_ALL, texUnitMap);
+    textured.draw(DM_ALL, texUnitMap);
+    DGL_Flush();
+    DGLFrameStats stats = DGL_FrameStats();
+    CHECK(stats.drawCalls == 1);
+    CHECK(stats.batches == 2);
+    CHECK(stats.mergedSections == 9 + 9);
+    CHECK(stats.vertices == 6 + 19 * 8);
+
+    // The texture matrix is set for each primitive, but it doesn't change.
+    stats = drawFrame(textured);
+    CHECK(stats.drawCalls == 1);
+    CHECK(stats.batches == 1);
+    CHECK(stats.mergedSections == 9);
+    CHECK(stats.vertices == 6 + 9 * 8);
+
+    // Primitives with different texture offsets cannot be merged. A draw call has at
+    // most 15 batches, because a new batch is not started in the last entry.
+    DrawList offsets(texturedSpec);
+    writeQuads(offsets, store, 20, true);
+    stats = drawFrame(offsets);
+    CHECK(stats.drawCalls == 2);
+    CHECK(stats.batches == 20);
+    CHECK(stats.mergedSections == 0);
+    CHECK(stats.vertices == (6 + 14 * 8) + (6 + 4 * 8));
+}
+
+static void testStateChanges()
+{
+    Store store;
+    const DrawList::Spec spec(UnlitGeom);
+    DrawList list(spec);
+    writeQuads(list, store, 4);
+
+    // Changes to the GL state are noticed by the draw call after the change.
+    DGL_BeginFrame();
+    list.draw(DM_ALL, texUnitMap);
+    DGL_Flush();
+    GLState::push().setDepthTest(true);
+    list.draw(DM_ALL, texUnitMap);
+    DGL_Flush();
+    list.draw(DM_ALL, texUnitMap);
+    DGL_Flush();
+    GLState::pop();
+    const DGLFrameStats stats = DGL_FrameStats();
+    CHECK(stats.drawCalls == 3);
+    CHECK(stats.stateChanges == 2);
+}
+
+static void benchmark()
+{
+    const int quads = 10000;
+    const int rounds = 100;
+
+    Store store;
+    DrawList::Spec spec(UnlitGeom);
+    spec.unit(TU_PRIMARY) = GLTextureUnit(7);
+    DrawList list(spec);
+    writeQuads(list, store, quads);
+
+    const auto start = chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i)
+    {
+        drawFrame(list);
+    }
+    const double elapsed =
+        chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / rounds;
+    cout << "Drawing " << quads << " quads: " << elapsed << " us ("
+         << elapsed * 1000 / quads << " ns per quad)" << endl;
+}
+
+int main(int argc, char **argv)
+{
+    const bool runBenchmarks = (argc > 1 && !strcmp(argv[1], "-bench"));
+
+    Libdeng_Init();
+    NullClient_Init();
+
+    // DGL takes the GL state of its batches from the current state stack.
+    GLStateStack stateStack;
+    GLStateStack::activate(stateStack);
+    DGL_SetNullBackend(true);
+
+    testUntexturedList();
+    testTexturedLists();
+    testStateChanges();
+
+    if (runBenchmarks) benchmark();
+
+    DGL_Shutdown();
+    Libdeng_Shutdown();
+
+    if (failures)
+    {
+        cout << failures << " checks failed" << endl;
+        return 1;
+    }
+    cout << "All checks passed" << endl;
+    return 0;
+}
@@ -0,0 +1,238 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Stand-ins for the client functions that drawlist.cpp and dgl_draw.cpp call. The DGL
+ * state (matrices, texture units, modulation) is kept like in dgl_common.cpp, because
+ * the batching in dgl_draw.cpp depends on it. Everything else that would need a window,
+ * resources or OpenGL does nothing; with the null backend none of it is reached.
+ */
+
+#define DE_NO_API_MACROS_GL
+
+#include "de_base.h"
+#include "gl/gl_main.h"
+#include "gl/gl_draw.h"
+#include "render/rend_main.h"
+#include "nullclient.h"
+
+using namespace de;
+
+// dgl_draw.cpp
+DE_EXTERN_C void DGL_Begin(dglprimtype_t mode);
+DE_EXTERN_C void DGL_End(void);
+DE_EXTERN_C void DGL_Color4ub(DGLubyte r, DGLubyte g, DGLubyte b, DGLubyte a);
+DE_EXTERN_C void DGL_TexCoord2f(byte target, float s, float t);
+DE_EXTERN_C void DGL_Vertex3f(float x, float y, float z);
+
+DE_DECLARE_API(GL);
+
+gl_state_t GL_state;
+int renderTextures = true;
+
+struct DGLState
+{
+    int matrixMode = 0;
+    List<Mat4f> matrixStacks[4];
+
+    int activeTexture = 0;
+    bool enableTexture[2] { true, false };
+    int textureModulation = 1;
+    Vec4f textureModulationColor;
+
+    DGLState()
+    {
+        for (auto &stack : matrixStacks)
+        {
+            stack.append(Mat4f());
+        }
+    }
+
+    int stackIndex(DGLenum id) const
+    {
+        switch (id)
+        {
+        case DGL_TEXTURE0: return 2;
+        case DGL_TEXTURE1: return 3;
+        case DGL_TEXTURE:  return 2 + activeTexture;
+        default:           return int(id) - DGL_MODELVIEW;
+        }
+    }
+
+    Mat4f &top()
+    {
+        return matrixStacks[matrixMode].back();
+    }
+};
+
+static DGLState s_dgl;
+
+static int nullGetInteger(int name)
+{
+    switch (name)
+    {
+    case DGL_ACTIVE_TEXTURE:   return s_dgl.activeTexture;
+    case DGL_TEXTURE0:         return s_dgl.enableTexture[0]? 1 : 0;
+    case DGL_TEXTURE1:         return s_dgl.enableTexture[1]? 1 : 0;
+    case DGL_MODULATE_TEXTURE: return s_dgl.textureModulation;
+    default:                   return 0;
+    }
+}
+
+static dd_bool nullSetInteger(int name, int value)
+{
+    switch (name)
+    {
+    case DGL_ACTIVE_TEXTURE:
+        s_dgl.activeTexture = value;
+        return true;
+
+    case DGL_MODULATE_TEXTURE:
+        s_dgl.textureModulation = value;
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+static void nullMatrixMode(DGLenum mode)
+{
+    s_dgl.matrixMode = s_dgl.stackIndex(mode);
+}
+
+static void nullPushMatrix()
+{
+    auto &stack = s_dgl.matrixStacks[s_dgl.matrixMode];
+    stack.push_back(stack.back());
+}
+
+static void nullPopMatrix()
+{
+    s_dgl.matrixStacks[s_dgl.matrixMode].pop_back();
+}
+
+static void nullLoadIdentity()
+{
+    s_dgl.top() = Mat4f();
+}
+
+static void nullTranslatef(float x, float y, float z)
+{
+    s_dgl.top() = s_dgl.top() * Mat4f::translate(Vec3f(x, y, z));
+}
+
+static void nullScalef(float x, float y, float z)
+{
+    s_dgl.top() = s_dgl.top() * Mat4f::scale(Vec3f(x, y, z));
+}
+
+void NullClient_Init()
+{
+    zap(_api_GL);
+    _api_GL.GetInteger   = nullGetInteger;
+    _api_GL.SetInteger   = nullSetInteger;
+    _api_GL.MatrixMode   = nullMatrixMode;
+    _api_GL.PushMatrix   = nullPushMatrix;
+    _api_GL.PopMatrix    = nullPopMatrix;
+    _api_GL.LoadIdentity = nullLoadIdentity;
+    _api_GL.Translatef   = nullTranslatef;
+    _api_GL.Scalef       = nullScalef;
+    _api_GL.Begin        = DGL_Begin;
+    _api_GL.End          = DGL_End;
+    _api_GL.Color4ub     = DGL_Color4ub;
+    _api_GL.TexCoord2f   = DGL_TexCoord2f;
+    _api_GL.Vertex3f     = DGL_Vertex3f;
+}
+
+// dgl_common.cpp ---------------------------------------------------------------------
+
+Mat4f DGL_Matrix(DGLenum matrixMode)
+{
+    return s_dgl.matrixStacks[s_dgl.stackIndex(matrixMode)].back();
+}
+
+void DGL_ModulateTexture(int mode)
+{
+    s_dgl.textureModulation = mode;
+}
+
+void DGL_SetModulationColor(const Vec4f &modColor)
+{
+    s_dgl.textureModulationColor = modColor;
+}
+
+Vec4f DGL_ModulationColor()
+{
+    return s_dgl.textureModulationColor;
+}
+
+void DGL_FogParams(GLUniform &, GLUniform &)
+{}
+
+// gl_main.cpp ------------------------------------------------------------------------
+
+void GL_SelectTexUnits(int count)
+{
+    for (int i = 0; i < MAX_TEX_UNITS; ++i)
+    {
+        s_dgl.enableTexture[i] = (i < count);
+    }
+}
+
+void GL_BlendMode(blendmode_t)
+{}
+
+void GL_BindTextureUnmanaged(GLuint glName, gfx::Wrapping, gfx::Wrapping, gfx::Filter)
+{
+    DGL_BindTexture2D(glName);
+}
+
+void GL_Bind(const GLTextureUnit &glTU)
+{
+    if (!glTU.hasTexture()) return;
+    DGL_BindTexture2D(glTU.getTextureGLName());
+}
+
+void GL_BindTo(const GLTextureUnit &glTU, int unit)
+{
+    if (!glTU.hasTexture()) return;
+    nullSetInteger(DGL_ACTIVE_TEXTURE, unit);
+    GL_Bind(glTU);
+}
+
+// clienttexture.cpp ------------------------------------------------------------------
+
+uint ClientTexture::Variant::glName() const
+{
+    // The test only uses unmanaged textures.
+    return 0;
+}
+
+// gl_draw.cpp ------------------------------------------------------------------------
+
+void GL_DrawLine(float, float, float, float, float, float, float, float) {}
+void GL_DrawRect(const Rectanglei &) {}
+void GL_DrawRect2(int, int, int, int) {}
+void GL_DrawRectf(const RectRawf *) {}
+void GL_DrawRectf2(double, double, double, double) {}
+void GL_DrawRectf2Tiled(double, double, double, double, int, int) {}
+void GL_DrawCutRectfTiled(const RectRawf *, int, int, int, int, const RectRawf *) {}
+void GL_DrawCutRectf2Tiled(double, double, double, double, int, int, int, int,
+                           double, double, double, double) {}
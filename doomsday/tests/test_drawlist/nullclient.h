@@ -0,0 +1,29 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_DRAWLIST_NULLCLIENT_H
+#define TEST_DRAWLIST_NULLCLIENT_H
+
+/**
+ * Sets up the stand-ins for the parts of the client that DrawList and the DGL drawing
+ * code call into. Must be called before anything is drawn.
+ */
+void NullClient_Init();
+
+#endif // TEST_DRAWLIST_NULLCLIENT_H
@@ -0,0 +1,402 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Checks the cached smoothed wall edge normals against normals computed without the
+ * cache, while planes move and wall materials and opacities change. The map is a row
+ * of rooms whose walls are slightly bent, so that neighboring walls are smoothed.
+ * Finding the blend neighbor follows the same rules as WallEdge: a side with a closed
+ * back blends with a solid neighbor, others with any neighbor that has a surface.
+ * Runs without a display.
+ */
+
+#include "render/edgenormals.h"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    if (!(cond)) { cout << "FAILED (line " << __LINE__ << "): " #cond << endl; failures++; }
+
+static const int SECTIONS = 3;
+
+struct MapVertex
+{
+    double x, y;
+    vector<int> lines;
+};
+
+struct MapSector
+{
+    double floor, ceiling;
+};
+
+struct MapLine
+{
+    int from, to;
+    int sectors[2];             ///< Front and back; -1 if none.
+    bool middleMaterial = false;
+    float middleOpacity = 1;
+    EdgeNormals normals[2];
+};
+
+struct TestMap : public EdgeNormals::Topology
+{
+    vector<MapVertex> vertices;
+    vector<MapSector> sectors;
+    vector<MapLine> lines;
+    mutable int computeCount = 0;
+
+    /**
+     * A row of rooms from left to right. The bottom and top walls of each room are
+     * made of two segments with a slight bend in the middle.
+     */
+    explicit TestMap(int roomCount)
+    {
+        for (int i = 0; i <= roomCount; ++i)
+        {
+            vertices.push_back({i * 128.0, 0, {}});
+            vertices.push_back({i * 128.0, 128, {}});
+        }
+        for (int i = 0; i < roomCount; ++i)
+        {
+            const int bottomMid = int(vertices.size());
+            vertices.push_back({i * 128.0 + 64, -8.0 - i, {}});
+            vertices.push_back({i * 128.0 + 64, 136.0 + i, {}});
+
+            sectors.push_back({0, 128});
+
+            // Front sides face into the room.
+            addLine(2 * i,            bottomMid,         i, -1);
+            addLine(bottomMid,        2 * (i + 1),       i, -1);
+            addLine(2 * (i + 1) + 1,  bottomMid + 1,     i, -1);
+            addLine(bottomMid + 1,    2 * i + 1,         i, -1);
+        }
+        // Walls between the rooms.
+        addLine(1, 0, 0, -1);
+        for (int i = 1; i < roomCount; ++i)
+        {
+            addLine(2 * i, 2 * i + 1, i - 1, i);
+        }
+        addLine(2 * roomCount, 2 * roomCount + 1, roomCount - 1, -1);
+    }
+
+    void addLine(int from, int to, int front, int back)
+    {
+        const int index = int(lines.size());
+        MapLine line;
+        line.from = from;
+        line.to   = to;
+        line.sectors[0] = front;
+        line.sectors[1] = back;
+        lines.push_back(line);
+        vertices[from].lines.push_back(index);
+        vertices[to]  .lines.push_back(index);
+    }
+
+    bool isClosed(const MapSector &sector) const { return sector.floor >= sector.ceiling; }
+
+    /// Same idea as R_SideBackClosed().
+    bool sideBackClosed(const MapLine &line, int side) const
+    {
+        if (line.sectors[side] < 0 || line.sectors[side ^ 1] < 0) return true;
+        if (isClosed(sectors[line.sectors[0]]) || isClosed(sectors[line.sectors[1]])) return true;
+        return line.middleMaterial && line.middleOpacity >= 1;
+    }
+
+    bool isSolid(const MapLine &line) const
+    {
+        return sideBackClosed(line, 0);
+    }
+
+    uint16_t angle(int from, int to) const
+    {
+        const double a = atan2(vertices[to].y - vertices[from].y, vertices[to].x - vertices[from].x);
+        return uint16_t(int64_t(std::round(a / (2 * M_PI) * 65536)) & 0xffff);
+    }
+
+    EdgeNormals::Normal sideNormal(const MapLine &line, int side) const
+    {
+        const double dx = vertices[line.to].x - vertices[line.from].x;
+        const double dy = vertices[line.to].y - vertices[line.from].y;
+        const double len = sqrt(dx * dx + dy * dy);
+        const float sign = side? -1 : 1;
+        return EdgeNormals::Normal {{ sign * float(-dy / len), sign * float(dx / len), 0 }};
+    }
+
+    static float dot(const EdgeNormals::Normal &a, const EdgeNormals::Normal &b)
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    /**
+     * Computes the normal of an edge without the cache. The neighbor is found by
+     * rotating around the edge's vertex, starting from the line and turning towards the
+     * side's front. A side with a closed back passes by lines that are not solid.
+     */
+    EdgeNormals::Normal computeNormal(int lineIndex, int side, int edge) const
+    {
+        computeCount++;
+
+        const MapLine &line = lines[lineIndex];
+        const EdgeNormals::Normal normal = sideNormal(line, side);
+        const int vertex  = (edge ^ side)? line.to : line.from;
+        const bool closed = sideBackClosed(line, side);
+        const uint16_t own = angle(vertex, vertex == line.from? line.to : line.from);
+        const uint16_t facing = uint16_t(int64_t(std::round(atan2(normal[1], normal[0]) / (2 * M_PI) * 65536)) & 0xffff);
+        const int turn = (uint16_t(facing - own) < 0x8000? 1 : -1);
+
+        const MapLine *neighbor = nullptr;
+        uint16_t nearest = 0xffff;
+        uint16_t diff = 0;
+        for (int n : vertices[vertex].lines)
+        {
+            if (n == lineIndex) continue;
+            const MapLine &cand = lines[n];
+            if (closed && !isSolid(cand)) continue;
+            const uint16_t candDiff = uint16_t(angle(vertex, cand.from == vertex? cand.to : cand.from) - own);
+            const uint16_t rotation = uint16_t(turn * candDiff);
+            if (rotation < nearest)
+            {
+                nearest  = rotation;
+                neighbor = &cand;
+                diff     = candDiff;
+            }
+        }
+        if (!neighbor) return EdgeNormals::smooth(normal, nullptr, 0);
+
+        // Blend with the neighbor's side that faces the same way.
+        const int neighborSide = (dot(sideNormal(*neighbor, 0), normal) >= 0? 0 : 1);
+        if (neighbor->sectors[neighborSide] < 0) return EdgeNormals::smooth(normal, nullptr, 0);
+        const EdgeNormals::Normal blend = sideNormal(*neighbor, neighborSide);
+        return EdgeNormals::smooth(normal, &blend, diff);
+    }
+
+    EdgeNormals::Normal cachedNormal(int lineIndex, int side, int section, int edge)
+    {
+        return lines[lineIndex].normals[side].normal(section, edge, [&] () {
+            return computeNormal(lineIndex, side, edge);
+        });
+    }
+
+    /// Number of cached edge normals that differ from the uncached ones.
+    int mismatches()
+    {
+        int count = 0;
+        for (int i = 0; i < int(lines.size()); ++i)
+        for (int side = 0; side < 2; ++side)
+        {
+            if (lines[i].sectors[side] < 0) continue;
+            for (int section = 0; section < SECTIONS; ++section)
+            for (int edge = 0; edge < 2; ++edge)
+            {
+                const int before = computeCount;
+                const auto expected = computeNormal(i, side, edge);
+                computeCount = before;
+                if (cachedNormal(i, side, section, edge) != expected) count++;
+            }
+        }
+        return count;
+    }
+
+    bool isAllValid(int lineIndex) const
+    {
+        for (int side = 0; side < 2; ++side)
+        {
+            if (lines[lineIndex].sectors[side] < 0) continue;
+            for (int section = 0; section < SECTIONS; ++section)
+            for (int edge = 0; edge < 2; ++edge)
+            {
+                if (!lines[lineIndex].normals[side].isValid(section, edge)) return false;
+            }
+        }
+        return true;
+    }
+
+    // Implements EdgeNormals::Topology.
+    EdgeNormals &normals(Line line, int side) const override
+    {
+        return static_cast<MapLine *>(line)->normals[side];
+    }
+
+    void forAllLinesAtVertex(Line line, int to, const std::function<void (Line)> &func) const override
+    {
+        const auto *ln = static_cast<MapLine *>(line);
+        for (int n : vertices[to? ln->to : ln->from].lines)
+        {
+            func(const_cast<MapLine *>(&lines[n]));
+        }
+    }
+
+    void forAllSectorLines(Sector sector, const std::function<void (Line)> &func) const override
+    {
+        const int index = int(static_cast<MapSector *>(sector) - sectors.data());
+        for (const auto &ln : lines)
+        {
+            if (ln.sectors[0] == index || ln.sectors[1] == index)
+            {
+                func(const_cast<MapLine *>(&ln));
+            }
+        }
+    }
+
+    MapLine *line(int index) { return &lines[index]; }
+    MapSector *sector(int index) { return &sectors[index]; }
+
+    /// Index of the wall between rooms @a left and @a left + 1.
+    int wallBetween(int left) const { return int(sectors.size()) * 4 + 1 + left; }
+};
+
+static void testCachedEqualsUncached()
+{
+    TestMap map(4);
+    CHECK(map.mismatches() == 0);
+
+    // Some walls are smoothed, some are not.
+    int smoothed = 0, plain = 0;
+    for (int i = 0; i < int(map.lines.size()); ++i)
+    for (int edge = 0; edge < 2; ++edge)
+    {
+        if (map.computeNormal(i, 0, edge) == map.sideNormal(map.lines[i], 0)) plain++;
+        else smoothed++;
+    }
+    CHECK(smoothed > 0);
+    CHECK(plain > 0);
+
+    // The second time around, nothing is computed.
+    map.computeCount = 0;
+    CHECK(map.mismatches() == 0);
+    CHECK(map.computeCount == 0);
+
+    // Smoothing rules.
+    const EdgeNormals::Normal a {{1, 0, 0}}, b {{0, 1, 0}};
+    CHECK(EdgeNormals::smooth(a, nullptr, 0x8000) == a);
+    CHECK(EdgeNormals::smooth(a, &b, 0x8000) == (EdgeNormals::Normal {{.5f, .5f, 0}}));
+    CHECK(EdgeNormals::smooth(a, &b, 0x6000) == (EdgeNormals::Normal {{.5f, .5f, 0}}));
+    CHECK(EdgeNormals::smooth(a, &b, 0x5fff) == a);
+    CHECK(EdgeNormals::smooth(a, &b, 0xa001) == a);
+}
+
+static void testPlaneMove()
+{
+    TestMap map(6);
+    CHECK(map.mismatches() == 0);
+
+    // Closing room 2 (like a door) closes the walls between it and its neighbors.
+    map.sectors[2].ceiling = map.sectors[2].floor;
+    CHECK(map.mismatches() > 0); // Stale without invalidation.
+
+    EdgeNormals::invalidateAroundSector(map, map.sector(2));
+    CHECK(!map.isAllValid(map.wallBetween(1)));
+    CHECK(!map.isAllValid(map.wallBetween(2)));
+    CHECK(map.isAllValid(0));                 // Bottom wall of room 0 is unaffected.
+    CHECK(map.isAllValid(map.wallBetween(4)));
+    CHECK(map.mismatches() == 0);
+
+    // Opening it again.
+    map.sectors[2].ceiling = 128;
+    EdgeNormals::invalidateAroundSector(map, map.sector(2));
+    CHECK(map.mismatches() == 0);
+}
+
+static void testMaterialAndOpacity()
+{
+    TestMap map(6);
+    CHECK(map.mismatches() == 0);
+
+    // An opaque middle material closes the wall between rooms 3 and 4.
+    const int wall = map.wallBetween(3);
+    map.lines[wall].middleMaterial = true;
+    CHECK(map.mismatches() > 0);
+
+    EdgeNormals::invalidateAroundLine(map, map.line(wall));
+    CHECK(!map.isAllValid(wall));
+    CHECK(!map.isAllValid(3 * 4 + 1));       // Bottom wall of room 3 ends at the wall.
+    CHECK(map.isAllValid(0));
+    CHECK(map.isAllValid(map.wallBetween(1)));
+    CHECK(map.mismatches() == 0);
+
+    // A translucent material does not close it.
+    map.lines[wall].middleOpacity = .5f;
+    CHECK(map.mismatches() > 0);
+    EdgeNormals::invalidateAroundLine(map, map.line(wall));
+    CHECK(map.mismatches() == 0);
+
+    // Neither does removing the material.
+    map.lines[wall].middleOpacity  = 1;
+    EdgeNormals::invalidateAroundLine(map, map.line(wall));
+    CHECK(map.mismatches() == 0);
+    map.lines[wall].middleMaterial = false;
+    EdgeNormals::invalidateAroundLine(map, map.line(wall));
+    CHECK(map.mismatches() == 0);
+}
+
+static void testRandomChanges()
+{
+    TestMap map(12);
+    mt19937 rng(4242);
+    uniform_int_distribution<int> sectorDist(0, int(map.sectors.size()) - 1);
+    uniform_int_distribution<int> wallDist(0, int(map.sectors.size()) - 2);
+
+    bool allEqual = true;
+    int closings = 0;
+    for (int i = 0; i < 500; ++i)
+    {
+        if (rng() % 2)
+        {
+            const int s = sectorDist(rng);
+            map.sectors[s].ceiling = (rng() % 3 == 0? map.sectors[s].floor : 128);
+            if (map.isClosed(map.sectors[s])) closings++;
+            EdgeNormals::invalidateAroundSector(map, map.sector(s));
+        }
+        else
+        {
+            MapLine &ln = map.lines[map.wallBetween(wallDist(rng))];
+            if (rng() % 2) ln.middleMaterial = !ln.middleMaterial;
+            else           ln.middleOpacity  = (ln.middleOpacity < 1? 1 : .25f);
+            EdgeNormals::invalidateAroundLine(map, &ln);
+        }
+        if (map.mismatches()) allEqual = false;
+    }
+    CHECK(allEqual);
+    CHECK(closings > 0);
+}
+
+int main(int, char **)
+{
+    testCachedEqualsUncached();
+    testPlaneMove();
+    testMaterialAndOpacity();
+    testRandomChanges();
+
+    if (failures)
+    {
+        cout << failures << " checks failed" << endl;
+        return 1;
+    }
+    cout << "All checks passed" << endl;
+    return 0;
+}
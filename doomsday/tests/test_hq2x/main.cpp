@@ -0,0 +1,181 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Verifies that the hq2x upscaler produces exactly the same output as the original
+ * implementation, and measures its speed. The expected checksums were computed with
+ * the original implementation from the same generated images. Runs without a display.
+ */
+
+#include "resource/hq2x.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    if (!(cond)) { cout << "FAILED (line " << __LINE__ << "): " #cond << endl; failures++; }
+
+/**
+ * Generates an RGBA image that looks a bit like a texture: most pixels use a few
+ * palette colors (some of them transparent), with random noise in between.
+ */
+static vector<uint8_t> makeImage(uint32_t seed, int width, int height)
+{
+    mt19937 rng(seed);
+    vector<uint32_t> palette(2 + rng() % 20);
+    for (uint32_t &color : palette)
+    {
+        color = rng() & (rng() % 2? 0xffffffff : 0x00ffffff);
+    }
+    vector<uint8_t> image(size_t(width) * height * 4);
+    for (size_t i = 0; i < image.size(); i += 4)
+    {
+        const uint32_t color = (rng() % 4? palette[rng() % palette.size()] : rng());
+        for (int c = 0; c < 4; ++c)
+        {
+            image[i + c] = uint8_t(color >> (8 * c));
+        }
+    }
+    return image;
+}
+
+/// FNV-1a hash of the image bytes.
+static uint64_t checksum(const uint8_t *data, size_t size)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ data[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+struct Case
+{
+    int width;
+    int height;
+    bool wrapH;
+    bool wrapV;
+    int passes;         ///< 2 for the 4x mode (hq2x applied twice).
+    uint64_t expected;  ///< Checksum of the original implementation's output.
+};
+
+static const Case cases[] = {
+    {   1,   1, false, false, 1, 0x34181d009d7e9cbdull },
+    {   1,   1, true , false, 1, 0x34181d009d7e9cbdull },
+    {   1,   1, false, true , 1, 0x34181d009d7e9cbdull },
+    {   1,   1, true , true , 1, 0x34181d009d7e9cbdull },
+    {   2,   3, false, false, 1, 0x405c07693c2c52edull },
+    {   2,   3, true , false, 1, 0x405c07693c2c52edull },
+    {   2,   3, false, true , 1, 0x405c07693c2c52edull },
+    {   2,   3, true , true , 1, 0x405c07693c2c52edull },
+    {   7,   5, false, false, 1, 0xf3a9a4ff7c16b045ull },
+    {   7,   5, false, false, 2, 0x66b473c9c634ac4eull },
+    {   7,   5, true , false, 1, 0xf3a9a4ff7c16b045ull },
+    {   7,   5, true , false, 2, 0x66b473c9c634ac4eull },
+    {   7,   5, false, true , 1, 0xf3a9a4ff7c16b045ull },
+    {   7,   5, false, true , 2, 0x66b473c9c634ac4eull },
+    {   7,   5, true , true , 1, 0xf3a9a4ff7c16b045ull },
+    {   7,   5, true , true , 2, 0x66b473c9c634ac4eull },
+    {  16,  16, false, false, 1, 0xff7ca1b690ca1c6dull },
+    {  16,  16, false, false, 2, 0x44e279f753fac991ull },
+    {  16,  16, true , false, 1, 0xff7ca1b690ca1c6dull },
+    {  16,  16, true , false, 2, 0x44e279f753fac991ull },
+    {  16,  16, false, true , 1, 0x429d29435eda5c2bull },
+    {  16,  16, false, true , 2, 0x3b92d5df6483084dull },
+    {  16,  16, true , true , 1, 0x7c6e5834d19d77bfull },
+    {  16,  16, true , true , 2, 0x336e34c86c98e82bull },
+    {  33,  17, false, false, 1, 0x07a0e44436aa4815ull },
+    {  33,  17, false, false, 2, 0xb6925ccfaf8c9595ull },
+    {  33,  17, true , false, 1, 0x07a0e44436aa4815ull },
+    {  33,  17, true , false, 2, 0xb6925ccfaf8c9595ull },
+    {  33,  17, false, true , 1, 0xe9726db634496a70ull },
+    {  33,  17, false, true , 2, 0x6661a849e71c49e3ull },
+    {  33,  17, true , true , 1, 0xe9726db634496a70ull },
+    {  33,  17, true , true , 2, 0x6661a849e71c49e3ull },
+    {  64, 128, false, false, 1, 0xee27752631e3cd1eull },
+    {  64, 128, true , false, 1, 0x2aa7773ce8305f2bull },
+    {  64, 128, false, true , 1, 0x0df92fe91f3352b6ull },
+    {  64, 128, true , true , 1, 0xf723e0e3c2257303ull },
+    { 300, 260, false, false, 1, 0x4304808e49c24649ull },
+    { 300, 260, true , false, 1, 0x7d7d795c446ae1bcull },
+    { 300, 260, false, true , 1, 0x163411817cf31dc5ull },
+    { 300, 260, true , true , 1, 0x8180c82dcdac75f4ull },
+};
+
+static void testGolden()
+{
+    for (const Case &tc : cases)
+    {
+        const uint32_t seed = uint32_t(tc.width * 1000 + tc.height);
+        vector<uint8_t> image = makeImage(seed, tc.width, tc.height);
+        int width = tc.width, height = tc.height;
+        for (int pass = 0; pass < tc.passes; ++pass)
+        {
+            uint8_t *scaled = GL_SmartFilterHQ2x(image.data(), width, height, tc.wrapH, tc.wrapV);
+            width  *= 2;
+            height *= 2;
+            image.assign(scaled, scaled + size_t(width) * height * 4);
+            free(scaled);
+        }
+        const uint64_t sum = checksum(image.data(), image.size());
+        if (sum != tc.expected)
+        {
+            cout << tc.width << "x" << tc.height << " wrap " << tc.wrapH << tc.wrapV
+                 << " passes " << tc.passes << ": checksum " << hex << sum << dec << endl;
+        }
+        CHECK(sum == tc.expected);
+    }
+}
+
+static void benchmark()
+{
+    const int size = 1024;
+    const vector<uint8_t> image = makeImage(1, size, size);
+    const auto start = chrono::steady_clock::now();
+    uint8_t *scaled = GL_SmartFilterHQ2x(image.data(), size, size, true, true);
+    const chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+    free(scaled);
+    cout << size << "x" << size << " upscaled in " << elapsed.count() << " ms" << endl;
+}
+
+int main(int, char **)
+{
+    GL_InitSmartFilterHQ2x();
+
+    testGolden();
+    benchmark();
+
+    if (failures)
+    {
+        cout << failures << " checks failed" << endl;
+        return 1;
+    }
+    cout << "All checks passed" << endl;
+    return 0;
+}
@@ -0,0 +1,312 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Verifies that the vectorized particle kernels produce exactly the same results as
+ * the scalar ones, and that the scalar kernels produce exactly the same results as the
+ * original per-particle code of Generator::accelerateParticle(). Also measures their
+ * performance.
+ */
+
+#include "world/particlekernels.h"
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static const int TICSPERSEC = 35;
+static const int32_t FRACUNIT = 0x10000;
+
+static int failures = 0;
+
+/// FixedMul() as built by default (DE_NO_FIXED_ASM).
+static int32_t FixedMul(int32_t a, int32_t b)
+{
+    return int32_t((double(a) * double(b)) / FRACUNIT);
+}
+
+static int32_t FLT2FIX(float x)
+{
+    return int32_t(x * FRACUNIT);
+}
+
+/// The parts of a particle stage definition that affect the forces.
+struct StageDef
+{
+    float   spin[2];
+    float   spinResistance[2];
+    float   vectorForce[3];
+    int32_t gravity;    ///< Generator::ParticleStage::gravity
+    int32_t resistance; ///< Generator::ParticleStage::resistance
+};
+
+/// Particles with their own storage.
+struct Particles : public ParticleArrays
+{
+    vector<uint8_t> block;
+
+    Particles(int count) : block(ParticleArrays::blockSize(count))
+    {
+        setBlock(block.data(), count);
+    }
+
+    Particles(const Particles &other) : ParticleArrays(other), block(other.block)
+    {
+        setBlock(block.data(), other.count);
+    }
+
+    bool operator == (const Particles &other) const
+    {
+        return count == other.count && block == other.block;
+    }
+};
+
+static Particles randomParticles(int count, int stageCount, mt19937 &rng)
+{
+    uniform_int_distribution<int> percent(0, 99), stage(0, stageCount - 1);
+    uniform_int_distribution<int32_t> mov(-64 * FRACUNIT, 64 * FRACUNIT);
+    uniform_int_distribution<int> angle(0, 65535);
+
+    Particles particles(count);
+    for (int i = 0; i < count; ++i)
+    {
+        // Every fourth particle doesn't exist; some arrays have long runs of a stage.
+        particles.stage[i] = (percent(rng) < 25? -1 : stageCount > 1 && percent(rng) < 50?
+                              stage(rng) : 0);
+        particles.tics[i] = int16_t(angle(rng));
+        for (int c = 0; c < 3; ++c)
+        {
+            particles.origin[c][i] = mov(rng);
+            particles.mov[c][i]    = mov(rng);
+        }
+        particles.yaw[i]     = uint16_t(angle(rng));
+        particles.pitch[i]   = uint16_t(angle(rng));
+        particles.bspLeaf[i] = nullptr;
+        particles.contact[i] = nullptr;
+    }
+    return particles;
+}
+
+static vector<StageDef> randomStages(int count, mt19937 &rng)
+{
+    uniform_int_distribution<int> percent(0, 99);
+    uniform_real_distribution<float> spin(-720, 720), spinResistance(0, .5f), force(-2, 2),
+                                     gravity(0, 1), resistance(0, .5f);
+    vector<StageDef> stages(static_cast<size_t>(count));
+    for (auto &st : stages)
+    {
+        // Zero is the most common value of each property.
+        for (int a = 0; a < 2; ++a)
+        {
+            st.spin[a]           = percent(rng) < 50? 0 : spin(rng);
+            st.spinResistance[a] = percent(rng) < 50? 0 : spinResistance(rng);
+        }
+        const bool hasForce = percent(rng) < 50;
+        for (int c = 0; c < 3; ++c)
+        {
+            st.vectorForce[c] = hasForce? force(rng) : 0;
+        }
+        st.gravity    = percent(rng) < 50? 0 : FLT2FIX(gravity(rng));
+        st.resistance = FLT2FIX(1 - (percent(rng) < 50? 0 : resistance(rng)));
+    }
+    return stages;
+}
+
+/**
+ * The forces of each stage, like Generator::accelerateParticles() determines them.
+ */
+static vector<ParticleStageForces> stageForces(const vector<StageDef> &stages, float mapGravity)
+{
+    vector<ParticleStageForces> forces(stages.size());
+    for (size_t s = 0; s < stages.size(); ++s)
+    {
+        const StageDef &st = stages[s];
+        ParticleStageForces &f = forces[s];
+        for (int c = 0; c < 3; ++c)
+        {
+            f.accel[c] = FLT2FIX(st.vectorForce[c]);
+        }
+        f.accel[2]  -= FixedMul(FLT2FIX(mapGravity), st.gravity);
+        f.resistance = st.resistance;
+        for (int a = 0; a < 2; ++a)
+        {
+            f.spin[a]       = 65536 * st.spin[a] / (360 * TICSPERSEC);
+            f.spinFactor[a] = 1 - st.spinResistance[a];
+        }
+    }
+    return forces;
+}
+
+/**
+ * The original code of Generator::spinParticle() and Generator::accelerateParticle(),
+ * without the sphere force.
+ */
+static void originalForces(Particles &particles, int index, int generatorId,
+                           const vector<StageDef> &stages, float mapGravity)
+{
+    static int const yawSigns[4]   = { 1,  1, -1, -1 };
+    static int const pitchSigns[4] = { 1, -1,  1, -1 };
+
+    const StageDef *stDef = &stages[size_t(particles.stage[index])];
+    const unsigned spinIndex = unsigned(index - generatorId / 8) % 4;
+
+    const int yawSign   =   yawSigns[spinIndex];
+    const int pitchSign = pitchSigns[spinIndex];
+
+    uint16_t &yaw   = particles.yaw[index];
+    uint16_t &pitch = particles.pitch[index];
+    if (stDef->spin[0] != 0)
+    {
+        yaw   += 65536 * yawSign   * stDef->spin[0] / (360 * TICSPERSEC);
+    }
+    if (stDef->spin[1] != 0)
+    {
+        pitch += 65536 * pitchSign * stDef->spin[1] / (360 * TICSPERSEC);
+    }
+
+    yaw   *= 1 - stDef->spinResistance[0];
+    pitch *= 1 - stDef->spinResistance[1];
+
+    particles.mov[2][index] -= FixedMul(FLT2FIX(mapGravity), stDef->gravity);
+
+    if (stDef->vectorForce[0] != 0 || stDef->vectorForce[1] != 0 ||
+        stDef->vectorForce[2] != 0)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            particles.mov[i][index] += FLT2FIX(stDef->vectorForce[i]);
+        }
+    }
+
+    if (stDef->resistance != FRACUNIT)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            particles.mov[i][index] = FixedMul(particles.mov[i][index], stDef->resistance);
+        }
+    }
+}
+
+static int spinPhase(int generatorId)
+{
+    return -(generatorId / 8) & 3;
+}
+
+static void verifyAgainstOriginal(const ParticleKernels &scalar, mt19937 &rng)
+{
+    const float mapGravity = .5f;
+    for (int generatorId : {1, 8, 17, 30, 64})
+    {
+        const vector<StageDef> stages = randomStages(4, rng);
+        const vector<ParticleStageForces> forces = stageForces(stages, mapGravity);
+
+        Particles original = randomParticles(500, int(stages.size()), rng);
+        Particles result   = original;
+        // Run a couple of ticks so that the particles slow down and spin.
+        for (int tick = 0; tick < 10; ++tick)
+        {
+            for (int i = 0; i < original.count; ++i)
+            {
+                if (original.stage[i] >= 0) originalForces(original, i, generatorId, stages, mapGravity);
+            }
+            scalar.applyForces(result, forces.data(), spinPhase(generatorId));
+        }
+        if (!(result == original))
+        {
+            cout << "MISMATCH: scalar kernel differs from the original code (generator "
+                 << generatorId << ")" << endl;
+            failures++;
+        }
+    }
+}
+
+static void verify(const ParticleKernels &ref, const ParticleKernels &k, mt19937 &rng)
+{
+    // Sizes chosen to exercise both the vectorized loops and the leftovers.
+    for (int n : {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 31, 33, 64, 257, 1000})
+    {
+        for (int stageCount : {1, 5})
+        {
+            for (int phase = 0; phase < 4; ++phase)
+            {
+                const vector<ParticleStageForces> forces =
+                    stageForces(randomStages(stageCount, rng), .5f);
+                Particles expected = randomParticles(n, stageCount, rng);
+                Particles result   = expected;
+                ref.applyForces(expected, forces.data(), phase);
+                k.applyForces(result, forces.data(), phase);
+                if (!(result == expected))
+                {
+                    cout << "MISMATCH: " << k.name << " applyForces (size " << n << ", "
+                         << stageCount << " stages, phase " << phase << ")" << endl;
+                    failures++;
+                }
+            }
+        }
+    }
+}
+
+static double benchmark(const function<void ()> &func)
+{
+    const int rounds = 50;
+    const auto start = chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) func();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / rounds;
+}
+
+static void benchmarkAll(const ParticleKernels &k, mt19937 &rng)
+{
+    const int n = 100000;
+    const vector<ParticleStageForces> forces = stageForces(randomStages(4, rng), .5f);
+    Particles particles = randomParticles(n, 4, rng);
+
+    cout << k.name << " (100000 particles, ms):" << endl;
+    cout << "  applyForces     " << benchmark([&] () { k.applyForces(particles, forces.data(), 1); }) << endl;
+}
+
+int main(int argc, char **argv)
+{
+    const bool runBenchmarks = (argc > 1 && !strcmp(argv[1], "-bench"));
+    mt19937 rng(1234);
+
+    const ParticleKernels &scalar = *Particle_KernelsAtLevel(ParticleKernels::Scalar);
+    cout << "Best available kernels: " << Particle_Kernels().name << endl;
+
+    verifyAgainstOriginal(scalar, rng);
+    for (int level = 0; level < ParticleKernels::LevelCount; ++level)
+    {
+        const ParticleKernels *kernels = Particle_KernelsAtLevel(ParticleKernels::Level(level));
+        if (!kernels) continue;
+        if (kernels != &scalar) verify(scalar, *kernels, rng);
+        if (runBenchmarks) benchmarkAll(*kernels, rng);
+    }
+
+    if (failures)
+    {
+        cout << failures << " mismatches found" << endl;
+        return 1;
+    }
+    cout << "All kernels agree" << endl;
+    return 0;
+}
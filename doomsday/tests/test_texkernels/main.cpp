@@ -0,0 +1,513 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Verifies that the vectorized image kernels produce exactly the same results as
+ * the scalar ones, and that the image operations built on them produce exactly the
+ * same results as the original gl_tex.cpp loops. Also measures their performance.
+ * Runs without a display.
+ */
+
+#include "gl/gl_texkernels.h"
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+typedef vector<uint8_t> Bytes;
+
+static int failures = 0;
+
+static Bytes randomBytes(size_t count, mt19937 &rng, int opaquePercent = 50)
+{
+    // Images have plenty of fully opaque/saturated values, so make those common.
+    uniform_int_distribution<int> dist(0, 255), percent(0, 99);
+    Bytes bytes(count);
+    for (auto &b : bytes)
+    {
+        b = uint8_t(percent(rng) < opaquePercent? 255 : dist(rng));
+    }
+    return bytes;
+}
+
+static void check(bool ok, const ImageKernels &kernels, const char *what, long size)
+{
+    if (!ok)
+    {
+        cout << "MISMATCH: " << kernels.name << " " << what << " (size " << size << ")" << endl;
+        failures++;
+    }
+}
+
+static void verify(const ImageKernels &ref, const ImageKernels &k, mt19937 &rng)
+{
+    // Sizes chosen to exercise both the vectorized loops and the leftovers.
+    for (long n : {0L, 1L, 3L, 7L, 15L, 16L, 17L, 31L, 32L, 33L, 63L, 64L, 65L, 257L, 1000L})
+    {
+        for (int opaque : {0, 50, 100})
+        {
+            const Bytes src  = randomBytes(size_t(4 * n + 64), rng, opaque);
+            const Bytes mask = randomBytes(size_t(n), rng, opaque);
+            {
+                uint64_t s1[4], s2[4];
+                long t1, t2;
+                ref.sumRGBA(src.data(), n, s1, &t1);
+                k.sumRGBA(src.data(), n, s2, &t2);
+                check(!memcmp(s1, s2, sizeof(s1)) && t1 == t2, k, "sumRGBA", n);
+            }
+            {
+                uint8_t lo1, hi1, lo2, hi2;
+                uint64_t sum1, sum2;
+                long m1, m2;
+                ref.byteStats(src.data(), n, &lo1, &hi1, &sum1, &m1);
+                k.byteStats(src.data(), n, &lo2, &hi2, &sum2, &m2);
+                check(lo1 == lo2 && hi1 == hi2 && sum1 == sum2 && m1 == m2, k, "byteStats", n);
+            }
+            check(ref.maskedMax(src.data(), mask.data(), n) == k.maskedMax(src.data(), mask.data(), n),
+                  k, "maskedMax", n);
+            {
+                Bytes a = src, b = src;
+                ref.desaturateRGBA(a.data(), n);
+                k.desaturateRGBA(b.data(), n);
+                check(a == b, k, "desaturateRGBA", n);
+            }
+            for (int weight : {0, 1, 0x8000, 0xabcd, 0xffff})
+            {
+                Bytes a(static_cast<size_t>(n)), b(static_cast<size_t>(n));
+                ref.lerpBytes(src.data(), src.data() + n, a.data(), n, weight);
+                k.lerpBytes(src.data(), src.data() + n, b.data(), n, weight);
+                check(a == b, k, "lerpBytes", n);
+            }
+            {
+                // In place, as done when generating mipmaps.
+                Bytes a = src, b = src;
+                ref.halveRGBA(a.data(), a.data() + 8 * (n / 4), a.data(), n / 4);
+                k.halveRGBA(b.data(), b.data() + 8 * (n / 4), b.data(), n / 4);
+                check(a == b, k, "halveRGBA", n);
+
+                a = b = src;
+                ref.halveBytes(a.data(), a.data() + 2 * n, a.data(), n);
+                k.halveBytes(b.data(), b.data() + 2 * n, b.data(), n);
+                check(a == b, k, "halveBytes", n);
+            }
+            {
+                long f1, l1, f2, l2;
+                bool r1 = ref.opaqueSpanRGBA(src.data(), n, &f1, &l1);
+                bool r2 = k.opaqueSpanRGBA(src.data(), n, &f2, &l2);
+                check(r1 == r2 && (!r1 || (f1 == f2 && l1 == l2)), k, "opaqueSpanRGBA", n);
+
+                r1 = ref.opaqueSpanAlpha(mask.data(), n, &f1, &l1);
+                r2 = k.opaqueSpanAlpha(mask.data(), n, &f2, &l2);
+                check(r1 == r2 && (!r1 || (f1 == f2 && l1 == l2)), k, "opaqueSpanAlpha", n);
+            }
+            {
+                // Keys of nearly similar colors, so that all thresholds are tested.
+                vector<uint32_t> keys(size_t(3 * (n + 2)));
+                uniform_int_distribution<int> delta(-50, 50), coin(0, 3);
+                for (auto &key : keys)
+                {
+                    key = (coin(rng)? 0xff000000 : 0) |
+                          (uint32_t(128 + delta(rng)) << 16) |
+                          (uint32_t(128 + delta(rng) / 6) << 8) |
+                           uint32_t(128 + delta(rng) / 6);
+                }
+                const uint32_t *rows = keys.data() + 1;
+                Bytes a(static_cast<size_t>(n)), b(static_cast<size_t>(n));
+                ref.hqPatterns(rows, rows + n + 2, rows + 2 * (n + 2), n, a.data());
+                k.hqPatterns(rows, rows + n + 2, rows + 2 * (n + 2), n, b.data());
+                check(a == b, k, "hqPatterns", n);
+            }
+            {
+                vector<uint32_t> table(256);
+                for (auto &color : table) color = uint32_t(rng());
+                Bytes a(size_t(4 * n)), b(size_t(4 * n));
+                ref.indexedToRGBA(src.data(), nullptr, table.data(), n, a.data());
+                k.indexedToRGBA(src.data(), nullptr, table.data(), n, b.data());
+                check(a == b, k, "indexedToRGBA", n);
+
+                ref.indexedToRGBA(src.data(), mask.data(), table.data(), n, a.data());
+                k.indexedToRGBA(src.data(), mask.data(), table.data(), n, b.data());
+                check(a == b, k, "indexedToRGBA (alpha)", n);
+            }
+        }
+    }
+}
+
+/*
+ * The original gl_tex.cpp loops, used as the reference for the image operations.
+ */
+namespace original {
+
+static void scaleLine(const uint8_t *in, int inStride, uint8_t *out, int outStride,
+                      int outLen, int inLen, int comps)
+{
+    float inToOutScale = outLen / (float) inLen;
+    int i, c;
+
+    if (inToOutScale > 1)
+    {
+        int inPosDelta = (0x10000 * (inLen - 1)) / (outLen - 1);
+        int inPos = inPosDelta;
+        const uint8_t *col1, *col2;
+        int weight, invWeight;
+
+        memcpy(out, in, comps);
+        out += outStride;
+        for (i = 1; i < outLen - 1; ++i, out += outStride, inPos += inPosDelta)
+        {
+            col1 = in + (inPos >> 16) * inStride;
+            col2 = col1 + inStride;
+            weight = inPos & 0xffff;
+            invWeight = 0x10000 - weight;
+            for (c = 0; c < comps; ++c)
+                out[c] = (uint8_t)((col1[c] * invWeight + col2[c] * weight) >> 16);
+        }
+        memcpy(out, in + (inLen - 1) * inStride, comps);
+        return;
+    }
+
+    if (inToOutScale < 1)
+    {
+        unsigned cumul[4] = { 0, 0, 0, 0 }, count = 0;
+        int outpos = 0;
+
+        for (i = 0; i < inLen; ++i, in += inStride)
+        {
+            if ((int) (i * inToOutScale) != outpos)
+            {
+                outpos = (int) (i * inToOutScale);
+                for (c = 0; c < comps; ++c)
+                {
+                    out[c] = (count? uint8_t(cumul[c] / count) : 0);
+                    cumul[c] = 0;
+                }
+                count = 0;
+                out += outStride;
+            }
+            for (c = 0; c < comps; ++c)
+                cumul[c] += in[c];
+            count++;
+        }
+        if (count)
+            for (c = 0; c < comps; ++c)
+                out[c] = (uint8_t)(cumul[c] / count);
+        return;
+    }
+
+    for (i = outLen; i > 0; i--, out += outStride, in += inStride)
+    {
+        for (c = 0; c < comps; ++c)
+            out[c] = in[c];
+    }
+}
+
+/// GL_ScaleBuffer: rows first, then each column separately.
+static Bytes scaleBuffer(const Bytes &in, int width, int height, int comps,
+                         int outWidth, int outHeight)
+{
+    // When magnifying a single pixel, scaleLine() reads (but ignores) the next one.
+    Bytes buffer(size_t(comps * outWidth * (height + 1))), out(size_t(comps * outWidth * outHeight));
+    for (int i = 0; i < height; ++i)
+    {
+        scaleLine(in.data() + i * width * comps, comps, buffer.data() + i * outWidth * comps,
+                  comps, outWidth, width, comps);
+    }
+    const int stride = outWidth * comps;
+    for (int i = 0; i < outWidth; ++i)
+    {
+        scaleLine(buffer.data() + i * comps, stride, out.data() + i * comps, stride,
+                  outHeight, height, comps);
+    }
+    return out;
+}
+
+/// Unconstrained 2x2 reduction of GL_DownMipmap32 (and GL_DownMipmap8, for one byte).
+static void downMipmap(uint8_t *in, int width, int height, int comps)
+{
+    int x, y, c, outW = width >> 1, outH = height >> 1;
+    uint8_t *out = in;
+    for (y = 0; y < outH; ++y, in += width * comps)
+        for (x = 0; x < outW; ++x, in += comps * 2)
+            for (c = 0; c < comps; ++c, out++)
+            {
+                if (comps == 1)
+                    *out = (in[0] + in[1] + in[width] + in[width + 1]) / 4;
+                else
+                    *out = (uint8_t)((in[c] + in[comps + c] + in[comps * width + c] +
+                                      in[comps * (width + 1) + c]) >> 2);
+            }
+}
+
+/// FindClipRegionNonAlpha.
+static void findClipRegion(const uint8_t *buffer, int width, int height, int pixelsize,
+                           int region[4])
+{
+    const uint8_t *src = buffer, *alphasrc;
+
+    region[0] = width;
+    region[1] = 0;
+    region[2] = height;
+    region[3] = 0;
+
+    if (pixelsize == 1)
+        alphasrc = buffer + width * height;
+    else
+        alphasrc = NULL;
+
+    for (int k = 0; k < height; ++k)
+        for (int i = 0; i < width; ++i, src += pixelsize, alphasrc++)
+        {
+            if (pixelsize == 1)
+            {
+                if (*alphasrc < 255)
+                    continue;
+            }
+            else if (pixelsize == 4)
+            {
+                if (src[3] < 255)
+                    continue;
+            }
+
+            if (i < region[0]) region[0] = i;
+            if (i > region[1]) region[1] = i;
+            if (k < region[2]) region[2] = k;
+            if (k > region[3]) region[3] = k;
+        }
+}
+
+/// GL_PalettizeImage, with a palette of 256 RGB colors and a gamma table.
+static void palettizeImage(uint8_t *out, int outformat, const uint8_t *palette,
+                           const uint8_t *gamma, const uint8_t *in, int informat, long numPels)
+{
+    const int inSize  = (informat == 2 ? 1 : informat);
+    const int outSize = (outformat == 2 ? 1 : outformat);
+
+    for (long i = 0; i < numPels; ++i)
+    {
+        const uint8_t *palColor = palette + 3 * *in;
+
+        out[0] = palColor[0];
+        out[1] = palColor[1];
+        out[2] = palColor[2];
+
+        if (gamma)
+        {
+            out[0] = gamma[out[0]];
+            out[1] = gamma[out[1]];
+            out[2] = gamma[out[2]];
+        }
+
+        if (outformat == 4)
+        {
+            if (informat == 2)
+                out[3] = in[numPels * inSize];
+            else
+                out[3] = 0;
+        }
+
+        in  += inSize;
+        out += outSize;
+    }
+}
+
+} // namespace original
+
+static void checkImage(bool ok, const ImageKernels &kernels, const char *what, int width,
+                       int height, int comps)
+{
+    if (!ok)
+    {
+        cout << "MISMATCH: " << kernels.name << " " << what << " (" << width << "x" << height
+             << ", " << comps << " bytes per pixel)" << endl;
+        failures++;
+    }
+}
+
+static void verifyImageOps(const ImageKernels &k, mt19937 &rng)
+{
+    const int sizes[][2] = { {1, 1}, {2, 2}, {3, 5}, {8, 8}, {17, 9}, {64, 32}, {100, 37},
+                             {256, 128} };
+
+    for (int comps : {1, 3, 4})
+    {
+        for (const auto &in : sizes)
+        {
+            const int w = in[0], h = in[1];
+            const Bytes src = randomBytes(size_t(2 * comps * w * h), rng);
+
+            // Magnified, minified, and unchanged in each direction.
+            for (const auto &out : sizes)
+            {
+                for (const auto &size : { out, in })
+                {
+                    const int ow = size[0], oh = size[1];
+                    Bytes scaled(size_t(comps * ow * oh));
+                    GL_ScaleImage(k, src.data(), w, h, comps, scaled.data(), ow, oh);
+                    checkImage(scaled == original::scaleBuffer(src, w, h, comps, ow, oh), k,
+                               "GL_ScaleImage", w, h, comps);
+                }
+            }
+
+            if (w >= 2 && h >= 2)
+            {
+                Bytes a = src, b = src;
+                original::downMipmap(a.data(), w, h, comps);
+                GL_HalveImage(k, b.data(), w, h, comps);
+                checkImage(a == b, k, "GL_HalveImage", w, h, comps);
+            }
+
+            for (int opaque : {0, 1, 50, 100})
+            {
+                // For one byte per pixel, the alpha values follow the image.
+                const Bytes pixels = randomBytes(size_t(comps * w * h + w * h), rng, opaque);
+                int a[4], b[4];
+                original::findClipRegion(pixels.data(), w, h, comps, a);
+                GL_FindOpaqueRegion(k, pixels.data(), w, h, comps, b);
+                checkImage(!memcmp(a, b, sizeof(a)), k, "GL_FindOpaqueRegion", w, h, comps);
+            }
+        }
+    }
+
+    // Paletted images with and without an alpha plane, with and without gamma.
+    {
+        const Bytes palette = randomBytes(3 * 256, rng, 5);
+        const Bytes gamma   = randomBytes(256, rng, 5);
+        for (const auto &size : sizes)
+        {
+            const long numPels = long(size[0]) * size[1];
+            const Bytes src = randomBytes(size_t(2 * numPels), rng);
+            for (const uint8_t *gammaLut : {(const uint8_t *) nullptr, gamma.data()})
+            {
+                // The lookup table is built like in GL_PalettizeImage.
+                vector<uint32_t> table(256);
+                for (int i = 0; i < 256; ++i)
+                {
+                    uint8_t rgba[4] = { palette[3 * i], palette[3 * i + 1], palette[3 * i + 2], 0 };
+                    if (gammaLut)
+                    {
+                        for (int c = 0; c < 3; ++c) rgba[c] = gammaLut[rgba[c]];
+                    }
+                    memcpy(&table[i], rgba, 4);
+                }
+                for (int informat : {1, 2})
+                {
+                    for (int outformat : {3, 4})
+                    {
+                        Bytes a(size_t(outformat * numPels)), b(size_t(outformat * numPels));
+                        original::palettizeImage(a.data(), outformat, palette.data(), gammaLut,
+                                                 src.data(), informat, numPels);
+                        GL_IndexedToTrueColor(k, src.data(),
+                                              informat == 2? src.data() + numPels : nullptr,
+                                              table.data(), numPels, b.data(), outformat);
+                        checkImage(a == b, k, "GL_IndexedToTrueColor", size[0], size[1], informat);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static double benchmark(const function<void ()> &func)
+{
+    const int rounds = 50;
+    const auto start = chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) func();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / rounds;
+}
+
+static void benchmarkAll(const ImageKernels &k, mt19937 &rng)
+{
+    const long w = 1024, h = 1024, n = w * h;
+    const Bytes src  = randomBytes(size_t(4 * n), rng);
+    const Bytes mask = randomBytes(size_t(n), rng);
+    Bytes work = src, out(static_cast<size_t>(4 * n));
+    uint64_t sums[4], sum;
+    long count, first, last;
+    uint8_t lo, hi;
+
+    cout << k.name << " (1024x1024, ms):" << endl;
+    cout << "  sumRGBA         " << benchmark([&] () { k.sumRGBA(src.data(), n, sums, &count); }) << endl;
+    cout << "  byteStats       " << benchmark([&] () { k.byteStats(src.data(), n, &lo, &hi, &sum, &count); }) << endl;
+    cout << "  maskedMax       " << benchmark([&] () { k.maskedMax(src.data(), mask.data(), n); }) << endl;
+    cout << "  desaturateRGBA  " << benchmark([&] () { k.desaturateRGBA(work.data(), n); }) << endl;
+    cout << "  lerpBytes       " << benchmark([&] () { k.lerpBytes(src.data(), src.data() + 4 * w, out.data(), 4 * n - 4 * w, 0x4000); }) << endl;
+    cout << "  halveRGBA       " << benchmark([&] () {
+        for (long y = 0; y < h / 2; ++y)
+            k.halveRGBA(src.data() + 8 * w * y, src.data() + 8 * w * y + 4 * w, out.data() + 2 * w * y, w / 2);
+    }) << endl;
+    cout << "  halveBytes      " << benchmark([&] () {
+        for (long y = 0; y < h / 2; ++y)
+            k.halveBytes(src.data() + 2 * w * y, src.data() + 2 * w * y + w, out.data() + w / 2 * y, w / 2);
+    }) << endl;
+    cout << "  opaqueSpanRGBA  " << benchmark([&] () { k.opaqueSpanRGBA(src.data(), n, &first, &last); }) << endl;
+    cout << "  opaqueSpanAlpha " << benchmark([&] () { k.opaqueSpanAlpha(mask.data(), n, &first, &last); }) << endl;
+    cout << "  hqPatterns      " << benchmark([&] () {
+        const uint32_t *keys = reinterpret_cast<const uint32_t *>(src.data());
+        for (long y = 1; y < h - 1; ++y)
+            k.hqPatterns(keys + w * (y - 1) + 1, keys + w * y + 1, keys + w * (y + 1) + 1, w - 2, out.data() + w * y);
+    }) << endl;
+
+    // Converting a full sprite set from paletted (with an alpha plane) to RGBA:
+    // a thousand 64x96 frames.
+    {
+        const long spriteCount = 1000, spritePels = 64 * 96;
+        const Bytes sprites = randomBytes(size_t(2 * spritePels * spriteCount), rng);
+        vector<uint32_t> table(256);
+        for (auto &color : table) color = uint32_t(rng());
+        Bytes rgba(size_t(4 * spritePels));
+        cout << "  indexedToRGBA   " << benchmark([&] () {
+            for (long i = 0; i < spriteCount; ++i)
+            {
+                const uint8_t *sprite = sprites.data() + 2 * spritePels * i;
+                k.indexedToRGBA(sprite, sprite + spritePels, table.data(), spritePels, rgba.data());
+            }
+        }) << " (1000 sprites)" << endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const bool runBenchmarks = (argc > 1 && !strcmp(argv[1], "-bench"));
+    mt19937 rng(1234);
+
+    const ImageKernels &scalar = *GL_ImageKernelsAtLevel(ImageKernels::Scalar);
+    cout << "Best available kernels: " << GL_ImageKernels().name << endl;
+
+    for (int level = 0; level < ImageKernels::LevelCount; ++level)
+    {
+        const ImageKernels *kernels = GL_ImageKernelsAtLevel(ImageKernels::Level(level));
+        if (!kernels) continue;
+        if (kernels != &scalar) verify(scalar, *kernels, rng);
+        verifyImageOps(*kernels, rng);
+        if (runBenchmarks) benchmarkAll(*kernels, rng);
+    }
+
+    if (failures)
+    {
+        cout << failures << " mismatches found" << endl;
+        return 1;
+    }
+    cout << "All kernels agree" << endl;
+    return 0;
+}
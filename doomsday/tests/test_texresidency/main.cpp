@@ -0,0 +1,201 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Exercises the texture residency manager with a fake backend that only records
+ * which textures were evicted. Runs without a display.
+ */
+
+#include "resource/textureresidency.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    if (!(cond)) { cout << "FAILED (line " << __LINE__ << "): " #cond << endl; failures++; }
+
+/// Evicts textures like the client does: the texture is released and removed.
+struct FakeBackend : public TextureResidency::Backend
+{
+    TextureResidency *residency = nullptr;
+    vector<TextureResidency::Item> evicted;
+
+    void evict(TextureResidency::Item item) override
+    {
+        evicted.push_back(item);
+        residency->remove(item);
+    }
+};
+
+struct Fixture
+{
+    FakeBackend backend;
+    TextureResidency residency;
+    int textures[16] {};
+
+    Fixture() : residency(backend)
+    {
+        backend.residency = &residency;
+        residency.setMinIdleFrames(2);
+    }
+
+    TextureResidency::Item tex(int i) const { return &textures[i]; }
+};
+
+static void testUnlimited()
+{
+    Fixture f;
+    for (int i = 0; i < 8; ++i) f.residency.add(f.tex(i), 1000, 0);
+    CHECK(f.residency.evictIdle(10) == 0);
+    CHECK(f.backend.evicted.empty());
+    CHECK(f.residency.counters().residentCount == 8);
+    CHECK(f.residency.counters().residentBytes == 8000);
+}
+
+static void testLeastRecentlyUsedFirst()
+{
+    Fixture f;
+    f.residency.setBudget(4000);
+    for (int i = 0; i < 6; ++i) f.residency.add(f.tex(i), 1000, i);
+    f.residency.touch(f.tex(0), 6); // Now the most recently used.
+
+    // Target is 7/8 of the budget: 3500 bytes, so three must go.
+    CHECK(f.residency.evictIdle(10) == 3);
+    CHECK(f.backend.evicted.size() == 3);
+    if (f.backend.evicted.size() == 3)
+    {
+        CHECK(f.backend.evicted[0] == f.tex(1));
+        CHECK(f.backend.evicted[1] == f.tex(2));
+        CHECK(f.backend.evicted[2] == f.tex(3));
+    }
+    const auto counters = f.residency.counters();
+    CHECK(counters.residentCount == 3);
+    CHECK(counters.residentBytes == 3000);
+    CHECK(counters.evictionCount == 3);
+    CHECK(counters.evictedBytes == 3000);
+    CHECK(counters.peakBytes == 6000);
+}
+
+static void testRecentlyUsedAreKept()
+{
+    Fixture f;
+    f.residency.setBudget(1000);
+    for (int i = 0; i < 4; ++i) f.residency.add(f.tex(i), 1000, 5);
+
+    // Everything was used too recently, even though the budget is exceeded.
+    CHECK(f.residency.evictIdle(6) == 0);
+    CHECK(f.residency.counters().residentBytes == 4000);
+
+    // Only one eviction pass per frame.
+    f.residency.touch(f.tex(3), 7);
+    CHECK(f.residency.evictIdle(6) == 0);
+    CHECK(f.residency.evictIdle(7) == 3);
+    CHECK(f.residency.counters().residentCount == 1);
+    CHECK(f.backend.evicted.size() == 3);
+}
+
+static void testReloads()
+{
+    Fixture f;
+    f.residency.setBudget(2000);
+    for (int i = 0; i < 3; ++i) f.residency.add(f.tex(i), 1000, 0);
+    CHECK(f.residency.evictIdle(5) == 2);
+
+    // The evicted textures are needed again.
+    for (auto item : f.backend.evicted) f.residency.add(item, 1000, 6);
+    CHECK(f.residency.counters().reloadCount == 2);
+
+    // Removing a texture for good forgets that it was evicted.
+    f.residency.setBudget(0);
+    f.residency.remove(f.tex(2));
+    CHECK(f.residency.evictIdle(20) == 0);
+    f.residency.add(f.tex(2), 1000, 20);
+    CHECK(f.residency.counters().reloadCount == 2);
+}
+
+static void testReadd()
+{
+    Fixture f;
+    f.residency.add(f.tex(0), 1000, 0);
+    f.residency.add(f.tex(0), 500, 1); // Replaced with a smaller texture.
+    CHECK(f.residency.counters().residentCount == 1);
+    CHECK(f.residency.counters().residentBytes == 500);
+    f.residency.remove(f.tex(0));
+    f.residency.remove(f.tex(0));
+    CHECK(f.residency.counters().residentBytes == 0);
+    f.residency.touch(f.tex(1), 2); // Unknown textures are ignored.
+    CHECK(f.residency.counters().residentCount == 0);
+}
+
+/// A texture whose GL name is kept elsewhere, like a halo's flare texture.
+static void testHeldNameIsPinned()
+{
+    Fixture f;
+    f.residency.setBudget(2000);
+    for (int i = 0; i < 4; ++i) f.residency.add(f.tex(i), 1000, 0);
+
+    // The flare texture (tex 0) is the least recently used one, but its name is held.
+    f.residency.pin(f.tex(0));
+    CHECK(f.residency.isPinned(f.tex(0)));
+    CHECK(!f.residency.isPinned(f.tex(1)));
+
+    CHECK(f.residency.evictIdle(10) == 3);
+    for (auto item : f.backend.evicted) CHECK(item != f.tex(0));
+    CHECK(f.residency.counters().residentCount == 1);
+    CHECK(f.residency.counters().residentBytes == 1000);
+
+    // Pinned textures are kept even if they alone exceed the budget.
+    f.residency.setBudget(500);
+    CHECK(f.residency.evictIdle(20) == 0);
+    CHECK(f.residency.counters().residentBytes == 1000);
+
+    // A texture may be pinned before it becomes resident.
+    f.residency.pin(f.tex(5));
+    f.residency.add(f.tex(5), 1000, 20);
+    CHECK(f.residency.evictIdle(30) == 0);
+
+    // Releasing the texture for good unpins it.
+    f.residency.remove(f.tex(0));
+    CHECK(!f.residency.isPinned(f.tex(0)));
+    f.residency.add(f.tex(0), 1000, 30);
+    CHECK(f.residency.evictIdle(40) == 1);
+    CHECK(f.backend.evicted.back() == f.tex(0));
+}
+
+int main(int, char **)
+{
+    testUnlimited();
+    testLeastRecentlyUsedFirst();
+    testRecentlyUsedAreKept();
+    testReloads();
+    testReadd();
+    testHeldNameIsPinned();
+
+    if (failures)
+    {
+        cout << failures << " checks failed" << endl;
+        return 1;
+    }
+    cout << "All checks passed" << endl;
+    return 0;
+}
@@ -0,0 +1,296 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2026 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Verifies that the view frustum rejects only boxes that are entirely outside the
+ * view volume of a perspective view (compared to testing points in clip space), and
+ * measures the cost of the box test. Runs without a display.
+ */
+
+#include "render/viewfrustum.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    if (!(cond)) { cout << "FAILED (line " << __LINE__ << "): " #cond << endl; failures++; }
+
+/// Column-major 4x4 matrix, like de::Mat4f.
+struct Matrix
+{
+    float m[16];
+
+    float &at(int r, int c) { return m[c * 4 + r]; }
+    float at(int r, int c) const { return m[c * 4 + r]; }
+
+    Matrix operator * (const Matrix &other) const
+    {
+        Matrix result;
+        for (int r = 0; r < 4; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                float sum = 0;
+                for (int k = 0; k < 4; ++k) sum += at(r, k) * other.at(k, c);
+                result.at(r, c) = sum;
+            }
+        }
+        return result;
+    }
+};
+
+static Matrix perspective(float fovY, float aspect, float nearDist, float farDist)
+{
+    Matrix p = {};
+    const float f = 1.f / tan(fovY / 2);
+    p.at(0, 0) = f / aspect;
+    p.at(1, 1) = f;
+    p.at(2, 2) = (farDist + nearDist) / (nearDist - farDist);
+    p.at(2, 3) = 2 * farDist * nearDist / (nearDist - farDist);
+    p.at(3, 2) = -1;
+    return p;
+}
+
+/// Model-view matrix of a viewer at map coordinates @a eye, turned @a yaw radians from
+/// the map's X axis and @a pitch radians up. Like the renderer, GL space is the map's
+/// (x, z, y).
+static Matrix view(const double eye[3], float yaw, float pitch)
+{
+    const float glEye[3] = { float(eye[0]), float(eye[2]), float(eye[1]) };
+    const float fwd[3]   = { cos(yaw) * cos(pitch), sin(pitch), sin(yaw) * cos(pitch) };
+    const float right[3] = { -sin(yaw), 0, cos(yaw) };
+    const float up[3]    = { right[1] * fwd[2] - right[2] * fwd[1],
+                             right[2] * fwd[0] - right[0] * fwd[2],
+                             right[0] * fwd[1] - right[1] * fwd[0] };
+    const float *rows[3] = { right, up, fwd };
+
+    Matrix v = {};
+    for (int r = 0; r < 3; ++r)
+    {
+        const float sign = (r == 2? -1.f : 1.f);  // Looking down -Z.
+        float dot = 0;
+        for (int c = 0; c < 3; ++c)
+        {
+            v.at(r, c) = sign * rows[r][c];
+            dot += v.at(r, c) * glEye[c];
+        }
+        v.at(r, 3) = -dot;
+    }
+    v.at(3, 3) = 1;
+    return v;
+}
+
+/// Transforms a map space point to clip space.
+static void toClip(const Matrix &mvp, const double p[3], double clip[4])
+{
+    const double gl[4] = { p[0], p[2], p[1], 1 };
+    for (int r = 0; r < 4; ++r)
+    {
+        clip[r] = 0;
+        for (int c = 0; c < 4; ++c) clip[r] += mvp.at(r, c) * gl[c];
+    }
+}
+
+static bool isInside(const Matrix &mvp, const double p[3])
+{
+    double clip[4];
+    toClip(mvp, p, clip);
+    for (int i = 0; i < 3; ++i)
+    {
+        if (clip[i] < -clip[3] || clip[i] > clip[3]) return false;
+    }
+    return true;
+}
+
+/// Determines if all the corners of a box are outside the same clip plane, which is
+/// what a rejection by the frustum means.
+static bool isOutsideOnePlane(const Matrix &mvp, const double min[3], const double max[3])
+{
+    for (int plane = 0; plane < 6; ++plane)
+    {
+        const int axis = plane / 2;
+        const double sign = (plane % 2? -1 : 1);
+        bool allOutside = true;
+        for (int corner = 0; corner < 8 && allOutside; ++corner)
+        {
+            const double p[3] = { corner & 1? max[0] : min[0],
+                                  corner & 2? max[1] : min[1],
+                                  corner & 4? max[2] : min[2] };
+            double clip[4];
+            toClip(mvp, p, clip);
+            if (clip[3] + sign * clip[axis] >= -1e-6) allOutside = false;
+        }
+        if (allOutside) return true;
+    }
+    return false;
+}
+
+static bool isBoxVisible(const ViewFrustum &frustum, double x0, double y0, double z0,
+                         double x1, double y1, double z1)
+{
+    const double min[3] = { x0, y0, z0 };
+    const double max[3] = { x1, y1, z1 };
+    return frustum.isBoxVisible(min, max);
+}
+
+static void testFixedBoxes()
+{
+    // Looking along the map's +X axis from the origin, at eye height 40.
+    const double eye[3] = { 0, 0, 40 };
+    const Matrix mvp = perspective(1.2f, 16.f / 9.f, 4, 8000) * view(eye, 0, 0);
+
+    ViewFrustum frustum;
+    CHECK(isBoxVisible(frustum, 1e6, 1e6, 1e6, 1e6 + 1, 1e6 + 1, 1e6 + 1));
+
+    frustum.setMatrix(mvp.m);
+    CHECK( isBoxVisible(frustum, 100, -10, 0, 120, 10, 64));     // Ahead.
+    CHECK(!isBoxVisible(frustum, -120, -10, 0, -100, 10, 64));   // Behind.
+    CHECK(!isBoxVisible(frustum, 100, 400, 0, 120, 420, 64));    // Far to the left.
+    CHECK(!isBoxVisible(frustum, 100, -420, 0, 120, -400, 64));  // Far to the right.
+    CHECK(!isBoxVisible(frustum, 100, -10, 300, 120, 10, 320));  // High above.
+    CHECK(!isBoxVisible(frustum, 100, -10, -320, 120, 10, -300)); // Deep below.
+    CHECK(!isBoxVisible(frustum, 9000, -10, 0, 9100, 10, 64));   // Beyond the far plane.
+    CHECK( isBoxVisible(frustum, -50, -50, 0, 50, 50, 64));      // Around the viewer.
+    CHECK( isBoxVisible(frustum, 100, -1000, 0, 120, 1000, 0));  // Flat, across the view.
+    CHECK( isBoxVisible(frustum, 100, 50, 40, 120, 400, 40));    // Crosses the left edge.
+
+    // Turning around makes the box behind visible.
+    frustum.setMatrix((perspective(1.2f, 16.f / 9.f, 4, 8000) * view(eye, 3.14159f, 0)).m);
+    CHECK( isBoxVisible(frustum, -120, -10, 0, -100, 10, 64));
+    CHECK(!isBoxVisible(frustum, 100, -10, 0, 120, 10, 64));
+
+    frustum.setUnbounded();
+    CHECK(isBoxVisible(frustum, 100, -10, 300, 120, 10, 320));
+}
+
+static void testRandomBoxes()
+{
+    mt19937 rng(1234);
+    uniform_real_distribution<double> coord(-2000, 2000);
+    uniform_real_distribution<double> size(0, 300);
+    uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+    uniform_real_distribution<float> pitch(-.8f, .8f);
+
+    int missed = 0, wrongRejects = 0, visibleCount = 0, total = 0;
+    for (int viewIndex = 0; viewIndex < 50; ++viewIndex)
+    {
+        const double eye[3] = { coord(rng), coord(rng), coord(rng) / 10 };
+        const Matrix mvp = perspective(1.3f, 4.f / 3.f, 4, 3000) * view(eye, angle(rng), pitch(rng));
+
+        ViewFrustum frustum;
+        frustum.setMatrix(mvp.m);
+
+        for (int i = 0; i < 2000; ++i, ++total)
+        {
+            double min[3], max[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                min[k] = coord(rng) / (k == 2? 10 : 1);
+                max[k] = min[k] + size(rng) / (k == 2? 2 : 1);
+            }
+            const bool visible = frustum.isBoxVisible(min, max);
+            if (visible) visibleCount++;
+
+            if (!visible)
+            {
+                // No point in a rejected box may be inside the view volume.
+                bool anyInside = false;
+                const int steps = 4;
+                for (int a = 0; a <= steps && !anyInside; ++a)
+                for (int b = 0; b <= steps && !anyInside; ++b)
+                for (int c = 0; c <= steps && !anyInside; ++c)
+                {
+                    const double p[3] = { min[0] + (max[0] - min[0]) * a / steps,
+                                          min[1] + (max[1] - min[1]) * b / steps,
+                                          min[2] + (max[2] - min[2]) * c / steps };
+                    anyInside = isInside(mvp, p);
+                }
+                if (anyInside) missed++;
+                if (!isOutsideOnePlane(mvp, min, max)) wrongRejects++;
+            }
+            else if (isOutsideOnePlane(mvp, min, max))
+            {
+                // Should have been rejected.
+                wrongRejects++;
+            }
+        }
+    }
+    CHECK(missed == 0);
+    CHECK(wrongRejects == 0);
+    CHECK(visibleCount > 0 && visibleCount < total);
+    cout << visibleCount << " of " << total << " random boxes are in view" << endl;
+}
+
+static void testPerformance()
+{
+    const double eye[3] = { 0, 0, 40 };
+    ViewFrustum frustum;
+    frustum.setMatrix((perspective(1.2f, 16.f / 9.f, 4, 8000) * view(eye, .5f, .1f)).m);
+
+    mt19937 rng(99);
+    uniform_real_distribution<double> coord(-4000, 4000);
+    const int count = 1 << 16;
+    vector<double> boxes(count * 6);
+    for (int i = 0; i < count; ++i)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            boxes[i * 6 + k]     = coord(rng);
+            boxes[i * 6 + 3 + k] = boxes[i * 6 + k] + 64;
+        }
+    }
+
+    const int rounds = 40;
+    int visible = 0;
+    auto start = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            if (frustum.isBoxVisible(&boxes[i * 6], &boxes[i * 6 + 3])) visible++;
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    const double ns = chrono::duration<double, nano>(end - start).count() / (double(count) * rounds);
+    CHECK(visible > 0);
+    cout << ns << " ns per box test (" << double(visible) / rounds << " of " << count
+         << " visible)" << endl;
+}
+
+int main(int, char **)
+{
+    testFixedBoxes();
+    testRandomBoxes();
+    testPerformance();
+
+    if (failures)
+    {
+        cout << failures << " checks failed" << endl;
+        return 1;
+    }
+    cout << "All checks passed" << endl;
+    return 0;
+}